@@ -3,61 +3,69 @@
  */
 #include "airgead_investment_planner_cli.h"
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 #include "mini_utils.h"
+#include "screen.h"
 
 namespace airgead_investment_planner_cli {
-using std::cout;
 using std::endl;
 using std::string;
 
-long double DepositCalculator::calculateCompoundInterest(
-    long double principal, long double interestRatePercent,
-    long double monthlyDeposit, int years) {
-  const double MONTHS_IN_A_YEAR = 12.0L;
-  const double PERCENTAGE_TO_DECIMAL = 100.0L;
+namespace {
+// Portfolio planner columns, in the order they are simulated
+const RebalancePolicy REBALANCE_POLICIES[] = {
+    RebalancePolicy::NEVER, RebalancePolicy::MONTHLY,
+    RebalancePolicy::QUARTERLY, RebalancePolicy::ANNUAL,
+    RebalancePolicy::THRESHOLD};
+const char* const REBALANCE_POLICY_NAMES[] = {"Never", "Monthly", "Quarterly",
+                                              "Annual", "Threshold"};
 
-  // Convert percentage to decimal
-  long double annualInterestRate = interestRatePercent / PERCENTAGE_TO_DECIMAL;
-  // Calculate monthly rate
-  long double monthlyRate = annualInterestRate / MONTHS_IN_A_YEAR;
-
-  // Calculate total number of months in the period
-  int totalMonths = years * static_cast<int>(MONTHS_IN_A_YEAR);
-
-  // Calculate compounded principal amount
-  long double compoundedPrincipal =
-      principal * pow(1.0L + monthlyRate, totalMonths);
-
-  // Calculate future value of monthly deposits (with early deposit adjustment)
-  long double futureValueOfDeposits =
-      monthlyDeposit * (pow(1.0L + monthlyRate, totalMonths + 1) - 1) /
-          monthlyRate -
-      monthlyDeposit;
+// Draws the title banner that opens each planner session as one frame, so it
+// is written with a single write
+void printBanner(std::ostream& out,
+                 const mini_utils::StringFormatter& FORMATTER,
+                 const char* TITLE) {
+  const char FORMAT_CHAR = '-';
+  mini_utils::Screen screen(FORMATTER.getWidth(), 4);
+  FORMATTER.appendHorizontalSeparator(screen.beginLine(0), FORMAT_CHAR);
+  FORMATTER.appendFullBorder(screen.beginLine(1), TITLE, FORMAT_CHAR);
+  FORMATTER.appendHorizontalSeparator(screen.beginLine(2), FORMAT_CHAR);
+  screen.present(out);
+}
+}  // namespace
 
-  // Return the total compounded value (principal + deposits)
-  return compoundedPrincipal + futureValueOfDeposits;
+std::string trimUserFormatting(const std::string& ORIG_STR) {
+  const std::string RESULT = mini_utils::trim(ORIG_STR);
+  size_t start = RESULT.find_first_not_of("$%");
+  // If all characters are '$' or '%', return an empty string
+  return (start != std::string::npos) ? RESULT.substr(start) : "";
 }
 
 InvestmentPlannerCli::InvestmentPlannerCli(int t_width, double t_principal,
                                            double t_monthlyDeposit,
-                                           double t_annualRate, int t_years)
+                                           double t_annualRate, int t_years,
+                                           CalculationMode t_mode)
     : m_width(t_width),
       m_string_formatter(t_width),
       m_table_formatter(t_width),
       m_principal(t_principal),
       m_monthlyDeposit(t_monthlyDeposit),
       m_annualRate(t_annualRate),
-      m_years(t_years) {}
+      m_years(t_years),
+      m_mode(t_mode) {}
 
-std::string InvestmentPlannerCli::trimUserFormatting(
-    const std::string& ORIG_STR) {
-  const std::string RESULT = mini_utils::trim(ORIG_STR);
-  size_t start = RESULT.find_first_not_of("$%");
-  // If all characters are '$' or '%', return an empty string
-  return (start != std::string::npos) ? RESULT.substr(start) : "";
+void InvestmentPlannerCli::setCalculationMode(CalculationMode mode) {
+  m_mode = mode;
+}
+
+void InvestmentPlannerCli::setStreams(std::istream& in, std::ostream& out) {
+  m_in = &in;
+  m_out = &out;
 }
 
 void InvestmentPlannerCli::getValuesFromUser() {
@@ -67,16 +75,19 @@ void InvestmentPlannerCli::getValuesFromUser() {
 
   // Bug or feature: hexadecimal input support
   m_principal = mini_utils::getValidatedInput<double>(
-      "Initial Investment Amount (in $): ", mini_utils::isPositiveRealNum,
-      "positive real number", false, trimUserFormatting);
+      *m_in, *m_out, "Initial Investment Amount (in $): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
   m_monthlyDeposit = mini_utils::getValidatedInput<double>(
-      "Monthly Deposit (in $): ", mini_utils::isPositiveRealNum,
-      "positive real number", false, trimUserFormatting);
+      *m_in, *m_out, "Monthly Deposit (in $): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
   m_annualRate = mini_utils::getValidatedInput<double>(
-      "Annual Interest Rate (in %): ", mini_utils::isPositiveRealNum,
-      "positive real number", false, trimUserFormatting);
+      *m_in, *m_out, "Annual Interest Rate (in %): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
   m_years = mini_utils::getValidatedInput<int>(
-      "Investment Term (Years): ",
+      *m_in, *m_out, "Investment Term (Years): ",
       [MIN_YEARS, MAX_YEARS](int input) {
         return input >= MIN_YEARS && input <= MAX_YEARS;
       },
@@ -90,24 +101,51 @@ string InvestmentPlannerCli::getTable(bool withDeposits) {
                                  "End of the Year Earned Interest"};
   m_table_formatter.setHeaders(headers);
   if (!m_table_formatter.setColumnWidths({10, 35, 35})) {
-    cout << "Unexpected error happened: unable to set table column widths."
-         << endl;
+    *m_out << "Unexpected error happened: unable to set table column widths."
+           << endl;
     return "";
   }
 
-  double lastYearBalance = m_principal;
   const double MONTHLY_DEPOSIT = withDeposits ? m_monthlyDeposit : 0;
-  const double ANNUAL_DEPOSIT = MONTHLY_DEPOSIT * 12;
+  if (m_mode == CalculationMode::FIXED_POINT) {
+    addFixedPointRows(MONTHLY_DEPOSIT);
+  } else {
+    addFloatingPointRows(MONTHLY_DEPOSIT);
+  }
+
+  const string OUT_SUFFIX = (withDeposits ? "" : "out");
+  const string HEADER =
+      m_string_formatter.horizontalSeparatorWithSides('-', '+') + "\n" +
+      m_string_formatter.formatCentered("Balance and Interest With" +
+                                            OUT_SUFFIX +
+                                            " Additional Monthly Deposits",
+                                        '|') +
+      "\n";
+
+  // Ideally, we can defer cleaning table and just return the result,
+  // but defer implementation would overcomplicate things.
+  const string RESULT = HEADER + m_table_formatter.render();
+
+  // Clean table
+  m_table_formatter.clearRows();
+
+  return RESULT;
+}
+
+void InvestmentPlannerCli::addFloatingPointRows(double monthlyDeposit) {
+  long double lastYearBalance = m_principal;
+  const double ANNUAL_DEPOSIT = monthlyDeposit * 12;
 
   for (int currentYear = 1; currentYear < m_years + 1; ++currentYear) {
     string yearRow = std::to_string(currentYear);
 
     // Calculate year-end balance
     long double yearEndBalance = DepositCalculator::calculateCompoundInterest(
-        m_principal, m_annualRate, MONTHLY_DEPOSIT, currentYear);
+        m_principal, m_annualRate, monthlyDeposit, currentYear);
 
     // Calculate year-end earned interest
-    double earnedInterest = yearEndBalance - (lastYearBalance + ANNUAL_DEPOSIT);
+    long double earnedInterest =
+        yearEndBalance - (lastYearBalance + ANNUAL_DEPOSIT);
 
     // Convert to strings for table formatting
     string formattedEndYearBalance =
@@ -121,44 +159,417 @@ string InvestmentPlannerCli::getTable(bool withDeposits) {
 
     lastYearBalance = yearEndBalance;
   }
-  const string OUT_SUFFIX = (withDeposits ? "" : "out");
-  const string HEADER =
-      m_string_formatter.horizontalSeparatorWithSides('-', '+') + "\n" +
-      m_string_formatter.formatCentered("Balance and Interest With" +
-                                            OUT_SUFFIX +
-                                            " Additional Monthly Deposits",
-                                        '|') +
-      "\n";
+}
 
-  // Ideally, we can defer cleaning table and just return the result,
-  // but defer implementation would overcomplicate things.
-  const string RESULT = HEADER + m_table_formatter.render();
+void InvestmentPlannerCli::addFixedPointRows(double monthlyDeposit) {
+  const Money PRINCIPAL = Money::fromDollars(m_principal);
+  const Money MONTHLY_DEPOSIT = Money::fromDollars(monthlyDeposit);
+  const Money ANNUAL_DEPOSIT = MONTHLY_DEPOSIT.mulDiv(12, 1);
 
-  // Clean table
-  m_table_formatter.clearRows();
+  const std::vector<Money> YEAR_END_BALANCES =
+      DepositCalculator::calculateYearEndBalancesExact(
+          PRINCIPAL, PercentRate::fromPercent(m_annualRate), MONTHLY_DEPOSIT,
+          m_years);
 
-  return RESULT;
+  Money lastYearBalance = PRINCIPAL;
+  for (size_t i = 0; i < YEAR_END_BALANCES.size(); ++i) {
+    const Money& YEAR_END_BALANCE = YEAR_END_BALANCES[i];
+    const Money EARNED_INTEREST =
+        YEAR_END_BALANCE - (lastYearBalance + ANNUAL_DEPOSIT);
+
+    m_table_formatter.addRow({std::to_string(i + 1),
+                              "$" + YEAR_END_BALANCE.toString(),
+                              "$" + EARNED_INTEREST.toString()});
+
+    lastYearBalance = YEAR_END_BALANCE;
+  }
 }
 
 void InvestmentPlannerCli::pressToContinue() {
-  cout << "Press enter to continue..." << endl;
-  std::cin.get();
-  std::cout << "\x1b[1A\x1b[1A"  // Move cursor two lines up
-            << "\x1b[2K";        // Delete the entire line
+  mini_utils::Screen screen(m_width, 1);
+  screen.beginLine(0) = "Press enter to continue...";
+  screen.present(*m_out);
+  m_in->get();
+  // The terminal echoed the enter key below the prompt. Blank the prompt and
+  // leave the cursor on it, so what follows is written over both lines.
+  screen.addLinesBelow(1);
+  screen.clear();
+  screen.release(*m_out, 0);
 }
 
 void InvestmentPlannerCli::startCli() {
-  const char FORMAT_CHAR = '-';
-  cout << m_string_formatter.horizontalSeparator(FORMAT_CHAR) << endl
-       << m_string_formatter.formatFullBorder("Airgead Investment Calculator",
-                                              FORMAT_CHAR)
-       << endl
-       << m_string_formatter.horizontalSeparator(FORMAT_CHAR) << endl
-       << endl;
+  printBanner(*m_out, m_string_formatter, "Airgead Investment Calculator");
 
   getValuesFromUser();
   pressToContinue();
 
-  cout << getTable(false) << endl << getTable(true) << endl;
+  *m_out << getTable(false) << endl << getTable(true) << endl;
+}
+
+// LoanPlannerCli
+LoanPlannerCli::LoanPlannerCli(int t_width)
+    : m_width(t_width),
+      m_string_formatter(t_width),
+      m_table_formatter(t_width) {
+  // Longest supported term, so repeated runs never reallocate the columns
+  m_schedule.reserve(AmortizationCalculator::MAX_LOAN_YEARS *
+                     AmortizationCalculator::MONTHS_IN_A_YEAR);
+}
+
+void LoanPlannerCli::setStreams(std::istream& in, std::ostream& out) {
+  m_in = &in;
+  m_out = &out;
+}
+
+void LoanPlannerCli::getValuesFromUser() {
+  const int MIN_YEARS = AmortizationCalculator::MIN_LOAN_YEARS;
+  const int MAX_YEARS = AmortizationCalculator::MAX_LOAN_YEARS;
+
+  m_terms.principal = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Loan Amount (in $): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
+  m_terms.annualRatePercent = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Annual Interest Rate (in %): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
+  m_terms.years = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Loan Term (Years): ",
+      [MIN_YEARS, MAX_YEARS](int input) {
+        return input >= MIN_YEARS && input <= MAX_YEARS;
+      },
+      "integer between " + std::to_string(MIN_YEARS) + " and " +
+          std::to_string(MAX_YEARS));
+  const int PLAN = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Repayment Plan (1 - Mortgage, 2 - Fixed Principal): ",
+      [](int input) { return input == 1 || input == 2; }, "1 or 2");
+  m_terms.plan =
+      PLAN == 1 ? RepaymentPlan::MORTGAGE : RepaymentPlan::FIXED_PRINCIPAL;
+  m_terms.extraMonthlyPayment = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Extra Monthly Payment (in $): ",
+      [](double input) {
+        return input == 0 || mini_utils::isPositiveRealNum(input);
+      },
+      "zero or positive real number", false, trimUserFormatting);
+}
+
+void LoanPlannerCli::printSchedule() {
+  m_table_formatter.setHeaders(
+      {"Month", "Payment", "Principal", "Interest", "Balance"});
+  if (!m_table_formatter.setColumnWidths({10, 17, 17, 17, 19})) {
+    *m_out << "Unexpected error happened: unable to set table column widths."
+           << endl;
+    return;
+  }
+
+  const std::vector<Money>& PAYMENTS = m_schedule.getPayments();
+  const std::vector<Money>& PRINCIPAL_PAID = m_schedule.getPrincipalPaid();
+  const std::vector<Money>& INTEREST_PAID = m_schedule.getInterestPaid();
+  const std::vector<Money>& BALANCES = m_schedule.getBalances();
+
+  // Rows are formatted on demand into a reused row, one page at a time
+  int period = 0;
+  const mini_utils::TableFormatter::RowSource SCHEDULE_ROWS =
+      [&](std::vector<string>& row) {
+        if (period >= m_schedule.size()) {
+          return false;
+        }
+        row.resize(5);
+        row[0] = std::to_string(period + 1);
+        // Cells are rebuilt in place, reusing the row between periods
+        const Money* const VALUES[] = {
+            &PAYMENTS[period], &PRINCIPAL_PAID[period],
+            &INTEREST_PAID[period], &BALANCES[period]};
+        for (int i = 0; i < 4; ++i) {
+          row[i + 1] = "$";
+          row[i + 1] += VALUES[i]->toString();
+        }
+        ++period;
+        return true;
+      };
+
+  while (m_table_formatter.renderPage(*m_out, SCHEDULE_ROWS, ROWS_PER_PAGE) ==
+             ROWS_PER_PAGE &&
+         period < m_schedule.size() && askForNextPage()) {
+  }
+}
+
+bool LoanPlannerCli::askForNextPage() {
+  *m_out << "Press enter for the next page or 'q' to skip the rest: ";
+  string response;
+  getline(*m_in, response);
+  response = mini_utils::trim(response);
+  return response != "q" && response != "Q" && m_in->good();
+}
+
+string LoanPlannerCli::getSummary() const {
+  const int MONTHS = m_schedule.size();
+  return m_string_formatter.formatSideBorder(
+             "Paid off in " + std::to_string(MONTHS) + " months",
+             '|') +
+         "\n" +
+         m_string_formatter.formatSideBorder(
+             "Total interest: $" + m_schedule.getTotalInterest().toString(),
+             '|');
+}
+
+void LoanPlannerCli::startCli() {
+  printBanner(*m_out, m_string_formatter, "Airgead Loan Planner");
+
+  getValuesFromUser();
+  if (!AmortizationCalculator::buildSchedule(m_terms, m_schedule)) {
+    *m_out << "Unexpected error happened: unable to build loan schedule."
+           << endl;
+    return;
+  }
+
+  *m_out << m_string_formatter.horizontalSeparatorWithSides('-', '+') << endl
+         << m_string_formatter.formatCentered("Loan Amortization Schedule",
+                                              '|')
+         << endl;
+  printSchedule();
+  *m_out << getSummary() << endl
+         << m_string_formatter.horizontalSeparatorWithSides('-', '+') << endl;
+}
+
+// SensitivityPlannerCli
+SensitivityPlannerCli::SensitivityPlannerCli(int t_width)
+    : m_width(t_width), m_string_formatter(t_width) {}
+
+void SensitivityPlannerCli::setStreams(std::istream& in, std::ostream& out) {
+  m_in = &in;
+  m_out = &out;
+}
+
+std::vector<double> SensitivityPlannerCli::getRangeFromUser(
+    const string& NAME, const string& UNIT, int maxCount, double minValue,
+    double maxValue) {
+  const int COUNT = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Number of " + NAME + "s: ",
+      [maxCount](int input) { return input >= 1 && input <= maxCount; },
+      "integer between 1 and " + std::to_string(maxCount));
+  const auto IS_IN_RANGE = [minValue, maxValue](double input) {
+    return input >= minValue && input <= maxValue;
+  };
+  const string CRITERIA = "number between " +
+                          m_string_formatter.toStringWithPrecision(minValue) +
+                          " and " +
+                          m_string_formatter.toStringWithPrecision(maxValue);
+
+  const double LOWEST = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out,
+      (COUNT == 1 ? "" : "Lowest ") + NAME + " (" + UNIT + "): ",
+      IS_IN_RANGE, CRITERIA, false, trimUserFormatting);
+  std::vector<double> values = {LOWEST};
+  if (COUNT == 1) {
+    return values;
+  }
+  const double HIGHEST = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Highest " + NAME + " (" + UNIT + "): ",
+      [IS_IN_RANGE, LOWEST](double input) {
+        return IS_IN_RANGE(input) && input >= LOWEST;
+      },
+      CRITERIA + ", not below the lowest", false, trimUserFormatting);
+  for (int i = 1; i < COUNT; ++i) {
+    values.push_back(LOWEST + (HIGHEST - LOWEST) * i / (COUNT - 1));
+  }
+  return values;
+}
+
+void SensitivityPlannerCli::getValuesFromUser() {
+  // Upper bound of the amounts, only there to keep the matrices readable
+  const double MAX_AMOUNT = 1e9;
+
+  m_grid.principal = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Initial Investment Amount (in $): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
+  m_grid.annualRatesPercent =
+      getRangeFromUser("Annual Interest Rate", "in %", MAX_RATES, 0, 100);
+
+  // Terms are whole years; rounding may make neighbours equal
+  const std::vector<double> TERMS = getRangeFromUser(
+      "Investment Term", "Years", MAX_TERMS, SensitivityAnalysis::MIN_YEARS,
+      SensitivityAnalysis::MAX_YEARS);
+  m_grid.years.clear();
+  for (double term : TERMS) {
+    const int YEARS = static_cast<int>(std::lround(term));
+    if (m_grid.years.empty() || m_grid.years.back() != YEARS) {
+      m_grid.years.push_back(YEARS);
+    }
+  }
+
+  m_grid.monthlyDeposits = getRangeFromUser("Monthly Deposit", "in $",
+                                            MAX_DEPOSITS, 0, MAX_AMOUNT);
+}
+
+void SensitivityPlannerCli::printResults() {
+  const int OUTPUT = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Output (1 - Table, 2 - Heatmap, 3 - CSV File): ",
+      [](int input) { return input >= 1 && input <= 3; }, "1, 2 or 3");
+
+  if (OUTPUT == 3) {
+    *m_out << "CSV File Name: ";
+    string fileName;
+    getline(*m_in, fileName);
+    fileName = mini_utils::trim(fileName);
+    std::ofstream file(fileName);
+    m_analysis.writeCsv(file);
+    if (!file) {
+      *m_out << "Unable to write to file: " << fileName << endl;
+      return;
+    }
+    const SensitivityGrid& GRID = m_analysis.getGrid();
+    *m_out << "Saved balances of "
+           << GRID.annualRatesPercent.size() * GRID.years.size() *
+                  GRID.monthlyDeposits.size()
+           << " cells to " << fileName << endl;
+    return;
+  }
+
+  const std::vector<double>& DEPOSITS = m_analysis.getGrid().monthlyDeposits;
+  for (size_t deposit = 0; deposit < DEPOSITS.size(); ++deposit) {
+    const string MATRIX = OUTPUT == 1
+                              ? m_analysis.renderTable(deposit, m_width)
+                              : m_analysis.renderHeatmap(deposit, m_width);
+    if (MATRIX.empty()) {
+      *m_out << "Unexpected error happened: unable to set table column widths."
+             << endl;
+      return;
+    }
+    *m_out << endl
+           << "Final Balance With $"
+           << m_string_formatter.toStringWithPrecision(DEPOSITS[deposit])
+           << " Monthly Deposits" << endl
+           << MATRIX;
+  }
+}
+
+void SensitivityPlannerCli::startCli() {
+  printBanner(*m_out, m_string_formatter, "Airgead Sensitivity Planner");
+
+  getValuesFromUser();
+  if (!m_analysis.run(m_grid)) {
+    *m_out << "Unexpected error happened: unable to evaluate the grid."
+           << endl;
+    return;
+  }
+  printResults();
+}
+
+// PortfolioPlannerCli
+PortfolioPlannerCli::PortfolioPlannerCli(int t_width)
+    : m_string_formatter(t_width), m_table_formatter(t_width) {
+  m_simulator.reserve(static_cast<int>(std::size(REBALANCE_POLICIES)),
+                      MAX_ASSETS);
+}
+
+void PortfolioPlannerCli::setStreams(std::istream& in, std::ostream& out) {
+  m_in = &in;
+  m_out = &out;
+}
+
+void PortfolioPlannerCli::getValuesFromUser() {
+  const int MIN_YEARS = PortfolioSimulator::MIN_PORTFOLIO_YEARS;
+  const int MAX_YEARS = PortfolioSimulator::MAX_PORTFOLIO_YEARS;
+  // Cash earns nothing and an asset may be left out of the targets
+  const auto IS_ZERO_OR_POSITIVE = [](double input) {
+    return input == 0 || mini_utils::isPositiveRealNum(input);
+  };
+
+  m_terms.initialInvestment = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Initial Investment Amount (in $): ",
+      mini_utils::isPositiveRealNum, "positive real number", false,
+      trimUserFormatting);
+  m_terms.monthlyContribution = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Monthly Deposit (in $): ", IS_ZERO_OR_POSITIVE,
+      "zero or positive real number", false, trimUserFormatting);
+  m_terms.years = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Investment Term (Years): ",
+      [MIN_YEARS, MAX_YEARS](int input) {
+        return input >= MIN_YEARS && input <= MAX_YEARS;
+      },
+      "integer between " + std::to_string(MIN_YEARS) + " and " +
+          std::to_string(MAX_YEARS));
+
+  const int ASSET_COUNT = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Number of Assets: ",
+      [](int input) { return input >= 1 && input <= MAX_ASSETS; },
+      "integer between 1 and " + std::to_string(MAX_ASSETS));
+  m_terms.assets.resize(ASSET_COUNT);
+  for (int i = 0; i < ASSET_COUNT; ++i) {
+    const string NAME = "Asset " + std::to_string(i + 1);
+    m_terms.assets[i].annualRatePercent =
+        mini_utils::getValidatedInput<double>(
+            *m_in, *m_out, NAME + " Annual Return (in %): ",
+            IS_ZERO_OR_POSITIVE, "zero or positive real number", false,
+            trimUserFormatting);
+    m_terms.assets[i].targetWeight = mini_utils::getValidatedInput<double>(
+        *m_in, *m_out, NAME + " Target Weight (in %): ", IS_ZERO_OR_POSITIVE,
+        "zero or positive real number", false, trimUserFormatting);
+  }
+
+  m_terms.driftThresholdPercent = mini_utils::getValidatedInput<double>(
+      *m_in, *m_out, "Drift Threshold (in %): ",
+      [](double input) { return input >= 0 && input <= 100; },
+      "number between 0 and 100", false, trimUserFormatting);
+}
+
+void PortfolioPlannerCli::printResults() {
+  std::vector<string> headers = {"Year"};
+  headers.insert(headers.end(), std::begin(REBALANCE_POLICY_NAMES),
+                 std::end(REBALANCE_POLICY_NAMES));
+  m_table_formatter.setHeaders(headers);
+  if (!m_table_formatter.setColumnWidths({10, 14, 14, 14, 14, 14})) {
+    *m_out << "Unexpected error happened: unable to set table column widths."
+           << endl;
+    return;
+  }
+
+  std::vector<string> row(headers.size());
+  for (int year = 1; year <= m_terms.years; ++year) {
+    row[0] = std::to_string(year);
+    for (int portfolio = 0; portfolio < m_simulator.size(); ++portfolio) {
+      row[portfolio + 1] =
+          "$" + m_string_formatter.toStringWithPrecision(
+                    m_simulator.getYearEndBalance(portfolio, year));
+    }
+    m_table_formatter.addRow(row);
+  }
+
+  *m_out << m_string_formatter.horizontalSeparatorWithSides('-', '+') << endl
+         << m_string_formatter.formatCentered(
+                "Year-End Balance by Rebalancing Policy", '|')
+         << endl
+         << m_table_formatter.render();
+  m_table_formatter.clearRows();
+
+  for (int portfolio = 0; portfolio < m_simulator.size(); ++portfolio) {
+    *m_out << m_string_formatter.formatSideBorder(
+                  string(REBALANCE_POLICY_NAMES[portfolio]) +
+                      ": rebalanced " +
+                      std::to_string(
+                          m_simulator.getRebalanceCount(portfolio)) +
+                      " times",
+                  '|')
+           << endl;
+  }
+  *m_out << m_string_formatter.horizontalSeparatorWithSides('-', '+') << endl;
+}
+
+void PortfolioPlannerCli::startCli() {
+  printBanner(*m_out, m_string_formatter, "Airgead Portfolio Planner");
+
+  getValuesFromUser();
+  m_simulator.clear();
+  for (const RebalancePolicy POLICY : REBALANCE_POLICIES) {
+    m_terms.rebalancePolicy = POLICY;
+    if (m_simulator.addPortfolio(m_terms) < 0) {
+      *m_out << "The target weights must add up to more than 0." << endl;
+      return;
+    }
+  }
+  m_simulator.run();
+  printResults();
 }
-}  // namespace airgead_investment_planner_cli
\ No newline at end of file
+}  // namespace airgead_investment_planner_cli
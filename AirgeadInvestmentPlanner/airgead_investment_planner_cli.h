@@ -2,33 +2,52 @@
 #ifndef AIRGEAD_INVESTMENT_PLANNER_CLI_H
 #define AIRGEAD_INVESTMENT_PLANNER_CLI_H
 
+#include <iostream>
+#include <vector>
+
+#include "amortization.h"
+#include "deposit_calculator.h"
+#include "money.h"
+#include "portfolio.h"
+#include "sensitivity.h"
+
 namespace airgead_investment_planner_cli {
 const int DEFAULT_WIDTH = 80;
 
-class DepositCalculator {
- public:
-  static long double calculateCompoundInterest(long double principal,
-                                               long double interestRatePercent,
-                                               long double monthlyDeposit = 0,
-                                               int years = 1);
-};
+// Arithmetic backing the calculations: fast floating point or exact cents
+enum class CalculationMode { FLOATING_POINT, FIXED_POINT };
+
+// Trims spaces around the string and '$' and '%' in front of the string.
+std::string trimUserFormatting(const std::string& ORIG_STR);
 
 class InvestmentPlannerCli {
  public:
-  InvestmentPlannerCli(int t_width = DEFAULT_WIDTH, double t_principal = 0,
-                       double t_monthlyDeposit = 0, double t_annualRate = 0,
-                       int t_years = 0);
-  // Start CLI session with user
+  InvestmentPlannerCli(
+      int t_width = DEFAULT_WIDTH, double t_principal = 0,
+      double t_monthlyDeposit = 0, double t_annualRate = 0, int t_years = 0,
+      CalculationMode t_mode = CalculationMode::FLOATING_POINT);
+  // Start CLI session with user. Throws mini_utils::InputEndedError if the
+  // input ends first.
   void startCli();
 
+  // Choose between floating-point throughput and exact cents per run
+  void setCalculationMode(CalculationMode mode);
+
+  // Talk through the given streams instead of the console, e.g. to replay
+  // a scripted session. The streams must outlive the CLI.
+  void setStreams(std::istream& in, std::ostream& out);
+
  private:
   const int MIN_INVEST_YEARS = 1;
   const int MAX_INVEST_YEARS = 250;
   int m_width;
+  std::istream* m_in = &std::cin;
+  std::ostream* m_out = &std::cout;
   double m_principal;
   double m_monthlyDeposit;
   double m_annualRate;
   int m_years;
+  CalculationMode m_mode;
   mini_utils::StringFormatter m_string_formatter;
   mini_utils::TableFormatter m_table_formatter;
 
@@ -41,8 +60,114 @@ class InvestmentPlannerCli {
   // Make necessary calculations based on user input and render output table
   std::string getTable(bool withDeposits);
 
-  // Trims spaces around the string and '$' and '%' in front of the string.
-  static std::string trimUserFormatting(const std::string& ORIG_STR);
+  // Fill the table rows using floating-point compound interest formula
+  void addFloatingPointRows(double monthlyDeposit);
+
+  // Fill the table rows using exact fixed-point month by month simulation
+  void addFixedPointRows(double monthlyDeposit);
+};
+
+class LoanPlannerCli {
+ public:
+  LoanPlannerCli(int t_width = DEFAULT_WIDTH);
+  // Start CLI session with user. Throws mini_utils::InputEndedError if the
+  // input ends first.
+  void startCli();
+
+  // Talk through the given streams instead of the console, see
+  // InvestmentPlannerCli::setStreams
+  void setStreams(std::istream& in, std::ostream& out);
+
+ private:
+  // Rows rendered at once; rows are streamed, never stored in the formatter
+  static const size_t ROWS_PER_PAGE = 24;
+  int m_width;
+  std::istream* m_in = &std::cin;
+  std::ostream* m_out = &std::cout;
+  LoanTerms m_terms;
+  AmortizationSchedule m_schedule;
+  mini_utils::StringFormatter m_string_formatter;
+  mini_utils::TableFormatter m_table_formatter;
+
+  // Collect principal, rate, term, repayment plan and extra payment from user
+  void getValuesFromUser();
+
+  // Print the schedule page by page, asking user before every next page
+  void printSchedule();
+
+  // Ask user whether to show the next page, false if user wants to stop
+  bool askForNextPage();
+
+  // Payoff time and total interest of the schedule
+  std::string getSummary() const;
+};
+
+// Shows final balances over a grid of rates, terms and monthly deposits as
+// tables or heatmaps, or saves them as CSV
+class SensitivityPlannerCli {
+ public:
+  SensitivityPlannerCli(int t_width = DEFAULT_WIDTH);
+  // Start CLI session with user. Throws mini_utils::InputEndedError if the
+  // input ends first.
+  void startCli();
+
+  // Talk through the given streams instead of the console, see
+  // InvestmentPlannerCli::setStreams
+  void setStreams(std::istream& in, std::ostream& out);
+
+ private:
+  // Values per axis, so every matrix stays readable in a terminal
+  static const int MAX_RATES = 20;
+  static const int MAX_TERMS = 10;
+  static const int MAX_DEPOSITS = 5;
+  int m_width;
+  std::istream* m_in = &std::cin;
+  std::ostream* m_out = &std::cout;
+  SensitivityGrid m_grid;
+  SensitivityAnalysis m_analysis;
+  mini_utils::StringFormatter m_string_formatter;
+
+  // Collect principal and the range of every axis from user
+  void getValuesFromUser();
+
+  // Ask user for the number of values and the lowest and highest one, and
+  // return that many evenly spaced values
+  std::vector<double> getRangeFromUser(const std::string& NAME,
+                                       const std::string& UNIT, int maxCount,
+                                       double minValue, double maxValue);
+
+  // Print a matrix per deposit, or save every cell to a CSV file
+  void printResults();
+};
+
+// Compares year-end balances of a portfolio of assets under every
+// rebalancing policy, simulated side by side as one batch
+class PortfolioPlannerCli {
+ public:
+  PortfolioPlannerCli(int t_width = DEFAULT_WIDTH);
+  // Start CLI session with user. Throws mini_utils::InputEndedError if the
+  // input ends first.
+  void startCli();
+
+  // Talk through the given streams instead of the console, see
+  // InvestmentPlannerCli::setStreams
+  void setStreams(std::istream& in, std::ostream& out);
+
+ private:
+  // Assets are asked for one by one, so keep the list short
+  static const int MAX_ASSETS = 10;
+  std::istream* m_in = &std::cin;
+  std::ostream* m_out = &std::cout;
+  PortfolioTerms m_terms;
+  PortfolioSimulator m_simulator;
+  mini_utils::StringFormatter m_string_formatter;
+  mini_utils::TableFormatter m_table_formatter;
+
+  // Collect amounts, term, assets and drift threshold from user
+  void getValuesFromUser();
+
+  // Print the balances per policy and how often each rebalanced
+  void printResults();
 };
 }  // namespace airgead_investment_planner_cli
 
@@ -0,0 +1,118 @@
+#include "amortization.h"
+
+#include "deposit_calculator.h"
+
+namespace airgead_investment_planner_cli {
+
+// AmortizationSchedule
+void AmortizationSchedule::reserve(int periods) {
+  m_payments.reserve(periods);
+  m_principalPaid.reserve(periods);
+  m_interestPaid.reserve(periods);
+  m_balances.reserve(periods);
+}
+
+void AmortizationSchedule::clear() {
+  m_payments.clear();
+  m_principalPaid.clear();
+  m_interestPaid.clear();
+  m_balances.clear();
+}
+
+int AmortizationSchedule::size() const {
+  return static_cast<int>(m_balances.size());
+}
+
+void AmortizationSchedule::addPeriod(const Money& PAYMENT,
+                                     const Money& PRINCIPAL_PAID,
+                                     const Money& INTEREST_PAID,
+                                     const Money& BALANCE) {
+  m_payments.push_back(PAYMENT);
+  m_principalPaid.push_back(PRINCIPAL_PAID);
+  m_interestPaid.push_back(INTEREST_PAID);
+  m_balances.push_back(BALANCE);
+}
+
+Money AmortizationSchedule::getTotalInterest() const {
+  Money total;
+  for (const Money& INTEREST : m_interestPaid) {
+    total += INTEREST;
+  }
+  return total;
+}
+
+const std::vector<Money>& AmortizationSchedule::getPayments() const {
+  return m_payments;
+}
+
+const std::vector<Money>& AmortizationSchedule::getPrincipalPaid() const {
+  return m_principalPaid;
+}
+
+const std::vector<Money>& AmortizationSchedule::getInterestPaid() const {
+  return m_interestPaid;
+}
+
+const std::vector<Money>& AmortizationSchedule::getBalances() const {
+  return m_balances;
+}
+
+// AmortizationCalculator
+long double AmortizationCalculator::calculateMortgagePayment(
+    long double principal, long double annualRatePercent, int months) {
+  const long double MONTHLY_RATE =
+      annualRatePercent / 100.0L / MONTHS_IN_A_YEAR;
+  if (MONTHLY_RATE == 0) {
+    return principal / months;
+  }
+
+  // P * r / (1 - (1 + r)^-n), expressed with the shared (1 + r)^n table
+  const long double GROWTH =
+      GrowthFactorCache::shared().getGrowthFactor(MONTHLY_RATE, months);
+  return principal * MONTHLY_RATE * GROWTH / (GROWTH - 1);
+}
+
+bool AmortizationCalculator::buildSchedule(const LoanTerms& TERMS,
+                                           AmortizationSchedule& schedule) {
+  schedule.clear();
+  if (TERMS.years < MIN_LOAN_YEARS || TERMS.years > MAX_LOAN_YEARS ||
+      !(TERMS.principal > 0) || !(TERMS.annualRatePercent >= 0) ||
+      !(TERMS.extraMonthlyPayment >= 0)) {
+    return false;
+  }
+
+  const int MONTHS = TERMS.years * MONTHS_IN_A_YEAR;
+  const Money PRINCIPAL = Money::fromDollars(TERMS.principal);
+  const PercentRate RATE = PercentRate::fromPercent(TERMS.annualRatePercent);
+  const Money EXTRA_PAYMENT = Money::fromDollars(TERMS.extraMonthlyPayment);
+  if (PRINCIPAL.isOverflow() || !RATE.isValid() ||
+      EXTRA_PAYMENT.isOverflow()) {
+    return false;
+  }
+  const Money SCHEDULED_PAYMENT = Money::fromDollars(calculateMortgagePayment(
+      TERMS.principal, TERMS.annualRatePercent, MONTHS));
+  const Money FIXED_PRINCIPAL = PRINCIPAL.mulDiv(1, MONTHS);
+
+  schedule.reserve(MONTHS);
+  Money balance = PRINCIPAL;
+  for (int month = 1; month <= MONTHS && !balance.isZero(); ++month) {
+    const Money INTEREST = balance.monthlyInterest(RATE);
+
+    Money principalPaid = TERMS.plan == RepaymentPlan::MORTGAGE
+                              ? SCHEDULED_PAYMENT - INTEREST
+                              : FIXED_PRINCIPAL;
+    principalPaid += EXTRA_PAYMENT;
+
+    // The last period settles whatever is left, including rounding residue
+    if (balance < principalPaid || month == MONTHS) {
+      principalPaid = balance;
+    }
+    balance -= principalPaid;
+
+    schedule.addPeriod(principalPaid + INTEREST, principalPaid, INTEREST,
+                       balance);
+  }
+  return true;
+}
+
+}  // namespace airgead_investment_planner_cli
@@ -0,0 +1,79 @@
+#ifndef AMORTIZATION_H
+#define AMORTIZATION_H
+
+#include <vector>
+
+#include "money.h"
+
+namespace airgead_investment_planner_cli {
+
+enum class RepaymentPlan {
+  // Level monthly payment covering interest and principal (annuity)
+  MORTGAGE,
+  // Equal principal share every month plus that month's interest
+  FIXED_PRINCIPAL
+};
+
+struct LoanTerms {
+  double principal = 0;
+  double annualRatePercent = 0;
+  int years = 0;
+  RepaymentPlan plan = RepaymentPlan::MORTGAGE;
+  // Paid towards the principal on top of the scheduled payment every month
+  double extraMonthlyPayment = 0;
+};
+
+// Per-period loan schedule in exact cents, stored column by column, so each
+// column is a contiguous array that can be preallocated once for the longest
+// term and reused between runs without reallocating.
+class AmortizationSchedule {
+ public:
+  // Preallocate every column for the given number of monthly periods
+  void reserve(int periods);
+
+  // Drop all periods, keeping the allocated capacity
+  void clear();
+
+  // Number of periods until the loan is paid off
+  int size() const;
+
+  // Append a single period to every column
+  void addPeriod(const Money& PAYMENT, const Money& PRINCIPAL_PAID,
+                 const Money& INTEREST_PAID, const Money& BALANCE);
+
+  // Sum of the interest of every period
+  Money getTotalInterest() const;
+
+  const std::vector<Money>& getPayments() const;
+  const std::vector<Money>& getPrincipalPaid() const;
+  const std::vector<Money>& getInterestPaid() const;
+  const std::vector<Money>& getBalances() const;
+
+ private:
+  std::vector<Money> m_payments;
+  std::vector<Money> m_principalPaid;
+  std::vector<Money> m_interestPaid;
+  std::vector<Money> m_balances;
+};
+
+class AmortizationCalculator {
+ public:
+  static const int MONTHS_IN_A_YEAR = 12;
+  static const int MIN_LOAN_YEARS = 1;
+  static const int MAX_LOAN_YEARS = 250;
+
+  // Level payment that pays off the principal over the given months
+  static long double calculateMortgagePayment(long double principal,
+                                              long double annualRatePercent,
+                                              int months);
+
+  // Fill the schedule with one row per month until the loan is paid off.
+  // Amounts are kept in exact cents and interest is rounded to a cent every
+  // month with banker's rounding, as a lender would charge it. Returns false
+  // if the terms are out of the supported range.
+  static bool buildSchedule(const LoanTerms& TERMS,
+                            AmortizationSchedule& schedule);
+};
+
+}  // namespace airgead_investment_planner_cli
+#endif  // AMORTIZATION_H
@@ -0,0 +1,123 @@
+#include "deposit_calculator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace airgead_investment_planner_cli {
+
+// GrowthFactorCache
+double GrowthFactorCache::Stats::hitRate() const {
+  const unsigned long long TOTAL = hits + misses;
+  return TOTAL == 0 ? 0.0 : static_cast<double>(hits) / TOTAL;
+}
+
+long double GrowthFactorCache::getGrowthFactor(long double monthlyRate,
+                                               int months) {
+  if (months < 0) {
+    return std::pow(1.0L + monthlyRate, months);
+  }
+
+  const std::lock_guard<std::mutex> LOCK(m_mutex);
+  auto found = m_tables.find(monthlyRate);
+  if (found == m_tables.end()) {
+    if (m_tables.size() >= MAX_CACHED_RATES) {
+      m_tables.clear();
+    }
+    found = m_tables.emplace(monthlyRate, std::vector<long double>{1.0L}).first;
+  }
+
+  std::vector<long double>& factors = found->second;
+  if (months < static_cast<int>(factors.size())) {
+    ++m_stats.hits;
+    return factors[months];
+  }
+
+  ++m_stats.misses;
+  const long double GROWTH = 1.0L + monthlyRate;
+  // At least double the table, so a caller walking the months up a year at
+  // a time extends it a logarithmic number of times and hits in between
+  const size_t SIZE =
+      std::max(static_cast<size_t>(months) + 1, 2 * factors.size());
+  factors.reserve(SIZE);
+  for (size_t n = factors.size(); n < SIZE; ++n) {
+    // Periodically replace the running product with the exact value
+    factors.push_back(n % REANCHOR_INTERVAL == 0 ? std::pow(GROWTH, n)
+                                                 : factors.back() * GROWTH);
+  }
+  return factors[months];
+}
+
+GrowthFactorCache::Stats GrowthFactorCache::getStats() const {
+  const std::lock_guard<std::mutex> LOCK(m_mutex);
+  return m_stats;
+}
+
+void GrowthFactorCache::resetStats() {
+  const std::lock_guard<std::mutex> LOCK(m_mutex);
+  m_stats = Stats();
+}
+
+void GrowthFactorCache::clear() {
+  const std::lock_guard<std::mutex> LOCK(m_mutex);
+  m_tables.clear();
+}
+
+GrowthFactorCache& GrowthFactorCache::shared() {
+  static GrowthFactorCache cache;
+  return cache;
+}
+
+// DepositCalculator
+long double DepositCalculator::calculateCompoundInterest(
+    long double principal, long double interestRatePercent,
+    long double monthlyDeposit, int years) {
+  const double MONTHS_IN_A_YEAR = 12.0L;
+  const double PERCENTAGE_TO_DECIMAL = 100.0L;
+
+  // Convert percentage to decimal
+  long double annualInterestRate = interestRatePercent / PERCENTAGE_TO_DECIMAL;
+  // Calculate monthly rate
+  long double monthlyRate = annualInterestRate / MONTHS_IN_A_YEAR;
+
+  // Calculate total number of months in the period
+  int totalMonths = years * static_cast<int>(MONTHS_IN_A_YEAR);
+
+  // Growth factors are shared across years, scenarios and repeated runs
+  GrowthFactorCache& growthFactors = GrowthFactorCache::shared();
+
+  // Calculate compounded principal amount
+  long double compoundedPrincipal =
+      principal * growthFactors.getGrowthFactor(monthlyRate, totalMonths);
+
+  // Calculate future value of monthly deposits (with early deposit adjustment)
+  long double futureValueOfDeposits =
+      monthlyDeposit *
+          (growthFactors.getGrowthFactor(monthlyRate, totalMonths + 1) - 1) /
+          monthlyRate -
+      monthlyDeposit;
+
+  // Return the total compounded value (principal + deposits)
+  return compoundedPrincipal + futureValueOfDeposits;
+}
+
+std::vector<Money> DepositCalculator::calculateYearEndBalancesExact(
+    const Money& PRINCIPAL, const PercentRate& RATE,
+    const Money& MONTHLY_DEPOSIT, int years) {
+  const int MONTHS_IN_A_YEAR = 12;
+
+  std::vector<Money> yearEndBalances;
+  yearEndBalances.reserve(years > 0 ? years : 0);
+
+  Money balance = PRINCIPAL;
+  for (int year = 0; year < years; ++year) {
+    for (int month = 0; month < MONTHS_IN_A_YEAR; ++month) {
+      // Deposit is made at the start of the month and earns its interest
+      balance += MONTHLY_DEPOSIT;
+      balance += balance.monthlyInterest(RATE);
+    }
+    yearEndBalances.push_back(balance);
+  }
+  return yearEndBalances;
+}
+
+}  // namespace airgead_investment_planner_cli
@@ -0,0 +1,66 @@
+#ifndef DEPOSIT_CALCULATOR_H
+#define DEPOSIT_CALCULATOR_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "money.h"
+
+namespace airgead_investment_planner_cli {
+
+// Memoizes growth factors (1 + rate)^n per monthly rate, so table and batch
+// workloads do not call pow() for every year of every scenario.
+// Factors are built incrementally by multiplication and re-anchored with an
+// exact pow() every REANCHOR_INTERVAL months to bound the rounding drift.
+// Every method locks the cache, so one instance can be shared by threads.
+class GrowthFactorCache {
+ public:
+  struct Stats {
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+
+    // Share of lookups answered without extending the table, 0..1
+    double hitRate() const;
+  };
+
+  // Get (1 + monthlyRate)^months, extending the cached table if needed. The
+  // table at least doubles on each extension.
+  long double getGrowthFactor(long double monthlyRate, int months);
+
+  Stats getStats() const;
+  void resetStats();
+
+  // Drop all cached tables (statistics are kept)
+  void clear();
+
+  // Cache shared by every calculation within the session, on any thread
+  static GrowthFactorCache& shared();
+
+ private:
+  static const int REANCHOR_INTERVAL = 32;
+  // Tables are dropped once this many distinct rates are cached
+  static const size_t MAX_CACHED_RATES = 256;
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<long double, std::vector<long double>> m_tables;
+  Stats m_stats;
+};
+
+class DepositCalculator {
+ public:
+  static long double calculateCompoundInterest(long double principal,
+                                               long double interestRatePercent,
+                                               long double monthlyDeposit = 0,
+                                               int years = 1);
+
+  // Exact counterpart of calculateCompoundInterest: simulates the deposit
+  // month by month in fixed-point cents, rounding each month's interest with
+  // banker's rounding. Returns year-end balances for years 1 through years.
+  static std::vector<Money> calculateYearEndBalancesExact(
+      const Money& PRINCIPAL, const PercentRate& RATE,
+      const Money& MONTHLY_DEPOSIT, int years);
+};
+
+}  // namespace airgead_investment_planner_cli
+#endif  // DEPOSIT_CALCULATOR_H
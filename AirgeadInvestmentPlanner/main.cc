@@ -1,31 +1,75 @@
+#include <cstring>
 #include <iostream>
 
 #include "airgead_investment_planner_cli.h"
 
-int main() {
+int main(int argc, char* argv[]) {
   airgead_investment_planner_cli::InvestmentPlannerCli depositCalculatorCli =
       airgead_investment_planner_cli::InvestmentPlannerCli();
 
+  airgead_investment_planner_cli::LoanPlannerCli loanPlannerCli;
+  bool isLoanMode = false;
+
+  airgead_investment_planner_cli::SensitivityPlannerCli sensitivityPlannerCli;
+  bool isSensitivityMode = false;
+
+  airgead_investment_planner_cli::PortfolioPlannerCli portfolioPlannerCli;
+  bool isPortfolioMode = false;
+
+  for (int i = 1; i < argc; ++i) {
+    // "--exact" trades throughput for exact cents with banker's rounding
+    if (std::strcmp(argv[i], "--exact") == 0) {
+      depositCalculatorCli.setCalculationMode(
+          airgead_investment_planner_cli::CalculationMode::FIXED_POINT);
+    }
+    // "--loan" plans loan repayment instead of savings growth
+    if (std::strcmp(argv[i], "--loan") == 0) {
+      isLoanMode = true;
+    }
+    // "--sensitivity" compares final balances over ranges of rates, terms
+    // and deposits
+    if (std::strcmp(argv[i], "--sensitivity") == 0) {
+      isSensitivityMode = true;
+    }
+    // "--portfolio" compares rebalancing policies of a mix of assets
+    if (std::strcmp(argv[i], "--portfolio") == 0) {
+      isPortfolioMode = true;
+    }
+  }
+
   bool isWillingToContinue = false;
-  do {
-    // Show calculator CLI
-    depositCalculatorCli.startCli();
-
-    // Ask user whether continuation is desirable
-    const char CONTINUE_RESPONSE =
-        std::toupper(mini_utils::getValidatedInput<char>(
-            "Do you want to calculate with new values? (Y/N): ",
-            // Validate that user response within accepted range
-            [](char RESPONSE) {
-              RESPONSE = std::toupper(RESPONSE);
-              return RESPONSE == 'Y' || RESPONSE == 'N';
-            },
-            // Explain valid values to user
-            "Y or N character",
-            // Strict mode enabled ("y n" is not acceptable response)
-            true));
-    isWillingToContinue = CONTINUE_RESPONSE == 'Y';
-  } while (isWillingToContinue);
+  try {
+    do {
+      // Show calculator CLI
+      if (isLoanMode) {
+        loanPlannerCli.startCli();
+      } else if (isSensitivityMode) {
+        sensitivityPlannerCli.startCli();
+      } else if (isPortfolioMode) {
+        portfolioPlannerCli.startCli();
+      } else {
+        depositCalculatorCli.startCli();
+      }
+
+      // Ask user whether continuation is desirable
+      const char CONTINUE_RESPONSE =
+          std::toupper(mini_utils::getValidatedInput<char>(
+              "Do you want to calculate with new values? (Y/N): ",
+              // Validate that user response within accepted range
+              [](char RESPONSE) {
+                RESPONSE = std::toupper(RESPONSE);
+                return RESPONSE == 'Y' || RESPONSE == 'N';
+              },
+              // Explain valid values to user
+              "Y or N character",
+              // Strict mode enabled ("y n" is not acceptable response)
+              true));
+      isWillingToContinue = CONTINUE_RESPONSE == 'Y';
+    } while (isWillingToContinue);
+  } catch (const mini_utils::InputEndedError&) {
+    // The input ended mid-session, e.g. at the end of a script
+    std::cout << std::endl;
+  }
 
   std::cout << "Goodbye!" << std::endl;
 }
@@ -0,0 +1,251 @@
+#include "money.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace airgead_investment_planner_cli {
+namespace {
+const uint64_t SIGN_BIT = 0x8000000000000000ULL;
+const long double TWO_POW_64 = 18446744073709551616.0L;
+
+// Interest per month = balance * micro-percent / (12 months * 100% * 10^6)
+const uint32_t MONTHLY_MICRO_PERCENT_DIVISOR = 1200000000U;
+}  // namespace
+
+// PercentRate
+PercentRate PercentRate::fromPercent(long double percent) {
+  PercentRate rate;
+  const long double MICRO_PERCENT = std::nearbyint(percent * 1000000.0L);
+  // Rates beyond 2^63 micro-percent are meaningless and would not fit
+  if (!std::isfinite(MICRO_PERCENT) || MICRO_PERCENT < 0 ||
+      MICRO_PERCENT >= 9223372036854775808.0L) {
+    rate.m_isValid = false;
+    return rate;
+  }
+  rate.m_microPercent = static_cast<uint64_t>(MICRO_PERCENT);
+  return rate;
+}
+
+uint64_t PercentRate::getMicroPercent() const { return m_microPercent; }
+
+bool PercentRate::isValid() const { return m_isValid; }
+
+// Money
+// Public
+Money Money::fromCents(long long cents) {
+  Money result;
+  result.m_low = static_cast<uint64_t>(cents);
+  result.m_high = cents < 0 ? ~0ULL : 0ULL;  // Sign extension
+  return result;
+}
+
+Money Money::fromDollars(long double dollars) {
+  if (!std::isfinite(dollars)) {
+    return makeOverflow();
+  }
+
+  // nearbyint() honors the default rounding mode, which is ties-to-even
+  const long double CENTS = std::nearbyint(std::fabs(dollars) * 100.0L);
+  if (CENTS >= TWO_POW_64 * (TWO_POW_64 / 2)) {  // 2^127
+    return makeOverflow();
+  }
+
+  const long double HIGH_PART = std::floor(CENTS / TWO_POW_64);
+  Money result;
+  result.m_high = static_cast<uint64_t>(HIGH_PART);
+  result.m_low = static_cast<uint64_t>(CENTS - HIGH_PART * TWO_POW_64);
+  return dollars < 0 ? result.negated() : result;
+}
+
+Money Money::operator+(const Money& OTHER) const {
+  if (m_overflow || OTHER.m_overflow) {
+    return makeOverflow();
+  }
+
+  Money result;
+  result.m_low = m_low + OTHER.m_low;
+  const uint64_t CARRY = result.m_low < m_low ? 1 : 0;
+  result.m_high = m_high + OTHER.m_high + CARRY;
+
+  // Adding two values of the same sign must not flip the sign
+  const bool IS_SAME_SIGN = (m_high & SIGN_BIT) == (OTHER.m_high & SIGN_BIT);
+  if (IS_SAME_SIGN && (result.m_high & SIGN_BIT) != (m_high & SIGN_BIT)) {
+    return makeOverflow();
+  }
+  return result;
+}
+
+Money Money::operator-(const Money& OTHER) const {
+  return *this + OTHER.negated();
+}
+
+Money& Money::operator+=(const Money& OTHER) {
+  *this = *this + OTHER;
+  return *this;
+}
+
+Money& Money::operator-=(const Money& OTHER) {
+  *this = *this - OTHER;
+  return *this;
+}
+
+bool Money::operator==(const Money& OTHER) const {
+  return !m_overflow && !OTHER.m_overflow && m_high == OTHER.m_high &&
+         m_low == OTHER.m_low;
+}
+
+bool Money::operator!=(const Money& OTHER) const { return !(*this == OTHER); }
+
+bool Money::operator<(const Money& OTHER) const {
+  if (m_overflow || OTHER.m_overflow) {
+    return false;
+  }
+  if (m_high != OTHER.m_high) {
+    return static_cast<int64_t>(m_high) < static_cast<int64_t>(OTHER.m_high);
+  }
+  return m_low < OTHER.m_low;
+}
+
+Money Money::mulDiv(uint64_t numerator, uint32_t denominator) const {
+  if (m_overflow || denominator == 0) {
+    return makeOverflow();
+  }
+
+  uint32_t magnitude[4];
+  toMagnitudeLimbs(magnitude);
+  const uint32_t FACTOR[2] = {static_cast<uint32_t>(numerator),
+                              static_cast<uint32_t>(numerator >> 32)};
+
+  // Schoolbook multiplication into a 192-bit product
+  uint32_t product[6] = {0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < 4; ++i) {
+    uint64_t carry = 0;
+    for (int j = 0; j < 2; ++j) {
+      const uint64_t PARTIAL = static_cast<uint64_t>(magnitude[i]) * FACTOR[j] +
+                               product[i + j] + carry;
+      product[i + j] = static_cast<uint32_t>(PARTIAL);
+      carry = PARTIAL >> 32;
+    }
+    product[i + 2] = static_cast<uint32_t>(carry);
+  }
+
+  // Long division by a 32-bit divisor, most significant limb first
+  uint64_t remainder = 0;
+  for (int i = 5; i >= 0; --i) {
+    const uint64_t CURRENT = (remainder << 32) | product[i];
+    product[i] = static_cast<uint32_t>(CURRENT / denominator);
+    remainder = CURRENT % denominator;
+  }
+
+  // Banker's rounding: round half to the even quotient
+  const uint64_t TWICE_REMAINDER = remainder * 2;
+  if (TWICE_REMAINDER > denominator ||
+      (TWICE_REMAINDER == denominator && (product[0] & 1) != 0)) {
+    for (int i = 0; i < 6 && ++product[i] == 0; ++i) {
+    }
+  }
+
+  if (product[4] != 0 || product[5] != 0) {
+    return makeOverflow();
+  }
+  return fromMagnitudeLimbs(product, isNegative());
+}
+
+Money Money::monthlyInterest(const PercentRate& RATE) const {
+  if (!RATE.isValid()) {
+    return makeOverflow();
+  }
+  return mulDiv(RATE.getMicroPercent(), MONTHLY_MICRO_PERCENT_DIVISOR);
+}
+
+bool Money::isOverflow() const { return m_overflow; }
+
+bool Money::isNegative() const { return (m_high & SIGN_BIT) != 0; }
+
+bool Money::isZero() const { return !m_overflow && m_high == 0 && m_low == 0; }
+
+long double Money::toDollars() const {
+  if (m_overflow) {
+    return NAN;
+  }
+  uint32_t magnitude[4];
+  toMagnitudeLimbs(magnitude);
+  long double cents = 0;
+  for (int i = 3; i >= 0; --i) {
+    cents = cents * 4294967296.0L + magnitude[i];
+  }
+  return (isNegative() ? -cents : cents) / 100.0L;
+}
+
+std::string Money::toString() const {
+  if (m_overflow) {
+    return "overflow";
+  }
+
+  uint32_t magnitude[4];
+  toMagnitudeLimbs(magnitude);
+
+  // Peel off nine decimal digits at a time, least significant chunk first
+  const uint32_t CHUNK_DIVISOR = 1000000000U;
+  const int CHUNK_DIGITS = 9;
+  std::string digits;
+  bool isRemainingZero = false;
+  while (!isRemainingZero) {
+    uint64_t remainder = 0;
+    isRemainingZero = true;
+    for (int i = 3; i >= 0; --i) {
+      const uint64_t CURRENT = (remainder << 32) | magnitude[i];
+      magnitude[i] = static_cast<uint32_t>(CURRENT / CHUNK_DIVISOR);
+      remainder = CURRENT % CHUNK_DIVISOR;
+      isRemainingZero = isRemainingZero && magnitude[i] == 0;
+    }
+    for (int i = 0; i < CHUNK_DIGITS; ++i) {
+      digits += static_cast<char>('0' + remainder % 10);
+      remainder /= 10;
+    }
+  }
+
+  // Drop leading zeros, keeping at least "0.00"
+  while (digits.size() > 3 && digits.back() == '0') {
+    digits.pop_back();
+  }
+  std::reverse(digits.begin(), digits.end());
+  digits.insert(digits.size() - 2, 1, '.');
+  return (isNegative() ? "-" : "") + digits;
+}
+
+// Private
+Money Money::makeOverflow() {
+  Money result;
+  result.m_overflow = true;
+  return result;
+}
+
+void Money::toMagnitudeLimbs(uint32_t limbs[4]) const {
+  const Money MAGNITUDE = isNegative() ? negated() : *this;
+  limbs[0] = static_cast<uint32_t>(MAGNITUDE.m_low);
+  limbs[1] = static_cast<uint32_t>(MAGNITUDE.m_low >> 32);
+  limbs[2] = static_cast<uint32_t>(MAGNITUDE.m_high);
+  limbs[3] = static_cast<uint32_t>(MAGNITUDE.m_high >> 32);
+}
+
+Money Money::fromMagnitudeLimbs(const uint32_t LIMBS[4], bool negative) {
+  // The magnitude has to stay below 2^127 to leave room for the sign
+  if ((LIMBS[3] & 0x80000000U) != 0) {
+    return makeOverflow();
+  }
+  Money result;
+  result.m_low = (static_cast<uint64_t>(LIMBS[1]) << 32) | LIMBS[0];
+  result.m_high = (static_cast<uint64_t>(LIMBS[3]) << 32) | LIMBS[2];
+  return negative ? result.negated() : result;
+}
+
+Money Money::negated() const {
+  Money result;
+  result.m_overflow = m_overflow;
+  result.m_low = ~m_low + 1;
+  result.m_high = ~m_high + (result.m_low == 0 ? 1 : 0);
+  return result;
+}
+
+}  // namespace airgead_investment_planner_cli
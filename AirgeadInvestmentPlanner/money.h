@@ -0,0 +1,83 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <string>
+
+namespace airgead_investment_planner_cli {
+
+// Annual interest rate stored in millionths of a percent, so typical user
+// input such as 5.25% is represented exactly (5250000).
+class PercentRate {
+ public:
+  PercentRate() = default;
+
+  // Round a percentage to the nearest millionth of a percent
+  static PercentRate fromPercent(long double percent);
+
+  uint64_t getMicroPercent() const;
+
+  // False if the percentage was negative, not finite or too large
+  bool isValid() const;
+
+ private:
+  uint64_t m_microPercent = 0;
+  bool m_isValid = true;
+};
+
+// Exact amount of money in cents, held in a signed 128-bit fixed-point value.
+// The 128-bit arithmetic is implemented over two 64-bit limbs because MSVC
+// has no native 128-bit integer type.
+// Overflow is sticky: once a result does not fit, the value stays invalid and
+// renders as "overflow" instead of silently wrapping.
+class Money {
+ public:
+  Money() = default;
+
+  static Money fromCents(long long cents);
+
+  // Round a dollar amount to a whole cent, ties to even (banker's rounding)
+  static Money fromDollars(long double dollars);
+
+  Money operator+(const Money& OTHER) const;
+  Money operator-(const Money& OTHER) const;
+  Money& operator+=(const Money& OTHER);
+  Money& operator-=(const Money& OTHER);
+  bool operator==(const Money& OTHER) const;
+  bool operator!=(const Money& OTHER) const;
+  bool operator<(const Money& OTHER) const;
+
+  // Multiply by NUMERATOR / DENOMINATOR and round the result to a whole cent
+  // with banker's rounding. The intermediate product is kept at full width.
+  Money mulDiv(uint64_t numerator, uint32_t denominator) const;
+
+  // One month of interest at the annual RATE, rounded with banker's rounding
+  Money monthlyInterest(const PercentRate& RATE) const;
+
+  bool isOverflow() const;
+  bool isNegative() const;
+  bool isZero() const;
+
+  // Approximate value in dollars, e.g. for comparison with the floating path
+  long double toDollars() const;
+
+  // Format as dollars with exactly two decimals, e.g. "-1234.05"
+  std::string toString() const;
+
+ private:
+  // Two's complement representation: value = m_high * 2^64 + m_low
+  uint64_t m_high = 0;
+  uint64_t m_low = 0;
+  bool m_overflow = false;
+
+  static Money makeOverflow();
+
+  // Unsigned magnitude split into four 32-bit limbs, least significant first
+  void toMagnitudeLimbs(uint32_t limbs[4]) const;
+  static Money fromMagnitudeLimbs(const uint32_t LIMBS[4], bool negative);
+
+  Money negated() const;
+};
+
+}  // namespace airgead_investment_planner_cli
+#endif  // MONEY_H
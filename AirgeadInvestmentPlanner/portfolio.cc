@@ -0,0 +1,221 @@
+#include "portfolio.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace airgead_investment_planner_cli {
+namespace {
+// Months between scheduled rebalancing, 0 if the policy has no schedule
+int getRebalanceInterval(RebalancePolicy policy) {
+  switch (policy) {
+    case RebalancePolicy::MONTHLY:
+      return 1;
+    case RebalancePolicy::QUARTERLY:
+      return 3;
+    case RebalancePolicy::ANNUAL:
+      return PortfolioSimulator::MONTHS_IN_A_YEAR;
+    default:
+      return 0;
+  }
+}
+}  // namespace
+
+void PortfolioSimulator::reserve(int portfolios, int assets) {
+  while (static_cast<int>(m_balances.size()) < assets) {
+    addAssetSlot();
+  }
+  for (size_t slot = 0; slot < m_balances.size(); ++slot) {
+    m_monthlyGrowth[slot].reserve(portfolios);
+    m_targetWeights[slot].reserve(portfolios);
+    m_balances[slot].reserve(portfolios);
+    m_finalBalances[slot].reserve(portfolios);
+  }
+  m_initialInvestments.reserve(portfolios);
+  m_contributions.reserve(portfolios);
+  m_rebalanceIntervals.reserve(portfolios);
+  m_driftThresholds.reserve(portfolios);
+  m_years.reserve(portfolios);
+  m_rebalanceCounts.reserve(portfolios);
+  m_totals.reserve(portfolios);
+  m_isRebalancing.reserve(portfolios);
+}
+
+void PortfolioSimulator::clear() {
+  for (size_t slot = 0; slot < m_balances.size(); ++slot) {
+    m_monthlyGrowth[slot].clear();
+    m_targetWeights[slot].clear();
+    m_balances[slot].clear();
+    m_finalBalances[slot].clear();
+  }
+  m_initialInvestments.clear();
+  m_contributions.clear();
+  m_rebalanceIntervals.clear();
+  m_driftThresholds.clear();
+  m_years.clear();
+  m_rebalanceCounts.clear();
+  m_totals.clear();
+  m_isRebalancing.clear();
+  m_yearEndBalances.clear();
+  m_portfolioCount = 0;
+  m_maxYears = 0;
+}
+
+int PortfolioSimulator::addPortfolio(const PortfolioTerms& TERMS) {
+  if (TERMS.years < MIN_PORTFOLIO_YEARS ||
+      TERMS.years > MAX_PORTFOLIO_YEARS || TERMS.initialInvestment < 0 ||
+      TERMS.monthlyContribution < 0 || TERMS.driftThresholdPercent < 0) {
+    return -1;
+  }
+  double totalWeight = 0;
+  for (const PortfolioAsset& ASSET : TERMS.assets) {
+    if (ASSET.targetWeight < 0) {
+      return -1;
+    }
+    totalWeight += ASSET.targetWeight;
+  }
+  if (!(totalWeight > 0)) {
+    return -1;
+  }
+
+  while (m_balances.size() < TERMS.assets.size()) {
+    addAssetSlot();
+  }
+  for (size_t slot = 0; slot < m_balances.size(); ++slot) {
+    const bool IS_USED = slot < TERMS.assets.size();
+    const double WEIGHT =
+        IS_USED ? TERMS.assets[slot].targetWeight / totalWeight : 0;
+    const double RATE = IS_USED ? TERMS.assets[slot].annualRatePercent : 0;
+    m_monthlyGrowth[slot].push_back(1 + RATE / 100.0 / MONTHS_IN_A_YEAR);
+    m_targetWeights[slot].push_back(WEIGHT);
+    m_balances[slot].push_back(0);
+    m_finalBalances[slot].push_back(0);
+  }
+  m_initialInvestments.push_back(TERMS.initialInvestment);
+  m_contributions.push_back(TERMS.monthlyContribution);
+  m_rebalanceIntervals.push_back(getRebalanceInterval(TERMS.rebalancePolicy));
+  m_driftThresholds.push_back(
+      TERMS.rebalancePolicy == RebalancePolicy::THRESHOLD
+          ? TERMS.driftThresholdPercent / 100.0
+          : std::numeric_limits<double>::infinity());
+  m_years.push_back(TERMS.years);
+  m_rebalanceCounts.push_back(0);
+  m_totals.push_back(0);
+  m_isRebalancing.push_back(0);
+  m_maxYears = std::max(m_maxYears, TERMS.years);
+  return m_portfolioCount++;
+}
+
+int PortfolioSimulator::size() const { return m_portfolioCount; }
+
+void PortfolioSimulator::run() {
+  const int COUNT = m_portfolioCount;
+  const size_t SLOTS = m_balances.size();
+  m_yearEndBalances.assign(static_cast<size_t>(m_maxYears) * COUNT, 0);
+
+  // Initial investment is split by target weights
+  for (size_t slot = 0; slot < SLOTS; ++slot) {
+    double* const balances = m_balances[slot].data();
+    const double* const weights = m_targetWeights[slot].data();
+    for (int p = 0; p < COUNT; ++p) {
+      balances[p] = m_initialInvestments[p] * weights[p];
+    }
+  }
+  std::fill(m_rebalanceCounts.begin(), m_rebalanceCounts.end(), 0);
+
+  double* const totals = m_totals.data();
+  uint8_t* const isRebalancing = m_isRebalancing.data();
+  const double* const contributions = m_contributions.data();
+  const double* const thresholds = m_driftThresholds.data();
+  const int* const intervals = m_rebalanceIntervals.data();
+  const int* const years = m_years.data();
+  int* const rebalanceCounts = m_rebalanceCounts.data();
+
+  const int MONTHS = m_maxYears * MONTHS_IN_A_YEAR;
+  for (int month = 1; month <= MONTHS; ++month) {
+    // Contributions are made at the start of the month and earn its return,
+    // as in DepositCalculator
+    std::fill(totals, totals + COUNT, 0.0);
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+      double* const balances = m_balances[slot].data();
+      const double* const weights = m_targetWeights[slot].data();
+      const double* const growth = m_monthlyGrowth[slot].data();
+      for (int p = 0; p < COUNT; ++p) {
+        const double BALANCE =
+            (balances[p] + contributions[p] * weights[p]) * growth[p];
+        balances[p] = BALANCE;
+        totals[p] += BALANCE;
+      }
+    }
+
+    // Rebalance at the end of scheduled months, or of months where any
+    // asset drifted past the threshold
+    for (int p = 0; p < COUNT; ++p) {
+      isRebalancing[p] = intervals[p] != 0 && month % intervals[p] == 0;
+    }
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+      const double* const balances = m_balances[slot].data();
+      const double* const weights = m_targetWeights[slot].data();
+      for (int p = 0; p < COUNT; ++p) {
+        const double DRIFT = std::fabs(balances[p] - totals[p] * weights[p]);
+        isRebalancing[p] |= DRIFT > thresholds[p] * totals[p];
+      }
+    }
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+      double* const balances = m_balances[slot].data();
+      const double* const weights = m_targetWeights[slot].data();
+      for (int p = 0; p < COUNT; ++p) {
+        balances[p] = isRebalancing[p] ? totals[p] * weights[p] : balances[p];
+      }
+    }
+    // Portfolios keep being simulated past their term, but are not counted
+    for (int p = 0; p < COUNT; ++p) {
+      rebalanceCounts[p] +=
+          isRebalancing[p] & (month <= years[p] * MONTHS_IN_A_YEAR);
+    }
+
+    if (month % MONTHS_IN_A_YEAR == 0) {
+      const int YEAR = month / MONTHS_IN_A_YEAR;
+      std::copy(totals, totals + COUNT,
+                m_yearEndBalances.begin() +
+                    static_cast<size_t>(YEAR - 1) * COUNT);
+      // Keep the assets of portfolios whose term ends here
+      for (size_t slot = 0; slot < SLOTS; ++slot) {
+        const double* const balances = m_balances[slot].data();
+        double* const finalBalances = m_finalBalances[slot].data();
+        for (int p = 0; p < COUNT; ++p) {
+          finalBalances[p] = years[p] == YEAR ? balances[p] : finalBalances[p];
+        }
+      }
+    }
+  }
+}
+
+double PortfolioSimulator::getYearEndBalance(int portfolio, int year) const {
+  return m_yearEndBalances[static_cast<size_t>(year - 1) * m_portfolioCount +
+                           portfolio];
+}
+
+double PortfolioSimulator::getFinalBalance(int portfolio) const {
+  return getYearEndBalance(portfolio, m_years[portfolio]);
+}
+
+double PortfolioSimulator::getFinalAssetBalance(int portfolio,
+                                                int asset) const {
+  return m_finalBalances[asset][portfolio];
+}
+
+int PortfolioSimulator::getRebalanceCount(int portfolio) const {
+  return m_rebalanceCounts[portfolio];
+}
+
+// PortfolioSimulator:Private
+
+void PortfolioSimulator::addAssetSlot() {
+  m_monthlyGrowth.emplace_back(m_portfolioCount, 1.0);
+  m_targetWeights.emplace_back(m_portfolioCount, 0.0);
+  m_balances.emplace_back(m_portfolioCount, 0.0);
+  m_finalBalances.emplace_back(m_portfolioCount, 0.0);
+}
+
+}  // namespace airgead_investment_planner_cli
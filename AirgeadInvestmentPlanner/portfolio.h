@@ -0,0 +1,111 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <cstdint>
+#include <vector>
+
+namespace airgead_investment_planner_cli {
+
+enum class RebalancePolicy {
+  // Holdings drift with their returns, only contributions follow the targets
+  NEVER,
+  MONTHLY,
+  QUARTERLY,
+  ANNUAL,
+  // Whenever an asset drifts too far from its target weight
+  THRESHOLD
+};
+
+struct PortfolioAsset {
+  double annualRatePercent = 0;
+  // Share of the portfolio, relative to the other assets' weights
+  double targetWeight = 0;
+};
+
+struct PortfolioTerms {
+  std::vector<PortfolioAsset> assets;
+  // Split between the assets by their target weights
+  double initialInvestment = 0;
+  double monthlyContribution = 0;
+  int years = 0;
+  RebalancePolicy rebalancePolicy = RebalancePolicy::ANNUAL;
+  // For THRESHOLD: largest allowed distance between an asset's weight and
+  // its target weight, in percentage points
+  double driftThresholdPercent = 5;
+};
+
+// Simulates a batch of portfolios month by month, all of them at once.
+//
+// State is stored structure-of-arrays: every asset slot has one contiguous
+// array per quantity, indexed by portfolio, so each step of a month is a
+// loop over portfolios without branches that the compiler can vectorize.
+// Portfolios with fewer assets than the widest one get zero-weight slots.
+// Amounts are doubles rather than the long doubles of DepositCalculator,
+// which have no vector instructions.
+class PortfolioSimulator {
+ public:
+  static const int MONTHS_IN_A_YEAR = 12;
+  static const int MIN_PORTFOLIO_YEARS = 1;
+  // Same limit as the single-account planner
+  static const int MAX_PORTFOLIO_YEARS = 250;
+
+  // Preallocate every array for the given number of portfolios and assets
+  void reserve(int portfolios, int assets);
+
+  // Drop all portfolios, keeping the allocated capacity
+  void clear();
+
+  // Add a portfolio to the batch. Returns its index, or -1 if the terms are
+  // out of the supported range or the weights do not add up to more than 0.
+  int addPortfolio(const PortfolioTerms& TERMS);
+
+  int size() const;
+
+  // Simulate every portfolio over its term, replacing earlier results
+  void run();
+
+  // Total balance of the portfolio at the end of year 1 to its term
+  double getYearEndBalance(int portfolio, int year) const;
+
+  double getFinalBalance(int portfolio) const;
+
+  // Balance of one of the portfolio's assets at the end of its term
+  double getFinalAssetBalance(int portfolio, int asset) const;
+
+  // Number of months at whose end the portfolio was rebalanced
+  int getRebalanceCount(int portfolio) const;
+
+ private:
+  // Add an asset slot, with zero weight for the portfolios already added
+  void addAssetSlot();
+
+  int m_portfolioCount = 0;
+  int m_maxYears = 0;
+
+  // Per asset slot, indexed by portfolio
+  std::vector<std::vector<double>> m_monthlyGrowth;
+  std::vector<std::vector<double>> m_targetWeights;
+  std::vector<std::vector<double>> m_balances;
+  // Asset balances at the end of every portfolio's own term
+  std::vector<std::vector<double>> m_finalBalances;
+
+  // Per portfolio
+  std::vector<double> m_initialInvestments;
+  std::vector<double> m_contributions;
+  // Months between scheduled rebalancing, 0 for none
+  std::vector<int> m_rebalanceIntervals;
+  // Fraction of the total, infinite unless the policy is THRESHOLD
+  std::vector<double> m_driftThresholds;
+  std::vector<int> m_years;
+  std::vector<int> m_rebalanceCounts;
+
+  // Scratch, per portfolio
+  std::vector<double> m_totals;
+  std::vector<uint8_t> m_isRebalancing;
+
+  // Indexed by (year - 1) * m_portfolioCount + portfolio
+  std::vector<double> m_yearEndBalances;
+};
+
+}  // namespace airgead_investment_planner_cli
+#endif  // PORTFOLIO_H
@@ -0,0 +1,283 @@
+#include "sensitivity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "mini_utils.h"
+
+namespace airgead_investment_planner_cli {
+namespace {
+// xterm 256-color backgrounds from blue through green and yellow to red
+const int HEATMAP_COLORS[] = {21, 33, 45, 49, 46, 118, 226, 214, 202, 196};
+const int HEATMAP_COLOR_COUNT =
+    static_cast<int>(sizeof(HEATMAP_COLORS) / sizeof(HEATMAP_COLORS[0]));
+
+// Only formats numbers, so its width is never used
+const mini_utils::StringFormatter NUMBER_FORMATTER(0);
+
+bool isValidAmount(double amount) { return amount >= 0; }
+
+// Number of term columns of fixedLength plus columnLength characters each
+// that fit in maxWidth, at least one
+size_t getColumnsPerPage(int maxWidth, size_t fixedLength,
+                         size_t columnLength) {
+  const size_t WIDTH = static_cast<size_t>(std::max(maxWidth, 0));
+  return WIDTH > fixedLength
+             ? std::max<size_t>(1, (WIDTH - fixedLength) / columnLength)
+             : 1;
+}
+}  // namespace
+
+bool SensitivityAnalysis::run(const SensitivityGrid& GRID, int threadCount) {
+  if (GRID.annualRatesPercent.empty() || GRID.years.empty() ||
+      GRID.monthlyDeposits.empty() || !isValidAmount(GRID.principal) ||
+      !std::all_of(GRID.annualRatesPercent.begin(),
+                   GRID.annualRatesPercent.end(), isValidAmount) ||
+      !std::all_of(GRID.monthlyDeposits.begin(), GRID.monthlyDeposits.end(),
+                   isValidAmount) ||
+      !std::all_of(GRID.years.begin(), GRID.years.end(), [](int years) {
+        return years >= MIN_YEARS && years <= MAX_YEARS;
+      })) {
+    return false;
+  }
+
+  m_grid = GRID;
+  m_termOrder.resize(m_grid.years.size());
+  for (size_t term = 0; term < m_termOrder.size(); ++term) {
+    m_termOrder[term] = term;
+  }
+  std::sort(m_termOrder.begin(), m_termOrder.end(),
+            [this](size_t left, size_t right) {
+              return m_grid.years[left] < m_grid.years[right];
+            });
+  m_balances.assign(m_grid.annualRatesPercent.size() * m_grid.years.size() *
+                        m_grid.monthlyDeposits.size(),
+                    0);
+
+  const size_t RATES = m_grid.annualRatesPercent.size();
+  size_t threads = threadCount > 0 ? static_cast<size_t>(threadCount)
+                                   : std::thread::hardware_concurrency();
+  threads = std::max<size_t>(1, std::min(threads, RATES));
+  if (threads == 1) {
+    for (size_t rate = 0; rate < RATES; ++rate) {
+      runRate(rate);
+    }
+    return true;
+  }
+
+  // Every rate writes its own slice of the balances, so workers only share
+  // the counter handing out the next rate
+  std::atomic<size_t> nextRate{0};
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([this, &nextRate, RATES] {
+      for (size_t rate = nextRate++; rate < RATES; rate = nextRate++) {
+        runRate(rate);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return true;
+}
+
+const SensitivityGrid& SensitivityAnalysis::getGrid() const { return m_grid; }
+
+double SensitivityAnalysis::getBalance(size_t rate, size_t term,
+                                       size_t deposit) const {
+  return m_balances[(rate * m_grid.years.size() + term) *
+                        m_grid.monthlyDeposits.size() +
+                    deposit];
+}
+
+std::string SensitivityAnalysis::renderTable(size_t deposit,
+                                             int maxWidth) const {
+  const size_t RATES = m_grid.annualRatesPercent.size();
+  const size_t TERMS = m_grid.years.size();
+
+  std::vector<std::string> headers = {"Rate"};
+  std::vector<std::vector<std::string>> rows(RATES);
+  size_t labelLength = headers[0].size();
+  size_t cellLength = 0;
+  for (size_t term = 0; term < TERMS; ++term) {
+    headers.push_back(std::to_string(m_grid.years[term]) + " years");
+    cellLength = std::max(cellLength, headers.back().size());
+  }
+  for (size_t rate = 0; rate < RATES; ++rate) {
+    rows[rate].push_back(NUMBER_FORMATTER.toStringWithPrecision(
+                             m_grid.annualRatesPercent[rate]) +
+                         "%");
+    labelLength = std::max(labelLength, rows[rate][0].size());
+    for (size_t term = 0; term < TERMS; ++term) {
+      rows[rate].push_back(
+          "$" + NUMBER_FORMATTER.toStringWithPrecision(
+                    getBalance(rate, term, deposit)));
+      cellLength = std::max(cellLength, rows[rate].back().size());
+    }
+  }
+
+  // Sized to fit every cell; see TableFormatter::writeRow for the padding.
+  // A line is "| label |" and " cell |" per term.
+  const int LABEL_WIDTH = static_cast<int>(labelLength) + 2;
+  const int CELL_WIDTH = static_cast<int>(cellLength) + 4;
+  const size_t TERMS_PER_PAGE =
+      getColumnsPerPage(maxWidth, labelLength + 4, cellLength + 3);
+
+  std::string tables;
+  std::vector<std::string> pageHeaders;
+  std::vector<std::string> pageRow;
+  for (size_t first = 0; first < TERMS; first += TERMS_PER_PAGE) {
+    const size_t LAST = std::min(TERMS, first + TERMS_PER_PAGE);
+    std::vector<int> widths(LAST - first + 1, CELL_WIDTH);
+    widths[0] = LABEL_WIDTH;
+    mini_utils::TableFormatter table(
+        LABEL_WIDTH + static_cast<int>(LAST - first) * CELL_WIDTH);
+    if (!table.setColumnWidths(widths)) {
+      return "";
+    }
+
+    pageHeaders.assign(1, headers[0]);
+    pageHeaders.insert(pageHeaders.end(), headers.begin() + 1 + first,
+                       headers.begin() + 1 + LAST);
+    table.setHeaders(pageHeaders);
+    for (const std::vector<std::string>& ROW : rows) {
+      pageRow.assign(1, ROW[0]);
+      pageRow.insert(pageRow.end(), ROW.begin() + 1 + first,
+                     ROW.begin() + 1 + LAST);
+      table.addRow(pageRow);
+    }
+    if (first > 0) {
+      tables += '\n';
+    }
+    tables += table.render();
+  }
+  return tables;
+}
+
+std::string SensitivityAnalysis::renderHeatmap(size_t deposit,
+                                               int maxWidth) const {
+  const size_t RATES = m_grid.annualRatesPercent.size();
+  const size_t TERMS = m_grid.years.size();
+
+  std::vector<std::string> labels(RATES);
+  std::vector<std::string> cells(RATES * TERMS);
+  size_t labelLength = 0;
+  size_t cellLength = 0;
+  double lowest = getBalance(0, 0, deposit);
+  double highest = lowest;
+  for (size_t rate = 0; rate < RATES; ++rate) {
+    labels[rate] = NUMBER_FORMATTER.toStringWithPrecision(
+                       m_grid.annualRatesPercent[rate]) +
+                   "%";
+    labelLength = std::max(labelLength, labels[rate].size());
+    for (size_t term = 0; term < TERMS; ++term) {
+      const double BALANCE = getBalance(rate, term, deposit);
+      lowest = std::min(lowest, BALANCE);
+      highest = std::max(highest, BALANCE);
+      std::string& cell = cells[rate * TERMS + term];
+      cell = "$" + NUMBER_FORMATTER.toStringWithPrecision(BALANCE);
+      cellLength = std::max(cellLength, cell.size());
+    }
+  }
+  for (size_t term = 0; term < TERMS; ++term) {
+    cellLength =
+        std::max(cellLength, std::to_string(m_grid.years[term]).size() + 2);
+  }
+
+  // Cells are right-aligned with a space on each side. Colors span the
+  // whole matrix, so they compare across pages.
+  const size_t TERMS_PER_PAGE =
+      getColumnsPerPage(maxWidth, labelLength, cellLength + 2);
+  std::string heatmap;
+  for (size_t first = 0; first < TERMS; first += TERMS_PER_PAGE) {
+    const size_t LAST = std::min(TERMS, first + TERMS_PER_PAGE);
+    if (first > 0) {
+      heatmap += '\n';
+    }
+    heatmap.append(labelLength, ' ');
+    for (size_t term = first; term < LAST; ++term) {
+      const std::string HEADER = std::to_string(m_grid.years[term]) + " y";
+      heatmap.append(cellLength + 2 - HEADER.size(), ' ');
+      heatmap += HEADER;
+    }
+    heatmap += '\n';
+    for (size_t rate = 0; rate < RATES; ++rate) {
+      heatmap.append(labelLength - labels[rate].size(), ' ');
+      heatmap += labels[rate];
+      for (size_t term = first; term < LAST; ++term) {
+        const double SHARE = highest > lowest
+                                 ? (getBalance(rate, term, deposit) - lowest) /
+                                       (highest - lowest)
+                                 : 0;
+        const int COLOR = HEATMAP_COLORS[std::min(
+            HEATMAP_COLOR_COUNT - 1,
+            static_cast<int>(SHARE * HEATMAP_COLOR_COUNT))];
+        const std::string& CELL = cells[rate * TERMS + term];
+        heatmap += "\x1b[30;48;5;" + std::to_string(COLOR) + "m";
+        heatmap.append(cellLength + 1 - CELL.size(), ' ');
+        heatmap += CELL;
+        heatmap += " \x1b[0m";
+      }
+      heatmap += '\n';
+    }
+  }
+  return heatmap;
+}
+
+void SensitivityAnalysis::writeCsv(std::ostream& out) const {
+  std::string line = "annual_rate_percent,years,monthly_deposit,balance\n";
+  out << line;
+  for (size_t rate = 0; rate < m_grid.annualRatesPercent.size(); ++rate) {
+    for (size_t term = 0; term < m_grid.years.size(); ++term) {
+      for (size_t deposit = 0; deposit < m_grid.monthlyDeposits.size();
+           ++deposit) {
+        line.clear();
+        NUMBER_FORMATTER.appendWithPrecision(
+            line, m_grid.annualRatesPercent[rate], 4);
+        line += ',';
+        line += std::to_string(m_grid.years[term]);
+        line += ',';
+        NUMBER_FORMATTER.appendWithPrecision(line,
+                                             m_grid.monthlyDeposits[deposit]);
+        line += ',';
+        NUMBER_FORMATTER.appendWithPrecision(line,
+                                             getBalance(rate, term, deposit));
+        line += '\n';
+        out << line;
+      }
+    }
+  }
+}
+
+// SensitivityAnalysis:Private
+
+void SensitivityAnalysis::runRate(size_t rate) {
+  const long double MONTHLY_GROWTH =
+      1 + m_grid.annualRatesPercent[rate] / 100.0L / MONTHS_IN_A_YEAR;
+  const size_t TERMS = m_grid.years.size();
+  const size_t DEPOSITS = m_grid.monthlyDeposits.size();
+
+  // (1 + r)^n grows the principal, and the sum of (1 + r)^k for k = 1..n
+  // grows the deposits, each made at the start of its month
+  long double principalGrowth = 1;
+  long double depositGrowth = 0;
+  int months = 0;
+  for (size_t term : m_termOrder) {
+    const int TERM_MONTHS = m_grid.years[term] * MONTHS_IN_A_YEAR;
+    for (; months < TERM_MONTHS; ++months) {
+      principalGrowth *= MONTHLY_GROWTH;
+      depositGrowth += principalGrowth;
+    }
+    double* const balances = &m_balances[(rate * TERMS + term) * DEPOSITS];
+    for (size_t deposit = 0; deposit < DEPOSITS; ++deposit) {
+      balances[deposit] = static_cast<double>(
+          m_grid.principal * principalGrowth +
+          m_grid.monthlyDeposits[deposit] * depositGrowth);
+    }
+  }
+}
+
+}  // namespace airgead_investment_planner_cli
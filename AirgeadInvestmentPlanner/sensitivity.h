@@ -0,0 +1,75 @@
+#ifndef SENSITIVITY_H
+#define SENSITIVITY_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace airgead_investment_planner_cli {
+
+// Values of every axis of the grid; each combination is one cell
+struct SensitivityGrid {
+  double principal = 0;
+  std::vector<double> annualRatesPercent;
+  std::vector<int> years;
+  std::vector<double> monthlyDeposits;
+};
+
+// Final balances of an investment over a grid of rates, terms and monthly
+// deposits, computed as DepositCalculator::calculateCompoundInterest does.
+//
+// The balance is linear in the principal and the deposit, with factors
+// that only depend on the rate and the term: (1 + r)^n and the sum of
+// (1 + r)^k for k = 1..n. So every rate is walked month by month once, up
+// to the longest term, and each cell costs a multiply-add when its term is
+// reached. Rates are spread over threads.
+//
+// Example:
+//   SensitivityAnalysis analysis;
+//   analysis.run({1000, {3, 5, 7}, {10, 20, 30}, {0, 100}});
+//   std::cout << analysis.renderTable(1, 80);
+class SensitivityAnalysis {
+ public:
+  static const int MONTHS_IN_A_YEAR = 12;
+  static const int MIN_YEARS = 1;
+  static const int MAX_YEARS = 250;
+
+  // Evaluate every cell of the grid on up to threadCount threads, 0 for
+  // one per hardware thread. Returns false if an axis is empty or a value
+  // is out of range: negative amounts or rates, or terms outside
+  // MIN_YEARS..MAX_YEARS.
+  bool run(const SensitivityGrid& GRID, int threadCount = 0);
+
+  const SensitivityGrid& getGrid() const;
+
+  // Final balance of the cell at the given index of every axis
+  double getBalance(size_t rate, size_t term, size_t deposit) const;
+
+  // Rates down the rows and terms across the columns, for one deposit.
+  // Terms that do not fit in maxWidth columns continue in further tables
+  // below, each repeating the rates. Returns an empty string if a table
+  // cannot be laid out.
+  std::string renderTable(size_t deposit, int maxWidth) const;
+
+  // Same matrix with every balance on a background color, from blue for
+  // the lowest balance for the deposit to red for the highest, split into
+  // pages of terms the same way
+  std::string renderHeatmap(size_t deposit, int maxWidth) const;
+
+  // One "rate,years,deposit,balance" line per cell, after a header line
+  void writeCsv(std::ostream& out) const;
+
+ private:
+  // Fill the balances of one rate for every term and deposit
+  void runRate(size_t rate);
+
+  SensitivityGrid m_grid;
+  // Indices of m_grid.years in ascending order of years
+  std::vector<size_t> m_termOrder;
+  // Indexed by (rate * terms + term) * deposits + deposit
+  std::vector<double> m_balances;
+};
+
+}  // namespace airgead_investment_planner_cli
+#endif  // SENSITIVITY_H
@@ -0,0 +1,142 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "amortization.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "money.h"
+
+using airgead_investment_planner_cli::AmortizationCalculator;
+using airgead_investment_planner_cli::AmortizationSchedule;
+using airgead_investment_planner_cli::LoanTerms;
+using airgead_investment_planner_cli::Money;
+using airgead_investment_planner_cli::RepaymentPlan;
+
+namespace {
+LoanTerms makeTerms(double principal, double annualRatePercent, int years,
+                    RepaymentPlan plan = RepaymentPlan::MORTGAGE,
+                    double extraMonthlyPayment = 0) {
+  LoanTerms terms;
+  terms.principal = principal;
+  terms.annualRatePercent = annualRatePercent;
+  terms.years = years;
+  terms.plan = plan;
+  terms.extraMonthlyPayment = extraMonthlyPayment;
+  return terms;
+}
+
+Money sum(const std::vector<Money>& AMOUNTS) {
+  Money total;
+  for (const Money& AMOUNT : AMOUNTS) {
+    total += AMOUNT;
+  }
+  return total;
+}
+}  // namespace
+
+// Tests the level payment against known annuity values
+TEST(AmortizationTest, CalculateMortgagePayment_MatchesAnnuity) {
+  EXPECT_NEAR(static_cast<double>(
+                  AmortizationCalculator::calculateMortgagePayment(100000, 6,
+                                                                   360)),
+              599.55, 0.005);
+  EXPECT_NEAR(static_cast<double>(
+                  AmortizationCalculator::calculateMortgagePayment(20000, 4.5,
+                                                                   60)),
+              372.86, 0.005);
+}
+
+// Tests that a 0% loan is split evenly instead of dividing by zero
+TEST(AmortizationTest, CalculateMortgagePayment_ZeroRate) {
+  EXPECT_DOUBLE_EQ(static_cast<double>(
+                       AmortizationCalculator::calculateMortgagePayment(
+                           12000, 0, 120)),
+                   100.0);
+
+  AmortizationSchedule schedule;
+  ASSERT_TRUE(AmortizationCalculator::buildSchedule(makeTerms(1000, 0, 1),
+                                                    schedule));
+  ASSERT_EQ(schedule.size(), 12);
+  EXPECT_TRUE(schedule.getTotalInterest().isZero());
+  EXPECT_EQ(schedule.getPayments()[0].toString(), "83.33");
+  EXPECT_EQ(schedule.getPayments().back().toString(), "83.37");
+}
+
+// Tests that every plan ends on a balance of exactly zero
+TEST(AmortizationTest, BuildSchedule_EndsOnZeroBalance) {
+  const LoanTerms TERMS[] = {
+      makeTerms(250000, 6.5, 30),
+      makeTerms(250000, 6.5, 30, RepaymentPlan::FIXED_PRINCIPAL),
+      makeTerms(250000, 6.5, 30, RepaymentPlan::MORTGAGE, 500),
+      makeTerms(999.99, 17.9, 1, RepaymentPlan::FIXED_PRINCIPAL, 0.01)};
+  for (const LoanTerms& LOAN : TERMS) {
+    AmortizationSchedule schedule;
+    ASSERT_TRUE(AmortizationCalculator::buildSchedule(LOAN, schedule));
+    ASSERT_GT(schedule.size(), 0);
+    EXPECT_TRUE(schedule.getBalances().back().isZero())
+        << schedule.getBalances().back().toString();
+    for (int period = 0; period + 1 < schedule.size(); ++period) {
+      EXPECT_FALSE(schedule.getBalances()[period].isZero());
+    }
+  }
+}
+
+// Tests that an extra payment pays the loan off early
+TEST(AmortizationTest, BuildSchedule_ExtraPaymentShortensTerm) {
+  AmortizationSchedule regular;
+  AmortizationSchedule early;
+  AmortizationCalculator::buildSchedule(makeTerms(250000, 6.5, 30), regular);
+  AmortizationCalculator::buildSchedule(
+      makeTerms(250000, 6.5, 30, RepaymentPlan::MORTGAGE, 500), early);
+  EXPECT_EQ(regular.size(), 360);
+  EXPECT_LT(early.size(), 260);
+  EXPECT_TRUE(early.getTotalInterest() < regular.getTotalInterest());
+}
+
+// Tests that the interest is exactly what was paid beyond the principal
+TEST(AmortizationTest, BuildSchedule_TotalInterestBalances) {
+  const LoanTerms TERMS[] = {
+      makeTerms(180000, 5.125, 15),
+      makeTerms(180000, 5.125, 15, RepaymentPlan::FIXED_PRINCIPAL, 250)};
+  for (const LoanTerms& LOAN : TERMS) {
+    AmortizationSchedule schedule;
+    ASSERT_TRUE(AmortizationCalculator::buildSchedule(LOAN, schedule));
+    const Money PRINCIPAL = Money::fromDollars(LOAN.principal);
+    EXPECT_EQ(sum(schedule.getPayments()) - PRINCIPAL,
+              schedule.getTotalInterest());
+    EXPECT_EQ(sum(schedule.getPrincipalPaid()), PRINCIPAL);
+    EXPECT_EQ(sum(schedule.getInterestPaid()), schedule.getTotalInterest());
+    for (int period = 0; period < schedule.size(); ++period) {
+      EXPECT_EQ(schedule.getPayments()[period],
+                schedule.getPrincipalPaid()[period] +
+                    schedule.getInterestPaid()[period]);
+    }
+  }
+}
+
+// Tests that terms out of range are rejected with an empty schedule
+TEST(AmortizationTest, BuildSchedule_RejectsInvalidTerms) {
+  const LoanTerms TERMS[] = {
+      makeTerms(1000, 5, 0),
+      makeTerms(1000, 5, AmortizationCalculator::MAX_LOAN_YEARS + 1),
+      makeTerms(0, 5, 10),
+      makeTerms(-1000, 5, 10),
+      makeTerms(NAN, 5, 10),
+      makeTerms(1000, -1, 10),
+      makeTerms(1000, NAN, 10),
+      makeTerms(1000, 5, 10, RepaymentPlan::MORTGAGE, -1),
+      makeTerms(1e40, 5, 10)};
+  AmortizationSchedule schedule;
+  ASSERT_TRUE(AmortizationCalculator::buildSchedule(makeTerms(1000, 5, 1),
+                                                    schedule));
+  for (const LoanTerms& LOAN : TERMS) {
+    EXPECT_FALSE(AmortizationCalculator::buildSchedule(LOAN, schedule))
+        << LOAN.principal << " at " << LOAN.annualRatePercent << "% for "
+        << LOAN.years << " years";
+    EXPECT_EQ(schedule.size(), 0);
+  }
+}
@@ -0,0 +1,111 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "deposit_calculator.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using airgead_investment_planner_cli::GrowthFactorCache;
+
+// Tests that a factor inside the cached table is a hit, past it a miss
+TEST(GrowthFactorCacheTest, GetGrowthFactor_CountsHitsAndMisses) {
+  GrowthFactorCache cache;
+  cache.getGrowthFactor(0.005L, 120);
+  EXPECT_EQ(cache.getStats().misses, 1u);
+  EXPECT_EQ(cache.getStats().hits, 0u);
+
+  cache.getGrowthFactor(0.005L, 60);
+  cache.getGrowthFactor(0.005L, 120);
+  EXPECT_EQ(cache.getStats().hits, 2u);
+  cache.getGrowthFactor(0.005L, 121);
+  EXPECT_EQ(cache.getStats().misses, 2u);
+  EXPECT_DOUBLE_EQ(cache.getStats().hitRate(), 0.5);
+
+  cache.resetStats();
+  EXPECT_EQ(cache.getStats().hits + cache.getStats().misses, 0u);
+}
+
+// Tests that walking up a year at a time, as the yearly table does, hits
+// after the first extension instead of extending on every lookup
+TEST(GrowthFactorCacheTest, GetGrowthFactor_YearlyLookupsHit) {
+  GrowthFactorCache cache;
+  const int YEARS = 250;
+  for (int year = 1; year <= YEARS; ++year) {
+    cache.getGrowthFactor(0.004L, year * 12);
+    cache.getGrowthFactor(0.004L, year * 12 + 1);
+  }
+  // 13 months, then doubling up past 3001
+  EXPECT_LE(cache.getStats().misses, 10u);
+  EXPECT_EQ(cache.getStats().hits + cache.getStats().misses, 2u * YEARS);
+
+  // A table run again is answered entirely from the cache
+  cache.resetStats();
+  for (int year = 1; year <= YEARS; ++year) {
+    cache.getGrowthFactor(0.004L, year * 12);
+  }
+  EXPECT_EQ(cache.getStats().misses, 0u);
+}
+
+// Tests that another rate gets its own table instead of the cached factors
+TEST(GrowthFactorCacheTest, GetGrowthFactor_NewRateIsNotServedStale) {
+  GrowthFactorCache cache;
+  const long double SLOW = cache.getGrowthFactor(0.001L, 24);
+  const long double FAST = cache.getGrowthFactor(0.01L, 24);
+  EXPECT_EQ(cache.getStats().misses, 2u);
+  EXPECT_NEAR(static_cast<double>(FAST), std::pow(1.01, 24), 1e-12);
+  EXPECT_NE(SLOW, FAST);
+  // The first rate's table is still there
+  EXPECT_EQ(cache.getGrowthFactor(0.001L, 24), SLOW);
+  EXPECT_EQ(cache.getStats().hits, 1u);
+
+  cache.clear();
+  EXPECT_EQ(cache.getGrowthFactor(0.001L, 24), SLOW);
+  EXPECT_EQ(cache.getStats().misses, 3u);
+}
+
+// Tests that incrementally built factors match pow() closely
+TEST(GrowthFactorCacheTest, GetGrowthFactor_MatchesPow) {
+  GrowthFactorCache cache;
+  for (const long double RATE : {0.0L, 0.0001L, 0.004166L, 0.01L, 0.05L}) {
+    for (int months = 0; months <= 3000; months += 7) {
+      const long double EXPECTED = std::pow(1 + RATE, months);
+      EXPECT_NEAR(static_cast<double>(cache.getGrowthFactor(RATE, months) /
+                                      EXPECTED),
+                  1.0, 1e-14)
+          << RATE << " over " << months << " months";
+    }
+  }
+  // Negative month counts bypass the table
+  EXPECT_NEAR(static_cast<double>(cache.getGrowthFactor(0.01L, -12)),
+              std::pow(1.01, -12), 1e-15);
+}
+
+// Tests that threads sharing one cache all see correct factors
+TEST(GrowthFactorCacheTest, GetGrowthFactor_IsSafeAcrossThreads) {
+  GrowthFactorCache cache;
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int thread = 0; thread < 4; ++thread) {
+    threads.emplace_back([&cache, &mismatches, thread] {
+      for (int i = 0; i < 2000; ++i) {
+        const long double RATE = 0.001L * (1 + (i + thread) % 8);
+        const int MONTHS = (i * 37) % 600;
+        const long double FACTOR = cache.getGrowthFactor(RATE, MONTHS);
+        if (std::fabs(FACTOR / std::pow(1 + RATE, MONTHS) - 1) > 1e-14) {
+          ++mismatches[thread];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (int count : mismatches) {
+    EXPECT_EQ(count, 0);
+  }
+  EXPECT_EQ(cache.getStats().hits + cache.getStats().misses, 8000u);
+}
@@ -0,0 +1,141 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "money.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "deposit_calculator.h"
+
+using airgead_investment_planner_cli::DepositCalculator;
+using airgead_investment_planner_cli::Money;
+using airgead_investment_planner_cli::PercentRate;
+
+// Tests that dollar amounts halfway between two cents round to the even one
+TEST(MoneyTest, FromDollars_RoundsTiesToEven) {
+  // Exact binary fractions, so the tie is a real tie
+  EXPECT_EQ(Money::fromDollars(0.125L).toString(), "0.12");
+  EXPECT_EQ(Money::fromDollars(0.375L).toString(), "0.38");
+  EXPECT_EQ(Money::fromDollars(-0.125L).toString(), "-0.12");
+  EXPECT_EQ(Money::fromDollars(-0.375L).toString(), "-0.38");
+  EXPECT_EQ(Money::fromDollars(2.5L / 100).toString(), "0.02");
+}
+
+// Tests that half a cent left by mulDiv rounds to the even cent
+TEST(MoneyTest, MulDiv_RoundsTiesToEven) {
+  EXPECT_EQ(Money::fromCents(1).mulDiv(1, 2), Money::fromCents(0));
+  EXPECT_EQ(Money::fromCents(3).mulDiv(1, 2), Money::fromCents(2));
+  EXPECT_EQ(Money::fromCents(5).mulDiv(1, 2), Money::fromCents(2));
+  EXPECT_EQ(Money::fromCents(-1).mulDiv(1, 2), Money::fromCents(0));
+  EXPECT_EQ(Money::fromCents(-3).mulDiv(1, 2), Money::fromCents(-2));
+  EXPECT_EQ(Money::fromCents(-5).mulDiv(1, 2), Money::fromCents(-2));
+  // Just past the tie rounds away from it
+  EXPECT_EQ(Money::fromCents(501).mulDiv(1, 1000), Money::fromCents(1));
+}
+
+// Tests arithmetic, ordering and formatting of negative amounts
+TEST(MoneyTest, NegativeAmounts) {
+  const Money DEBT = Money::fromCents(-12345);
+  EXPECT_TRUE(DEBT.isNegative());
+  EXPECT_EQ(DEBT.toString(), "-123.45");
+  EXPECT_EQ(Money::fromCents(-5).toString(), "-0.05");
+  EXPECT_EQ((DEBT + Money::fromCents(12345)), Money::fromCents(0));
+  EXPECT_TRUE((DEBT + Money::fromCents(12345)).isZero());
+  EXPECT_EQ(Money::fromCents(100) - Money::fromCents(250),
+            Money::fromCents(-150));
+  EXPECT_TRUE(DEBT < Money::fromCents(-1));
+  EXPECT_FALSE(Money::fromCents(1) < DEBT);
+  EXPECT_DOUBLE_EQ(static_cast<double>(DEBT.toDollars()), -123.45);
+}
+
+// Tests that sums and products carry across the boundary of the low limb
+TEST(MoneyTest, Arithmetic_CarriesAcross64Bits) {
+  const long long MAX_CENTS = std::numeric_limits<long long>::max();
+  // 2^63 cents
+  EXPECT_EQ((Money::fromCents(MAX_CENTS) + Money::fromCents(1)).toString(),
+            "92233720368547758.08");
+  // 2^62 * 8 = 2^65 cents
+  const Money BIG = Money::fromCents(1LL << 62).mulDiv(8, 1);
+  EXPECT_EQ(BIG.toString(), "368934881474191032.32");
+  EXPECT_EQ(BIG.mulDiv(1, 8), Money::fromCents(1LL << 62));
+  EXPECT_EQ((BIG - Money::fromCents(1)).mulDiv(1, 2).toString(),
+            "184467440737095516.16");
+  // Negative values borrow across the boundary too
+  EXPECT_EQ((Money::fromCents(0) - BIG).toString(), "-368934881474191032.32");
+  EXPECT_EQ(Money::fromCents(-(1LL << 62)).mulDiv(8, 1),
+            Money::fromCents(0) - BIG);
+}
+
+// Tests that results out of range become a sticky overflow
+TEST(MoneyTest, Overflow_IsSticky) {
+  const long long MAX_CENTS = std::numeric_limits<long long>::max();
+  // (2^63 - 1) * (2^64 - 1) still fits below 2^127, doubling it does not
+  const Money LARGEST = Money::fromCents(MAX_CENTS).mulDiv(UINT64_MAX, 1);
+  ASSERT_FALSE(LARGEST.isOverflow());
+  EXPECT_TRUE(LARGEST.mulDiv(2, 1).isOverflow());
+  EXPECT_TRUE((LARGEST + LARGEST).isOverflow());
+  EXPECT_TRUE((Money::fromCents(0) - LARGEST - LARGEST).isOverflow());
+
+  const Money OVERFLOW_VALUE = LARGEST.mulDiv(2, 1);
+  EXPECT_TRUE((OVERFLOW_VALUE - LARGEST).isOverflow());
+  EXPECT_EQ(OVERFLOW_VALUE.toString(), "overflow");
+  EXPECT_NE(OVERFLOW_VALUE, OVERFLOW_VALUE);
+  EXPECT_TRUE(Money::fromCents(1).mulDiv(1, 0).isOverflow());
+  EXPECT_TRUE(Money::fromDollars(INFINITY).isOverflow());
+  EXPECT_TRUE(Money::fromDollars(1e40L).isOverflow());
+  EXPECT_TRUE(
+      Money::fromCents(100).monthlyInterest(PercentRate::fromPercent(-1))
+          .isOverflow());
+}
+
+// Tests that rates are kept in exact millionths of a percent
+TEST(MoneyTest, PercentRate_IsExact) {
+  EXPECT_EQ(PercentRate::fromPercent(5.25L).getMicroPercent(), 5250000u);
+  EXPECT_EQ(PercentRate::fromPercent(0.000001L).getMicroPercent(), 1u);
+  EXPECT_FALSE(PercentRate::fromPercent(-0.5L).isValid());
+  EXPECT_FALSE(PercentRate::fromPercent(NAN).isValid());
+  // 12% a year is 1% a month
+  EXPECT_EQ(Money::fromCents(100000).monthlyInterest(
+                PercentRate::fromPercent(12)),
+            Money::fromCents(1000));
+}
+
+// Tests that the exact path stays within rounding of the floating path
+TEST(MoneyTest, ExactBalances_AgreeWithFloatingPoint) {
+  struct Scenario {
+    double principal;
+    double ratePercent;
+    double monthlyDeposit;
+    int years;
+  };
+  const Scenario SCENARIOS[] = {
+      {1000, 5, 50, 10}, {25000, 3.25, 0, 30}, {0, 7.5, 250, 20},
+      {1, 0.1, 1, 5},    {100000, 12, 1000, 40}};
+  for (const Scenario& SCENARIO : SCENARIOS) {
+    const std::vector<Money> BALANCES =
+        DepositCalculator::calculateYearEndBalancesExact(
+            Money::fromDollars(SCENARIO.principal),
+            PercentRate::fromPercent(SCENARIO.ratePercent),
+            Money::fromDollars(SCENARIO.monthlyDeposit), SCENARIO.years);
+    ASSERT_EQ(BALANCES.size(), static_cast<size_t>(SCENARIO.years));
+    for (int year = 1; year <= SCENARIO.years; ++year) {
+      const long double EXPECTED = DepositCalculator::calculateCompoundInterest(
+          SCENARIO.principal, SCENARIO.ratePercent, SCENARIO.monthlyDeposit,
+          year);
+      // Every month rounds by at most half a cent, which then compounds
+      const long double TOLERANCE = 0.005L * 12 * year *
+                                    std::pow(1 + SCENARIO.ratePercent / 1200,
+                                             12.0 * year);
+      EXPECT_NEAR(static_cast<double>(BALANCES[year - 1].toDollars()),
+                  static_cast<double>(EXPECTED),
+                  static_cast<double>(TOLERANCE))
+          << SCENARIO.principal << " at " << SCENARIO.ratePercent
+          << "% after " << year << " years";
+    }
+  }
+}
@@ -0,0 +1,104 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "airgead_investment_planner_cli.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "mini_utils.h"
+
+using airgead_investment_planner_cli::InvestmentPlannerCli;
+using airgead_investment_planner_cli::LoanPlannerCli;
+using airgead_investment_planner_cli::PortfolioPlannerCli;
+
+// Tests a deposit session through the injected streams
+TEST(PlannerCliTest, InvestmentPlanner_ReplaysSession) {
+  std::istringstream input("$1000\n50\n5%\n2\n\n");
+  std::ostringstream output;
+  InvestmentPlannerCli cli;
+  cli.setStreams(input, output);
+  cli.startCli();
+
+  const std::string TEXT = output.str();
+  EXPECT_NE(TEXT.find("Initial Investment Amount (in $): "
+                      "Monthly Deposit (in $): "
+                      "Annual Interest Rate (in %): "
+                      "Investment Term (Years): "
+                      "Press enter to continue...\n"),
+            std::string::npos);
+  // The prompt is blanked, and the tables start on its line
+  EXPECT_NE(TEXT.find("Press enter to continue...\n\x1b[2A\x1b[1G" +
+                      std::string(26, ' ') + "\r+---"),
+            std::string::npos);
+  // 1000 at 5% compounded monthly, without and with $50 deposits
+  EXPECT_NE(TEXT.find("Balance and Interest Without Additional Monthly"),
+            std::string::npos);
+  EXPECT_NE(TEXT.find("| 2        | $1104.94"), std::string::npos);
+  EXPECT_NE(TEXT.find("| 2        | $2369.48"), std::string::npos);
+}
+
+// Tests a loan session that skips the remaining schedule pages
+TEST(PlannerCliTest, LoanPlanner_ReplaysSession) {
+  std::istringstream input("200000\n6\n30\n1\n0\nq\n");
+  std::ostringstream output;
+  LoanPlannerCli cli;
+  cli.setStreams(input, output);
+  cli.startCli();
+
+  const std::string TEXT = output.str();
+  EXPECT_NE(TEXT.find("| 1        | $1199.10      | $199.10       "
+                      "| $1000.00      | $199800.90      |\n"),
+            std::string::npos);
+  EXPECT_EQ(TEXT.find("| 361 "), std::string::npos);
+  EXPECT_NE(TEXT.find("Paid off in 360 months"), std::string::npos);
+}
+
+// Tests a portfolio session comparing the rebalancing policies
+TEST(PlannerCliTest, PortfolioPlanner_ReplaysSession) {
+  std::istringstream input("10000\n100\n3\n2\n8\n60\n2\n40\n5\n");
+  std::ostringstream output;
+  PortfolioPlannerCli cli;
+  cli.setStreams(input, output);
+  cli.startCli();
+
+  const std::string TEXT = output.str();
+  EXPECT_NE(TEXT.find("| Year     | Never      | Monthly    | Quarterly  "
+                      "| Annual     | Threshold  |\n"),
+            std::string::npos);
+  // Annual rebalancing matches never rebalancing until the first year ends
+  EXPECT_NE(TEXT.find("| 1        | $11815.94  | $11811.63  | $11812.43  "
+                      "| $11815.94  | $11815.94  |\n"),
+            std::string::npos);
+  EXPECT_NE(TEXT.find("| Quarterly: rebalanced 12 times"), std::string::npos);
+  EXPECT_NE(TEXT.find("| Threshold: rebalanced 0 times"), std::string::npos);
+
+  // Weights that add up to nothing are reported, not simulated
+  std::istringstream zeroWeights("1000\n0\n1\n1\n5\n0\n5\n");
+  std::ostringstream zeroOutput;
+  cli.setStreams(zeroWeights, zeroOutput);
+  cli.startCli();
+  EXPECT_NE(zeroOutput.str().find(
+                "The target weights must add up to more than 0.\n"),
+            std::string::npos);
+  EXPECT_EQ(zeroOutput.str().find("Year-End Balance"), std::string::npos);
+}
+
+// Tests that the planners stop with InputEndedError when the input ends,
+// instead of prompting on forever
+TEST(PlannerCliTest, EndOfInput_Throws) {
+  std::istringstream depositInput("1000\n50\n");
+  std::ostringstream output;
+  InvestmentPlannerCli depositCli;
+  depositCli.setStreams(depositInput, output);
+  EXPECT_THROW(depositCli.startCli(), mini_utils::InputEndedError);
+  EXPECT_EQ(output.str().substr(output.str().size() - 29),
+            "Annual Interest Rate (in %): ");
+
+  std::istringstream loanInput("200000\nabc\n");
+  LoanPlannerCli loanCli;
+  loanCli.setStreams(loanInput, output);
+  EXPECT_THROW(loanCli.startCli(), mini_utils::InputEndedError);
+}
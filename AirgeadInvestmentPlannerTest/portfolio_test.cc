@@ -0,0 +1,187 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "portfolio.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "deposit_calculator.h"
+
+using airgead_investment_planner_cli::DepositCalculator;
+using airgead_investment_planner_cli::PortfolioAsset;
+using airgead_investment_planner_cli::PortfolioSimulator;
+using airgead_investment_planner_cli::PortfolioTerms;
+using airgead_investment_planner_cli::RebalancePolicy;
+
+namespace {
+const RebalancePolicy ALL_POLICIES[] = {
+    RebalancePolicy::NEVER, RebalancePolicy::MONTHLY,
+    RebalancePolicy::QUARTERLY, RebalancePolicy::ANNUAL,
+    RebalancePolicy::THRESHOLD};
+
+PortfolioTerms makeTerms(const std::vector<PortfolioAsset>& ASSETS,
+                         double initialInvestment, double monthlyContribution,
+                         int years, RebalancePolicy policy,
+                         double driftThresholdPercent = 5) {
+  PortfolioTerms terms;
+  terms.assets = ASSETS;
+  terms.initialInvestment = initialInvestment;
+  terms.monthlyContribution = monthlyContribution;
+  terms.years = years;
+  terms.rebalancePolicy = policy;
+  terms.driftThresholdPercent = driftThresholdPercent;
+  return terms;
+}
+
+// Weight of the asset in the portfolio at the end of its term
+double getFinalWeight(const PortfolioSimulator& SIMULATOR, int portfolio,
+                      int asset) {
+  return SIMULATOR.getFinalAssetBalance(portfolio, asset) /
+         SIMULATOR.getFinalBalance(portfolio);
+}
+}  // namespace
+
+// Tests that a single asset grows like the single-account formula, whatever
+// the policy
+TEST(PortfolioSimulatorTest, Run_SingleAssetMatchesCompoundInterest) {
+  PortfolioSimulator simulator;
+  for (const RebalancePolicy POLICY : ALL_POLICIES) {
+    ASSERT_GE(simulator.addPortfolio(
+                  makeTerms({{7, 1}}, 1000, 50, 30, POLICY, 0)),
+              0);
+  }
+  simulator.run();
+
+  for (int portfolio = 0; portfolio < simulator.size(); ++portfolio) {
+    for (int year = 1; year <= 30; ++year) {
+      const double EXPECTED = static_cast<double>(
+          DepositCalculator::calculateCompoundInterest(1000, 7, 50, year));
+      EXPECT_NEAR(simulator.getYearEndBalance(portfolio, year), EXPECTED,
+                  EXPECTED * 1e-12)
+          << "portfolio " << portfolio << ", year " << year;
+    }
+    // One asset never drifts from a weight of 1
+    EXPECT_EQ(simulator.getRebalanceCount(portfolio),
+              portfolio == 1 ? 360 : portfolio == 2 ? 120
+                                 : portfolio == 3 ? 30
+                                                  : 0);
+  }
+}
+
+// Tests that scheduled policies bring drifted assets back to their targets
+// at the end of every period, and that NEVER lets them drift
+TEST(PortfolioSimulatorTest, Run_ScheduledPoliciesRestoreTargetWeights) {
+  PortfolioSimulator simulator;
+  const std::vector<PortfolioAsset> ASSETS = {{12, 60}, {0, 40}};
+  for (const RebalancePolicy POLICY :
+       {RebalancePolicy::NEVER, RebalancePolicy::MONTHLY,
+        RebalancePolicy::QUARTERLY, RebalancePolicy::ANNUAL}) {
+    simulator.addPortfolio(makeTerms(ASSETS, 10000, 100, 3, POLICY));
+  }
+  simulator.run();
+
+  EXPECT_GT(getFinalWeight(simulator, 0, 0), 0.65);
+  EXPECT_EQ(simulator.getRebalanceCount(0), 0);
+  // 36 months end a month, a quarter and a year alike
+  for (int portfolio = 1; portfolio <= 3; ++portfolio) {
+    EXPECT_NEAR(getFinalWeight(simulator, portfolio, 0), 0.6, 1e-12);
+    EXPECT_NEAR(getFinalWeight(simulator, portfolio, 1), 0.4, 1e-12);
+  }
+  EXPECT_EQ(simulator.getRebalanceCount(1), 36);
+  EXPECT_EQ(simulator.getRebalanceCount(2), 12);
+  EXPECT_EQ(simulator.getRebalanceCount(3), 3);
+
+  // Moving money from the faster asset earlier loses growth
+  EXPECT_GT(simulator.getFinalBalance(0), simulator.getFinalBalance(3));
+  EXPECT_GT(simulator.getFinalBalance(3), simulator.getFinalBalance(2));
+  EXPECT_GT(simulator.getFinalBalance(2), simulator.getFinalBalance(1));
+}
+
+// Tests that THRESHOLD rebalances only once an asset drifts past the band
+TEST(PortfolioSimulatorTest, Run_ThresholdRebalancesOutsideTheBand) {
+  // At 1% a month against 0%, the faster asset of a 50/50 portfolio passes
+  // a 55% weight at the end of month 21, since 1.01^21 / (1.01^21 + 1) is
+  // above 0.55 and 1.01^20 / (1.01^20 + 1) is not
+  const std::vector<PortfolioAsset> ASSETS = {{12, 1}, {0, 1}};
+  PortfolioSimulator simulator;
+  simulator.addPortfolio(
+      makeTerms(ASSETS, 1000, 0, 1, RebalancePolicy::THRESHOLD, 5));
+  simulator.addPortfolio(
+      makeTerms(ASSETS, 1000, 0, 2, RebalancePolicy::THRESHOLD, 5));
+  simulator.addPortfolio(
+      makeTerms(ASSETS, 1000, 0, 2, RebalancePolicy::THRESHOLD, 0));
+  simulator.addPortfolio(
+      makeTerms(ASSETS, 1000, 0, 2, RebalancePolicy::THRESHOLD, 50));
+  simulator.run();
+
+  // Drifted inside the band after a year
+  EXPECT_EQ(simulator.getRebalanceCount(0), 0);
+  EXPECT_GT(getFinalWeight(simulator, 0, 0), 0.52);
+  EXPECT_LT(getFinalWeight(simulator, 0, 0), 0.55);
+
+  // Rebalanced once at month 21, then three months of drift again
+  EXPECT_EQ(simulator.getRebalanceCount(1), 1);
+  EXPECT_NEAR(simulator.getYearEndBalance(1, 1),
+              simulator.getYearEndBalance(0, 1), 1e-9);
+  EXPECT_GT(getFinalWeight(simulator, 1, 0), 0.5);
+  EXPECT_LT(getFinalWeight(simulator, 1, 0), 0.51);
+
+  // No band rebalances every month with any drift, a wide one never
+  EXPECT_EQ(simulator.getRebalanceCount(2), 24);
+  EXPECT_NEAR(getFinalWeight(simulator, 2, 0), 0.5, 1e-12);
+  EXPECT_EQ(simulator.getRebalanceCount(3), 0);
+}
+
+// Tests that zero-weight assets get nothing and change nothing, also as
+// padding slots of portfolios with fewer assets than others
+TEST(PortfolioSimulatorTest, Run_ZeroWeightAssets) {
+  PortfolioSimulator simulator;
+  simulator.addPortfolio(makeTerms({{5, 1}, {50, 0}, {9, 1}}, 1000, 10, 5,
+                                   RebalancePolicy::MONTHLY));
+  simulator.addPortfolio(
+      makeTerms({{5, 1}, {9, 1}}, 1000, 10, 5, RebalancePolicy::MONTHLY));
+  simulator.addPortfolio(
+      makeTerms({{5, 1}}, 1000, 10, 5, RebalancePolicy::THRESHOLD, 0));
+  simulator.run();
+
+  EXPECT_EQ(simulator.getFinalAssetBalance(0, 1), 0);
+  EXPECT_NEAR(simulator.getFinalBalance(0), simulator.getFinalBalance(1),
+              1e-9);
+  EXPECT_EQ(simulator.getRebalanceCount(0), simulator.getRebalanceCount(1));
+
+  // The single-asset portfolio got two padding slots
+  EXPECT_EQ(simulator.getFinalAssetBalance(2, 1), 0);
+  EXPECT_EQ(simulator.getFinalAssetBalance(2, 2), 0);
+  EXPECT_EQ(simulator.getRebalanceCount(2), 0);
+  EXPECT_NEAR(simulator.getFinalBalance(2),
+              static_cast<double>(
+                  DepositCalculator::calculateCompoundInterest(1000, 5, 10, 5)),
+              1e-9);
+}
+
+// Tests that terms out of the supported range are rejected
+TEST(PortfolioSimulatorTest, AddPortfolio_RejectsInvalidTerms) {
+  PortfolioSimulator simulator;
+  const RebalancePolicy POLICY = RebalancePolicy::ANNUAL;
+  EXPECT_EQ(simulator.addPortfolio(makeTerms({}, 1000, 0, 5, POLICY)), -1);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms({{5, 0}, {6, 0}}, 1000, 0, 5,
+                                             POLICY)),
+            -1);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms({{5, 2}, {6, -1}}, 1000, 0, 5,
+                                             POLICY)),
+            -1);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms({{5, 1}}, 1000, 0, 0, POLICY)),
+            -1);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms(
+                {{5, 1}}, 1000, 0, PortfolioSimulator::MAX_PORTFOLIO_YEARS + 1,
+                POLICY)),
+            -1);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms({{5, 1}}, -1, 0, 5, POLICY)), -1);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms(
+                {{5, 1}}, 1000, 0, 5, RebalancePolicy::THRESHOLD, -1)),
+            -1);
+  EXPECT_EQ(simulator.size(), 0);
+  EXPECT_EQ(simulator.addPortfolio(makeTerms({{5, 1}}, 0, 0, 5, POLICY)), 0);
+}
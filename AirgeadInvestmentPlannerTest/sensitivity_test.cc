@@ -0,0 +1,159 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "sensitivity.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "deposit_calculator.h"
+
+using airgead_investment_planner_cli::DepositCalculator;
+using airgead_investment_planner_cli::SensitivityAnalysis;
+using airgead_investment_planner_cli::SensitivityGrid;
+
+namespace {
+// 20 rates, 10 terms out of order and 5 deposits, the CLI's largest grid
+SensitivityGrid makeLargeGrid() {
+  SensitivityGrid grid;
+  grid.principal = 2500;
+  for (int i = 0; i < 20; ++i) {
+    grid.annualRatesPercent.push_back(0.5 * i);
+  }
+  grid.years = {30, 1, 250, 10, 5, 20, 40, 2, 100, 15};
+  grid.monthlyDeposits = {0, 25, 100, 250.5, 1000};
+  return grid;
+}
+
+// Longest line of the text, not counting color escapes
+size_t getWidestLine(const std::string& TEXT) {
+  size_t widest = 0;
+  std::istringstream lines(TEXT);
+  std::string line;
+  while (std::getline(lines, line)) {
+    size_t width = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+      if (line[i] == '\x1b') {
+        i = line.find('m', i);
+      } else {
+        ++width;
+      }
+    }
+    widest = std::max(widest, width);
+  }
+  return widest;
+}
+}  // namespace
+
+// Tests that a single cell is the single-account balance
+TEST(SensitivityAnalysisTest, Run_SingleCellMatchesCompoundInterest) {
+  for (const double RATE : {0.01, 3.25, 7.0, 100.0}) {
+    for (const int YEARS : {1, 12, 250}) {
+      SensitivityAnalysis analysis;
+      ASSERT_TRUE(analysis.run({1000, {RATE}, {YEARS}, {75}}));
+      const double EXPECTED = static_cast<double>(
+          DepositCalculator::calculateCompoundInterest(1000, RATE, 75, YEARS));
+      EXPECT_NEAR(analysis.getBalance(0, 0, 0), EXPECTED,
+                  std::fabs(EXPECTED) * 1e-12)
+          << RATE << "% over " << YEARS << " years";
+    }
+  }
+
+  // The closed form needs a rate; without one the deposits just add up
+  SensitivityAnalysis analysis;
+  ASSERT_TRUE(analysis.run({1000, {0}, {12}, {75}}));
+  EXPECT_EQ(analysis.getBalance(0, 0, 0), 1000 + 12 * 12 * 75);
+}
+
+// Tests that every cell of a large grid comes out the same on any number
+// of threads, and matches the single-account balance
+TEST(SensitivityAnalysisTest, Run_IndependentOfThreadCount) {
+  const SensitivityGrid GRID = makeLargeGrid();
+  SensitivityAnalysis single;
+  ASSERT_TRUE(single.run(GRID, 1));
+
+  for (const int THREADS : {0, 2, 3, 64}) {
+    SensitivityAnalysis threaded;
+    ASSERT_TRUE(threaded.run(GRID, THREADS));
+    for (size_t rate = 0; rate < GRID.annualRatesPercent.size(); ++rate) {
+      for (size_t term = 0; term < GRID.years.size(); ++term) {
+        for (size_t deposit = 0; deposit < GRID.monthlyDeposits.size();
+             ++deposit) {
+          EXPECT_EQ(threaded.getBalance(rate, term, deposit),
+                    single.getBalance(rate, term, deposit))
+              << THREADS << " threads";
+        }
+      }
+    }
+  }
+
+  const double EXPECTED = static_cast<double>(
+      DepositCalculator::calculateCompoundInterest(2500, 6, 250.5, 40));
+  EXPECT_NEAR(single.getBalance(12, 6, 3), EXPECTED, EXPECTED * 1e-12);
+}
+
+// Tests that grids with an empty axis or values out of range are rejected
+TEST(SensitivityAnalysisTest, Run_RejectsInvalidGrids) {
+  const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+  const SensitivityGrid VALID = {1000, {5}, {10}, {100}};
+  SensitivityAnalysis analysis;
+  ASSERT_TRUE(analysis.run(VALID));
+
+  std::vector<SensitivityGrid> invalidGrids(10, VALID);
+  invalidGrids[0].annualRatesPercent.clear();
+  invalidGrids[1].years.clear();
+  invalidGrids[2].monthlyDeposits.clear();
+  invalidGrids[3].principal = -1;
+  invalidGrids[4].principal = NOT_A_NUMBER;
+  invalidGrids[5].annualRatesPercent = {5, -0.5};
+  invalidGrids[6].monthlyDeposits = {NOT_A_NUMBER};
+  invalidGrids[7].years = {SensitivityAnalysis::MIN_YEARS - 1};
+  invalidGrids[8].years = {10, SensitivityAnalysis::MAX_YEARS + 1};
+  invalidGrids[9].monthlyDeposits = {100, -100};
+  for (size_t i = 0; i < invalidGrids.size(); ++i) {
+    EXPECT_FALSE(analysis.run(invalidGrids[i])) << "grid " << i;
+  }
+
+  // A rejected grid keeps the last results
+  EXPECT_EQ(analysis.getGrid().years, std::vector<int>{10});
+  EXPECT_GT(analysis.getBalance(0, 0, 0), 1000);
+}
+
+// Tests that matrices wider than the console continue below, with every
+// term shown once
+TEST(SensitivityAnalysisTest, Render_PagesColumnsToFitWidth) {
+  SensitivityAnalysis analysis;
+  ASSERT_TRUE(analysis.run(makeLargeGrid()));
+
+  for (const int WIDTH : {40, 80, 200}) {
+    const std::string TABLE = analysis.renderTable(4, WIDTH);
+    const std::string HEATMAP = analysis.renderHeatmap(4, WIDTH);
+    EXPECT_LE(getWidestLine(TABLE), static_cast<size_t>(WIDTH));
+    EXPECT_LE(getWidestLine(HEATMAP), static_cast<size_t>(WIDTH));
+    for (const int YEARS : makeLargeGrid().years) {
+      const std::string HEADER = " " + std::to_string(YEARS) + " years ";
+      EXPECT_NE(TABLE.find(HEADER), std::string::npos) << YEARS;
+      EXPECT_EQ(TABLE.find(HEADER), TABLE.rfind(HEADER)) << YEARS;
+    }
+  }
+
+  // Every page repeats the rates; a wide console needs fewer pages
+  const auto COUNT_RATE_HEADERS = [](const std::string& TABLE) {
+    size_t count = 0;
+    for (size_t i = TABLE.find("| Rate "); i != std::string::npos;
+         i = TABLE.find("| Rate ", i + 1)) {
+      ++count;
+    }
+    return count;
+  };
+  EXPECT_GT(COUNT_RATE_HEADERS(analysis.renderTable(4, 80)),
+            COUNT_RATE_HEADERS(analysis.renderTable(4, 200)));
+
+  // Too narrow for even one term still shows one term per page
+  EXPECT_EQ(COUNT_RATE_HEADERS(analysis.renderTable(4, 1)), 10u);
+}
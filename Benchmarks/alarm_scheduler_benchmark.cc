@@ -0,0 +1,78 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "alarm_scheduler.h"
+#include "benchmark.h"
+#include "clock.h"
+
+namespace benchmarks {
+namespace {
+using clock_cli::AlarmId;
+using clock_cli::AlarmScheduler;
+
+const int kPendingAlarms = 10000000;
+const int kCancels = 1000000;
+// Alarms are spread over a month, as a cron-like service would see them
+const long long kHorizonSeconds = 30LL * clock_cli::SECONDS_PER_DAY;
+
+std::vector<long long> MakeDelays() {
+  std::mt19937 random(42);
+  std::uniform_int_distribution<long long> delay(1, kHorizonSeconds);
+  std::vector<long long> delays(kPendingAlarms);
+  for (long long& value : delays) {
+    value = delay(random);
+  }
+  return delays;
+}
+}  // namespace
+
+void RunAlarmSchedulerBenchmarks() {
+  const std::vector<long long> delays = MakeDelays();
+  long long fired = 0;
+  AlarmScheduler scheduler([&fired](AlarmId) { ++fired; });
+  scheduler.reserve(kPendingAlarms);
+
+  std::vector<AlarmId> ids(kPendingAlarms);
+  Report("schedule, 10M pending", Measure(kPendingAlarms, [&] {
+           for (int i = 0; i < kPendingAlarms; ++i) {
+             ids[i] = scheduler.schedule(delays[i]);
+           }
+         }));
+  Report("cancel, every 10th", Measure(kCancels, [&] {
+           for (int i = 0; i < kPendingAlarms; i += 10) {
+             scheduler.cancel(ids[i]);
+           }
+         }));
+
+  // Clock::addOneSecond, as the live clock ticks, for a month
+  clock_cli::Clock clock;
+  clock.setAlarmScheduler(&scheduler);
+  const long long pending = static_cast<long long>(scheduler.size());
+  Report("expire by addOneSecond, per alarm", Measure(pending, [&] {
+           for (long long second = 0; second < kHorizonSeconds; ++second) {
+             clock.addOneSecond();
+           }
+         }));
+  std::cout << "  (" << fired << " fired over " << kHorizonSeconds
+            << " ticks)" << std::endl;
+
+  // Ticks with alarms pending far away only look at the occupancy bitmaps
+  scheduler.schedule(AlarmScheduler::MAX_DELAY_SECONDS);
+  Report("addOneSecond, nothing due", Measure(kHorizonSeconds, [&] {
+           for (long long second = 0; second < kHorizonSeconds; ++second) {
+             clock.addOneSecond();
+           }
+         }));
+
+  // The same month in a single jump
+  for (int i = 0; i < kPendingAlarms; ++i) {
+    scheduler.schedule(delays[i]);
+  }
+  fired = 0;
+  Report("expire by one addSeconds jump, per alarm",
+         Measure(kPendingAlarms, [&] { clock.addSeconds(kHorizonSeconds); }));
+  std::cout << "  (" << fired << " fired)" << std::endl;
+}
+
+}  // namespace benchmarks
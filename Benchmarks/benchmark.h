@@ -0,0 +1,67 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "allocation_counter.h"
+
+namespace benchmarks {
+
+// Wall time and heap allocations of a measured run and the number of
+// operations it performed
+struct Measurement {
+  double seconds = 0;
+  long long operations = 0;
+  long long allocations = 0;
+};
+
+// Runs the body once and measures its wall time. The body performs
+// `operations` units of work, used to derive per-operation cost.
+template <typename Body>
+Measurement Measure(long long operations, Body body) {
+  const long long allocations_before = mini_utils::getAllocationCount();
+  const auto start = std::chrono::steady_clock::now();
+  body();
+  const auto end = std::chrono::steady_clock::now();
+  return {std::chrono::duration<double>(end - start).count(), operations,
+          mini_utils::getAllocationCount() - allocations_before};
+}
+
+// Prints a single benchmark line: name, nanoseconds per op, ops per second
+// and heap allocations per op
+inline void Report(const std::string& name, const Measurement& measurement) {
+  const double ops = static_cast<double>(measurement.operations);
+  std::cout << "  " << std::left << std::setw(48) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(12)
+            << measurement.seconds * 1e9 / ops << " ns/op" << std::setw(14)
+            << std::setprecision(0) << ops / measurement.seconds << " op/s"
+            << std::setprecision(2) << std::setw(10)
+            << measurement.allocations / ops << " allocs/op" << std::endl;
+}
+
+// Benchmark suites, one per benchmarked module
+void RunDepositCalculatorBenchmarks();
+void RunTableFormatterBenchmarks();
+void RunStringFormatterBenchmarks();
+void RunClockBenchmarks();
+void RunInputParsingBenchmarks();
+void RunReplayBenchmarks();
+void RunItemSearchBenchmarks();
+void RunWindowedCounterBenchmarks();
+void RunStringPoolBenchmarks();
+void RunMemoryResourceBenchmarks();
+void RunWordCountBenchmarks();
+void RunHyperLogLogBenchmarks();
+void RunQueryServerBenchmarks();
+void RunFrequencyDiffBenchmarks();
+void RunFrozenItemTableBenchmarks();
+void RunPortfolioBenchmarks();
+void RunSensitivityBenchmarks();
+void RunAlarmSchedulerBenchmarks();
+void RunCoOccurrenceBenchmarks();
+
+}  // namespace benchmarks
+#endif  // BENCHMARK_H
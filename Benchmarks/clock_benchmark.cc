@@ -0,0 +1,226 @@
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "clock.h"
+#include "time_format.h"
+#include "time_zone.h"
+
+namespace benchmarks {
+namespace {
+using clock_cli::Clock;
+using clock_cli::SECONDS_PER_DAY;
+using clock_cli::SECONDS_PER_HOUR;
+using clock_cli::SECONDS_PER_MINUTE;
+using clock_cli::TimeZone;
+
+const int kOffsets = 10000000;
+const long long kMaxOffset = 10LL * SECONDS_PER_DAY;
+
+const int kConversions = 10000000;
+const char* const kZoneNames[] = {"Europe/Berlin", "America/New_York",
+                                  "Asia/Tokyo", "Australia/Sydney",
+                                  "America/Sao_Paulo"};
+const long long kYear2100 = 4102444800LL;  // Last precomputed transitions
+
+const int kFormatDays = 20;  // Every second of the day, this many times
+
+// The representation Clock used before: three fields with carries, advanced
+// only by the +1 hour, minute and second steps the menu offers
+class CarryClock {
+ public:
+  // Adds the duration as the equivalent number of unit steps
+  void AddDuration(long long seconds) {
+    long long forward = seconds % SECONDS_PER_DAY;
+    if (forward < 0) {
+      forward += SECONDS_PER_DAY;  // Going back is going forward around a day
+    }
+    for (long long i = forward / SECONDS_PER_HOUR; i > 0; --i) {
+      ++hours_;
+      AdjustTime();
+    }
+    for (long long i = forward / SECONDS_PER_MINUTE % 60; i > 0; --i) {
+      ++minutes_;
+      AdjustTime();
+    }
+    for (long long i = forward % SECONDS_PER_MINUTE; i > 0; --i) {
+      ++seconds_;
+      AdjustTime();
+    }
+  }
+
+  int GetSecondsOfDay() const {
+    return hours_ * SECONDS_PER_HOUR + minutes_ * SECONDS_PER_MINUTE +
+           seconds_;
+  }
+
+ private:
+  unsigned short hours_ = 0;
+  unsigned short minutes_ = 0;
+  unsigned short seconds_ = 0;
+
+  void AdjustTime() {
+    auto adjust_unit = [](unsigned short& unit, unsigned short max_limit) {
+      if (unit >= max_limit) {
+        unsigned short overflow = unit / max_limit;
+        unit %= max_limit;
+        return overflow;
+      }
+      return static_cast<unsigned short>(0);
+    };
+    minutes_ += adjust_unit(seconds_, 60);
+    hours_ += adjust_unit(minutes_, 60);
+    adjust_unit(hours_, 24);
+  }
+};
+
+// The way Clock::formatTime rendered a time before the formatting kernels
+std::string FormatWithStream(int seconds_of_day) {
+  std::ostringstream oss;
+  oss << std::setfill('0') << std::setw(2) << seconds_of_day / 3600 << ":"
+      << std::setw(2) << seconds_of_day / 60 % 60 << ":" << std::setw(2)
+      << seconds_of_day % 60;
+  return oss.str();
+}
+
+void RunFormattingBenchmarks() {
+  std::vector<int> day(SECONDS_PER_DAY);
+  for (int i = 0; i < SECONDS_PER_DAY; ++i) {
+    day[i] = i;
+  }
+  const long long times = static_cast<long long>(kFormatDays) * day.size();
+  std::string log;
+  log.reserve(times * (clock_cli::TIME_24_HOURS_LENGTH + 1));
+
+  Report("hh:mm:ss, ostringstream per time", Measure(times, [&] {
+           for (int i = 0; i < kFormatDays; ++i) {
+             for (const int second : day) {
+               log += FormatWithStream(second);
+               log += '\n';
+             }
+           }
+         }));
+  const std::string stream_log = log;
+
+  log.clear();
+  Report("hh:mm:ss, formatTime24Hours kernel", Measure(times, [&] {
+           char buffer[clock_cli::TIME_24_HOURS_LENGTH];
+           for (int i = 0; i < kFormatDays; ++i) {
+             for (const int second : day) {
+               clock_cli::formatTime24Hours(second, buffer);
+               log.append(buffer, sizeof(buffer));
+               log += '\n';
+             }
+           }
+         }));
+
+  log.clear();
+  Report("hh:mm:ss, appendTimes24Hours batch", Measure(times, [&] {
+           for (int i = 0; i < kFormatDays; ++i) {
+             clock_cli::appendTimes24Hours(log, day);
+           }
+         }));
+
+  int parsed = 0;
+  long long checksum = 0;
+  Report("hh:mm:ss, parseTime24Hours kernel", Measure(times, [&] {
+           const char* line = log.data();
+           for (long long i = 0; i < times; ++i) {
+             clock_cli::parseTime24Hours(
+                 {line, clock_cli::TIME_24_HOURS_LENGTH}, parsed);
+             checksum += parsed;
+             line += clock_cli::TIME_24_HOURS_LENGTH + 1;
+           }
+         }));
+  std::cout << "  (" << (log == stream_log ? "outputs match" : "OUTPUTS DIFFER")
+            << ", checksum " << checksum << ")" << std::endl;
+}
+}  // namespace
+
+void RunClockBenchmarks() {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<long long> offset(-kMaxOffset, kMaxOffset);
+  std::vector<long long> offsets(kOffsets);
+  for (long long& value : offsets) {
+    value = offset(random);
+  }
+
+  CarryClock carry_clock;
+  Report("carry-based unit steps, per offset", Measure(kOffsets, [&] {
+           for (const long long value : offsets) {
+             carry_clock.AddDuration(value);
+           }
+         }));
+
+  Clock clock;
+  Report("seconds of day addSeconds, per offset", Measure(kOffsets, [&] {
+           for (const long long value : offsets) {
+             clock.addSeconds(value);
+           }
+         }));
+
+  Clock bulk_clock;
+  Report("seconds of day addDurations, bulk", Measure(kOffsets, [&] {
+           bulk_clock.addDurations(offsets);
+         }));
+
+  const bool is_consistent =
+      carry_clock.GetSecondsOfDay() == clock.getSecondsOfDay() &&
+      clock.getSecondsOfDay() == bulk_clock.getSecondsOfDay();
+  std::cout << "  (final time " << clock.getSecondsOfDay() << " s, "
+            << (is_consistent ? "all paths agree" : "PATHS DISAGREE") << ")"
+            << std::endl;
+
+  RunFormattingBenchmarks();
+
+  std::vector<TimeZone> zones;
+  for (const char* name : kZoneNames) {
+    TimeZone zone;
+    if (TimeZone::load(name, zone)) {
+      zones.push_back(std::move(zone));
+    }
+  }
+  if (zones.empty()) {
+    std::cout << "  (no tzdata in " << clock_cli::ZONEINFO_DIRECTORY
+              << ", skipping time zone conversions)" << std::endl;
+    return;
+  }
+
+  // Random instants from 1970 to 2100, each converted in every zone
+  std::uniform_int_distribution<long long> instant(0, kYear2100);
+  std::vector<long long> instants(kConversions / zones.size());
+  for (long long& value : instants) {
+    value = instant(random);
+  }
+  const long long conversions =
+      static_cast<long long>(instants.size() * zones.size());
+  long long checksum = 0;
+
+  Report("time zones, random instants, binary search",
+         Measure(conversions, [&] {
+           for (const long long value : instants) {
+             for (const TimeZone& zone : zones) {
+               checksum += zone.getUtcOffset(value);
+             }
+           }
+         }));
+
+  // A running clock: consecutive seconds mostly share the cached interval
+  const long long kStart = 1700000000;
+  Report("time zones, consecutive seconds, cached offset",
+         Measure(conversions, [&] {
+           for (size_t i = 0; i < instants.size(); ++i) {
+             for (TimeZone& zone : zones) {
+               checksum += zone.getUtcOffsetCached(kStart + i);
+             }
+           }
+         }));
+  std::cout << "  (" << zones.size() << " zones, checksum " << checksum << ")"
+            << std::endl;
+}
+
+}  // namespace benchmarks
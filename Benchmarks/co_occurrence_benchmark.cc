@@ -0,0 +1,107 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "co_occurrence_counter.h"
+
+namespace benchmarks {
+namespace {
+const int kSessions = 500000;
+const int kCatalog = 20000;
+const int kMaxItemsPerSession = 12;
+
+// Baskets of 1 to 12 products with Zipf-like popularity, a blank line
+// after each
+std::string MakeSessions() {
+  std::mt19937 random(42);
+  std::geometric_distribution<int> rank(0.002);
+  std::uniform_int_distribution<int> items_per_session(1,
+                                                       kMaxItemsPerSession);
+  std::string text;
+  for (int session = 0; session < kSessions; ++session) {
+    for (int i = items_per_session(random); i > 0; --i) {
+      text += "product-";
+      text += std::to_string(rank(random) % kCatalog);
+      text += '\n';
+    }
+    text += '\n';
+  }
+  return text;
+}
+}  // namespace
+
+void RunCoOccurrenceBenchmarks() {
+  const std::string text = MakeSessions();
+
+  // Straightforward version: a map keyed by both names joined
+  long long pairs = 0;
+  size_t map_pairs = 0;
+  Report("unordered_map<string, int>, per session",
+         Measure(kSessions, [&] {
+           std::unordered_map<std::string, int> counts;
+           std::vector<std::string> session;
+           std::istringstream input(text);
+           std::string line;
+           const auto count_session = [&] {
+             for (size_t first = 0; first < session.size(); ++first) {
+               for (size_t second = 0; second < session.size(); ++second) {
+                 if (session[first] < session[second]) {
+                   ++counts[session[first] + '\t' + session[second]];
+                   ++pairs;
+                 }
+               }
+             }
+             session.clear();
+           };
+           while (std::getline(input, line)) {
+             if (line.empty()) {
+               count_session();
+             } else {
+               session.push_back(line);
+             }
+           }
+           count_session();
+           map_pairs = counts.size();
+         }));
+
+  // One thread, then one per hardware thread if there are more
+  std::vector<int> thread_counts = {1};
+  if (std::thread::hardware_concurrency() > 1) {
+    thread_counts.push_back(
+        static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  for (int threads : thread_counts) {
+    item_tracker::CoOccurrenceCounter counter(threads);
+    Report("CoOccurrenceCounter, " + std::to_string(threads) +
+               " threads, per session",
+           Measure(kSessions, [&] {
+             std::istringstream input(text);
+             counter.ImportSessionsFromStream(input);
+           }));
+    std::cout << "  (" << counter.GetPairCount() << " pairs, "
+              << map_pairs << " in the map)" << std::endl;
+  }
+
+  item_tracker::CoOccurrenceCounter counter;
+  std::istringstream input(text);
+  counter.ImportSessionsFromStream(input);
+  const int lookups = static_cast<int>(counter.GetItemCount());
+  long long checksum = 0;
+  Report("GetTopPartners(10)", Measure(lookups, [&] {
+           for (uint32_t id = 0; id < counter.GetItemCount(); ++id) {
+             for (const item_tracker::Partner& partner :
+                  counter.GetTopPartners(id, 10)) {
+               checksum += partner.frequency;
+             }
+           }
+         }));
+  std::cout << "  (" << pairs << " pairs counted, checksum " << checksum
+            << ")" << std::endl;
+}
+
+}  // namespace benchmarks
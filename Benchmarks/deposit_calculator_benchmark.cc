@@ -0,0 +1,75 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "airgead_investment_planner_cli.h"
+#include "benchmark.h"
+
+namespace benchmarks {
+namespace {
+using airgead_investment_planner_cli::DepositCalculator;
+using airgead_investment_planner_cli::GrowthFactorCache;
+using airgead_investment_planner_cli::Money;
+using airgead_investment_planner_cli::PercentRate;
+
+const int kYears = 250;  // Longest supported investment term
+const int kRuns = 2000;
+const double kPrincipal = 1000;
+const double kMonthlyDeposit = 50;
+const double kAnnualRate = 5;
+
+// Year-end balances the way InvestmentPlannerCli::getTable computes them
+long double FloatingPointTable() {
+  long double checksum = 0;
+  for (int year = 1; year <= kYears; ++year) {
+    checksum += DepositCalculator::calculateCompoundInterest(
+        kPrincipal, kAnnualRate, kMonthlyDeposit, year);
+  }
+  return checksum;
+}
+
+long double FixedPointTable() {
+  const std::vector<Money> balances =
+      DepositCalculator::calculateYearEndBalancesExact(
+          Money::fromDollars(kPrincipal), PercentRate::fromPercent(kAnnualRate),
+          Money::fromDollars(kMonthlyDeposit), kYears);
+  return balances.back().toDollars();
+}
+}  // namespace
+
+void RunDepositCalculatorBenchmarks() {
+  GrowthFactorCache& cache = GrowthFactorCache::shared();
+  long double checksum = 0;
+  const long long kTableRows = static_cast<long long>(kRuns) * kYears;
+
+  Report("floating point, cold growth cache", Measure(kTableRows, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             cache.clear();
+             checksum += FloatingPointTable();
+           }
+         }));
+
+  cache.resetStats();
+  Report("floating point, warm growth cache", Measure(kTableRows, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             checksum += FloatingPointTable();
+           }
+         }));
+  std::cout << "  growth cache hit rate: " << cache.getStats().hitRate() * 100
+            << "%" << std::endl;
+
+  Report("fixed point, banker's rounding monthly", Measure(kTableRows, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             checksum += FixedPointTable();
+           }
+         }));
+
+  // Drift of the floating path against exact per-month rounding
+  const long double kFloating = DepositCalculator::calculateCompoundInterest(
+      kPrincipal, kAnnualRate, kMonthlyDeposit, kYears);
+  std::cout << std::setprecision(2) << "  divergence after " << kYears
+            << " years: $" << std::fabs(kFloating - FixedPointTable())
+            << " (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
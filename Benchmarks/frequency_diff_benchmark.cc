@@ -0,0 +1,92 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "frequency_diff.h"
+#include "item_tracker.h"
+
+namespace benchmarks {
+namespace {
+const int kDistinctItems = 500000;
+const int kLines = 2000000;
+}  // namespace
+
+void RunFrequencyDiffBenchmarks() {
+  // Today drops a tenth of yesterday's items and adds as many new ones
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> item(0, kDistinctItems - 1);
+  std::string yesterday_lines;
+  std::string today_lines;
+  for (int i = 0; i < kLines; ++i) {
+    yesterday_lines += "item " + std::to_string(item(random)) + "\n";
+    const int shifted_item = item(random) + kDistinctItems / 10;
+    today_lines += "item " + std::to_string(shifted_item) + "\n";
+  }
+  item_tracker::ItemTracker yesterday;
+  item_tracker::ItemTracker today;
+  std::istringstream yesterday_input(yesterday_lines);
+  std::istringstream today_input(today_lines);
+  yesterday.ImportFromStream(yesterday_input);
+  today.ImportFromStream(today_input);
+
+  std::ostringstream snapshot_output;
+  std::ostringstream sorted_yesterday_output;
+  std::ostringstream sorted_today_output;
+  yesterday.ExportToStream(snapshot_output);
+  yesterday.ExportToStream(sorted_yesterday_output, true);
+  today.ExportToStream(sorted_today_output, true);
+  const std::string snapshot = snapshot_output.str();
+  const std::string sorted_yesterday = sorted_yesterday_output.str();
+  const std::string sorted_today = sorted_today_output.str();
+  const long long items =
+      static_cast<long long>(yesterday.GetItemCount() + today.GetItemCount());
+  std::cout << "  (operations are items of both tables)" << std::endl;
+
+  // What diffing the exported files amounted to: both parsed into maps
+  const auto load = [](const std::string& text,
+                       std::unordered_map<std::string, int>& table) {
+    std::istringstream input(text);
+    std::string line;
+    while (getline(input, line)) {
+      const size_t separator = line.rfind(' ');
+      table[line.substr(0, separator)] = std::stoi(line.substr(separator + 1));
+    }
+  };
+  size_t changed = 0;
+  Report("both snapshots into string maps", Measure(items, [&] {
+           std::unordered_map<std::string, int> before;
+           std::unordered_map<std::string, int> after;
+           load(snapshot, before);
+           load(sorted_today, after);
+           for (const auto& entry : after) {
+             auto found = before.find(entry.first);
+             changed += found == before.end() || found->second != entry.second;
+           }
+           for (const auto& entry : before) {
+             changed += after.count(entry.first) == 0;
+           }
+         }));
+
+  item_tracker::FrequencyDiff diff;
+  Report("Compare(tracker, tracker)", Measure(items, [&] {
+           diff.Compare(yesterday, today);
+         }));
+  Report("Compare(snapshot, tracker)", Measure(items, [&] {
+           std::istringstream before(snapshot);
+           diff.Compare(before, today);
+         }));
+  Report("CompareSorted(snapshot, snapshot)", Measure(items, [&] {
+           std::istringstream before(sorted_yesterday);
+           std::istringstream after(sorted_today);
+           diff.CompareSorted(before, after);
+         }));
+  std::cout << "  (" << diff.GetDeltas().size() << " changed, "
+            << diff.GetNewCount() << " new, " << diff.GetVanishedCount()
+            << " vanished; maps found " << changed << ")" << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "counting_resource.h"
+#include "frozen_item_table.h"
+#include "item_tracker.h"
+
+namespace benchmarks {
+namespace {
+// About 16 MB of text
+const size_t kTextBytes = 16 << 20;
+const int kVocabulary = 50000;
+const int kMaxWordsPerLine = 16;
+const int kLookups = 1000000;
+
+// Words of 2 to 10 letters with Zipf-like popularity, split into lines
+std::string MakeText() {
+  std::mt19937 random(42);
+  std::vector<std::string> vocabulary;
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<int> length(2, 10);
+  for (int i = 0; i < kVocabulary; ++i) {
+    std::string word(length(random), ' ');
+    for (char& c : word) {
+      c = static_cast<char>(letter(random));
+    }
+    vocabulary.push_back(word);
+  }
+
+  std::geometric_distribution<int> rank(0.001);
+  std::uniform_int_distribution<int> words_per_line(1, kMaxWordsPerLine);
+  std::string text;
+  text.reserve(kTextBytes + 256);
+  while (text.size() < kTextBytes) {
+    for (int i = words_per_line(random); i > 0; --i) {
+      text += vocabulary[rank(random) % kVocabulary];
+      text += ' ';
+    }
+    text.back() = '\n';
+  }
+  return text;
+}
+
+void ReportMemory(const std::string& name, size_t bytes, size_t items) {
+  std::cout << "  " << name << ": " << bytes / 1024 << " KB, "
+            << static_cast<double>(bytes) / items << " bytes/item"
+            << std::endl;
+}
+}  // namespace
+
+void RunFrozenItemTableBenchmarks() {
+  // Words and the two and three word runs of the text, which share
+  // prefixes the way natural-language keys do
+  std::istringstream input(MakeText());
+  mini_utils::CountingResource tracker_memory;
+  item_tracker::ItemTracker tracker(&tracker_memory);
+  tracker.ImportWordsFromStream(input, 3);
+  const size_t items = tracker.GetItemCount();
+
+  mini_utils::CountingResource map_memory;
+  std::pmr::unordered_map<std::pmr::string, int> map(&map_memory);
+  map.reserve(items);
+  tracker.ForEachItem([&map](std::string_view item, int frequency) {
+    map.emplace(std::pmr::string(item, map.get_allocator()), frequency);
+  });
+
+  mini_utils::CountingResource table_memory;
+  item_tracker::FrozenItemTable table(&table_memory);
+  Report("freeze, per item", Measure(static_cast<long long>(items), [&] {
+           table = item_tracker::FrozenItemTable(tracker, &table_memory);
+         }));
+
+  std::cout << "  (" << items << " items)" << std::endl;
+  ReportMemory("std::pmr::unordered_map", map_memory.getBytesInUse(), items);
+  ReportMemory("ItemTracker", tracker_memory.getBytesInUse(), items);
+  ReportMemory("FrozenItemTable", table_memory.getBytesInUse(), items);
+
+  // Lookups of stored items in random order, and of missing ones
+  std::vector<std::string> keys;
+  keys.reserve(items);
+  tracker.ForEachItem(
+      [&keys](std::string_view item, int) { keys.emplace_back(item); });
+  std::mt19937 random(7);
+  std::uniform_int_distribution<size_t> key(0, keys.size() - 1);
+  std::vector<const std::string*> lookups(kLookups);
+  std::vector<std::string> missing(kLookups / 10);
+  for (auto& lookup : lookups) {
+    lookup = &keys[key(random)];
+  }
+  for (std::string& item : missing) {
+    item = keys[key(random)] + "q";
+  }
+
+  long long checksum = 0;
+  Report("unordered_map find", Measure(kLookups, [&] {
+           for (const std::string* item : lookups) {
+             checksum += map.find(std::pmr::string(*item))->second;
+           }
+         }));
+  Report("ItemTracker::GetWordFrequency", Measure(kLookups, [&] {
+           for (const std::string* item : lookups) {
+             checksum += tracker.GetWordFrequency(*item);
+           }
+         }));
+  Report("FrozenItemTable::GetFrequency", Measure(kLookups, [&] {
+           for (const std::string* item : lookups) {
+             checksum += table.GetFrequency(*item);
+           }
+         }));
+  Report("FrozenItemTable::GetFrequency, missing",
+         Measure(static_cast<long long>(missing.size()), [&] {
+           for (const std::string& item : missing) {
+             checksum += table.GetFrequency(item);
+           }
+         }));
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
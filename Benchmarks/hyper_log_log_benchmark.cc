@@ -0,0 +1,95 @@
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark.h"
+#include "hyper_log_log.h"
+#include "item_tracker.h"
+
+namespace benchmarks {
+namespace {
+const int kLines = 5000000;
+const int kDistinctItems = 1000000;
+const int kDays = 30;
+}  // namespace
+
+void RunHyperLogLogBenchmarks() {
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> item(0, kDistinctItems - 1);
+  std::vector<std::string> days(kDays);
+  std::string text;
+  for (int i = 0; i < kLines; ++i) {
+    const std::string line = "item " + std::to_string(item(random)) + "\n";
+    days[i % kDays] += line;
+    text += line;
+  }
+
+  std::unordered_set<std::string> exact;
+  Report("exact count, string set, per line", Measure(kLines, [&] {
+           std::istringstream input(text);
+           std::string line;
+           while (getline(input, line)) {
+             exact.insert(line);
+           }
+         }));
+
+  item_tracker::HyperLogLog sketch;
+  Report("AddLinesFromStream, per line", Measure(kLines, [&] {
+           std::istringstream input(text);
+           sketch.AddLinesFromStream(input);
+         }));
+  std::cout << "  (" << exact.size() << " distinct, estimated "
+            << sketch.Estimate() << ", "
+            << sketch.Serialize().size() << " bytes serialized)" << std::endl;
+
+  // Per-day sketches merged into the one of the whole month
+  std::vector<item_tracker::HyperLogLog> day_sketches(kDays);
+  for (int day = 0; day < kDays; ++day) {
+    std::istringstream input(days[day]);
+    day_sketches[day].AddLinesFromStream(input);
+  }
+  item_tracker::HyperLogLog month;
+  Report("merge a day into the month", Measure(kDays, [&] {
+           for (const item_tracker::HyperLogLog& day : day_sketches) {
+             month.Merge(day);
+           }
+         }));
+  std::cout << "  (month estimated " << month.Estimate() << ")" << std::endl;
+
+  // Error over many independent sketches of a known count
+  const int kSketches = 200;
+  const int kCount = 100000;
+  double squared_error = 0;
+  for (int i = 0; i < kSketches; ++i) {
+    item_tracker::HyperLogLog trial;
+    for (int j = 0; j < kCount; ++j) {
+      trial.Add(std::to_string(i) + "/" + std::to_string(j));
+    }
+    const double error = (static_cast<double>(trial.Estimate()) - kCount) /
+                         kCount;
+    squared_error += error * error;
+  }
+  std::cout << "  (relative standard error " << std::sqrt(squared_error /
+                                                           kSketches) * 100
+            << "% over " << kSketches << " sketches of " << kCount << ")"
+            << std::endl;
+
+  // Importing with the tables pre-sized from the estimate
+  item_tracker::ItemTracker unsized;
+  Report("ItemTracker import, per line", Measure(kLines, [&] {
+           std::istringstream input(text);
+           unsized.ImportFromStream(input);
+         }));
+  item_tracker::ItemTracker sized;
+  Report("ItemTracker import, reserved, per line", Measure(kLines, [&] {
+           sized.Reserve(sketch.Estimate());
+           std::istringstream input(text);
+           sized.ImportFromStream(input);
+         }));
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "mini_utils.h"
+
+namespace benchmarks {
+namespace {
+const int kLines = 1000000;
+
+// Typical scripted answers: amounts with user formatting, terms, choices
+const char* const kInputs[] = {"  1000.50 ", "$50", "5.25%", "30", "Y",
+                               "abc",        "12x", " 7 "};
+
+// The extraction getValidatedInput used before parseInput: trim copy,
+// std::function preprocessor and a stringstream per line
+template <typename T>
+bool ParseWithStream(const std::string& line, T& value,
+                     bool& has_extra_characters) {
+  const std::function<std::string(const std::string&)> preprocess =
+      mini_utils::trim;
+  std::stringstream input_stream(preprocess(line));
+  if (!(input_stream >> value)) {
+    return false;
+  }
+  char extra_char;
+  has_extra_characters = static_cast<bool>(input_stream >> extra_char);
+  return true;
+}
+}  // namespace
+
+void RunInputParsingBenchmarks() {
+  std::vector<std::string> lines;
+  lines.reserve(kLines);
+  for (int i = 0; i < kLines; ++i) {
+    lines.emplace_back(kInputs[i % (sizeof(kInputs) / sizeof(kInputs[0]))]);
+  }
+  double sum = 0;
+  bool has_extra_characters = false;
+
+  Report("double, trim + stringstream", Measure(kLines, [&] {
+           for (const std::string& line : lines) {
+             double value = 0;
+             if (ParseWithStream(line, value, has_extra_characters)) {
+               sum += value;
+             }
+           }
+         }));
+
+  Report("double, trimView + parseInput", Measure(kLines, [&] {
+           for (const std::string& line : lines) {
+             double value = 0;
+             if (mini_utils::parseInput(mini_utils::trimView(line), value,
+                                        has_extra_characters)) {
+               sum += value;
+             }
+           }
+         }));
+
+  Report("int, trim + stringstream", Measure(kLines, [&] {
+           for (const std::string& line : lines) {
+             int value = 0;
+             if (ParseWithStream(line, value, has_extra_characters)) {
+               sum += value;
+             }
+           }
+         }));
+
+  Report("int, trimView + parseInput", Measure(kLines, [&] {
+           for (const std::string& line : lines) {
+             int value = 0;
+             if (mini_utils::parseInput(mini_utils::trimView(line), value,
+                                        has_extra_characters)) {
+               sum += value;
+             }
+           }
+         }));
+  std::cout << "  (checksum " << sum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
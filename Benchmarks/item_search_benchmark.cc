@@ -0,0 +1,79 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "item_search_index.h"
+
+namespace benchmarks {
+namespace {
+const int kItems = 1000000;
+const int kQueries = 2000;
+const int kScanQueries = 20;
+const size_t kLimit = 10;
+const int kMaxDistance = 1;
+
+// Item names made of syllables, e.g. "tomapiru", so keys share prefixes and
+// trigrams the way real product names do
+std::string RandomItem(std::mt19937& random) {
+  static const char* const kSyllables[] = {
+      "to", "ma", "pi", "ru", "ke", "so", "la", "ni", "ba", "do",
+      "fe", "gu", "ho", "ji", "ko", "mu", "ne", "po", "ri", "su"};
+  std::uniform_int_distribution<int> count(2, 6);
+  std::uniform_int_distribution<int> syllable(0, 19);
+  std::string item;
+  for (int i = count(random); i > 0; --i) {
+    item += kSyllables[syllable(random)];
+  }
+  return item;
+}
+}  // namespace
+
+void RunItemSearchBenchmarks() {
+  std::mt19937 random(42);
+  std::unordered_map<std::string, int> items;
+  std::uniform_int_distribution<int> frequency(1, 1000);
+  while (static_cast<int>(items.size()) < kItems) {
+    items[RandomItem(random)] = frequency(random);
+  }
+  std::vector<std::string> queries;
+  for (int i = 0; i < kQueries; ++i) {
+    queries.push_back(RandomItem(random).substr(0, 6));
+  }
+
+  item_tracker::ItemSearchIndex index;
+  Report("build index, per item",
+         Measure(kItems, [&] { index.Build(items); }));
+
+  size_t found = 0;
+  Report("prefix query", Measure(kQueries, [&] {
+           for (const std::string& query : queries) {
+             found += index.FindByPrefix(query, kLimit).size();
+           }
+         }));
+  Report("substring query", Measure(kQueries, [&] {
+           for (const std::string& query : queries) {
+             found += index.FindBySubstring(query.substr(1, 4), kLimit).size();
+           }
+         }));
+  Report("similar query, distance 1", Measure(kQueries, [&] {
+           for (const std::string& query : queries) {
+             found += index.FindSimilar(query, kMaxDistance, kLimit).size();
+           }
+         }));
+
+  // What a query costs without an index: every item is checked
+  Report("substring query, full scan", Measure(kScanQueries, [&] {
+           for (int i = 0; i < kScanQueries; ++i) {
+             const std::string text = queries[i].substr(1, 4);
+             for (const auto& item : items) {
+               found += item.first.find(text) != std::string::npos;
+             }
+           }
+         }));
+  std::cout << "  (checksum " << found << ")" << std::endl;
+}
+
+}  // namespace benchmarks
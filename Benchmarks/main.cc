@@ -0,0 +1,42 @@
+/*
+ * Benchmarks for the mini projects. Pass a suite name to run only that suite.
+ */
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+
+int main(int argc, char* argv[]) {
+  const std::vector<std::pair<std::string, void (*)()>> kSuites = {
+      {"deposit_calculator", benchmarks::RunDepositCalculatorBenchmarks},
+      {"table_formatter", benchmarks::RunTableFormatterBenchmarks},
+      {"string_formatter", benchmarks::RunStringFormatterBenchmarks},
+      {"clock", benchmarks::RunClockBenchmarks},
+      {"input_parsing", benchmarks::RunInputParsingBenchmarks},
+      {"replay", benchmarks::RunReplayBenchmarks},
+      {"item_search", benchmarks::RunItemSearchBenchmarks},
+      {"windowed_counter", benchmarks::RunWindowedCounterBenchmarks},
+      {"string_pool", benchmarks::RunStringPoolBenchmarks},
+      {"memory_resource", benchmarks::RunMemoryResourceBenchmarks},
+      {"word_count", benchmarks::RunWordCountBenchmarks},
+      {"hyper_log_log", benchmarks::RunHyperLogLogBenchmarks},
+      {"query_server", benchmarks::RunQueryServerBenchmarks},
+      {"frequency_diff", benchmarks::RunFrequencyDiffBenchmarks},
+      {"frozen_item_table", benchmarks::RunFrozenItemTableBenchmarks},
+      {"portfolio", benchmarks::RunPortfolioBenchmarks},
+      {"sensitivity", benchmarks::RunSensitivityBenchmarks},
+      {"alarm_scheduler", benchmarks::RunAlarmSchedulerBenchmarks},
+      {"co_occurrence", benchmarks::RunCoOccurrenceBenchmarks},
+  };
+
+  const std::string filter = argc > 1 ? argv[1] : "";
+  for (const auto& suite : kSuites) {
+    if (!filter.empty() && suite.first.find(filter) == std::string::npos) {
+      continue;
+    }
+    std::cout << suite.first << std::endl;
+    suite.second();
+  }
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "counting_resource.h"
+#include "item_tracker.h"
+#include "mini_utils.h"
+
+namespace benchmarks {
+namespace {
+const int kLines = 2000000;
+const int kDistinctItems = 20000;
+const int kRows = 200000;
+
+// Measures building a table of kRows long cells on the global heap or in an
+// arena, rendering it, and tearing it down
+void BenchmarkTable(bool useArena, const std::vector<std::string>& row,
+                    size_t& checksum) {
+  const std::string name = useArena ? "arena" : "global heap";
+  std::pmr::monotonic_buffer_resource arena;
+  auto table = std::make_unique<mini_utils::TableFormatter>(
+      80, useArena ? &arena : std::pmr::get_default_resource());
+  table->setColumnWidths({10, 17, 17, 17, 19});
+  Report("TableFormatter addRow, " + name, Measure(kRows, [&] {
+           for (int i = 0; i < kRows; ++i) {
+             table->addRow(row);
+           }
+         }));
+  Report("TableFormatter render, " + name, Measure(kRows, [&] {
+           checksum += table->render().size();
+         }));
+  Report("TableFormatter teardown, " + name, Measure(kRows, [&] {
+           table.reset();
+           arena.release();
+         }));
+}
+}  // namespace
+
+void RunMemoryResourceBenchmarks() {
+  std::mt19937 random(42);
+  std::geometric_distribution<int> item_rank(0.0002);
+  std::string text;
+  for (int i = 0; i < kLines; ++i) {
+    text += "long grocery item name " +
+            std::to_string(item_rank(random) % kDistinctItems) + "\n";
+  }
+
+  // The string-keyed map ItemTracker used to count in, for the teardown cost
+  {
+    auto items = std::make_unique<std::unordered_map<std::string, int>>();
+    std::istringstream input(text);
+    std::string line;
+    while (getline(input, line)) {
+      ++(*items)[line];
+    }
+    Report("string map teardown, per item",
+           Measure(items->size(), [&] { items.reset(); }));
+  }
+
+  // The same import on the global heap and on an arena counted on its way
+  // to the heap; allocs/op counts calls to the global operator new
+  auto heap_tracker = std::make_unique<item_tracker::ItemTracker>();
+  Report("ItemTracker import, global heap", Measure(kLines, [&] {
+           std::istringstream input(text);
+           heap_tracker->ImportFromStream(input);
+         }));
+  Report("ItemTracker teardown, global heap",
+         Measure(kDistinctItems, [&] { heap_tracker.reset(); }));
+
+  mini_utils::CountingResource upstream(std::pmr::new_delete_resource());
+  auto arena = std::make_unique<std::pmr::monotonic_buffer_resource>(&upstream);
+  auto arena_tracker = std::make_unique<item_tracker::ItemTracker>(arena.get());
+  Report("ItemTracker import, arena", Measure(kLines, [&] {
+           std::istringstream input(text);
+           arena_tracker->ImportFromStream(input);
+         }));
+  std::cout << "  (" << upstream.getAllocationCount() << " arena blocks, "
+            << upstream.getPeakBytes() / (1 << 20) << " MiB)" << std::endl;
+  Report("ItemTracker teardown, arena release", Measure(kDistinctItems, [&] {
+           arena_tracker.reset();
+           arena.reset();
+         }));
+
+  // Cells longer than the small string buffer, so every cell allocates
+  const std::vector<std::string> row = {
+      "month 1234567", "$1,234,567,890.12", "$1,234,567,890.12",
+      "$1,234,567,890.12", "$1,234,567,890.12"};
+  size_t checksum = 0;
+  BenchmarkTable(false, row, checksum);
+  BenchmarkTable(true, row, checksum);
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
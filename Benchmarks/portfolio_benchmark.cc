@@ -0,0 +1,78 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "portfolio.h"
+
+namespace benchmarks {
+namespace {
+using airgead_investment_planner_cli::PortfolioAsset;
+using airgead_investment_planner_cli::PortfolioSimulator;
+using airgead_investment_planner_cli::PortfolioTerms;
+using airgead_investment_planner_cli::RebalancePolicy;
+
+const int kPortfolios = 10000;
+const int kAssets = 4;
+const int kYears = 30;
+
+// Stock, bond, cash and real estate mixes with every rebalancing policy
+std::vector<PortfolioTerms> MakePortfolios() {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> weight(0.05, 1.0);
+  std::uniform_real_distribution<double> rate_noise(-1.0, 1.0);
+  const double kRates[kAssets] = {7.0, 3.5, 1.5, 5.0};
+  const RebalancePolicy kPolicies[] = {
+      RebalancePolicy::NEVER, RebalancePolicy::MONTHLY,
+      RebalancePolicy::QUARTERLY, RebalancePolicy::ANNUAL,
+      RebalancePolicy::THRESHOLD};
+
+  std::vector<PortfolioTerms> portfolios(kPortfolios);
+  for (int i = 0; i < kPortfolios; ++i) {
+    PortfolioTerms& terms = portfolios[i];
+    for (double rate : kRates) {
+      terms.assets.push_back({rate + rate_noise(random), weight(random)});
+    }
+    terms.initialInvestment = 10000;
+    terms.monthlyContribution = 500;
+    terms.years = kYears;
+    terms.rebalancePolicy = kPolicies[i % 5];
+  }
+  return portfolios;
+}
+}  // namespace
+
+void RunPortfolioBenchmarks() {
+  const std::vector<PortfolioTerms> portfolios = MakePortfolios();
+  double checksum = 0;
+
+  // One portfolio per run, as a single-account calculator would
+  PortfolioSimulator single;
+  single.reserve(1, kAssets);
+  Report("one portfolio per batch, per portfolio",
+         Measure(kPortfolios, [&] {
+           for (const PortfolioTerms& terms : portfolios) {
+             single.clear();
+             single.addPortfolio(terms);
+             single.run();
+             checksum += single.getFinalBalance(0);
+           }
+         }));
+
+  PortfolioSimulator batch;
+  batch.reserve(kPortfolios, kAssets);
+  Report("whole batch, per portfolio", Measure(kPortfolios, [&] {
+           batch.clear();
+           for (const PortfolioTerms& terms : portfolios) {
+             batch.addPortfolio(terms);
+           }
+           batch.run();
+         }));
+  for (int i = 0; i < batch.size(); ++i) {
+    checksum += batch.getFinalBalance(i);
+  }
+  std::cout << "  (" << kAssets << " assets, " << kYears
+            << " years, checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
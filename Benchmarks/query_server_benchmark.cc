@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "item_query_server.h"
+#include "item_tracker.h"
+#include "query_protocol.h"
+
+namespace benchmarks {
+#ifdef __linux__
+namespace {
+const int kDistinctItems = 100000;
+const int kItemLines = 1000000;
+const int kRequestsPerRun = 200000;
+const int kBatchSize = 64;
+
+using Clock = std::chrono::steady_clock;
+
+// Closed-loop load: every client keeps `depth` requests in flight and sends
+// the next one as soon as a response comes back
+struct LoadRun {
+  int clients;
+  int depth;
+  // Items per request, 1 for kFrequency
+  int batch_size;
+};
+
+// Run the load and report throughput and p50/p99 latency
+void RunLoad(const std::string& socket_path, const LoadRun& run) {
+  const int requests_per_client = kRequestsPerRun / run.clients;
+  std::vector<std::vector<double>> latencies(run.clients);
+  std::vector<std::thread> clients;
+
+  const Measurement measurement = Measure(kRequestsPerRun, [&] {
+    for (int c = 0; c < run.clients; ++c) {
+      clients.emplace_back([&, c] {
+        item_tracker::ItemQueryClient client;
+        if (!client.Connect(socket_path)) return;
+        std::mt19937 random(c);
+        std::uniform_int_distribution<int> item(0, kDistinctItems - 1);
+        std::vector<std::string> names(run.batch_size);
+        std::vector<std::string_view> views(run.batch_size);
+        std::vector<Clock::time_point> sent_at(requests_per_client);
+        std::vector<double>& client_latencies = latencies[c];
+        client_latencies.reserve(requests_per_client);
+        std::string frames;
+
+        auto append_request = [&](uint32_t id) {
+          for (int i = 0; i < run.batch_size; ++i) {
+            names[i] = "item " + std::to_string(item(random));
+            views[i] = names[i];
+          }
+          if (run.batch_size == 1) {
+            item_tracker::AppendFrequencyRequest(frames, id, views[0]);
+          } else {
+            item_tracker::AppendBatchFrequencyRequest(frames, id, views);
+          }
+          sent_at[id] = Clock::now();
+        };
+
+        int sent = 0;
+        for (; sent < run.depth && sent < requests_per_client; ++sent) {
+          append_request(sent);
+        }
+        if (!client.Send(frames)) return;
+        item_tracker::QueryResponse response;
+        for (int received = 0; received < requests_per_client; ++received) {
+          if (!client.Receive(response)) return;
+          client_latencies.push_back(
+              std::chrono::duration<double, std::micro>(
+                  Clock::now() - sent_at[response.request_id])
+                  .count());
+          if (sent < requests_per_client) {
+            frames.clear();
+            append_request(sent++);
+            if (!client.Send(frames)) return;
+          }
+        }
+      });
+    }
+    for (std::thread& client : clients) {
+      client.join();
+    }
+  });
+
+  std::vector<double> all;
+  for (const std::vector<double>& client_latencies : latencies) {
+    all.insert(all.end(), client_latencies.begin(), client_latencies.end());
+  }
+  if (all.size() != static_cast<size_t>(requests_per_client) * run.clients) {
+    std::cout << "  (requests failed)" << std::endl;
+    return;
+  }
+  auto percentile = [&all](double fraction) {
+    auto nth = all.begin() + static_cast<size_t>(fraction * (all.size() - 1));
+    std::nth_element(all.begin(), nth, all.end());
+    return *nth;
+  };
+  const std::string kind =
+      run.batch_size == 1 ? "frequency"
+                          : "batch of " + std::to_string(run.batch_size);
+  Report(kind + ", " + std::to_string(run.clients) + " clients, depth " +
+             std::to_string(run.depth),
+         {measurement.seconds,
+          static_cast<long long>(requests_per_client) * run.clients,
+          measurement.allocations});
+  std::cout << "  (p50 " << percentile(0.5) << " us, p99 " << percentile(0.99)
+            << " us)" << std::endl;
+}
+}  // namespace
+#endif
+
+void RunQueryServerBenchmarks() {
+#ifdef __linux__
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> item(0, kDistinctItems - 1);
+  std::string lines;
+  for (int i = 0; i < kItemLines; ++i) {
+    lines += "item " + std::to_string(item(random)) + "\n";
+  }
+  item_tracker::ItemTracker tracker;
+  std::istringstream input(lines);
+  tracker.ImportFromStream(input);
+
+  const std::string socket_path = "query_server_benchmark.sock";
+  item_tracker::ItemQueryServer server(tracker);
+  if (!server.Listen(socket_path)) {
+    std::cout << "  (cannot listen on " << socket_path << ")" << std::endl;
+    return;
+  }
+  std::thread loop([&server] { server.Run(); });
+  std::cout << "  (operations are requests, latency is round trip)"
+            << std::endl;
+
+  const LoadRun kRuns[] = {{1, 1, 1},  {1, 32, 1}, {4, 1, 1},
+                           {4, 32, 1}, {16, 8, 1}, {4, 8, kBatchSize}};
+  for (const LoadRun& run : kRuns) {
+    RunLoad(socket_path, run);
+  }
+  server.Stop();
+  loop.join();
+#else
+  std::cout << "  (skipped, serving needs epoll)" << std::endl;
+#endif
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+#include "airgead_investment_planner_cli.h"
+#include "benchmark.h"
+#include "clock.h"
+#include "item_tracker.h"
+
+namespace benchmarks {
+namespace {
+const int kClockSessions = 20000;
+const int kDepositSessions = 2000;
+const int kLoanSessions = 2000;
+const int kItemTrackerSessions = 2000;
+const int kMenuRedraws = 200000;
+
+// Recorded sessions, one line per interaction. Every script ends the
+// session, because the prompts keep asking until they get valid input.
+const char kClockScript[] =
+    "12\n30\n0\n1\n2\n3\n6\n7\n0\n1\n1\n2\n2\n3\n3\n4\n";
+const char kDepositScript[] = "$1000\n$50\n5%\n30\n\n";
+// The loan schedule stops after its first page
+const char kLoanScript[] = "$200000\n6.5%\nabc\n30\n1\n0\nq\n";
+// Every menu choice is followed by a line the CLI discards
+const char kItemTrackerScript[] =
+    "1\n\nApples\n1\n\nKiwi\n2\n\n3\n\n9\n4\n";
+const char kItems[] = "Apples\nPears\nApples\nZucchini\nApples\nPears\n";
+
+// Input read straight from a script in memory. Rewinding does not copy the
+// script, so replays allocate only what the CLI itself allocates.
+class ScriptBuffer : public std::streambuf {
+ public:
+  explicit ScriptBuffer(const std::string& script) : script_(script) {
+    Rewind();
+  }
+
+  void Rewind() {
+    char* begin = const_cast<char*>(script_.data());
+    setg(begin, begin, begin + script_.size());
+  }
+
+ private:
+  const std::string& script_;
+};
+
+// Output that is counted and dropped, so terminal speed is not measured
+class CountingBuffer : public std::streambuf {
+ public:
+  long long bytes() const { return bytes_; }
+
+ protected:
+  int overflow(int character) override {
+    ++bytes_;
+    return character == traits_type::eof() ? 0 : character;
+  }
+
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    bytes_ += count;
+    return count;
+  }
+
+ private:
+  long long bytes_ = 0;
+};
+
+// Lines of a script, each one a user interaction
+long long CountInteractions(const std::string& script) {
+  return std::count(script.begin(), script.end(), '\n');
+}
+
+// Replays the script `sessions` times against a CLI wired to the given
+// streams and reports the cost per interaction
+template <typename StartSession>
+void ReplaySessions(const std::string& name, const std::string& script,
+                    int sessions, StartSession start_session) {
+  ScriptBuffer script_buffer(script);
+  CountingBuffer output_buffer;
+  std::istream input(&script_buffer);
+  std::ostream output(&output_buffer);
+
+  const long long interactions = CountInteractions(script) * sessions;
+  Report(name, Measure(interactions, [&] {
+           for (int i = 0; i < sessions; ++i) {
+             script_buffer.Rewind();
+             input.clear();
+             start_session(input, output);
+           }
+         }));
+  std::cout << "  (" << output_buffer.bytes() / interactions
+            << " bytes written per interaction)" << std::endl;
+}
+}  // namespace
+
+void RunReplayBenchmarks() {
+  ReplaySessions("clock session", kClockScript, kClockSessions,
+                 [](std::istream& input, std::ostream& output) {
+                   clock_cli::Clock clock;
+                   clock.setStreams(input, output);
+                   clock.startCli();
+                 });
+
+  ReplaySessions(
+      "deposit calculator session", kDepositScript, kDepositSessions,
+      [](std::istream& input, std::ostream& output) {
+        airgead_investment_planner_cli::InvestmentPlannerCli cli;
+        cli.setStreams(input, output);
+        cli.startCli();
+      });
+
+  ReplaySessions("loan planner session", kLoanScript, kLoanSessions,
+                 [](std::istream& input, std::ostream& output) {
+                   airgead_investment_planner_cli::LoanPlannerCli cli;
+                   cli.setStreams(input, output);
+                   cli.startCli();
+                 });
+
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path();
+  const std::string items_file = (directory / "replay_items.txt").string();
+  const std::string frequency_file =
+      (directory / "replay_frequency.dat").string();
+  std::ofstream(items_file) << kItems;
+
+  // The menu fits the precomputed 80-column frame; other widths are laid out
+  // on every redraw, so the two sessions differ by the menu redraw cost
+  for (const int width : {80, 100}) {
+    ReplaySessions(
+        "item tracker session, " + std::to_string(width) + " columns",
+        kItemTrackerScript, kItemTrackerSessions,
+        [&](std::istream& input, std::ostream& output) {
+          item_tracker::ItemTrackerCli cli(items_file, frequency_file, width);
+          cli.SetStreams(input, output);
+          cli.Start();
+        });
+  }
+  std::remove(items_file.c_str());
+  std::remove(frequency_file.c_str());
+
+  CountingBuffer output_buffer;
+  std::ostream output(&output_buffer);
+  clock_cli::Clock clock;
+  clock.setStreams(std::cin, output);
+  Report("clock menu redraw", Measure(kMenuRedraws, [&] {
+           for (int i = 0; i < kMenuRedraws; ++i) {
+             clock.displayMenu();
+           }
+         }));
+  Report("clock time redraw", Measure(kMenuRedraws, [&] {
+           for (int i = 0; i < kMenuRedraws; ++i) {
+             clock.displayTime();
+           }
+         }));
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <thread>
+
+#include "airgead_investment_planner_cli.h"
+#include "benchmark.h"
+#include "sensitivity.h"
+
+namespace benchmarks {
+namespace {
+using airgead_investment_planner_cli::DepositCalculator;
+using airgead_investment_planner_cli::SensitivityAnalysis;
+using airgead_investment_planner_cli::SensitivityGrid;
+
+const int kRates = 64;
+const int kTerms = 50;
+const int kDeposits = 10;
+const int kRuns = 20;
+
+// Rates from 0.5% to 16%, terms every 5 years up to the longest supported
+SensitivityGrid MakeGrid() {
+  SensitivityGrid grid;
+  grid.principal = 10000;
+  for (int i = 0; i < kRates; ++i) {
+    grid.annualRatesPercent.push_back(0.5 + i * 0.25);
+  }
+  for (int i = 1; i <= kTerms; ++i) {
+    grid.years.push_back(i * 5);
+  }
+  for (int i = 0; i < kDeposits; ++i) {
+    grid.monthlyDeposits.push_back(i * 100);
+  }
+  return grid;
+}
+}  // namespace
+
+void RunSensitivityBenchmarks() {
+  const SensitivityGrid GRID = MakeGrid();
+  const long long kCells = static_cast<long long>(kRates) * kTerms * kDeposits;
+  long double checksum = 0;
+
+  // One calculateCompoundInterest call per cell, as getTable does per year
+  Report("calculateCompoundInterest per cell", Measure(kCells, [&] {
+           for (double rate : GRID.annualRatesPercent) {
+             for (int years : GRID.years) {
+               for (double deposit : GRID.monthlyDeposits) {
+                 checksum += DepositCalculator::calculateCompoundInterest(
+                     GRID.principal, rate, deposit, years);
+               }
+             }
+           }
+         }));
+
+  SensitivityAnalysis analysis;
+  Report("SensitivityAnalysis, 1 thread, per cell",
+         Measure(kCells * kRuns, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             analysis.run(GRID, 1);
+             checksum += analysis.getBalance(kRates - 1, kTerms - 1, 0);
+           }
+         }));
+  Report("SensitivityAnalysis, all threads, per cell",
+         Measure(kCells * kRuns, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             analysis.run(GRID);
+             checksum += analysis.getBalance(kRates - 1, kTerms - 1, 0);
+           }
+         }));
+  std::cout << "  (" << kCells << " cells, hardware threads: "
+            << std::thread::hardware_concurrency() << ", checksum "
+            << static_cast<double>(checksum) << ")" << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,90 @@
+#include <string>
+
+#include "benchmark.h"
+#include "mini_utils.h"
+
+namespace benchmarks {
+namespace {
+using mini_utils::StaticFrame;
+using mini_utils::StringFormatter;
+
+const int kWidth = 80;
+const int kFrames = 200000;
+const char* const kItems[] = {
+    "1. Find item frequency", "2. List items with frequencies",
+    "3. List item histogram with frequencies", "4. Exit"};
+
+// The ItemTracker menu, one string per line as returned by the formatter
+void ComposeByValue(const StringFormatter& formatter, std::string& frame) {
+  frame = formatter.horizontalSeparator() + "\n" +
+          formatter.formatFullBorder("Item Tracker Menu") + "\n" +
+          formatter.formatSideBorder("Options:") + "\n";
+  for (const char* item : kItems) {
+    frame += formatter.formatSideBorder(item) + "\n";
+  }
+  frame += formatter.horizontalSeparator() + "\n";
+}
+
+// The same menu appended line by line into a reused buffer
+void ComposeAppending(const StringFormatter& formatter, std::string& frame) {
+  frame.clear();
+  formatter.appendHorizontalSeparator(frame);
+  frame += '\n';
+  formatter.appendFullBorder(frame, "Item Tracker Menu");
+  frame += '\n';
+  formatter.appendSideBorder(frame, "Options:");
+  frame += '\n';
+  for (const char* item : kItems) {
+    formatter.appendSideBorder(frame, item);
+    frame += '\n';
+  }
+  formatter.appendHorizontalSeparator(frame);
+  frame += '\n';
+}
+
+constexpr StaticFrame<kWidth, 8> MakeMenuFrame() {
+  StaticFrame<kWidth, 8> frame;
+  frame.horizontalSeparator()
+      .formatFullBorder("Item Tracker Menu")
+      .formatSideBorder("Options:")
+      .formatSideBorder("1. Find item frequency")
+      .formatSideBorder("2. List items with frequencies")
+      .formatSideBorder("3. List item histogram with frequencies")
+      .formatSideBorder("4. Exit")
+      .horizontalSeparator();
+  return frame;
+}
+
+constexpr auto kMenuFrame = MakeMenuFrame();
+}  // namespace
+
+void RunStringFormatterBenchmarks() {
+  const StringFormatter formatter(kWidth);
+  std::string frame;
+  size_t checksum = 0;
+
+  Report("menu frame, format* by value", Measure(kFrames, [&] {
+           for (int i = 0; i < kFrames; ++i) {
+             ComposeByValue(formatter, frame);
+             checksum += frame.size();
+           }
+         }));
+
+  ComposeAppending(formatter, frame);  // Warm up the buffer capacity
+  Report("menu frame, append* into reused buffer", Measure(kFrames, [&] {
+           for (int i = 0; i < kFrames; ++i) {
+             ComposeAppending(formatter, frame);
+             checksum += frame.size();
+           }
+         }));
+
+  Report("menu frame, compile-time StaticFrame copy", Measure(kFrames, [&] {
+           for (int i = 0; i < kFrames; ++i) {
+             frame.assign(kMenuFrame.data(), kMenuFrame.size());
+             checksum += frame.size();
+           }
+         }));
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "item_tracker.h"
+#include "string_pool.h"
+
+namespace benchmarks {
+namespace {
+const int kLines = 4000000;
+const int kDistinctItems = 50000;
+const int kThreads = 4;
+}  // namespace
+
+void RunStringPoolBenchmarks() {
+  // Skewed popularity, like a log of purchases
+  std::mt19937 random(42);
+  std::geometric_distribution<int> item_rank(0.0002);
+  std::vector<std::string> lines;
+  lines.reserve(kLines);
+  std::string text;
+  for (int i = 0; i < kLines; ++i) {
+    lines.push_back("grocery item " +
+                    std::to_string(item_rank(random) % kDistinctItems));
+    text += lines.back() + "\n";
+  }
+
+  // The counting ItemTracker did before it interned its items
+  std::unordered_map<std::string, int> map_counts;
+  Report("count by string key, per line", Measure(kLines, [&] {
+           for (const std::string& line : lines) {
+             ++map_counts[line];
+           }
+         }));
+  mini_utils::StringPool pool;
+  std::vector<int> id_counts;
+  Report("count by interned id, per line", Measure(kLines, [&] {
+           for (const std::string& line : lines) {
+             const uint32_t id = pool.intern(line);
+             if (id == id_counts.size()) {
+               id_counts.push_back(0);
+             }
+             ++id_counts[id];
+           }
+         }));
+  std::cout << "  (" << pool.size() << " distinct items, "
+            << pool.getArenaBytes() << " arena bytes)" << std::endl;
+
+  std::vector<std::pair<std::string, int>> map_entries;
+  Report("sort by frequency, string entries, per item",
+         Measure(map_counts.size(), [&] {
+           map_entries.assign(map_counts.begin(), map_counts.end());
+           std::sort(map_entries.begin(), map_entries.end(),
+                     [](const auto& left, const auto& right) {
+                       return left.second > right.second;
+                     });
+         }));
+  std::vector<uint32_t> ids;
+  Report("sort by frequency, ids, per item", Measure(id_counts.size(), [&] {
+           ids.resize(id_counts.size());
+           for (uint32_t id = 0; id < ids.size(); ++id) {
+             ids[id] = id;
+           }
+           std::sort(ids.begin(), ids.end(),
+                     [&](uint32_t left, uint32_t right) {
+                       return id_counts[left] > id_counts[right];
+                     });
+         }));
+
+  item_tracker::ItemTracker tracker;
+  Report("ItemTracker import, per line", Measure(kLines, [&] {
+           std::istringstream input(text);
+           tracker.ImportFromStream(input);
+         }));
+  item_tracker::ItemTracker merged;
+  // Includes rebuilding the search index over the merged items
+  Report("ItemTracker merge, per item", Measure(pool.size(), [&] {
+           merged.Merge(tracker);
+         }));
+
+  // Every thread interns its own slice of the lines into the shared pool
+  for (int threads = 1; threads <= kThreads; threads *= 2) {
+    mini_utils::ConcurrentStringPool shared_pool;
+    Report("concurrent intern, " + std::to_string(threads) +
+               " threads, per line",
+           Measure(kLines, [&] {
+             std::vector<std::thread> workers;
+             for (int worker = 0; worker < threads; ++worker) {
+               workers.emplace_back([&, worker] {
+                 for (int i = worker; i < kLines; i += threads) {
+                   shared_pool.intern(lines[i]);
+                 }
+               });
+             }
+             for (std::thread& thread : workers) {
+               thread.join();
+             }
+           }));
+  }
+  std::cout << "  (checksum " << map_entries.size() + ids.size() << ")"
+            << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,88 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "mini_utils.h"
+
+namespace benchmarks {
+namespace {
+using mini_utils::TableFormatter;
+
+const int kRows = 3000;  // Monthly loan schedule over 250 years
+const int kRuns = 200;
+
+TableFormatter MakeFormatter() {
+  TableFormatter formatter(80);
+  formatter.setColumnWidths({10, 17, 17, 17, 19});
+  formatter.setHeaders(
+      {"Month", "Payment", "Principal", "Interest", "Balance"});
+  return formatter;
+}
+
+void FillRow(int index, std::vector<std::string>& row) {
+  row.resize(5);
+  row[0] = std::to_string(index + 1);
+  for (size_t i = 1; i < row.size(); ++i) {
+    row[i] = "$1234567.89";
+  }
+}
+}  // namespace
+
+void RunTableFormatterBenchmarks() {
+  const long long kRenderedRows = static_cast<long long>(kRuns) * kRows;
+  size_t checksum = 0;
+
+  Report("addRow + render() to string", Measure(kRenderedRows, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             TableFormatter formatter = MakeFormatter();
+             std::vector<std::string> row;
+             for (int i = 0; i < kRows; ++i) {
+               FillRow(i, row);
+               formatter.addRow(row);
+             }
+             checksum += formatter.render().size();
+           }
+         }));
+
+  std::string buffer;
+  Report("renderPage(row source) to reused buffer", Measure(kRenderedRows, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             const TableFormatter formatter = MakeFormatter();
+             int index = 0;
+             buffer.clear();
+             checksum += formatter.renderPage(
+                 buffer, [&](std::vector<std::string>& row) {
+                   if (index >= kRows) {
+                     return false;
+                   }
+                   FillRow(index++, row);
+                   return true;
+                 },
+                 kRows);
+           }
+         }));
+
+  Report("renderPage(row source) to stream, 24 rows/page",
+         Measure(kRenderedRows, [&] {
+           for (int run = 0; run < kRuns; ++run) {
+             const TableFormatter formatter = MakeFormatter();
+             std::ostringstream out;
+             int index = 0;
+             const TableFormatter::RowSource source =
+                 [&](std::vector<std::string>& row) {
+                   if (index >= kRows) {
+                     return false;
+                   }
+                   FillRow(index++, row);
+                   return true;
+                 };
+             while (formatter.renderPage(out, source, 24) > 0) {
+             }
+             checksum += out.str().size();
+           }
+         }));
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "windowed_item_counter.h"
+
+namespace benchmarks {
+namespace {
+const int kEvents = 2000000;
+const int kDistinctItems = 10000;
+const int kAppends = 100;
+const int kQueries = 100;
+// A day by minute
+const int kBucketSeconds = 60;
+const int kBucketCount = 24 * 60;
+const long long kHour = 60 * 60;
+// Two days of events starting at a fixed time
+const long long kStart = 1700000000;
+const long long kSpan = 2 * 24 * kHour;
+}  // namespace
+
+void RunWindowedCounterBenchmarks() {
+  // Item popularity is skewed so top and trending queries have winners
+  std::mt19937 random(42);
+  std::geometric_distribution<int> item_rank(0.001);
+  std::vector<std::string> lines;
+  lines.reserve(kEvents);
+  for (int i = 0; i < kEvents; ++i) {
+    const long long timestamp = kStart + kSpan * i / kEvents;
+    lines.push_back(std::to_string(timestamp) + " item" +
+                    std::to_string(item_rank(random) % kDistinctItems) +
+                    "\n");
+  }
+
+  item_tracker::WindowedItemCounter memory_counter(kBucketSeconds,
+                                                   kBucketCount);
+  Report("add event", Measure(kEvents, [&] {
+           for (int i = 0; i < kEvents; ++i) {
+             memory_counter.Add("item" + std::to_string(i % kDistinctItems),
+                                kStart + kSpan * i / kEvents);
+           }
+         }));
+
+  // The file grows in appends, each followed by a read of the new lines
+  const std::string file_name =
+      (std::filesystem::temp_directory_path() / "windowed_counter.txt")
+          .string();
+  std::ofstream(file_name, std::ios::trunc);
+  item_tracker::WindowedItemCounter counter(kBucketSeconds, kBucketCount);
+  double append_seconds = 0;
+  Measurement follow;
+  follow.operations = kEvents;
+  for (int append = 0; append < kAppends; ++append) {
+    const Measurement write = Measure(0, [&] {
+      std::ofstream output(file_name, std::ios::app | std::ios::binary);
+      for (int i = append * kEvents / kAppends;
+           i < (append + 1) * kEvents / kAppends; ++i) {
+        output << lines[i];
+      }
+    });
+    append_seconds += write.seconds;
+    const Measurement read =
+        Measure(0, [&] { counter.LoadNewLinesFromFile(file_name); });
+    follow.seconds += read.seconds;
+    follow.allocations += read.allocations;
+  }
+  Report("follow appended file, per line", follow);
+  std::cout << "  (appending took " << append_seconds << " s, "
+            << counter.GetRejectedLines() << " lines rejected)" << std::endl;
+
+  item_tracker::WindowedItemCounter reloaded(kBucketSeconds, kBucketCount);
+  Report("load whole file, per line", Measure(kEvents, [&] {
+           reloaded.LoadNewLinesFromFile(file_name);
+         }));
+  std::remove(file_name.c_str());
+
+  long long checksum = 0;
+  Report("count of item, last hour", Measure(kQueries, [&] {
+           for (int i = 0; i < kQueries; ++i) {
+             checksum += counter.GetCount("item" + std::to_string(i), kHour);
+           }
+         }));
+  Report("count of item, last day", Measure(kQueries, [&] {
+           for (int i = 0; i < kQueries; ++i) {
+             checksum +=
+                 counter.GetCount("item" + std::to_string(i), 24 * kHour);
+           }
+         }));
+  Report("top 10 items, last hour", Measure(kQueries, [&] {
+           for (int i = 0; i < kQueries; ++i) {
+             checksum += counter.GetTopItems(kHour, 10).size();
+           }
+         }));
+  Report("trending 10 items, hour over hour", Measure(kQueries, [&] {
+           for (int i = 0; i < kQueries; ++i) {
+             checksum += counter.GetTrendingItems(kHour, 10).size();
+           }
+         }));
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,102 @@
+#include <iostream>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "item_tracker.h"
+#include "word_splitter.h"
+
+namespace benchmarks {
+namespace {
+// About 64 MB of text
+const size_t kTextBytes = 64 << 20;
+const int kVocabulary = 50000;
+const int kMaxWordsPerLine = 16;
+
+// Words of 2 to 10 letters with Zipf-like popularity, punctuated and split
+// into lines like prose
+std::string MakeText() {
+  std::mt19937 random(42);
+  std::vector<std::string> vocabulary;
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<int> length(2, 10);
+  for (int i = 0; i < kVocabulary; ++i) {
+    std::string word(length(random), ' ');
+    for (char& c : word) {
+      c = static_cast<char>(letter(random));
+    }
+    vocabulary.push_back(word);
+  }
+
+  std::geometric_distribution<int> rank(0.001);
+  std::uniform_int_distribution<int> words_per_line(1, kMaxWordsPerLine);
+  std::uniform_int_distribution<int> punctuation(0, 9);
+  std::string text;
+  text.reserve(kTextBytes + 256);
+  while (text.size() < kTextBytes) {
+    for (int i = words_per_line(random); i > 0; --i) {
+      text += vocabulary[rank(random) % kVocabulary];
+      text += punctuation(random) == 0 ? ", " : " ";
+    }
+    text.back() = '\n';
+  }
+  return text;
+}
+}  // namespace
+
+void RunWordCountBenchmarks() {
+  const std::string text = MakeText();
+  const long long bytes = static_cast<long long>(text.size());
+  std::cout << "  (operations are bytes of text, op/s is bytes/s)"
+            << std::endl;
+
+  // What counting words looked like with streams and a string-keyed map
+  std::unordered_map<std::string, int> stream_counts;
+  Report("stream extraction into string map", Measure(bytes, [&] {
+           std::istringstream input(text);
+           std::string word;
+           while (input >> word) {
+             ++stream_counts[word];
+           }
+         }));
+
+  std::pmr::vector<item_tracker::Word> words;
+  size_t word_count = 0;
+  Report("SplitWords only", Measure(bytes, [&] {
+           size_t line_start = 0;
+           while (line_start < text.size()) {
+             size_t line_end = text.find('\n', line_start);
+             if (line_end == std::string::npos) {
+               line_end = text.size();
+             }
+             words.clear();
+             item_tracker::SplitWords(
+                 std::string_view(text).substr(line_start,
+                                               line_end - line_start),
+                 words);
+             word_count += words.size();
+             line_start = line_end + 1;
+           }
+         }));
+
+  for (int max_ngram_words = 1; max_ngram_words <= 3; ++max_ngram_words) {
+    item_tracker::ItemTracker tracker;
+    Report("ImportWordsFromStream, up to " + std::to_string(max_ngram_words) +
+               " words",
+           Measure(bytes, [&] {
+             std::istringstream input(text);
+             tracker.ImportWordsFromStream(input, max_ngram_words);
+           }));
+    size_t items = 0;
+    tracker.ForEachItem([&items](std::string_view, int) { ++items; });
+    std::cout << "  (" << items << " distinct items)" << std::endl;
+  }
+  std::cout << "  (" << word_count << " words, " << stream_counts.size()
+            << " distinct)" << std::endl;
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,235 @@
+#include "alarm_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace clock_cli {
+namespace {
+// Trailing zero bits of a non-zero value
+int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(value);
+#else
+  int count = 0;
+  while ((value & 1) == 0) {
+    value >>= 1;
+    ++count;
+  }
+  return count;
+#endif
+}
+}  // namespace
+
+AlarmScheduler::AlarmScheduler(FireHandler onFire)
+    : m_onFire(std::move(onFire)), m_nodes(SLOT_COUNT) {
+  // Every slot starts as an empty circular list around its head
+  for (uint32_t head = 0; head < SLOT_COUNT; ++head) {
+    m_nodes[head].next = head;
+    m_nodes[head].prev = head;
+  }
+}
+
+void AlarmScheduler::reserve(size_t alarms) {
+  m_nodes.reserve(SLOT_COUNT + alarms);
+}
+
+AlarmId AlarmScheduler::schedule(long long delaySeconds,
+                                 long long intervalSeconds) {
+  if (delaySeconds < 0 || delaySeconds > MAX_DELAY_SECONDS ||
+      intervalSeconds < 0 || intervalSeconds > MAX_INTERVAL_SECONDS) {
+    return INVALID_ALARM;
+  }
+
+  uint32_t index = m_freeHead;
+  if (index != FREE) {
+    m_freeHead = m_nodes[index].next;
+  } else if (m_nodes.size() < FIRING) {
+    index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back({0, 0, 0, 0, 0});
+  } else {
+    return INVALID_ALARM;
+  }
+
+  Node& node = m_nodes[index];
+  node.dueTime = m_now + std::max(1LL, delaySeconds);
+  node.intervalSeconds = static_cast<uint32_t>(intervalSeconds);
+  insert(index);
+  ++m_size;
+  return makeId(index, node.generation);
+}
+
+bool AlarmScheduler::cancel(AlarmId id) {
+  const uint32_t INDEX = static_cast<uint32_t>(id);
+  if (INDEX < SLOT_COUNT || INDEX >= m_nodes.size()) {
+    return false;
+  }
+  const Node& NODE = m_nodes[INDEX];
+  if (NODE.generation != static_cast<uint32_t>(id >> 32) ||
+      NODE.prev == FREE) {
+    return false;
+  }
+  // An alarm detached to fire is skipped once its node has moved on
+  if (NODE.prev != FIRING) {
+    unlink(INDEX);
+  }
+  freeNode(INDEX);
+  return true;
+}
+
+void AlarmScheduler::advance(long long seconds) {
+  if (seconds <= 0) {
+    return;
+  }
+  const uint64_t TARGET = m_now + static_cast<uint64_t>(seconds);
+  // Fire handlers may add alarms before the next slot found so far, so the
+  // next slot is looked up again after every one
+  for (uint64_t next = findNextSlotTime(); next <= TARGET;
+       next = findNextSlotTime()) {
+    m_now = next;
+    processSlots();
+  }
+  m_now = TARGET;
+}
+
+long long AlarmScheduler::getTime() const {
+  return static_cast<long long>(m_now);
+}
+
+size_t AlarmScheduler::size() const { return m_size; }
+
+// AlarmScheduler:Private
+
+void AlarmScheduler::insert(uint32_t index) {
+  Node& node = m_nodes[index];
+  const uint64_t DELAY = node.dueTime - m_now;
+  int level = 0;
+  while (level < WHEEL_LEVELS - 1 &&
+         DELAY >> (LEVEL_BITS * (level + 1)) != 0) {
+    ++level;
+  }
+  const int SLOT =
+      static_cast<int>(node.dueTime >> (LEVEL_BITS * level)) &
+      (SLOTS_PER_LEVEL - 1);
+  const uint32_t HEAD = static_cast<uint32_t>(level * SLOTS_PER_LEVEL + SLOT);
+
+  // Appended at the tail of the slot's list
+  Node& head = m_nodes[HEAD];
+  node.next = HEAD;
+  node.prev = head.prev;
+  m_nodes[head.prev].next = index;
+  head.prev = index;
+  m_occupied[level][SLOT / 64] |= uint64_t{1} << (SLOT % 64);
+}
+
+void AlarmScheduler::unlink(uint32_t index) {
+  const Node& NODE = m_nodes[index];
+  m_nodes[NODE.prev].next = NODE.next;
+  m_nodes[NODE.next].prev = NODE.prev;
+  // Only the head is left when both neighbours are the same head
+  if (NODE.prev == NODE.next && NODE.prev < SLOT_COUNT) {
+    const int LEVEL = static_cast<int>(NODE.prev) / SLOTS_PER_LEVEL;
+    const int SLOT = static_cast<int>(NODE.prev) % SLOTS_PER_LEVEL;
+    m_occupied[LEVEL][SLOT / 64] &= ~(uint64_t{1} << (SLOT % 64));
+  }
+}
+
+int AlarmScheduler::findOccupiedSlot(int level, int from) const {
+  if (from >= SLOTS_PER_LEVEL) {
+    return -1;
+  }
+  int word = from / 64;
+  uint64_t bits = m_occupied[level][word] & (~uint64_t{0} << (from % 64));
+  while (bits == 0) {
+    if (++word == WORDS_PER_LEVEL) {
+      return -1;
+    }
+    bits = m_occupied[level][word];
+  }
+  return word * 64 + countTrailingZeros(bits);
+}
+
+uint64_t AlarmScheduler::findNextSlotTime() const {
+  uint64_t next = UINT64_MAX;
+  for (int level = 0; level < WHEEL_LEVELS; ++level) {
+    const int SHIFT = LEVEL_BITS * level;
+    const int CURRENT = static_cast<int>(m_now >> SHIFT) &
+                        (SLOTS_PER_LEVEL - 1);
+    // Start of the level's current rotation
+    uint64_t start = m_now >> (SHIFT + LEVEL_BITS) << (SHIFT + LEVEL_BITS);
+    int slot = findOccupiedSlot(level, CURRENT + 1);
+    if (slot < 0) {
+      // Slots up to the current one are next visited in the next rotation
+      slot = findOccupiedSlot(level, 0);
+      if (slot < 0) {
+        continue;
+      }
+      start += uint64_t{1} << (SHIFT + LEVEL_BITS);
+    }
+    next = std::min(next, start + (static_cast<uint64_t>(slot) << SHIFT));
+  }
+  return next;
+}
+
+void AlarmScheduler::processSlots() {
+  // Alarms of the higher levels move down first, as some may be due now
+  for (int level = WHEEL_LEVELS - 1; level >= 0; --level) {
+    const int SHIFT = LEVEL_BITS * level;
+    if ((m_now & ((uint64_t{1} << SHIFT) - 1)) != 0) {
+      continue;
+    }
+    const int SLOT = static_cast<int>(m_now >> SHIFT) & (SLOTS_PER_LEVEL - 1);
+    if ((m_occupied[level][SLOT / 64] >> (SLOT % 64) & 1) == 0) {
+      continue;
+    }
+
+    // Detach the whole list, then hand its alarms on one by one
+    const uint32_t HEAD = static_cast<uint32_t>(level * SLOTS_PER_LEVEL + SLOT);
+    uint32_t index = m_nodes[HEAD].next;
+    m_nodes[HEAD].next = HEAD;
+    m_nodes[HEAD].prev = HEAD;
+    m_occupied[level][SLOT / 64] &= ~(uint64_t{1} << (SLOT % 64));
+    while (index != HEAD) {
+      const uint32_t NEXT = m_nodes[index].next;
+      if (level > 0) {
+        insert(index);
+      } else {
+        m_nodes[index].prev = FIRING;
+        m_due.push_back(makeId(index, m_nodes[index].generation));
+      }
+      index = NEXT;
+    }
+  }
+
+  // Handlers may schedule and cancel, so no node is held across a call
+  for (const AlarmId ID : m_due) {
+    const uint32_t INDEX = static_cast<uint32_t>(ID);
+    Node& node = m_nodes[INDEX];
+    if (node.generation != static_cast<uint32_t>(ID >> 32) ||
+        node.prev != FIRING) {
+      continue;
+    }
+    if (node.intervalSeconds != 0) {
+      node.dueTime = m_now + node.intervalSeconds;
+      insert(INDEX);
+    } else {
+      freeNode(INDEX);
+    }
+    m_onFire(ID);
+  }
+  m_due.clear();
+}
+
+void AlarmScheduler::freeNode(uint32_t index) {
+  Node& node = m_nodes[index];
+  ++node.generation;
+  node.prev = FREE;
+  node.next = m_freeHead;
+  m_freeHead = index;
+  --m_size;
+}
+
+AlarmId AlarmScheduler::makeId(uint32_t index, uint32_t generation) {
+  return static_cast<AlarmId>(generation) << 32 | index;
+}
+
+}  // namespace clock_cli
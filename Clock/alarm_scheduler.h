@@ -0,0 +1,126 @@
+#ifndef ALARM_SCHEDULER_H
+#define ALARM_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace clock_cli {
+using AlarmId = uint64_t;
+
+// One-shot and recurring alarms on a hierarchical timing wheel, in whole
+// seconds of elapsed time.
+//
+// The wheel has WHEEL_LEVELS levels of SLOTS_PER_LEVEL slots. An alarm due
+// in 256^k to 256^(k + 1) seconds goes to level k, in the slot given by
+// byte k of its due time. When time reaches the start of an occupied slot,
+// its alarms are moved down to the level their remaining delay belongs to,
+// ending in level 0 where a slot holds the alarms of one exact second.
+// Insert and cancel are O(1); advancing jumps straight to the next occupied
+// slot with per-level occupancy bitmaps, so a long jump costs the slots it
+// crosses that hold alarms, not the seconds it covers.
+//
+// Alarms are kept in a pool of intrusive list nodes indexed by the id, which
+// also carries a generation, so ids of fired or cancelled alarms go stale
+// instead of reaching a reused node.
+//
+// Example:
+//   AlarmScheduler scheduler([](AlarmId id) { std::cout << id << "\n"; });
+//   const AlarmId ALARM = scheduler.schedule(90);
+//   scheduler.advance(SECONDS_PER_HOUR);  // prints the id once
+
+class AlarmScheduler {
+ public:
+  // Called for every alarm that is due. It may schedule and cancel alarms,
+  // including the one that fired.
+  using FireHandler = std::function<void(AlarmId id)>;
+
+  static constexpr int WHEEL_LEVELS = 5;
+  static constexpr int SLOTS_PER_LEVEL = 256;
+  // Longest delay, about 34,000 years
+  static constexpr long long MAX_DELAY_SECONDS =
+      (1LL << (8 * WHEEL_LEVELS)) - 1;
+  // Longest interval of a recurring alarm, about 136 years
+  static constexpr long long MAX_INTERVAL_SECONDS = UINT32_MAX;
+  // Never returned by schedule()
+  static constexpr AlarmId INVALID_ALARM = 0;
+
+  explicit AlarmScheduler(FireHandler onFire);
+
+  // Preallocate nodes for the given number of pending alarms
+  void reserve(size_t alarms);
+
+  // Schedule an alarm delaySeconds from now; a delay of 0 counts as 1. With
+  // a positive interval, it fires again every intervalSeconds after that
+  // until cancelled. Returns INVALID_ALARM if either is out of range.
+  AlarmId schedule(long long delaySeconds, long long intervalSeconds = 0);
+
+  // Returns false if the alarm already fired for the last time or was
+  // cancelled
+  bool cancel(AlarmId id);
+
+  // Move time forward, firing due alarms in time order. Alarms due in the
+  // same second fire in no particular order. Must not be called from the
+  // fire handler.
+  void advance(long long seconds);
+
+  // Seconds advanced since construction
+  long long getTime() const;
+
+  // Alarms waiting to fire
+  size_t size() const;
+
+ private:
+  static constexpr int LEVEL_BITS = 8;
+  static constexpr int SLOT_COUNT = WHEEL_LEVELS * SLOTS_PER_LEVEL;
+  static constexpr int WORDS_PER_LEVEL = SLOTS_PER_LEVEL / 64;
+  // prev of a node that is on the free list, or detached to fire
+  static constexpr uint32_t FREE = UINT32_MAX;
+  static constexpr uint32_t FIRING = UINT32_MAX - 1;
+
+  // Node of a circular doubly linked list. The first SLOT_COUNT nodes are
+  // the list heads of the slots, the rest hold alarms.
+  struct Node {
+    uint64_t dueTime;
+    uint32_t next;
+    uint32_t prev;
+    uint32_t generation;
+    uint32_t intervalSeconds;
+  };
+
+  // Link the alarm into the slot its due time belongs to
+  void insert(uint32_t index);
+
+  // Unlink the alarm from its slot, clearing the slot's bit if it empties
+  void unlink(uint32_t index);
+
+  // First slot of the level from the given one on that holds alarms, or -1
+  int findOccupiedSlot(int level, int from) const;
+
+  // Start of the next occupied slot after the current time, or UINT64_MAX
+  // if the wheel is empty
+  uint64_t findNextSlotTime() const;
+
+  // Handle the slots starting at the current time: move the alarms of the
+  // higher levels down, then fire the alarms of level 0
+  void processSlots();
+
+  void freeNode(uint32_t index);
+
+  static AlarmId makeId(uint32_t index, uint32_t generation);
+
+  FireHandler m_onFire;
+  uint64_t m_now = 0;
+  size_t m_size = 0;
+  std::vector<Node> m_nodes;
+  // Head of the list of free nodes, threaded through next
+  uint32_t m_freeHead = FREE;
+  // One bit per slot that holds alarms
+  uint64_t m_occupied[WHEEL_LEVELS][WORDS_PER_LEVEL] = {};
+  // Alarms detached to fire, reused between seconds
+  std::vector<AlarmId> m_due;
+};
+
+}  // namespace clock_cli
+#endif  // ALARM_SCHEDULER_H
@@ -1,108 +1,278 @@
 #include "clock.h"
 
-#include <iomanip>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
 
 #include "mini_utils.h"
+#include "screen.h"
+#include "time_format.h"
 
 namespace clock_cli {
-using std::cin;
-using std::cout;
 using std::endl;
-using std::setfill;
-using std::setw;
 using std::string;
 
 using mini_utils::StringFormatter;
 
-void Clock::printStyledBorder(bool doubleBorder) {
-  string border(m_width, '*');
-  cout << border;
-  if (doubleBorder) {
-    cout << CLOCK_SEPARATOR << border;
+namespace {
+constexpr const char* MENU_ITEMS[] = {
+    "1 - Add One Hour", "2 - Add One Minute", "3 - Add One Second",
+    "4 - Exit Program", "5 - Run Live Clock", "6 - Show World Clock"};
+
+const int MAX_LIVE_SECONDS = 24 * 60 * 60;
+
+// Menu items between two borders
+const int MENU_LINES = sizeof(MENU_ITEMS) / sizeof(MENU_ITEMS[0]) + 2;
+
+// The menu never changes, so it is laid out once at compile time
+constexpr mini_utils::StaticFrame<DEFAULT_WIDTH, MENU_LINES> makeMenuFrame() {
+  mini_utils::StaticFrame<DEFAULT_WIDTH, MENU_LINES> frame;
+  frame.horizontalSeparator();
+  for (const char* ITEM : MENU_ITEMS) {
+    frame.formatSideBorder(ITEM);
+  }
+  frame.horizontalSeparator();
+  return frame;
+}
+
+constexpr auto MENU_FRAME = makeMenuFrame();
+}  // namespace
+
+void Clock::appendStyledBorder(string& out, int columns) const {
+  for (int i = 0; i < columns; ++i) {
+    if (i > 0) {
+      out += CLOCK_SEPARATOR;
+    }
+    m_formatter.appendHorizontalSeparator(out);
   }
-  cout << endl;
+  out += '\n';
+}
+
+void Clock::appendColumns(string& out, const std::vector<string>& CELLS) const {
+  for (size_t i = 0; i < CELLS.size(); ++i) {
+    if (i > 0) {
+      out += CLOCK_SEPARATOR;
+    }
+    m_formatter.appendCentered(out, CELLS[i]);
+  }
+}
+
+void Clock::appendTitleLine(string& out) const {
+  m_formatter.appendCentered(out, "12-Hour Clock");
+  out += CLOCK_SEPARATOR;
+  m_formatter.appendCentered(out, "24-Hour Clock");
+}
+
+void Clock::appendTimeLine(string& out) const {
+  // Formatted on the stack, the live clock redraws this line every second
+  char time12Hours[TIME_12_HOURS_LENGTH];
+  char time24Hours[TIME_24_HOURS_LENGTH];
+  formatTime12Hours(m_secondsOfDay, time12Hours);
+  formatTime24Hours(m_secondsOfDay, time24Hours);
+
+  m_formatter.appendCentered(out, {time12Hours, TIME_12_HOURS_LENGTH});
+  out += CLOCK_SEPARATOR;
+  m_formatter.appendCentered(out, {time24Hours, TIME_24_HOURS_LENGTH});
+}
+
+void Clock::appendStatsLine(string& out, const LiveStats& STATS) const {
+  const double AVERAGE_JITTER_US =
+      STATS.ticks == 0 ? 0 : STATS.totalJitterUs / STATS.ticks;
+  char buffer[128];
+  const int LENGTH = std::snprintf(
+      buffer, sizeof(buffer),
+      "Tick jitter avg %.3f ms, max %.3f ms | Frame %.1f us, max %.1f us",
+      AVERAGE_JITTER_US / 1000, STATS.maxJitterUs / 1000, STATS.lastRenderUs,
+      STATS.maxRenderUs);
+  out.append(buffer, std::min<int>(LENGTH, sizeof(buffer) - 1));
 }
 
 void Clock::displayTime() {
-  printStyledBorder(true);
+  m_frame.clear();
+  appendStyledBorder(m_frame, 2);
+  appendTitleLine(m_frame);
+  m_frame += '\n';
+  appendTimeLine(m_frame);
+  m_frame += '\n';
+  appendStyledBorder(m_frame, 2);
+  *m_out << m_frame << std::flush;
+}
+
+void Clock::runLive(int seconds) {
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  const auto TICK = std::chrono::seconds(1);
+  // Wide enough for the stats line, which is the longest
+  const int LIVE_WIDTH = 128;
+  const int TIME_ROW = 2;
+  const int STATS_ROW = 4;
+
+  LiveStats stats;
+  mini_utils::Screen screen(LIVE_WIDTH, STATS_ROW + 1);
 
-  cout << m_formatter.formatCentered("12-Hour Clock") << CLOCK_SEPARATOR
-       << m_formatter.formatCentered("24-Hour Clock") << endl;
+  // Full frame once; later frames only patch the time and stats lines
+  m_frame.clear();
+  appendStyledBorder(m_frame, 2);
+  appendTitleLine(m_frame);
+  screen.writeLines(0, m_frame);
+  appendTimeLine(screen.beginLine(TIME_ROW));
+  m_frame.clear();
+  appendStyledBorder(m_frame, 2);
+  screen.writeLines(TIME_ROW + 1, m_frame);
+  appendStatsLine(screen.beginLine(STATS_ROW), stats);
+  screen.present(*m_out);
 
-  cout << m_formatter.formatCentered(getFormattedTime12Hours())
-       << CLOCK_SEPARATOR
-       << m_formatter.formatCentered(getFormattedTime24Hours()) << endl;
+  const auto START = steady_clock::now();
+  int tick = 1;
+  while (tick <= seconds) {
+    // Absolute deadlines: a late wake-up does not delay the following ticks
+    const auto DEADLINE = START + tick * TICK;
+    std::this_thread::sleep_until(DEADLINE);
+    const auto WOKE_UP = steady_clock::now();
 
-  printStyledBorder(true);
+    const double JITTER_US =
+        duration<double, std::micro>(WOKE_UP - DEADLINE).count();
+    ++stats.ticks;
+    stats.totalJitterUs += JITTER_US;
+    stats.maxJitterUs = std::max(stats.maxJitterUs, JITTER_US);
+
+    // Catch up on every tick that fell due while the process was not running
+    while (tick <= seconds && START + tick * TICK <= WOKE_UP) {
+      addOneSecond();
+      ++tick;
+    }
+
+    const auto RENDER_START = steady_clock::now();
+    appendTimeLine(screen.beginLine(TIME_ROW));
+    appendStatsLine(screen.beginLine(STATS_ROW), stats);
+    // One write per frame
+    screen.present(*m_out);
+
+    stats.lastRenderUs =
+        duration<double, std::micro>(steady_clock::now() - RENDER_START)
+            .count();
+    stats.maxRenderUs = std::max(stats.maxRenderUs, stats.lastRenderUs);
+  }
 }
 
 // TODO: check whether the formatter is leaking
 // Maybe even make a dependency injection for formatter
-Clock::Clock() : m_hours(0), m_minutes(0), m_seconds(0), m_formatter(m_width) {}
+Clock::Clock() : m_secondsOfDay(0), m_formatter(m_width) {}
+
+Clock::Clock(int hours, int minutes, int seconds) : m_formatter(m_width) {
+  addSeconds(static_cast<long long>(hours) * SECONDS_PER_HOUR +
+             static_cast<long long>(minutes) * SECONDS_PER_MINUTE + seconds);
+}
 
-Clock::Clock(int hours, int minutes, int seconds)
-    : m_hours(hours),
-      m_minutes(minutes),
-      m_seconds(seconds),
-      m_formatter(m_width) {}
+void Clock::setStreams(std::istream& in, std::ostream& out) {
+  m_in = &in;
+  m_out = &out;
+}
 
 void Clock::displayMenu() {
-  printStyledBorder();
-  cout << m_formatter.formatSideBorder("1 - Add One Hour") << endl
-       << m_formatter.formatSideBorder("2 - Add One Minute") << endl
-       << m_formatter.formatSideBorder("3 - Add One Second") << endl
-       << m_formatter.formatSideBorder("4 - Exit Program") << endl;
-  printStyledBorder();
+  if (m_width == DEFAULT_WIDTH) {
+    m_out->write(MENU_FRAME.data(), MENU_FRAME.size());
+    m_out->flush();
+    return;
+  }
+
+  m_frame.clear();
+  appendStyledBorder(m_frame);
+  for (const char* ITEM : MENU_ITEMS) {
+    m_formatter.appendSideBorder(m_frame, ITEM);
+    m_frame += '\n';
+  }
+  appendStyledBorder(m_frame);
+  *m_out << m_frame << std::flush;
 }
 
 void Clock::getTimeFromUser() {
-  std::cout << "Please enter time in 24-hour format:" << std::endl;
+  *m_out << "Please enter time in 24-hour format:" << std::endl;
 
   // Collect input from user
-  m_hours = mini_utils::getValidatedInput<int>(
-      "Hours: ",
+  const int HOURS = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Hours: ",
       [](const int& HOURS_INPUT) {
         return HOURS_INPUT >= 0 && HOURS_INPUT <= 23;
       },
       "integer in range from 0 to 23");
 
-  m_minutes = mini_utils::getValidatedInput<int>(
-      "Minutes: ",
+  const int MINUTES = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Minutes: ",
       [](const int& MINUTES_INPUT) {
         return MINUTES_INPUT >= 0 && MINUTES_INPUT <= 59;
       },
       "integer in range from 0 to 59");
 
-  m_seconds = mini_utils::getValidatedInput<int>(
-      "Seconds: ",
+  const int SECONDS = mini_utils::getValidatedInput<int>(
+      *m_in, *m_out, "Seconds: ",
       [](const int& SECONDS_INPUT) {
         return SECONDS_INPUT >= 0 && SECONDS_INPUT <= 59;
       },
       "integer in range from 0 to 59");
-}
 
-string Clock::getFormattedTime24Hours() const {
-  return formatTime(m_hours, "", m_minutes, m_seconds);
+  m_secondsOfDay =
+      HOURS * SECONDS_PER_HOUR + MINUTES * SECONDS_PER_MINUTE + SECONDS;
 }
 
-string Clock::getFormattedTime12Hours() const {
-  unsigned short formattedHours = (m_hours % 12 == 0) ? 12 : m_hours % 12;
-  string period = (m_hours >= 12) ? " PM" : " AM";
-  return formatTime(formattedHours, period, m_minutes, m_seconds);
+bool Clock::addTimeZone(const string& NAME) {
+  TimeZone zone;
+  if (!TimeZone::load(NAME, zone)) {
+    return false;
+  }
+  m_timeZones.push_back(std::move(zone));
+  return true;
 }
 
-string Clock::formatTime(unsigned short hours, const string& PERIOD,
-                         unsigned short minutes, unsigned short seconds) const {
-  std::ostringstream oss;
-  oss << std::setfill('0') << std::setw(2) << hours << ":" << std::setw(2)
-      << minutes << ":" << std::setw(2) << seconds << PERIOD;
-  return oss.str();
+void Clock::displayWorldTime() {
+  if (m_timeZones.empty()) {
+    m_timeZones.push_back(TimeZone::utc());
+  }
+
+  // Clock time on the current UTC day
+  const long long NOW = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+  const long long UTC_SECONDS = NOW - wrapToDay(NOW) + m_secondsOfDay;
+
+  std::vector<string> names;
+  std::vector<string> times;
+  std::vector<string> offsets;
+  for (TimeZone& zone : m_timeZones) {
+    const TimeZone::LocalTimeType& TYPE =
+        zone.getLocalTimeTypeCached(UTC_SECONDS);
+    const int LOCAL_TIME = wrapToDay(UTC_SECONDS + TYPE.utcOffset);
+    const int OFFSET_MINUTES = std::abs(TYPE.utcOffset) / SECONDS_PER_MINUTE;
+
+    char offset[32];
+    std::snprintf(offset, sizeof(offset), "UTC%c%02d:%02d",
+                  TYPE.utcOffset < 0 ? '-' : '+', OFFSET_MINUTES / 60,
+                  OFFSET_MINUTES % 60);
+
+    names.push_back(zone.getName());
+    times.emplace_back(TIME_24_HOURS_LENGTH, ' ');
+    formatTime24Hours(LOCAL_TIME, times.back().data());
+    offsets.push_back(TYPE.abbreviation + " " + offset);
+  }
+
+  const int COLUMNS = static_cast<int>(m_timeZones.size());
+  m_frame.clear();
+  appendStyledBorder(m_frame, COLUMNS);
+  appendColumns(m_frame, names);
+  m_frame += '\n';
+  appendColumns(m_frame, times);
+  m_frame += '\n';
+  appendColumns(m_frame, offsets);
+  m_frame += '\n';
+  appendStyledBorder(m_frame, COLUMNS);
+  *m_out << m_frame << std::flush;
 }
 
 bool Clock::execInstructionFromUser() {
   int choice = mini_utils::getValidatedInput<int>(
-      "Enter your choice: ",
-      [](int input) { return input >= 1 && input <= 4; });
+      *m_in, *m_out, "Enter your choice: ",
+      [](int input) { return input >= 1 && input <= 6; });
   switch (choice) {
     case 1:
       addOneHour();
@@ -117,48 +287,74 @@ bool Clock::execInstructionFromUser() {
       displayTime();
       break;
     case 4:
-      cout << m_formatter.formatSideBorder("Exiting program...");
+      *m_out << m_formatter.formatSideBorder("Exiting program...");
       return false;
+    case 5:
+      runLive(mini_utils::getValidatedInput<int>(
+          *m_in, *m_out, "Seconds to run: ",
+          [](int input) { return input >= 1 && input <= MAX_LIVE_SECONDS; },
+          "integer in range from 1 to " + std::to_string(MAX_LIVE_SECONDS)));
+      break;
+    case 6:
+      displayWorldTime();
+      break;
   }
   return true;
 }
 
-void Clock::addOneSecond() {
-  ++m_seconds;
-  adjustTime();
-}
+void Clock::addOneSecond() { addSeconds(1); }
 
-void Clock::addOneMinute() {
-  ++m_minutes;
-  adjustTime();
-}
+void Clock::addOneMinute() { addSeconds(SECONDS_PER_MINUTE); }
 
-void Clock::addOneHour() {
-  ++m_hours;
-  adjustTime();
+void Clock::addOneHour() { addSeconds(SECONDS_PER_HOUR); }
+
+void Clock::addSeconds(long long seconds) {
+  // Reduce first: the sum of two values below a day cannot overflow
+  m_secondsOfDay = wrapToDay(m_secondsOfDay + seconds % SECONDS_PER_DAY);
+  if (m_alarmScheduler != nullptr) {
+    m_alarmScheduler->advance(seconds);
+  }
 }
 
-void Clock::adjustTime() {
-  // Helper lambda to adjust time units
-  auto adjustUnit = [](unsigned short& unit, unsigned short maxLimit) {
-    if (unit >= maxLimit) {
-      unsigned short overflow = unit / maxLimit;
-      unit %= maxLimit;
-      return overflow;
+void Clock::addDurations(const std::vector<long long>& DURATIONS) {
+  // Each reduced term is below a day in magnitude, so the running sum stays
+  // far from overflow for any batch that fits in memory
+  long long total = m_secondsOfDay;
+  for (const long long DURATION : DURATIONS) {
+    total += DURATION % SECONDS_PER_DAY;
+  }
+  m_secondsOfDay = wrapToDay(total);
+
+  // Durations back in time are skipped, see setAlarmScheduler
+  if (m_alarmScheduler != nullptr) {
+    for (const long long DURATION : DURATIONS) {
+      m_alarmScheduler->advance(DURATION);
     }
-    return (unsigned short)0;
-  };
+  }
+}
+
+int Clock::getSecondsOfDay() const { return m_secondsOfDay; }
 
-  // Adjust seconds, minutes, and hours
-  m_minutes += adjustUnit(m_seconds, 60);  // Adjust seconds to minutes
-  m_hours += adjustUnit(m_minutes, 60);    // Adjust minutes to hours
-  adjustUnit(m_hours, 24);                 // Adjust hours to 24-hour format
+void Clock::setAlarmScheduler(AlarmScheduler* scheduler) {
+  m_alarmScheduler = scheduler;
+}
+
+int Clock::wrapToDay(long long seconds) {
+  // C++ remainder keeps the sign of the dividend, so shift negatives up
+  const long long REMAINDER = seconds % SECONDS_PER_DAY;
+  return static_cast<int>(REMAINDER < 0 ? REMAINDER + SECONDS_PER_DAY
+                                        : REMAINDER);
 }
 
 void Clock::startCli() {
-  getTimeFromUser();
-  do {
-    displayMenu();
-  } while (execInstructionFromUser());
+  try {
+    getTimeFromUser();
+    do {
+      displayMenu();
+    } while (execInstructionFromUser());
+  } catch (const mini_utils::InputEndedError&) {
+    // The input ended without choosing to exit, e.g. at the end of a script
+    *m_out << std::endl;
+  }
 }
 }  // namespace clock_cli
\ No newline at end of file
@@ -1,46 +1,87 @@
 #ifndef CLOCK_H
 #define CLOCK_H
+#include <chrono>
+#include <iostream>
 #include <string>
+#include <vector>
 
+#include "alarm_scheduler.h"
 #include "mini_utils.h"
+#include "time_zone.h"
 
 namespace clock_cli {
 using std::string;
 
+// Clock formatting width the menu is laid out for at compile time
+const unsigned short DEFAULT_WIDTH = 26;
+
+const int SECONDS_PER_MINUTE = 60;
+const int SECONDS_PER_HOUR = 60 * SECONDS_PER_MINUTE;
+const int SECONDS_PER_DAY = 24 * SECONDS_PER_HOUR;
+
 class Clock {
  private:
-  // Expected range of values is 0..60,
-  // hence unsigned short int, which ranges 0..65535
-  unsigned short m_hours = 0;
-  unsigned short m_minutes = 0;
-  unsigned short m_seconds = 0;
+  // Time as seconds since midnight, always in range 0..SECONDS_PER_DAY - 1.
+  // Hours, minutes and seconds are decoded only when the time is formatted.
+  int m_secondsOfDay = 0;
 
   // Clock formatting width, expected range 0..1000 (ultra wide screen)
-  unsigned short m_width = 26;
+  unsigned short m_width = DEFAULT_WIDTH;
 
   mini_utils::StringFormatter m_formatter;
 
+  // Streams the CLI talks through, the console unless replaced
+  std::istream* m_in = &std::cin;
+  std::ostream* m_out = &std::cout;
+
+  // Output buffer reused by every redraw, written with a single call
+  string m_frame;
+
   // Separator between 24- and 12-hour clocks
   const string CLOCK_SEPARATOR = "    ";
 
-  // Print border composed of start characters, optionally formatted for two
-  // clocks
-  void printStyledBorder(bool doubleBorder = false);
+  // Tick timing of the live mode
+  struct LiveStats {
+    long long ticks = 0;
+    double totalJitterUs = 0;  // Lateness of wake-ups past their deadline
+    double maxJitterUs = 0;
+    double lastRenderUs = 0;  // Time to build and write a frame
+    double maxRenderUs = 0;
+  };
+
+  // Zones shown side by side by the world clock, loaded once at startup
+  std::vector<TimeZone> m_timeZones;
+
+  // Advanced along with the time, if set
+  AlarmScheduler* m_alarmScheduler = nullptr;
+
+  // Append border composed of star characters, one per clock column
+  void appendStyledBorder(string& out, int columns = 1) const;
+
+  // Append the cells centered in clock columns, without line break
+  void appendColumns(string& out, const std::vector<string>& CELLS) const;
 
-  // Get formatted time in 12-hour formats
-  string getFormattedTime12Hours() const;
+  // Append the "12-Hour Clock" and "24-Hour Clock" titles, without line break
+  void appendTitleLine(string& out) const;
 
-  // Get formatted time in 24-hour formats
-  string getFormattedTime24Hours() const;
+  // Append the time in both formats, without line break
+  void appendTimeLine(string& out) const;
 
-  // Adjust the time by carrying over values. For example, if seconds >= 60,
-  // they will be converted to minutes.
-  void adjustTime();
+  // Append the live mode jitter and render time readout, without line break
+  void appendStatsLine(string& out, const LiveStats& STATS) const;
+
+  // Wrap any number of seconds into the range of a day, so that negative
+  // durations count back from midnight
+  static int wrapToDay(long long seconds);
 
  public:
   Clock();
   Clock(int hours, int minutes, int seconds);
 
+  // Talk through the given streams instead of the console, e.g. to replay
+  // a scripted session. The streams must outlive the clock.
+  void setStreams(std::istream& in, std::ostream& out);
+
   // Display the time menu for user interaction
   void displayMenu();
 
@@ -62,11 +103,37 @@ class Clock {
   // Add one hour to the time
   void addOneHour();
 
-  // Helper to get 12- or 24-hours formatted time
-  string formatTime(unsigned short hours, const string& PERIOD,
-                    unsigned short minutes, unsigned short seconds) const;
+  // Add a signed duration of any length to the time, wrapping around midnight
+  void addSeconds(long long seconds);
+
+  // Add every duration in order. The durations are summed modulo a day
+  // first, so the whole batch costs one wrap instead of one per duration.
+  void addDurations(const std::vector<long long>& DURATIONS);
+
+  // Seconds since midnight, 0..SECONDS_PER_DAY - 1
+  int getSecondsOfDay() const;
+
+  // Advance the scheduler by every forward move of the time, however long,
+  // firing the alarms due on the way. Moving the time back leaves the
+  // scheduler alone, as it counts elapsed time. The scheduler must outlive
+  // the clock; nullptr detaches it.
+  void setAlarmScheduler(AlarmScheduler* scheduler);
+
+  // Tick in real time for the given number of seconds. Ticks are scheduled
+  // against absolute steady_clock deadlines, so lateness never accumulates,
+  // and every frame redraws only the characters that changed.
+  void runLive(int seconds);
+
+  // Load a zone by its IANA name, e.g. "Europe/Berlin", for the world clock.
+  // Returns false if the zone is not in the local tzdata.
+  bool addTimeZone(const string& NAME);
+
+  // Print the clock time, read as UTC of the current day, in every added
+  // zone side by side, or in UTC if none were added
+  void displayWorldTime();
 
-  // Start the command-line interface (CLI) for interacting with the clock
+  // Start the command-line interface (CLI) for interacting with the clock.
+  // Returns once the user exits or the input ends.
   void startCli();
 };
 
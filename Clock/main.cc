@@ -3,10 +3,19 @@
  * the same time.
  */
 
+#include <iostream>
+
 #include "clock.h"
 
-int main() {
+// Arguments are IANA time zone names shown by the world clock, e.g.
+// "Europe/Berlin America/New_York"
+int main(int argc, char* argv[]) {
   clock_cli::Clock clock;
+  for (int i = 1; i < argc; ++i) {
+    if (!clock.addTimeZone(argv[i])) {
+      std::cerr << "Unknown time zone: " << argv[i] << std::endl;
+    }
+  }
   clock.startCli();
 
   return 0;
@@ -0,0 +1,143 @@
+#include "time_format.h"
+
+#include <array>
+#include <cstring>
+
+namespace clock_cli {
+namespace {
+const int SECONDS_IN_MINUTE = 60;
+const int SECONDS_IN_HOUR = 60 * 60;
+const unsigned char NOT_A_DIGIT = 0xFF;
+
+// "00", "01", ..., "99" back to back, so a pair is copied with one memcpy
+constexpr std::array<char, 200> makeDigitPairs() {
+  std::array<char, 200> pairs{};
+  for (int i = 0; i < 100; ++i) {
+    pairs[i * 2] = static_cast<char>('0' + i / 10);
+    pairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
+  }
+  return pairs;
+}
+
+// Value of every character, NOT_A_DIGIT for anything but '0'..'9'
+constexpr std::array<unsigned char, 256> makeDigitValues() {
+  std::array<unsigned char, 256> values{};
+  for (int i = 0; i < 256; ++i) {
+    values[i] = i >= '0' && i <= '9' ? static_cast<unsigned char>(i - '0')
+                                     : NOT_A_DIGIT;
+  }
+  return values;
+}
+
+constexpr auto DIGIT_PAIRS = makeDigitPairs();
+constexpr auto DIGIT_VALUES = makeDigitValues();
+
+inline void writeTwoDigits(char* out, int value) {
+  std::memcpy(out, DIGIT_PAIRS.data() + value * 2, 2);
+}
+
+// Two-digit number at TEXT, or -1 if either character is not a digit
+inline int readTwoDigits(const char* TEXT) {
+  const unsigned char TENS = DIGIT_VALUES[static_cast<unsigned char>(TEXT[0])];
+  const unsigned char ONES = DIGIT_VALUES[static_cast<unsigned char>(TEXT[1])];
+  if (TENS == NOT_A_DIGIT || ONES == NOT_A_DIGIT) {
+    return -1;
+  }
+  return TENS * 10 + ONES;
+}
+
+// "hh:mm:ss" with hours already converted to the wanted clock
+inline void writeClockTime(char* out, int hours, int secondsOfDay) {
+  writeTwoDigits(out, hours);
+  out[2] = ':';
+  writeTwoDigits(out + 3, secondsOfDay / SECONDS_IN_MINUTE % 60);
+  out[5] = ':';
+  writeTwoDigits(out + 6, secondsOfDay % SECONDS_IN_MINUTE);
+}
+
+// Reads "hh:mm:ss" with minutes and seconds validated, hours unchecked
+bool readClockTime(const char* TEXT, int& hours, int& minutesAndSeconds) {
+  const int HOURS = readTwoDigits(TEXT);
+  const int MINUTES = readTwoDigits(TEXT + 3);
+  const int SECONDS = readTwoDigits(TEXT + 6);
+  if (TEXT[2] != ':' || TEXT[5] != ':' || HOURS < 0 || MINUTES < 0 ||
+      MINUTES > 59 || SECONDS < 0 || SECONDS > 59) {
+    return false;
+  }
+  hours = HOURS;
+  minutesAndSeconds = MINUTES * SECONDS_IN_MINUTE + SECONDS;
+  return true;
+}
+
+// Shared batch loop: size the output once, then format in place
+template <size_t LENGTH, typename Format>
+void appendTimes(string& out, const std::vector<int>& SECONDS_OF_DAY,
+                 char delimiter, Format format) {
+  const size_t START = out.size();
+  out.resize(START + SECONDS_OF_DAY.size() * (LENGTH + 1));
+  char* position = out.data() + START;
+  for (const int SECONDS : SECONDS_OF_DAY) {
+    format(SECONDS, position);
+    position[LENGTH] = delimiter;
+    position += LENGTH + 1;
+  }
+}
+}  // namespace
+
+void formatTime24Hours(int secondsOfDay, char* out) {
+  writeClockTime(out, secondsOfDay / SECONDS_IN_HOUR, secondsOfDay);
+}
+
+void formatTime12Hours(int secondsOfDay, char* out) {
+  const int HOURS = secondsOfDay / SECONDS_IN_HOUR;
+  writeClockTime(out, HOURS % 12 == 0 ? 12 : HOURS % 12, secondsOfDay);
+  std::memcpy(out + TIME_24_HOURS_LENGTH, HOURS >= 12 ? " PM" : " AM", 3);
+}
+
+bool parseTime24Hours(std::string_view TEXT, int& secondsOfDay) {
+  int hours = 0;
+  int minutesAndSeconds = 0;
+  if (TEXT.size() != TIME_24_HOURS_LENGTH ||
+      !readClockTime(TEXT.data(), hours, minutesAndSeconds) || hours > 23) {
+    return false;
+  }
+  secondsOfDay = hours * SECONDS_IN_HOUR + minutesAndSeconds;
+  return true;
+}
+
+bool parseTime12Hours(std::string_view TEXT, int& secondsOfDay) {
+  int hours = 0;
+  int minutesAndSeconds = 0;
+  if (TEXT.size() != TIME_12_HOURS_LENGTH ||
+      !readClockTime(TEXT.data(), hours, minutesAndSeconds) || hours < 1 ||
+      hours > 12 || TEXT[8] != ' ' || TEXT[10] != 'M' ||
+      (TEXT[9] != 'A' && TEXT[9] != 'P')) {
+    return false;
+  }
+  // 12 AM is midnight and 12 PM is noon
+  const int HOURS_24 = hours % 12 + (TEXT[9] == 'P' ? 12 : 0);
+  secondsOfDay = HOURS_24 * SECONDS_IN_HOUR + minutesAndSeconds;
+  return true;
+}
+
+void appendTimes24Hours(string& out, const std::vector<int>& SECONDS_OF_DAY,
+                        char delimiter) {
+  appendTimes<TIME_24_HOURS_LENGTH>(out, SECONDS_OF_DAY, delimiter,
+                                    formatTime24Hours);
+}
+
+void appendTimes12Hours(string& out, const std::vector<int>& SECONDS_OF_DAY,
+                        char delimiter) {
+  appendTimes<TIME_12_HOURS_LENGTH>(out, SECONDS_OF_DAY, delimiter,
+                                    formatTime12Hours);
+}
+
+void appendTimeUnit(string& out, unsigned short value) {
+  if (value < 100) {
+    out.append(DIGIT_PAIRS.data() + value * 2, 2);
+    return;
+  }
+  out += std::to_string(value);
+}
+
+}  // namespace clock_cli
@@ -0,0 +1,46 @@
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Allocation-free formatting and parsing of times of day. Digits are written
+// and read two at a time through lookup tables instead of iostreams.
+namespace clock_cli {
+using std::string;
+
+// Length of "hh:mm:ss"
+const size_t TIME_24_HOURS_LENGTH = 8;
+
+// Length of "hh:mm:ss AM"
+const size_t TIME_12_HOURS_LENGTH = 11;
+
+// Write seconds since midnight (0..86399) as "hh:mm:ss" to OUT, which must
+// have room for TIME_24_HOURS_LENGTH characters. No terminator is written.
+void formatTime24Hours(int secondsOfDay, char* out);
+
+// Write seconds since midnight (0..86399) as "hh:mm:ss AM" to OUT, which
+// must have room for TIME_12_HOURS_LENGTH characters. Midnight is 12 AM.
+void formatTime12Hours(int secondsOfDay, char* out);
+
+// Parse exactly "hh:mm:ss" with hours 00..23. Returns false if the text is
+// malformed or out of range, leaving SECONDS_OF_DAY unchanged.
+bool parseTime24Hours(std::string_view TEXT, int& secondsOfDay);
+
+// Parse exactly "hh:mm:ss AM" or "hh:mm:ss PM" with hours 01..12
+bool parseTime12Hours(std::string_view TEXT, int& secondsOfDay);
+
+// Append every time formatted, each followed by DELIMITER. The output grows
+// once for the whole batch.
+void appendTimes24Hours(string& out, const std::vector<int>& SECONDS_OF_DAY,
+                        char delimiter = '\n');
+void appendTimes12Hours(string& out, const std::vector<int>& SECONDS_OF_DAY,
+                        char delimiter = '\n');
+
+// Append a time unit zero-padded to at least two digits, like
+// std::setw(2) with std::setfill('0')
+void appendTimeUnit(string& out, unsigned short value);
+
+}  // namespace clock_cli
+#endif  // TIME_FORMAT_H
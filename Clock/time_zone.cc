@@ -0,0 +1,439 @@
+#include "time_zone.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace clock_cli {
+namespace {
+const int SECONDS_IN_DAY = 24 * 60 * 60;
+const int SECONDS_IN_HOUR = 60 * 60;
+
+// Fixed part of a TZif header: magic, version, 15 reserved bytes, 6 counts
+const size_t HEADER_SIZE = 44;
+
+// Date part of a POSIX TZ rule: "Jn", "n" or "Mm.w.d"
+struct RuleDate {
+  char kind = 'M';
+  int month = 0;
+  int week = 0;
+  int weekday = 0;
+  int day = 0;  // Day number of the "Jn" and "n" forms
+  int time = 2 * SECONDS_IN_HOUR;  // Local time of the change, default 02:00
+};
+
+long long readBigEndian(const unsigned char* bytes, int size) {
+  unsigned long long value = 0;
+  for (int i = 0; i < size; ++i) {
+    value = (value << 8) | bytes[i];
+  }
+  // Sign extend 32-bit values
+  if (size == 4) {
+    return static_cast<int32_t>(static_cast<uint32_t>(value));
+  }
+  return static_cast<long long>(value);
+}
+
+bool isLeapYear(long long year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int getDaysInMonth(long long year, int month) {
+  const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && isLeapYear(year) ? 29 : DAYS[month - 1];
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date, and back. Both use
+// eras of 400 years, which repeat exactly.
+long long daysFromCivil(long long year, int month, int day) {
+  year -= month <= 2 ? 1 : 0;
+  const long long ERA = (year >= 0 ? year : year - 399) / 400;
+  const long long YEAR_OF_ERA = year - ERA * 400;
+  const long long DAY_OF_YEAR =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const long long DAY_OF_ERA =
+      YEAR_OF_ERA * 365 + YEAR_OF_ERA / 4 - YEAR_OF_ERA / 100 + DAY_OF_YEAR;
+  return ERA * 146097 + DAY_OF_ERA - 719468;
+}
+
+long long yearFromDays(long long days) {
+  days += 719468;
+  const long long ERA = (days >= 0 ? days : days - 146096) / 146097;
+  const long long DAY_OF_ERA = days - ERA * 146097;
+  const long long YEAR_OF_ERA =
+      (DAY_OF_ERA - DAY_OF_ERA / 1460 + DAY_OF_ERA / 36524 -
+       DAY_OF_ERA / 146096) /
+      365;
+  const long long DAY_OF_YEAR =
+      DAY_OF_ERA - (365 * YEAR_OF_ERA + YEAR_OF_ERA / 4 - YEAR_OF_ERA / 100);
+  const long long MONTH_INDEX = (5 * DAY_OF_YEAR + 2) / 153;  // March is 0
+  return YEAR_OF_ERA + ERA * 400 + (MONTH_INDEX >= 10 ? 1 : 0);
+}
+
+// Days since epoch of the day a rule date falls on in the given year
+long long getRuleDay(const RuleDate& DATE, long long year) {
+  const long long NEW_YEAR = daysFromCivil(year, 1, 1);
+  if (DATE.kind == 'J') {
+    // Day 1..365, February 29 is never counted
+    const bool IS_AFTER_LEAP_DAY = isLeapYear(year) && DATE.day >= 60;
+    return NEW_YEAR + DATE.day - 1 + (IS_AFTER_LEAP_DAY ? 1 : 0);
+  }
+  if (DATE.kind == 'N') {
+    return NEW_YEAR + DATE.day;  // Day 0..365, February 29 counted
+  }
+
+  // Weekday of the month, week 5 meaning the last one
+  const long long FIRST = daysFromCivil(year, DATE.month, 1);
+  const int FIRST_WEEKDAY = static_cast<int>(((FIRST + 4) % 7 + 7) % 7);
+  int dayOfMonth = (DATE.weekday - FIRST_WEEKDAY + 7) % 7 + (DATE.week - 1) * 7;
+  while (dayOfMonth >= getDaysInMonth(year, DATE.month)) {
+    dayOfMonth -= 7;
+  }
+  return FIRST + dayOfMonth;
+}
+
+bool parseNumber(const string& RULE, size_t& pos, int& number) {
+  const size_t START = pos;
+  number = 0;
+  while (pos < RULE.size() &&
+         std::isdigit(static_cast<unsigned char>(RULE[pos]))) {
+    number = number * 10 + (RULE[pos++] - '0');
+    if (number > 100000) {
+      return false;
+    }
+  }
+  return pos > START;
+}
+
+// Zone abbreviation, either alphabetic ("CET") or quoted ("<+03>")
+bool parseAbbreviation(const string& RULE, size_t& pos, string& abbreviation) {
+  const size_t START = pos;
+  if (pos < RULE.size() && RULE[pos] == '<') {
+    const size_t END = RULE.find('>', pos);
+    if (END == string::npos) {
+      return false;
+    }
+    abbreviation = RULE.substr(pos + 1, END - pos - 1);
+    pos = END + 1;
+    return true;
+  }
+  while (pos < RULE.size() &&
+         std::isalpha(static_cast<unsigned char>(RULE[pos]))) {
+    ++pos;
+  }
+  abbreviation = RULE.substr(START, pos - START);
+  return pos - START >= 3;
+}
+
+// Signed time "[+-]hh[:mm[:ss]]" in seconds
+bool parseTime(const string& RULE, size_t& pos, int& seconds) {
+  int sign = 1;
+  if (pos < RULE.size() && (RULE[pos] == '+' || RULE[pos] == '-')) {
+    sign = RULE[pos++] == '-' ? -1 : 1;
+  }
+  int hours = 0;
+  int minutes = 0;
+  int secondsPart = 0;
+  if (!parseNumber(RULE, pos, hours)) {
+    return false;
+  }
+  if (pos < RULE.size() && RULE[pos] == ':') {
+    ++pos;
+    if (!parseNumber(RULE, pos, minutes)) {
+      return false;
+    }
+    if (pos < RULE.size() && RULE[pos] == ':') {
+      ++pos;
+      if (!parseNumber(RULE, pos, secondsPart)) {
+        return false;
+      }
+    }
+  }
+  seconds = sign * (hours * SECONDS_IN_HOUR + minutes * 60 + secondsPart);
+  return true;
+}
+
+bool parseRuleDate(const string& RULE, size_t& pos, RuleDate& date) {
+  if (pos < RULE.size() && RULE[pos] == 'M') {
+    ++pos;
+    date.kind = 'M';
+    if (!parseNumber(RULE, pos, date.month) || pos >= RULE.size() ||
+        RULE[pos++] != '.' || !parseNumber(RULE, pos, date.week) ||
+        pos >= RULE.size() || RULE[pos++] != '.' ||
+        !parseNumber(RULE, pos, date.weekday)) {
+      return false;
+    }
+    if (date.month < 1 || date.month > 12 || date.week < 1 || date.week > 5 ||
+        date.weekday > 6) {
+      return false;
+    }
+  } else {
+    date.kind = 'N';
+    if (pos < RULE.size() && RULE[pos] == 'J') {
+      ++pos;
+      date.kind = 'J';
+    }
+    if (!parseNumber(RULE, pos, date.day) || date.day > 365 ||
+        (date.kind == 'J' && date.day < 1)) {
+      return false;
+    }
+  }
+
+  if (pos < RULE.size() && RULE[pos] == '/') {
+    ++pos;
+    return parseTime(RULE, pos, date.time);
+  }
+  return true;
+}
+}  // namespace
+
+// Public
+TimeZone::TimeZone() : m_name("UTC"), m_types{{0, false, "UTC"}} {}
+
+bool TimeZone::load(const string& NAME, TimeZone& zone) {
+  // Zone names are relative paths inside the database
+  if (NAME.empty() || NAME[0] == '/' || NAME.find("..") != string::npos) {
+    return false;
+  }
+  return loadFile(string(ZONEINFO_DIRECTORY) + "/" + NAME, NAME, zone);
+}
+
+bool TimeZone::loadFile(const string& PATH, const string& NAME,
+                        TimeZone& zone) {
+  std::ifstream file(PATH, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  const std::vector<unsigned char> DATA(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  TimeZone parsed;
+  parsed.m_name = NAME;
+  if (!parsed.parse(DATA)) {
+    return false;
+  }
+  zone = std::move(parsed);
+  return true;
+}
+
+TimeZone TimeZone::utc() { return TimeZone(); }
+
+const string& TimeZone::getName() const { return m_name; }
+
+const TimeZone::LocalTimeType& TimeZone::getLocalTimeType(
+    long long utcSeconds) const {
+  long long start = 0;
+  long long end = 0;
+  return m_types[findTypeIndex(utcSeconds, start, end)];
+}
+
+int TimeZone::getUtcOffset(long long utcSeconds) const {
+  return getLocalTimeType(utcSeconds).utcOffset;
+}
+
+const TimeZone::LocalTimeType& TimeZone::getLocalTimeTypeCached(
+    long long utcSeconds) {
+  if (utcSeconds < m_cacheStart || utcSeconds >= m_cacheEnd) {
+    m_cacheType = findTypeIndex(utcSeconds, m_cacheStart, m_cacheEnd);
+  }
+  return m_types[m_cacheType];
+}
+
+int TimeZone::getUtcOffsetCached(long long utcSeconds) {
+  return getLocalTimeTypeCached(utcSeconds).utcOffset;
+}
+
+size_t TimeZone::getTransitionCount() const { return m_transitions.size(); }
+
+// Private
+size_t TimeZone::findTypeIndex(long long utcSeconds, long long& start,
+                               long long& end) const {
+  // First transition strictly after the time; the one before it is in effect
+  const size_t NEXT = std::upper_bound(m_transitions.begin(),
+                                       m_transitions.end(), utcSeconds) -
+                      m_transitions.begin();
+  start = NEXT == 0 ? LLONG_MIN : m_transitions[NEXT - 1];
+  end = NEXT == m_transitions.size() ? LLONG_MAX : m_transitions[NEXT];
+  return NEXT == 0 ? 0 : m_transitionTypes[NEXT - 1];
+}
+
+bool TimeZone::parse(const std::vector<unsigned char>& DATA) {
+  size_t offset = 0;
+  int timeSize = 4;
+  for (int block = 0; block < 2; ++block) {
+    if (DATA.size() < offset + HEADER_SIZE ||
+        !std::equal(DATA.begin() + offset, DATA.begin() + offset + 4, "TZif")) {
+      return false;
+    }
+    const unsigned char VERSION = DATA[offset + 4];
+    const unsigned char* COUNTS = DATA.data() + offset + 20;
+    const size_t UT_COUNT = readBigEndian(COUNTS, 4);
+    const size_t STANDARD_COUNT = readBigEndian(COUNTS + 4, 4);
+    const size_t LEAP_COUNT = readBigEndian(COUNTS + 8, 4);
+    const size_t TIME_COUNT = readBigEndian(COUNTS + 12, 4);
+    const size_t TYPE_COUNT = readBigEndian(COUNTS + 16, 4);
+    const size_t CHAR_COUNT = readBigEndian(COUNTS + 20, 4);
+    const size_t BLOCK_SIZE = TIME_COUNT * (timeSize + 1) + TYPE_COUNT * 6 +
+                              CHAR_COUNT + LEAP_COUNT * (timeSize + 4) +
+                              STANDARD_COUNT + UT_COUNT;
+    offset += HEADER_SIZE;
+    if (DATA.size() < offset + BLOCK_SIZE) {
+      return false;
+    }
+
+    // Version 2+ files repeat the data with 64-bit times after the first
+    // block, which only exists for old readers
+    if (block == 0 && VERSION >= '2') {
+      offset += BLOCK_SIZE;
+      timeSize = 8;
+      continue;
+    }
+
+    if (TYPE_COUNT == 0 || TYPE_COUNT > 256) {
+      return false;
+    }
+    const unsigned char* TIMES = DATA.data() + offset;
+    const unsigned char* INDICES = TIMES + TIME_COUNT * timeSize;
+    const unsigned char* TYPES = INDICES + TIME_COUNT;
+    const char* CHARS =
+        reinterpret_cast<const char*>(TYPES + TYPE_COUNT * 6);
+
+    m_types.clear();
+    for (size_t i = 0; i < TYPE_COUNT; ++i) {
+      const unsigned char* TYPE = TYPES + i * 6;
+      const size_t ABBREVIATION_INDEX = TYPE[5];
+      if (ABBREVIATION_INDEX >= CHAR_COUNT) {
+        return false;
+      }
+      const char* ABBREVIATION = CHARS + ABBREVIATION_INDEX;
+      const size_t LENGTH = std::find(ABBREVIATION, CHARS + CHAR_COUNT, '\0') -
+                            ABBREVIATION;
+      m_types.push_back({static_cast<int>(readBigEndian(TYPE, 4)),
+                         TYPE[4] != 0, string(ABBREVIATION, LENGTH)});
+    }
+
+    m_transitions.resize(TIME_COUNT);
+    m_transitionTypes.resize(TIME_COUNT);
+    for (size_t i = 0; i < TIME_COUNT; ++i) {
+      m_transitions[i] = readBigEndian(TIMES + i * timeSize, timeSize);
+      m_transitionTypes[i] = INDICES[i];
+      if (INDICES[i] >= TYPE_COUNT ||
+          (i > 0 && m_transitions[i] <= m_transitions[i - 1])) {
+        return false;
+      }
+    }
+    offset += BLOCK_SIZE;
+
+    // Footer of version 2+ files: the rule for times after the last
+    // transition, enclosed in newlines
+    if (timeSize == 8 && offset < DATA.size() && DATA[offset] == '\n') {
+      const auto RULE_END =
+          std::find(DATA.begin() + offset + 1, DATA.end(), '\n');
+      if (RULE_END != DATA.end() &&
+          !applyFooterRule(string(DATA.begin() + offset + 1, RULE_END))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+bool TimeZone::applyFooterRule(const string& RULE) {
+  if (RULE.empty()) {
+    return true;  // No rule, the last transition stays in effect
+  }
+
+  // POSIX offsets count west of Greenwich, hence the negation
+  LocalTimeType standard;
+  size_t pos = 0;
+  if (!parseAbbreviation(RULE, pos, standard.abbreviation) ||
+      !parseTime(RULE, pos, standard.utcOffset)) {
+    return false;
+  }
+  standard.utcOffset = -standard.utcOffset;
+  if (pos == RULE.size()) {
+    // Without daylight saving the zone keeps one offset, which the
+    // transitions already end with
+    if (m_transitions.empty()) {
+      m_types.assign(1, standard);
+    }
+    return true;
+  }
+
+  LocalTimeType daylight;
+  daylight.isDst = true;
+  if (!parseAbbreviation(RULE, pos, daylight.abbreviation)) {
+    return false;
+  }
+  daylight.utcOffset = standard.utcOffset + SECONDS_IN_HOUR;
+  if (pos < RULE.size() && RULE[pos] != ',') {
+    if (!parseTime(RULE, pos, daylight.utcOffset)) {
+      return false;
+    }
+    daylight.utcOffset = -daylight.utcOffset;
+  }
+
+  RuleDate start;
+  RuleDate end;
+  if (pos >= RULE.size() || RULE[pos++] != ',' ||
+      !parseRuleDate(RULE, pos, start) || pos >= RULE.size() ||
+      RULE[pos++] != ',' || !parseRuleDate(RULE, pos, end) ||
+      pos != RULE.size()) {
+    return false;
+  }
+
+  if (m_types.size() > 254) {
+    return false;  // No room for two more types in an unsigned char index
+  }
+  const unsigned char STANDARD_TYPE = findOrAddType(standard);
+  const unsigned char DAYLIGHT_TYPE = findOrAddType(daylight);
+
+  // Rule transitions begin in the year of the last listed one
+  const long long LAST_LISTED =
+      m_transitions.empty() ? LLONG_MIN : m_transitions.back();
+  const long long FIRST_YEAR =
+      m_transitions.empty()
+          ? 1970
+          : yearFromDays(LAST_LISTED / SECONDS_IN_DAY -
+                         (LAST_LISTED % SECONDS_IN_DAY < 0 ? 1 : 0));
+  for (long long year = FIRST_YEAR; year <= LAST_PRECOMPUTED_YEAR; ++year) {
+    // Daylight time starts at local standard time and ends at local
+    // daylight time
+    long long changes[2] = {
+        getRuleDay(start, year) * SECONDS_IN_DAY + start.time -
+            standard.utcOffset,
+        getRuleDay(end, year) * SECONDS_IN_DAY + end.time -
+            daylight.utcOffset};
+    unsigned char types[2] = {DAYLIGHT_TYPE, STANDARD_TYPE};
+    // Southern hemisphere zones end daylight time first
+    if (changes[1] < changes[0]) {
+      std::swap(changes[0], changes[1]);
+      std::swap(types[0], types[1]);
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (changes[i] > LAST_LISTED) {
+        m_transitions.push_back(changes[i]);
+        m_transitionTypes.push_back(types[i]);
+      }
+    }
+  }
+  return true;
+}
+
+unsigned char TimeZone::findOrAddType(const LocalTimeType& TYPE) {
+  for (size_t i = 0; i < m_types.size(); ++i) {
+    if (m_types[i].utcOffset == TYPE.utcOffset &&
+        m_types[i].isDst == TYPE.isDst &&
+        m_types[i].abbreviation == TYPE.abbreviation) {
+      return static_cast<unsigned char>(i);
+    }
+  }
+  m_types.push_back(TYPE);
+  return static_cast<unsigned char>(m_types.size() - 1);
+}
+
+}  // namespace clock_cli
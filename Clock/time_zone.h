@@ -0,0 +1,88 @@
+#ifndef TIME_ZONE_H
+#define TIME_ZONE_H
+
+#include <string>
+#include <vector>
+
+namespace clock_cli {
+using std::string;
+
+// Directory the IANA time zone database is installed to
+inline constexpr const char* ZONEINFO_DIRECTORY = "/usr/share/zoneinfo";
+
+// Transitions from the footer rule are precomputed up to this year, later
+// times keep the offset of the last transition
+const int LAST_PRECOMPUTED_YEAR = 2100;
+
+// Time zone loaded once from a compiled tzdata (TZif) file into compact
+// sorted transition arrays, so that a conversion is a binary search or, for
+// times close to the previous one, a check against the cached interval.
+class TimeZone {
+ public:
+  // Offset from UTC together with its abbreviation, e.g. +3600 "CET"
+  struct LocalTimeType {
+    int utcOffset = 0;
+    bool isDst = false;
+    string abbreviation;
+  };
+
+  TimeZone();
+
+  // Load a zone by its IANA name, e.g. "Europe/Berlin", from
+  // ZONEINFO_DIRECTORY. Returns false if the file is missing or malformed.
+  static bool load(const string& NAME, TimeZone& zone);
+
+  // Load a zone from a TZif file at PATH under the given display NAME
+  static bool loadFile(const string& PATH, const string& NAME, TimeZone& zone);
+
+  // Coordinated Universal Time, available without tzdata
+  static TimeZone utc();
+
+  const string& getName() const;
+
+  // Local time type in effect at the given UTC time (seconds since epoch)
+  const LocalTimeType& getLocalTimeType(long long utcSeconds) const;
+
+  // Offset from UTC in seconds, found by binary search
+  int getUtcOffset(long long utcSeconds) const;
+
+  // Same as getUtcOffset, but remembers the interval between the two
+  // transitions around the last lookup. Consecutive lookups of nearby times,
+  // such as the frames of a running clock, then cost two comparisons.
+  int getUtcOffsetCached(long long utcSeconds);
+  const LocalTimeType& getLocalTimeTypeCached(long long utcSeconds);
+
+  size_t getTransitionCount() const;
+
+ private:
+  string m_name;
+
+  // Sorted UTC times of offset changes and the type that starts at each.
+  // Times before the first transition use type 0.
+  std::vector<long long> m_transitions;
+  std::vector<unsigned char> m_transitionTypes;
+  std::vector<LocalTimeType> m_types;
+
+  // Interval [m_cacheStart, m_cacheEnd) of the last cached lookup and the
+  // type in effect during it
+  long long m_cacheStart = 0;
+  long long m_cacheEnd = 0;
+  size_t m_cacheType = 0;
+
+  // Index of the type in effect, and the interval it is in effect for
+  size_t findTypeIndex(long long utcSeconds, long long& start,
+                       long long& end) const;
+
+  // Parse the TZif data, preferring the 64-bit block of version 2+ files
+  bool parse(const std::vector<unsigned char>& DATA);
+
+  // Extend the transitions with the POSIX TZ rule from the file footer, such
+  // as "CET-1CEST,M3.5.0,M10.5.0/3", up to LAST_PRECOMPUTED_YEAR
+  bool applyFooterRule(const string& RULE);
+
+  // Index of the type with the given offset and abbreviation, added if new
+  unsigned char findOrAddType(const LocalTimeType& TYPE);
+};
+
+}  // namespace clock_cli
+#endif  // TIME_ZONE_H
@@ -0,0 +1,156 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "alarm_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "clock.h"
+
+namespace {
+// Fire times of every alarm, as the scheduler saw them
+class FireLog {
+ public:
+  clock_cli::AlarmScheduler::FireHandler GetHandler() {
+    return [this](clock_cli::AlarmId id) {
+      fires_.push_back({id, scheduler_->getTime()});
+    };
+  }
+
+  void SetScheduler(const clock_cli::AlarmScheduler* scheduler) {
+    scheduler_ = scheduler;
+  }
+
+  const std::vector<std::pair<clock_cli::AlarmId, long long>>& GetFires()
+      const {
+    return fires_;
+  }
+
+ private:
+  const clock_cli::AlarmScheduler* scheduler_ = nullptr;
+  std::vector<std::pair<clock_cli::AlarmId, long long>> fires_;
+};
+}  // namespace
+
+// Tests that alarms on every level fire in their exact second, tick by tick
+TEST(AlarmSchedulerTest, Advance_FiresOnTimeTickByTick) {
+  FireLog log;
+  clock_cli::AlarmScheduler scheduler(log.GetHandler());
+  log.SetScheduler(&scheduler);
+  const std::vector<long long> delays = {1,     2,     255,   256,  257,
+                                         511,   65535, 65536, 65537, 70000,
+                                         200000};
+  std::unordered_map<clock_cli::AlarmId, long long> due_times;
+  for (long long delay : delays) {
+    due_times[scheduler.schedule(delay)] = delay;
+  }
+  for (long long second = 0; second < 200000; ++second) {
+    scheduler.advance(1);
+  }
+
+  ASSERT_EQ(log.GetFires().size(), delays.size());
+  for (const auto& fire : log.GetFires()) {
+    EXPECT_EQ(fire.second, due_times[fire.first]);
+  }
+  EXPECT_EQ(scheduler.size(), 0u);
+}
+
+// Tests that random jumps fire every alarm at its due time and in order
+TEST(AlarmSchedulerTest, Advance_LargeJumpsCascade) {
+  FireLog log;
+  clock_cli::AlarmScheduler scheduler(log.GetHandler());
+  log.SetScheduler(&scheduler);
+  std::mt19937 random(7);
+  std::uniform_int_distribution<long long> delay(1, 10LL * 365 * 86400);
+  std::uniform_int_distribution<long long> jump(1, 40LL * 86400);
+
+  std::unordered_map<clock_cli::AlarmId, long long> due_times;
+  for (int i = 0; i < 20000; ++i) {
+    const long long due = scheduler.getTime() + delay(random);
+    due_times[scheduler.schedule(due - scheduler.getTime())] = due;
+    if (i % 100 == 0) {
+      scheduler.advance(jump(random));
+    }
+  }
+  while (scheduler.size() > 0) {
+    scheduler.advance(jump(random));
+  }
+
+  ASSERT_EQ(log.GetFires().size(), due_times.size());
+  long long previous = 0;
+  for (const auto& fire : log.GetFires()) {
+    EXPECT_EQ(fire.second, due_times[fire.first]);
+    EXPECT_GE(fire.second, previous);
+    previous = fire.second;
+  }
+}
+
+// Tests that recurring alarms repeat until cancelled from their handler
+TEST(AlarmSchedulerTest, Schedule_RecurringUntilCancelled) {
+  std::vector<long long> fire_times;
+  clock_cli::AlarmScheduler* scheduler_pointer = nullptr;
+  clock_cli::AlarmScheduler scheduler([&](clock_cli::AlarmId id) {
+    fire_times.push_back(scheduler_pointer->getTime());
+    if (fire_times.size() == 4) {
+      EXPECT_TRUE(scheduler_pointer->cancel(id));
+    }
+  });
+  scheduler_pointer = &scheduler;
+
+  scheduler.schedule(10, 300);
+  scheduler.advance(100000);
+  EXPECT_EQ(fire_times, (std::vector<long long>{10, 310, 610, 910}));
+  EXPECT_EQ(scheduler.size(), 0u);
+}
+
+// Tests that cancelled and stale ids are rejected and never fire
+TEST(AlarmSchedulerTest, Cancel_StaleIds) {
+  int fire_count = 0;
+  clock_cli::AlarmScheduler scheduler(
+      [&fire_count](clock_cli::AlarmId) { ++fire_count; });
+
+  const clock_cli::AlarmId first = scheduler.schedule(70000);
+  EXPECT_TRUE(scheduler.cancel(first));
+  EXPECT_FALSE(scheduler.cancel(first));
+  // The node is reused under a new id
+  const clock_cli::AlarmId second = scheduler.schedule(5);
+  EXPECT_NE(second, first);
+  EXPECT_FALSE(scheduler.cancel(first));
+  EXPECT_FALSE(scheduler.cancel(clock_cli::AlarmScheduler::INVALID_ALARM));
+
+  scheduler.advance(100000);
+  EXPECT_EQ(fire_count, 1);
+  EXPECT_FALSE(scheduler.cancel(second));
+
+  EXPECT_EQ(scheduler.schedule(-1), clock_cli::AlarmScheduler::INVALID_ALARM);
+  EXPECT_EQ(scheduler.schedule(
+                clock_cli::AlarmScheduler::MAX_DELAY_SECONDS + 1),
+            clock_cli::AlarmScheduler::INVALID_ALARM);
+}
+
+// Tests that the clock drives the scheduler forward, never back
+TEST(AlarmSchedulerTest, Clock_AdvancesScheduler) {
+  int fire_count = 0;
+  clock_cli::AlarmScheduler scheduler(
+      [&fire_count](clock_cli::AlarmId) { ++fire_count; });
+  clock_cli::Clock clock(23, 59, 59);
+  clock.setAlarmScheduler(&scheduler);
+  scheduler.schedule(2);
+  scheduler.schedule(clock_cli::SECONDS_PER_DAY * 3LL);
+
+  clock.addOneSecond();
+  clock.addSeconds(-10);
+  EXPECT_EQ(fire_count, 0);
+  clock.addOneSecond();
+  EXPECT_EQ(fire_count, 1);
+  clock.addDurations({clock_cli::SECONDS_PER_DAY, -5,
+                      clock_cli::SECONDS_PER_DAY * 2LL});
+  EXPECT_EQ(fire_count, 2);
+  EXPECT_EQ(scheduler.getTime(), 2 + clock_cli::SECONDS_PER_DAY * 3LL);
+}
@@ -0,0 +1,142 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "clock.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using clock_cli::Clock;
+using clock_cli::SECONDS_PER_DAY;
+using clock_cli::SECONDS_PER_HOUR;
+
+// Tests that adding time wraps past 23:59:59 to midnight and on
+TEST(ClockTest, AddSeconds_WrapsPastMidnight) {
+  Clock lastSecond(23, 59, 59);
+  lastSecond.addOneSecond();
+  EXPECT_EQ(lastSecond.getSecondsOfDay(), 0);
+
+  Clock lastMinute(23, 59, 30);
+  lastMinute.addOneMinute();
+  EXPECT_EQ(lastMinute.getSecondsOfDay(), 30);
+
+  Clock lastHour(23, 0, 0);
+  lastHour.addOneHour();
+  EXPECT_EQ(lastHour.getSecondsOfDay(), 0);
+
+  Clock evening(22, 0, 0);
+  evening.addSeconds(3 * SECONDS_PER_HOUR + 5);
+  EXPECT_EQ(evening.getSecondsOfDay(), SECONDS_PER_HOUR + 5);
+}
+
+// Tests that negative durations count back across midnight
+TEST(ClockTest, AddSeconds_NegativeDurations) {
+  Clock midnight(0, 0, 0);
+  midnight.addSeconds(-1);
+  EXPECT_EQ(midnight.getSecondsOfDay(), SECONDS_PER_DAY - 1);
+
+  Clock night(1, 0, 0);
+  night.addSeconds(-2 * SECONDS_PER_HOUR);
+  EXPECT_EQ(night.getSecondsOfDay(), 23 * SECONDS_PER_HOUR);
+
+  Clock noon(12, 0, 0);
+  noon.addSeconds(-12 * SECONDS_PER_HOUR);
+  EXPECT_EQ(noon.getSecondsOfDay(), 0);
+}
+
+// Tests that durations of several days only move the time of day
+TEST(ClockTest, AddSeconds_MultiDayDurations) {
+  Clock clock(6, 30, 0);
+  const int START = clock.getSecondsOfDay();
+  clock.addSeconds(3LL * SECONDS_PER_DAY);
+  EXPECT_EQ(clock.getSecondsOfDay(), START);
+  clock.addSeconds(-400LL * SECONDS_PER_DAY - 60);
+  EXPECT_EQ(clock.getSecondsOfDay(), START - 60);
+  clock.addSeconds(10LL * SECONDS_PER_DAY + SECONDS_PER_HOUR + 60);
+  EXPECT_EQ(clock.getSecondsOfDay(), START + SECONDS_PER_HOUR);
+
+  // The extremes of the type do not overflow
+  Clock forward(0, 0, 0);
+  forward.addSeconds(std::numeric_limits<long long>::max());
+  EXPECT_EQ(forward.getSecondsOfDay(),
+            std::numeric_limits<long long>::max() % SECONDS_PER_DAY);
+  Clock backward(0, 0, 0);
+  backward.addSeconds(std::numeric_limits<long long>::min());
+  EXPECT_EQ(backward.getSecondsOfDay(),
+            std::numeric_limits<long long>::min() % SECONDS_PER_DAY +
+                SECONDS_PER_DAY);
+}
+
+// Tests that a batch of durations lands where adding them one by one does
+TEST(ClockTest, AddDurations_MatchesAddSeconds) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<long long> duration(-5LL * SECONDS_PER_DAY,
+                                                    5LL * SECONDS_PER_DAY);
+  for (int batch = 0; batch < 100; ++batch) {
+    std::vector<long long> durations(batch % 20);
+    for (long long& seconds : durations) {
+      seconds = duration(random);
+    }
+    durations.push_back(std::numeric_limits<long long>::max());
+    durations.push_back(std::numeric_limits<long long>::min());
+
+    Clock batched(23, 59, 59);
+    Clock single(23, 59, 59);
+    batched.addDurations(durations);
+    for (long long seconds : durations) {
+      single.addSeconds(seconds);
+    }
+    EXPECT_EQ(batched.getSecondsOfDay(), single.getSecondsOfDay());
+  }
+
+  Clock clock(10, 0, 0);
+  clock.addDurations({});
+  EXPECT_EQ(clock.getSecondsOfDay(), 10 * SECONDS_PER_HOUR);
+}
+
+// Tests a scripted session through the injected streams
+TEST(ClockTest, StartCli_ReplaysSession) {
+  std::istringstream input("12\n30\n15\n3\n4\n");
+  std::ostringstream output;
+  Clock clock;
+  clock.setStreams(input, output);
+  clock.startCli();
+
+  const std::string TEXT = output.str();
+  EXPECT_EQ(TEXT.rfind("Please enter time in 24-hour format:\n"
+                       "Hours: Minutes: Seconds: ",
+                       0),
+            0u);
+  EXPECT_NE(TEXT.find("*      12:30:16 PM       *    "
+                      "*        12:30:16        *\n"),
+            std::string::npos);
+  EXPECT_EQ(TEXT.substr(TEXT.size() - 45),
+            "Enter your choice: * Exiting program...     *");
+  EXPECT_EQ(clock.getSecondsOfDay(), 12 * SECONDS_PER_HOUR + 30 * 60 + 16);
+}
+
+// Tests that the session ends when the input does, instead of prompting on
+// forever
+TEST(ClockTest, StartCli_EndsAtEndOfInput) {
+  std::istringstream input("12\n");
+  std::ostringstream output;
+  Clock clock;
+  clock.setStreams(input, output);
+  clock.startCli();
+  EXPECT_EQ(output.str(),
+            "Please enter time in 24-hour format:\nHours: Minutes: \n");
+
+  // At the menu, after an invalid choice
+  std::istringstream menuInput("1\n2\n3\n9\n");
+  std::ostringstream menuOutput;
+  Clock menuClock;
+  menuClock.setStreams(menuInput, menuOutput);
+  menuClock.startCli();
+  const std::string TEXT = menuOutput.str();
+  EXPECT_EQ(TEXT.substr(TEXT.size() - 21), "\nEnter your choice: \n");
+}
@@ -0,0 +1,113 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "time_format.h"
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+const int kSecondsPerDay = 24 * 60 * 60;
+
+// The ostringstream formatting Clock::formatTime used before the kernels
+std::string FormatWithStream(int seconds_of_day, bool twelve_hours) {
+  int hours = seconds_of_day / 3600;
+  std::string period;
+  if (twelve_hours) {
+    period = hours >= 12 ? " PM" : " AM";
+    hours = hours % 12 == 0 ? 12 : hours % 12;
+  }
+  std::ostringstream oss;
+  oss << std::setfill('0') << std::setw(2) << hours << ":" << std::setw(2)
+      << seconds_of_day / 60 % 60 << ":" << std::setw(2)
+      << seconds_of_day % 60 << period;
+  return oss.str();
+}
+}  // namespace
+
+// Tests the 24-hour kernel against the stream output for every second
+TEST(TimeFormatTest, FormatTime24Hours_MatchesStreamForWholeDay) {
+  char buffer[clock_cli::TIME_24_HOURS_LENGTH];
+  for (int second = 0; second < kSecondsPerDay; ++second) {
+    clock_cli::formatTime24Hours(second, buffer);
+    ASSERT_EQ(std::string(buffer, sizeof(buffer)),
+              FormatWithStream(second, false))
+        << "second " << second;
+  }
+}
+
+// Tests the 12-hour kernel against the stream output for every second
+TEST(TimeFormatTest, FormatTime12Hours_MatchesStreamForWholeDay) {
+  char buffer[clock_cli::TIME_12_HOURS_LENGTH];
+  for (int second = 0; second < kSecondsPerDay; ++second) {
+    clock_cli::formatTime12Hours(second, buffer);
+    ASSERT_EQ(std::string(buffer, sizeof(buffer)),
+              FormatWithStream(second, true))
+        << "second " << second;
+  }
+}
+
+// Tests that parsing the formatted text returns every second unchanged
+TEST(TimeFormatTest, ParseTime_RoundTripsWholeDay) {
+  for (int second = 0; second < kSecondsPerDay; ++second) {
+    int parsed_24 = -1;
+    int parsed_12 = -1;
+    ASSERT_TRUE(clock_cli::parseTime24Hours(FormatWithStream(second, false),
+                                            parsed_24));
+    ASSERT_TRUE(clock_cli::parseTime12Hours(FormatWithStream(second, true),
+                                            parsed_12));
+    ASSERT_EQ(parsed_24, second);
+    ASSERT_EQ(parsed_12, second);
+  }
+}
+
+// Tests rejection of malformed and out of range times
+TEST(TimeFormatTest, ParseTime_RejectsInvalidText) {
+  const std::vector<std::string> invalid_24 = {
+      "", "24:00:00", "23:60:00", "23:59:60", "1:00:00", "01:00:0",
+      "01-00-00", "0a:00:00", " 01:00:00", "01:00:00 ", "-1:00:00"};
+  const std::vector<std::string> invalid_12 = {
+      "00:00:00 AM", "13:00:00 PM", "12:00:00", "12:00:00 am",
+      "12:00:00 XM", "12:00:00 AN", "12:00:00AM", "12:60:00 PM"};
+
+  int seconds_of_day = 42;
+  for (const std::string& text : invalid_24) {
+    EXPECT_FALSE(clock_cli::parseTime24Hours(text, seconds_of_day)) << text;
+  }
+  for (const std::string& text : invalid_12) {
+    EXPECT_FALSE(clock_cli::parseTime12Hours(text, seconds_of_day)) << text;
+  }
+  EXPECT_EQ(seconds_of_day, 42);
+}
+
+// Tests that the batch API matches formatting the times one by one
+TEST(TimeFormatTest, AppendTimes_MatchesSingleFormatting) {
+  const std::vector<int> seconds = {0, 1, 3599, 43200, 46800, 86399};
+  std::string expected_24 = "log: ";
+  std::string expected_12 = "log: ";
+  for (const int second : seconds) {
+    expected_24 += FormatWithStream(second, false) + ",";
+    expected_12 += FormatWithStream(second, true) + ",";
+  }
+
+  std::string batch_24 = "log: ";
+  std::string batch_12 = "log: ";
+  clock_cli::appendTimes24Hours(batch_24, seconds, ',');
+  clock_cli::appendTimes12Hours(batch_12, seconds, ',');
+  EXPECT_EQ(batch_24, expected_24);
+  EXPECT_EQ(batch_12, expected_12);
+}
+
+// Tests zero padding of single units, including values past two digits
+TEST(TimeFormatTest, AppendTimeUnit_PadsToTwoDigits) {
+  std::string result;
+  clock_cli::appendTimeUnit(result, 0);
+  clock_cli::appendTimeUnit(result, 7);
+  clock_cli::appendTimeUnit(result, 59);
+  clock_cli::appendTimeUnit(result, 123);
+  EXPECT_EQ(result, "000759123");
+}
@@ -0,0 +1,200 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "time_zone.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using clock_cli::TimeZone;
+
+namespace {
+// Local time type of a TZif file: offset, daylight flag, abbreviation index
+struct TzifType {
+  int32_t utcOffset;
+  bool isDst;
+  unsigned char abbreviationIndex;
+};
+
+void appendBigEndian(std::vector<unsigned char>& data, long long value,
+                     int size) {
+  for (int shift = (size - 1) * 8; shift >= 0; shift -= 8) {
+    data.push_back(static_cast<unsigned char>(value >> shift));
+  }
+}
+
+void appendHeader(std::vector<unsigned char>& data, size_t timeCount,
+                  size_t typeCount, size_t charCount) {
+  data.insert(data.end(), {'T', 'Z', 'i', 'f', '2'});
+  data.insert(data.end(), 15, 0);
+  // UT and standard indicator, leap second, time, type and character counts
+  for (const size_t COUNT : {size_t{0}, size_t{0}, size_t{0}, timeCount,
+                             typeCount, charCount}) {
+    appendBigEndian(data, static_cast<long long>(COUNT), 4);
+  }
+}
+
+// Version 2 TZif data with an empty 32-bit block, the 64-bit block and the
+// footer rule
+std::vector<unsigned char> makeTzif(const std::vector<long long>& TIMES,
+                                    const std::vector<unsigned char>& INDICES,
+                                    const std::vector<TzifType>& TYPES,
+                                    const std::string& CHARS,
+                                    const std::string& RULE) {
+  std::vector<unsigned char> data;
+  appendHeader(data, 0, 0, 0);
+  appendHeader(data, TIMES.size(), TYPES.size(), CHARS.size() + 1);
+  for (const long long TIME : TIMES) {
+    appendBigEndian(data, TIME, 8);
+  }
+  data.insert(data.end(), INDICES.begin(), INDICES.end());
+  for (const TzifType& TYPE : TYPES) {
+    appendBigEndian(data, TYPE.utcOffset, 4);
+    data.push_back(TYPE.isDst ? 1 : 0);
+    data.push_back(TYPE.abbreviationIndex);
+  }
+  data.insert(data.end(), CHARS.begin(), CHARS.end());
+  data.push_back('\0');
+  data.push_back('\n');
+  data.insert(data.end(), RULE.begin(), RULE.end());
+  data.push_back('\n');
+  return data;
+}
+
+// Writes the data to a temporary file and loads it
+bool loadData(const std::vector<unsigned char>& DATA, TimeZone& zone) {
+  const std::string PATH =
+      (std::filesystem::temp_directory_path() / "time_zone_test.tzif")
+          .string();
+  std::ofstream(PATH, std::ios::binary)
+      .write(reinterpret_cast<const char*>(DATA.data()),
+             static_cast<std::streamsize>(DATA.size()));
+  const bool IS_LOADED = TimeZone::loadFile(PATH, "Test/Zone", zone);
+  std::filesystem::remove(PATH);
+  return IS_LOADED;
+}
+
+// Sydney: one listed transition out of daylight time in April 2020, then
+// the footer rule, which ends daylight time before it starts each year
+const long long SYDNEY_DST_END_2020 = 1586016000;    // 2020-04-04 16:00 UTC
+const long long SYDNEY_DST_START_2020 = 1601740800;  // 2020-10-03 16:00 UTC
+const long long SYDNEY_DST_END_2021 = 1617465600;    // 2021-04-03 16:00 UTC
+
+std::vector<unsigned char> makeSydneyZone(const std::string& RULE) {
+  return makeTzif({SYDNEY_DST_END_2020}, {0},
+                  {{36000, false, 0}, {39600, true, 5}},
+                  std::string("AEST\0AEDT", 9), RULE);
+}
+}  // namespace
+
+// Tests offsets before, between and after the listed transitions
+TEST(TimeZoneTest, LoadFile_ListedTransitions) {
+  TimeZone zone;
+  ASSERT_TRUE(loadData(makeTzif({1000, 2000}, {1, 0},
+                                {{3600, false, 0}, {7200, true, 4}},
+                                std::string("CET\0CEST", 8), ""),
+                       zone));
+  EXPECT_EQ(zone.getName(), "Test/Zone");
+  EXPECT_EQ(zone.getTransitionCount(), 2u);
+
+  // Type 0 is in effect before the first transition
+  EXPECT_EQ(zone.getUtcOffset(-1000000), 3600);
+  EXPECT_EQ(zone.getUtcOffset(999), 3600);
+  EXPECT_EQ(zone.getUtcOffset(1000), 7200);
+  EXPECT_EQ(zone.getLocalTimeType(1999).abbreviation, "CEST");
+  EXPECT_TRUE(zone.getLocalTimeType(1999).isDst);
+  EXPECT_EQ(zone.getUtcOffset(2000), 3600);
+  EXPECT_EQ(zone.getLocalTimeType(4000000000LL).abbreviation, "CET");
+
+  // The cached lookups agree, moving forward and back again
+  for (const long long TIME : {0LL, 999LL, 1000LL, 1500LL, 1999LL, 2000LL,
+                               1000LL, 5LL, 3000000000LL}) {
+    EXPECT_EQ(zone.getUtcOffsetCached(TIME), zone.getUtcOffset(TIME)) << TIME;
+  }
+}
+
+// Tests that the footer rule continues past the last transition, with the
+// southern-hemisphere order of daylight time ending before it starts
+TEST(TimeZoneTest, LoadFile_FooterRuleSouthernHemisphere) {
+  TimeZone zone;
+  ASSERT_TRUE(
+      loadData(makeSydneyZone("AEST-10AEDT,M10.1.0,M4.1.0/3"), zone));
+  EXPECT_GT(zone.getTransitionCount(), 2u * (2100 - 2020));
+
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_END_2020 - 1), 36000);
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_END_2020), 36000);
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_START_2020 - 1), 36000);
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_START_2020), 39600);
+  EXPECT_EQ(zone.getLocalTimeType(SYDNEY_DST_START_2020).abbreviation,
+            "AEDT");
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_END_2021 - 1), 39600);
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_END_2021), 36000);
+
+  // Decades later the rule still applies: summer in January, not in July
+  EXPECT_TRUE(zone.getLocalTimeType(2525817600LL).isDst);   // 2050-01-15
+  EXPECT_FALSE(zone.getLocalTimeType(2541456000LL).isDst);  // 2050-07-15
+}
+
+// Tests that truncated or inconsistent files are rejected
+TEST(TimeZoneTest, LoadFile_RejectsMalformedData) {
+  const std::vector<unsigned char> VALID =
+      makeSydneyZone("AEST-10AEDT,M10.1.0,M4.1.0/3");
+  TimeZone zone;
+  ASSERT_TRUE(loadData(VALID, zone));
+
+  // Cut anywhere before the footer
+  const size_t FOOTER_START = VALID.size() - 30;
+  for (size_t size = 0; size < FOOTER_START; ++size) {
+    const std::vector<unsigned char> TRUNCATED(VALID.begin(),
+                                               VALID.begin() + size);
+    EXPECT_FALSE(loadData(TRUNCATED, zone)) << size << " bytes";
+  }
+
+  std::vector<unsigned char> badMagic = VALID;
+  badMagic[44] = 'X';
+  EXPECT_FALSE(loadData(badMagic, zone));
+
+  // Type index past the types, transitions out of order, abbreviation
+  // index past the characters, no types at all
+  EXPECT_FALSE(loadData(makeTzif({1000}, {2}, {{0, false, 0}},
+                                 "UTC", ""),
+                        zone));
+  EXPECT_FALSE(loadData(makeTzif({2000, 1000}, {0, 0}, {{0, false, 0}},
+                                 "UTC", ""),
+                        zone));
+  EXPECT_FALSE(loadData(makeTzif({}, {}, {{0, false, 9}}, "UTC", ""),
+                        zone));
+  EXPECT_FALSE(loadData(makeTzif({}, {}, {}, "UTC", ""), zone));
+
+  // Footer rules that do not parse
+  for (const char* RULE :
+       {"AEST-10AEDT,M13.1.0,M4.1.0/3", "AEST-10AEDT,M10.1.0",
+        "AEST-10AEDT,M10.6.0,M4.1.0", "A-10", "AEST-10AEDT,J0,J100",
+        "AEST-10AEDT,M10.1.0,M4.1.0/3x"}) {
+    EXPECT_FALSE(loadData(makeSydneyZone(RULE), zone)) << RULE;
+  }
+
+  // A failed load leaves the zone as it was
+  EXPECT_EQ(zone.getName(), "Test/Zone");
+  EXPECT_EQ(zone.getUtcOffset(SYDNEY_DST_START_2020), 39600);
+}
+
+// Tests that zones missing from the database, or outside it, are not loaded
+TEST(TimeZoneTest, Load_MissingZone) {
+  TimeZone zone;
+  EXPECT_FALSE(TimeZone::load("No/Such_Zone", zone));
+  EXPECT_FALSE(TimeZone::load("", zone));
+  EXPECT_FALSE(TimeZone::load("/etc/passwd", zone));
+  EXPECT_FALSE(TimeZone::load("../../etc/passwd", zone));
+  EXPECT_FALSE(TimeZone::loadFile(
+      (std::filesystem::temp_directory_path() / "no_such_zone.tzif")
+          .string(),
+      "Missing", zone));
+  EXPECT_EQ(zone.getName(), "UTC");
+  EXPECT_EQ(zone.getUtcOffset(0), 0);
+}
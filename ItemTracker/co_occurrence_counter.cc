@@ -0,0 +1,302 @@
+#include "co_occurrence_counter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#include "mini_utils.h"
+
+namespace item_tracker {
+namespace {
+constexpr size_t kMinPairSlots = 1024;
+// Groups a counting thread takes at once, so threads pick work through the
+// shared counter rarely and a few large sessions do not land on one thread
+constexpr size_t kGroupsPerTask = 256;
+
+uint64_t MakePairKey(uint32_t first, uint32_t second) {
+  return static_cast<uint64_t>(first) << 32 | second;
+}
+
+// Spread the bits of a key, whose low bits pick its slot
+uint64_t MixKey(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xFF51AFD7ED558CCDULL;
+  key ^= key >> 33;
+  key *= 0xC4CEB9FE1A85EC53ULL;
+  return key ^ (key >> 33);
+}
+
+// Field of the line at the index, counting from 0
+bool FindField(std::string_view line, char delimiter, int index,
+               std::string_view& field) {
+  for (; index > 0; --index) {
+    const size_t end = line.find(delimiter);
+    if (end == std::string_view::npos) return false;
+    line.remove_prefix(end + 1);
+  }
+  field = line.substr(0, line.find(delimiter));
+  return true;
+}
+}  // namespace
+
+// CoOccurrenceCounter:Public
+CoOccurrenceCounter::CoOccurrenceCounter(int thread_count)
+    : thread_count_(thread_count > 0
+                        ? thread_count
+                        : static_cast<int>(std::max(
+                              1u, std::thread::hardware_concurrency()))) {}
+
+bool CoOccurrenceCounter::LoadSessionsFromFile(const std::string& file_name) {
+  std::ifstream input_file(file_name);
+  if (!input_file.is_open() || input_file.fail()) {
+    return false;
+  }
+  return ImportSessionsFromStream(input_file);
+}
+
+bool CoOccurrenceCounter::ImportSessionsFromStream(
+    std::istream& input_stream) {
+  Clear();
+  is_ordered_ = false;
+  std::string line;
+  while (getline(input_stream, line)) {
+    const std::string_view trimmed_line = mini_utils::trimView(line);
+    if (trimmed_line.empty()) {
+      EndGroup();
+    } else {
+      AddItem(trimmed_line);
+    }
+  }
+  EndGroup();
+  CountPairs();
+  return true;
+}
+
+bool CoOccurrenceCounter::ImportFieldPairsFromStream(
+    std::istream& input_stream, char delimiter, int first_field,
+    int second_field) {
+  Clear();
+  is_ordered_ = true;
+  if (first_field < 0 || second_field < 0) {
+    return false;
+  }
+  std::string line;
+  std::string_view first;
+  std::string_view second;
+  while (getline(input_stream, line)) {
+    if (!FindField(line, delimiter, first_field, first) ||
+        !FindField(line, delimiter, second_field, second)) {
+      continue;
+    }
+    first = mini_utils::trimView(first);
+    second = mini_utils::trimView(second);
+    if (first.empty() || second.empty()) continue;
+    AddItem(first);
+    AddItem(second);
+    EndGroup();
+  }
+  CountPairs();
+  return true;
+}
+
+bool CoOccurrenceCounter::FindItem(std::string_view item,
+                                   uint32_t& id) const {
+  return item_names_.find(item, id);
+}
+
+std::string_view CoOccurrenceCounter::GetItemName(uint32_t id) const {
+  return item_names_.view(id);
+}
+
+int CoOccurrenceCounter::GetItemFrequency(uint32_t id) const {
+  return frequencies_[id];
+}
+
+size_t CoOccurrenceCounter::GetItemCount() const {
+  return frequencies_.size();
+}
+
+size_t CoOccurrenceCounter::GetPairCount() const { return pairs_.size; }
+
+int CoOccurrenceCounter::GetPairFrequency(uint32_t first,
+                                          uint32_t second) const {
+  if (!is_ordered_ && first > second) std::swap(first, second);
+  return pairs_.Find(MakePairKey(first, second));
+}
+
+std::vector<Partner> CoOccurrenceCounter::GetTopPartners(
+    uint32_t id, size_t max_partners) const {
+  const size_t start = partner_starts_[id];
+  const size_t end =
+      std::min(partner_starts_[id + 1], start + max_partners);
+  return std::vector<Partner>(partners_.begin() + start,
+                              partners_.begin() + end);
+}
+
+// CoOccurrenceCounter:Private
+
+void CoOccurrenceCounter::PairTable::Add(uint64_t key, int frequency) {
+  if ((size + 1) * 2 > slots.size()) {
+    Grow();
+  }
+  const size_t mask = slots.size() - 1;
+  size_t slot = MixKey(key) & mask;
+  for (; slots[slot].key != kEmptyKey; slot = (slot + 1) & mask) {
+    if (slots[slot].key == key) {
+      slots[slot].frequency += frequency;
+      return;
+    }
+  }
+  slots[slot] = {key, frequency};
+  ++size;
+}
+
+int CoOccurrenceCounter::PairTable::Find(uint64_t key) const {
+  if (slots.empty()) return 0;
+  const size_t mask = slots.size() - 1;
+  for (size_t slot = MixKey(key) & mask; slots[slot].key != kEmptyKey;
+       slot = (slot + 1) & mask) {
+    if (slots[slot].key == key) return slots[slot].frequency;
+  }
+  return 0;
+}
+
+void CoOccurrenceCounter::PairTable::Grow() {
+  std::vector<PairSlot> grown(std::max(kMinPairSlots, slots.size() * 2),
+                              {kEmptyKey, 0});
+  const size_t mask = grown.size() - 1;
+  for (const PairSlot& entry : slots) {
+    if (entry.key == kEmptyKey) continue;
+    size_t slot = MixKey(entry.key) & mask;
+    while (grown[slot].key != kEmptyKey) slot = (slot + 1) & mask;
+    grown[slot] = entry;
+  }
+  slots.swap(grown);
+}
+
+void CoOccurrenceCounter::Clear() {
+  item_names_.clear();
+  frequencies_.clear();
+  group_items_.clear();
+  group_starts_.assign(1, 0);
+  pairs_ = PairTable();
+  partner_starts_.clear();
+  partners_.clear();
+}
+
+void CoOccurrenceCounter::AddItem(std::string_view item) {
+  const uint32_t id = item_names_.intern(item);
+  if (id == frequencies_.size()) frequencies_.push_back(0);
+  group_items_.push_back(id);
+}
+
+void CoOccurrenceCounter::EndGroup() {
+  const auto start = group_items_.begin() + group_starts_.back();
+  if (start == group_items_.end()) return;
+  // Sessions are sets, kept sorted so every pair comes out as first < second
+  if (!is_ordered_) {
+    std::sort(start, group_items_.end());
+    group_items_.erase(std::unique(start, group_items_.end()),
+                       group_items_.end());
+  }
+  for (auto item = start; item != group_items_.end(); ++item) {
+    if (item == start || *item != *(item - 1)) ++frequencies_[*item];
+  }
+  group_starts_.push_back(group_items_.size());
+}
+
+void CoOccurrenceCounter::CountPairs() {
+  const size_t group_count = group_starts_.size() - 1;
+  const size_t task_count =
+      (group_count + kGroupsPerTask - 1) / kGroupsPerTask;
+  const size_t threads = std::max<size_t>(
+      1, std::min(static_cast<size_t>(thread_count_), task_count));
+
+  // Every thread counts into its own table; only the task counter is shared
+  std::vector<PairTable> tables(threads);
+  std::atomic<size_t> next_task{0};
+  const auto count_tasks = [this, &next_task, group_count](PairTable& table) {
+    for (size_t task = next_task++; task * kGroupsPerTask < group_count;
+         task = next_task++) {
+      const size_t end = std::min(group_count, (task + 1) * kGroupsPerTask);
+      for (size_t group = task * kGroupsPerTask; group < end; ++group) {
+        CountGroupPairs(group, table);
+      }
+    }
+  };
+  if (threads == 1) {
+    count_tasks(tables[0]);
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (PairTable& table : tables) {
+      workers.emplace_back(count_tasks, std::ref(table));
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // The largest table is kept and the others are added to it
+  auto largest = std::max_element(
+      tables.begin(), tables.end(),
+      [](const PairTable& left, const PairTable& right) {
+        return left.size < right.size;
+      });
+  pairs_ = std::move(*largest);
+  for (auto table = tables.begin(); table != tables.end(); ++table) {
+    if (table == largest) continue;
+    for (const PairSlot& slot : table->slots) {
+      if (slot.key != kEmptyKey) pairs_.Add(slot.key, slot.frequency);
+    }
+  }
+  BuildPartners();
+}
+
+void CoOccurrenceCounter::CountGroupPairs(size_t group,
+                                          PairTable& table) const {
+  const uint32_t* const items = &group_items_[group_starts_[group]];
+  const size_t count = group_starts_[group + 1] - group_starts_[group];
+  if (is_ordered_) {
+    table.Add(MakePairKey(items[0], items[1]), 1);
+    return;
+  }
+  for (size_t first = 0; first < count; ++first) {
+    for (size_t second = first + 1; second < count; ++second) {
+      table.Add(MakePairKey(items[first], items[second]), 1);
+    }
+  }
+}
+
+void CoOccurrenceCounter::BuildPartners() {
+  // Count the partners of every item, then place them by prefix sums
+  partner_starts_.assign(frequencies_.size() + 1, 0);
+  ForEachPair([this](uint32_t first, uint32_t second, int) {
+    ++partner_starts_[first + 1];
+    if (!is_ordered_) ++partner_starts_[second + 1];
+  });
+  for (size_t id = 1; id < partner_starts_.size(); ++id) {
+    partner_starts_[id] += partner_starts_[id - 1];
+  }
+  partners_.resize(partner_starts_.back());
+  std::vector<size_t> next(partner_starts_.begin(), partner_starts_.end() - 1);
+  ForEachPair([this, &next](uint32_t first, uint32_t second, int frequency) {
+    partners_[next[first]++] = {second, frequency};
+    if (!is_ordered_) partners_[next[second]++] = {first, frequency};
+  });
+
+  for (size_t id = 0; id < frequencies_.size(); ++id) {
+    std::sort(partners_.begin() + partner_starts_[id],
+              partners_.begin() + partner_starts_[id + 1],
+              [](const Partner& left, const Partner& right) {
+                return left.frequency != right.frequency
+                           ? left.frequency > right.frequency
+                           : left.id < right.id;
+              });
+  }
+}
+// /CoOccurrenceCounter
+
+}  // namespace item_tracker
@@ -0,0 +1,136 @@
+#ifndef CO_OCCURRENCE_COUNTER_H
+#define CO_OCCURRENCE_COUNTER_H
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "string_pool.h"
+
+namespace item_tracker {
+
+// Item counted together with another one, see GetTopPartners()
+struct Partner {
+  uint32_t id;
+  int frequency;
+};
+
+// Counts of pairs of items: items that appear in the same session, a block
+// of lines between blank lines, or the composite key of two delimited
+// fields of a line.
+//
+// Items are interned into dense ids and a pair is counted under a single
+// 64-bit key holding both ids. Lines are interned on one thread; the pairs
+// are then counted on several, each into a table of its own, and the
+// tables are merged at the end, so counting threads never share a cache
+// line. Once counted, every item's partners are sorted by frequency, so
+// the top K of an item are read without a search.
+//
+// Example:
+//   CoOccurrenceCounter counter;
+//   counter.LoadSessionsFromFile("baskets.txt");
+//   uint32_t id = 0;
+//   if (counter.FindItem("bread", id)) {
+//     for (const Partner& partner : counter.GetTopPartners(id, 5)) { ... }
+//   }
+class CoOccurrenceCounter {
+ public:
+  // Count pairs on up to thread_count threads, 0 for one per hardware
+  // thread
+  explicit CoOccurrenceCounter(int thread_count = 0);
+
+  // Count every pair of distinct items that appear in the same session.
+  // An item repeated within a session counts once. Lines are trimmed and
+  // a session ends at an empty or blank line. Replaces any earlier counts.
+  bool LoadSessionsFromFile(const std::string& file_name);
+  bool ImportSessionsFromStream(std::istream& input_stream);
+
+  // Count the composite key of two delimited fields of every line, e.g.
+  // fields 0 and 2 of "user,day,product". Fields are trimmed and lines
+  // missing either field are skipped. Pairs are ordered: (a, b) and (b, a)
+  // are different keys. Replaces any earlier counts.
+  bool ImportFieldPairsFromStream(std::istream& input_stream, char delimiter,
+                                  int first_field, int second_field);
+
+  // Id of a counted item
+  bool FindItem(std::string_view item, uint32_t& id) const;
+
+  // Item by id, 0..GetItemCount() - 1, and the number of sessions or lines
+  // it appears in
+  std::string_view GetItemName(uint32_t id) const;
+  int GetItemFrequency(uint32_t id) const;
+  size_t GetItemCount() const;
+
+  // Number of distinct pairs counted
+  size_t GetPairCount() const;
+
+  // Times the two items were counted together, in either order for
+  // sessions and in the given order for field pairs
+  int GetPairFrequency(uint32_t first, uint32_t second) const;
+
+  // Up to max_partners items most often counted with the item, most
+  // frequent first and ties by id. For field pairs these are the second
+  // fields of the lines whose first field is the item.
+  std::vector<Partner> GetTopPartners(uint32_t id, size_t max_partners) const;
+
+  // Call visit(first, second, frequency) for every pair, in no particular
+  // order. Session pairs are visited once, with first < second.
+  template <typename Visitor>
+  void ForEachPair(Visitor visit) const {
+    for (const PairSlot& slot : pairs_.slots) {
+      if (slot.key == kEmptyKey) continue;
+      visit(static_cast<uint32_t>(slot.key >> 32),
+            static_cast<uint32_t>(slot.key), slot.frequency);
+    }
+  }
+
+ private:
+  static constexpr uint64_t kEmptyKey = UINT64_MAX;
+
+  struct PairSlot {
+    uint64_t key;
+    int frequency;
+  };
+
+  // Open addressing with linear probing, at most half full, a power of two
+  struct PairTable {
+    std::vector<PairSlot> slots;
+    size_t size = 0;
+
+    void Add(uint64_t key, int frequency);
+    int Find(uint64_t key) const;
+    void Grow();
+  };
+
+  // Drop every item and pair
+  void Clear();
+
+  // Record a trimmed item of the current session or line
+  void AddItem(std::string_view item);
+
+  // Close the items added since the last call as one session or line
+  void EndGroup();
+
+  // Count the pairs of every group into per-thread tables and merge them
+  // into pairs_, then build the partner lists
+  void CountPairs();
+  void CountGroupPairs(size_t group, PairTable& table) const;
+  void BuildPartners();
+
+  int thread_count_;
+  bool is_ordered_ = false;
+  mini_utils::StringPool item_names_;
+  std::vector<int> frequencies_;
+  // Item ids of every group back to back, a group starting at each offset
+  std::vector<uint32_t> group_items_;
+  std::vector<size_t> group_starts_;
+  PairTable pairs_;
+  // Partners of item i are partners_[partner_starts_[i]..[i + 1]]
+  std::vector<size_t> partner_starts_;
+  std::vector<Partner> partners_;
+};
+
+}  // namespace item_tracker
+#endif  // CO_OCCURRENCE_COUNTER_H
@@ -0,0 +1,172 @@
+#include "frequency_diff.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+namespace item_tracker {
+namespace {
+// Reads the "item frequency" lines of a snapshot sorted by item, checking
+// that every item is greater than the one before
+class SortedSnapshotReader {
+ public:
+  explicit SortedSnapshotReader(std::istream& input) : input_(input) {}
+
+  // Move to the next line. Returns false at the end of the snapshot or at
+  // a bad line, which IsValid() tells apart.
+  bool Next() {
+    // The previous line is kept for the order check, swapping buffers so
+    // neither is reallocated
+    line_.swap(previous_line_);
+    const size_t previous_size = item_.size();
+    while (getline(input_, line_)) {
+      if (line_.empty()) continue;
+      if (!ItemTracker::ParseSnapshotLine(line_, item_, frequency_)) {
+        is_valid_ = false;
+        return false;
+      }
+      if (has_previous_ &&
+          item_ <= std::string_view(previous_line_.data(), previous_size)) {
+        is_valid_ = false;
+        return false;
+      }
+      has_previous_ = true;
+      return true;
+    }
+    return false;
+  }
+
+  std::string_view GetItem() const { return item_; }
+  int GetFrequency() const { return frequency_; }
+  bool IsValid() const { return is_valid_; }
+
+ private:
+  std::istream& input_;
+  std::string line_;
+  std::string previous_line_;
+  std::string_view item_;
+  int frequency_ = 0;
+  bool has_previous_ = false;
+  bool is_valid_ = true;
+};
+}  // namespace
+
+double ItemDelta::GetRatio() const {
+  return before == 0 ? std::numeric_limits<double>::infinity()
+                     : static_cast<double>(after) / before;
+}
+
+void FrequencyDiff::Compare(const ItemTracker& before,
+                            const ItemTracker& after) {
+  Clear();
+  after.ForEachItem([this, &before](std::string_view item, int frequency) {
+    AddDelta(item, before.GetWordFrequency(item), frequency);
+  });
+  before.ForEachItem([this, &after](std::string_view item, int frequency) {
+    uint32_t id = 0;
+    if (!after.FindItem(item, id)) {
+      AddDelta(item, frequency, 0);
+    }
+  });
+  SortDeltas();
+}
+
+bool FrequencyDiff::Compare(std::istream& before, const ItemTracker& after) {
+  Clear();
+  // Tracker items the snapshot has; the rest are new
+  std::vector<bool> is_in_snapshot(after.GetItemCount(), false);
+  std::string line;
+  std::string_view item;
+  int frequency = 0;
+  while (getline(before, line)) {
+    if (line.empty()) continue;
+    if (!ItemTracker::ParseSnapshotLine(line, item, frequency)) {
+      return false;
+    }
+    uint32_t id = 0;
+    if (after.FindItem(item, id)) {
+      if (is_in_snapshot[id]) {
+        return false;
+      }
+      is_in_snapshot[id] = true;
+      AddDelta(after.GetItemName(id), frequency, after.GetItemFrequency(id));
+    } else {
+      const size_t copied_count = copied_items_.size();
+      if (copied_items_.intern(item) < copied_count) {
+        return false;
+      }
+      AddCopiedDelta(item, frequency, 0);
+    }
+  }
+
+  for (uint32_t id = 0; id < is_in_snapshot.size(); ++id) {
+    if (!is_in_snapshot[id]) {
+      AddDelta(after.GetItemName(id), 0, after.GetItemFrequency(id));
+    }
+  }
+  SortDeltas();
+  return true;
+}
+
+bool FrequencyDiff::CompareSorted(std::istream& before, std::istream& after) {
+  Clear();
+  SortedSnapshotReader before_reader(before);
+  SortedSnapshotReader after_reader(after);
+  bool has_before = before_reader.Next();
+  bool has_after = after_reader.Next();
+  while (has_before || has_after) {
+    const int order =
+        !has_after    ? -1
+        : !has_before ? 1
+                      : before_reader.GetItem().compare(after_reader.GetItem());
+    if (order < 0) {
+      AddCopiedDelta(before_reader.GetItem(), before_reader.GetFrequency(), 0);
+      has_before = before_reader.Next();
+    } else if (order > 0) {
+      AddCopiedDelta(after_reader.GetItem(), 0, after_reader.GetFrequency());
+      has_after = after_reader.Next();
+    } else {
+      AddCopiedDelta(after_reader.GetItem(), before_reader.GetFrequency(),
+                     after_reader.GetFrequency());
+      has_before = before_reader.Next();
+      has_after = after_reader.Next();
+    }
+  }
+  SortDeltas();
+  return before_reader.IsValid() && after_reader.IsValid();
+}
+
+// FrequencyDiff:Private
+
+void FrequencyDiff::Clear() {
+  copied_items_.clear();
+  deltas_.clear();
+  new_count_ = 0;
+  vanished_count_ = 0;
+}
+
+void FrequencyDiff::AddDelta(std::string_view item, int before, int after) {
+  if (before == after) return;
+  new_count_ += before == 0;
+  vanished_count_ += after == 0;
+  deltas_.push_back({item, before, after});
+}
+
+void FrequencyDiff::AddCopiedDelta(std::string_view item, int before,
+                                   int after) {
+  if (before == after) return;
+  AddDelta(copied_items_.view(copied_items_.intern(item)), before, after);
+}
+
+void FrequencyDiff::SortDeltas() {
+  std::sort(deltas_.begin(), deltas_.end(),
+            [](const ItemDelta& left, const ItemDelta& right) {
+              const int left_change = std::abs(left.GetChange());
+              const int right_change = std::abs(right.GetChange());
+              return left_change != right_change ? left_change > right_change
+                                                 : left.item < right.item;
+            });
+}
+
+}  // namespace item_tracker
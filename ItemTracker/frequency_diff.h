@@ -0,0 +1,75 @@
+#ifndef FREQUENCY_DIFF_H
+#define FREQUENCY_DIFF_H
+#include <cstddef>
+#include <istream>
+#include <string_view>
+#include <vector>
+
+#include "item_tracker.h"
+#include "string_pool.h"
+
+namespace item_tracker {
+
+// Change of an item's frequency between two tables
+struct ItemDelta {
+  std::string_view item;
+  int before = 0;
+  int after = 0;
+
+  int GetChange() const { return after - before; }
+  // after / before, infinity for new items and 0 for vanished ones
+  double GetRatio() const;
+};
+
+// Joins two frequency tables, e.g. yesterday's and today's, into per-item
+// deltas, largest absolute change first. Unchanged items are left out.
+//
+// A table is a loaded ItemTracker or a snapshot written by
+// ItemTracker::ExportToStream(), read line by line. Items are looked up in
+// the tracker's own index and only copied when the tracker lacks them, so
+// a comparison never holds a second full copy of the keys.
+//
+// Example:
+//   FrequencyDiff diff;
+//   std::ifstream yesterday("frequency.dat");
+//   diff.Compare(yesterday, tracker);
+//   for (const ItemDelta& delta : diff.GetDeltas()) ...
+class FrequencyDiff {
+ public:
+  // Hash join of two trackers, probing each one's index with the items of
+  // the other. The deltas point into the trackers, which must outlive them.
+  void Compare(const ItemTracker& before, const ItemTracker& after);
+
+  // Hash join of a snapshot against a tracker, which must outlive the
+  // deltas. Returns false if a line is malformed or an item repeats.
+  bool Compare(std::istream& before, const ItemTracker& after);
+
+  // Merge join of two snapshots sorted by item, as written with
+  // is_sorted_by_item, in a single pass over each. Only changed items are
+  // kept. Returns false if a line is malformed or out of order.
+  bool CompareSorted(std::istream& before, std::istream& after);
+
+  // Deltas of the last comparison by descending absolute change, then item
+  const std::vector<ItemDelta>& GetDeltas() const { return deltas_; }
+
+  // Items only in the after table, and only in the before one
+  size_t GetNewCount() const { return new_count_; }
+  size_t GetVanishedCount() const { return vanished_count_; }
+
+ private:
+  void Clear();
+  // Record the item if its frequency changed; a copied item is stored in
+  // copied_items_ first
+  void AddDelta(std::string_view item, int before, int after);
+  void AddCopiedDelta(std::string_view item, int before, int after);
+  void SortDeltas();
+
+  // Items no tracker holds
+  mini_utils::StringPool copied_items_;
+  std::vector<ItemDelta> deltas_;
+  size_t new_count_ = 0;
+  size_t vanished_count_ = 0;
+};
+
+}  // namespace item_tracker
+#endif  // FREQUENCY_DIFF_H
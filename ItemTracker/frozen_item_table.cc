@@ -0,0 +1,208 @@
+#include "frozen_item_table.h"
+
+#include <algorithm>
+#include <string>
+
+namespace item_tracker {
+namespace {
+void AppendVarint(std::pmr::vector<char>& out, size_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+// Encoded data is trusted, so reading needs no bounds checks
+size_t ReadVarint(const char*& position) {
+  size_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(*position++);
+    value |= static_cast<size_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+}
+
+size_t CommonPrefixLength(std::string_view left, std::string_view right) {
+  const size_t length = std::min(left.size(), right.size());
+  size_t common = 0;
+  while (common < length && left[common] == right[common]) ++common;
+  return common;
+}
+
+// Items are ordered like std::string_view compares them, by unsigned bytes
+bool IsGreater(char left, char right) {
+  return static_cast<unsigned char>(left) > static_cast<unsigned char>(right);
+}
+
+// The first 8 bytes of the item, big-endian and zero padded, so prefixes
+// order like their items unless they are equal
+uint64_t GetKeyPrefix(std::string_view item) {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    prefix <<= 8;
+    if (i < item.size()) {
+      prefix |= static_cast<unsigned char>(item[i]);
+    }
+  }
+  return prefix;
+}
+}  // namespace
+
+FrozenItemTable::FrozenItemTable(std::pmr::memory_resource* resource)
+    : blocks_(resource),
+      block_offsets_(resource),
+      block_prefixes_(resource),
+      packed_frequencies_(resource) {}
+
+FrozenItemTable::FrozenItemTable(const ItemTracker& tracker,
+                                 std::pmr::memory_resource* resource)
+    : FrozenItemTable(resource) {
+  item_count_ = tracker.GetItemCount();
+  std::vector<uint32_t> ids(item_count_);
+  size_t item_bytes = 0;
+  int max_frequency = 1;
+  for (uint32_t id = 0; id < ids.size(); ++id) {
+    ids[id] = id;
+    item_bytes += tracker.GetItemName(id).size();
+    max_frequency = std::max(max_frequency, tracker.GetItemFrequency(id));
+  }
+  std::sort(ids.begin(), ids.end(), [&tracker](uint32_t left, uint32_t right) {
+    return tracker.GetItemName(left) < tracker.GetItemName(right);
+  });
+
+  while (frequency_bits_ < 31 && max_frequency >> frequency_bits_ != 0) {
+    ++frequency_bits_;
+  }
+  packed_frequencies_.assign((item_count_ * frequency_bits_ + 63) / 64, 0);
+  block_offsets_.reserve((item_count_ + kBlockSize - 1) / kBlockSize);
+  block_prefixes_.reserve(block_offsets_.capacity());
+  // Front coding only shrinks the items, and lengths rarely take more than
+  // a byte each
+  blocks_.reserve(item_bytes + 2 * item_count_);
+
+  std::string_view previous;
+  for (size_t index = 0; index < item_count_; ++index) {
+    const std::string_view item = tracker.GetItemName(ids[index]);
+    size_t shared = 0;
+    if (index % kBlockSize == 0) {
+      block_offsets_.push_back(static_cast<uint32_t>(blocks_.size()));
+      block_prefixes_.push_back(GetKeyPrefix(item));
+    } else {
+      shared = CommonPrefixLength(previous, item);
+      AppendVarint(blocks_, shared);
+    }
+    AppendVarint(blocks_, item.size() - shared);
+    blocks_.insert(blocks_.end(), item.begin() + shared, item.end());
+    previous = item;
+
+    const uint64_t frequency =
+        static_cast<uint64_t>(tracker.GetItemFrequency(ids[index]));
+    const size_t bit = index * frequency_bits_;
+    packed_frequencies_[bit / 64] |= frequency << (bit % 64);
+    if (bit % 64 + frequency_bits_ > 64) {
+      packed_frequencies_[bit / 64 + 1] |= frequency >> (64 - bit % 64);
+    }
+  }
+  blocks_.shrink_to_fit();
+}
+
+int FrozenItemTable::GetFrequency(std::string_view item) const {
+  const char* const data = blocks_.data();
+  // The last block whose first item is not greater than the item
+  const uint64_t item_prefix = GetKeyPrefix(item);
+  size_t low = 0;
+  size_t high = block_offsets_.size();
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    bool is_first_not_greater = block_prefixes_[middle] < item_prefix;
+    if (block_prefixes_[middle] == item_prefix) {
+      const char* position = data + block_offsets_[middle];
+      const size_t length = ReadVarint(position);
+      is_first_not_greater = std::string_view(position, length) <= item;
+    }
+    if (is_first_not_greater) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == 0) {
+    return 0;
+  }
+
+  const size_t block = low - 1;
+  const char* position = data + block_offsets_[block];
+  const char* const end = block + 1 < block_offsets_.size()
+                              ? data + block_offsets_[block + 1]
+                              : data + blocks_.size();
+  const size_t first_length = ReadVarint(position);
+  const std::string_view first(position, first_length);
+  position += first_length;
+  if (first == item) {
+    return GetFrequencyAt(block * kBlockSize);
+  }
+
+  // Items are compared without being decoded: `matched` is the prefix the
+  // searched item shares with the previous item, which is smaller than it
+  size_t matched = CommonPrefixLength(first, item);
+  for (size_t index = block * kBlockSize + 1; position < end; ++index) {
+    const size_t shared = ReadVarint(position);
+    const size_t suffix_length = ReadVarint(position);
+    const std::string_view suffix(position, suffix_length);
+    position += suffix_length;
+    // Equal to the previous item past where that one was below the
+    // searched item, so below it too
+    if (shared > matched) continue;
+    // Above the previous item where that one equals the searched item, so
+    // above it too
+    if (shared < matched) return 0;
+
+    const std::string_view rest = item.substr(matched);
+    const size_t common = CommonPrefixLength(suffix, rest);
+    if (common == suffix.size() && common == rest.size()) {
+      return GetFrequencyAt(index);
+    }
+    if (common == rest.size() ||
+        (common < suffix.size() && IsGreater(suffix[common], rest[common]))) {
+      return 0;
+    }
+    matched += common;
+  }
+  return 0;
+}
+
+void FrozenItemTable::ForEachItem(
+    const std::function<void(std::string_view, int)>& visit) const {
+  std::string item;
+  const char* position = blocks_.data();
+  for (size_t index = 0; index < item_count_; ++index) {
+    const size_t shared = index % kBlockSize == 0 ? 0 : ReadVarint(position);
+    const size_t suffix_length = ReadVarint(position);
+    item.resize(shared);
+    item.append(position, suffix_length);
+    position += suffix_length;
+    visit(item, GetFrequencyAt(index));
+  }
+}
+
+size_t FrozenItemTable::GetEncodedBytes() const {
+  return blocks_.size() + block_offsets_.size() * sizeof(uint32_t) +
+         block_prefixes_.size() * sizeof(uint64_t) +
+         packed_frequencies_.size() * sizeof(uint64_t);
+}
+
+// FrozenItemTable:Private
+
+int FrozenItemTable::GetFrequencyAt(size_t index) const {
+  const size_t bit = index * frequency_bits_;
+  uint64_t value = packed_frequencies_[bit / 64] >> (bit % 64);
+  if (bit % 64 + frequency_bits_ > 64) {
+    value |= packed_frequencies_[bit / 64 + 1] << (64 - bit % 64);
+  }
+  return static_cast<int>(value & ((uint64_t{1} << frequency_bits_) - 1));
+}
+
+}  // namespace item_tracker
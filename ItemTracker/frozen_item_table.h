@@ -0,0 +1,72 @@
+#ifndef FROZEN_ITEM_TABLE_H
+#define FROZEN_ITEM_TABLE_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "item_tracker.h"
+
+namespace item_tracker {
+
+// Read-only, compressed copy of an ItemTracker's items and frequencies, for
+// tables that are done being imported and are only looked up from then on.
+//
+// Items are sorted and front coded in blocks of kBlockSize: the first item
+// of a block is stored whole and every other one as the length of the
+// prefix it shares with the item before plus the rest. A sampled index
+// holds the offset of every block and the first bytes of its first item as
+// an integer, so a lookup is a binary search over integers, touching the
+// blocks only on ties, and a scan of at most one block, without decoding
+// any item into a buffer. Frequencies are bit-packed with just enough bits
+// for the largest one.
+//
+// Example:
+//   tracker.LoadWordsFromFile("book.txt", 3);
+//   const FrozenItemTable table(tracker);
+//   table.GetFrequency("once upon a");
+class FrozenItemTable {
+ public:
+  // Items per front-coded block
+  static constexpr size_t kBlockSize = 16;
+
+  explicit FrozenItemTable(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // Freeze the tracker's current items. The table is allocated from the
+  // resource and does not refer to the tracker afterwards.
+  explicit FrozenItemTable(
+      const ItemTracker& tracker,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // Frequency of the item, 0 if it is not in the table. O(log n).
+  int GetFrequency(std::string_view item) const;
+
+  size_t GetItemCount() const { return item_count_; }
+
+  // Call visit(item, frequency) for every item, in item order
+  void ForEachItem(
+      const std::function<void(std::string_view, int)>& visit) const;
+
+  // Bytes of the encoded blocks, the index and the frequencies
+  size_t GetEncodedBytes() const;
+
+ private:
+  int GetFrequencyAt(size_t index) const;
+
+  // Front-coded items; see the class comment
+  std::pmr::vector<char> blocks_;
+  // Offset of every block in blocks_
+  std::pmr::vector<uint32_t> block_offsets_;
+  // First 8 bytes of every block's first item, big-endian and zero padded
+  std::pmr::vector<uint64_t> block_prefixes_;
+  // Frequencies of frequency_bits_ bits each, in item order
+  std::pmr::vector<uint64_t> packed_frequencies_;
+  int frequency_bits_ = 0;
+  size_t item_count_ = 0;
+};
+
+}  // namespace item_tracker
+#endif  // FROZEN_ITEM_TABLE_H
@@ -0,0 +1,386 @@
+#include "hyper_log_log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "mini_utils.h"
+#include "word_splitter.h"
+
+namespace item_tracker {
+namespace {
+constexpr char kMagic[] = {'H', 'L', 'L', 1};
+constexpr uint8_t kSparseMode = 0;
+constexpr uint8_t kDenseMode = 1;
+constexpr size_t kHeaderSize = sizeof(kMagic) + 2;
+constexpr int kValueBits = 6;
+constexpr uint32_t kValueMask = (1 << kValueBits) - 1;
+// Bytes of text read at once when scanning lines
+constexpr size_t kReadChunkSize = 1 << 20;
+
+// Finalizer of MurmurHash3, so every bit of the word hash affects the
+// register index and the leading zero count
+uint64_t MixBits(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  return hash ^ (hash >> 33);
+}
+
+// Leading zero bits of a non-zero value
+int CountLeadingZeros(uint64_t value) {
+#if defined(__GNUC__)
+  return __builtin_clzll(value);
+#else
+  int count = 0;
+  for (int shift = 32; shift > 0; shift /= 2) {
+    if (value >> (64 - shift) == 0) {
+      count += shift;
+      value <<= shift;
+    }
+  }
+  return count;
+#endif
+}
+
+// 1 + leading zeros of the bits after the first `index_bits`, at most
+// 64 - index_bits + 1 when they are all zero
+uint8_t RegisterValue(uint64_t hash, int index_bits) {
+  const uint64_t rest = hash << index_bits;
+  return static_cast<uint8_t>(
+      rest == 0 ? 64 - index_bits + 1 : CountLeadingZeros(rest) + 1);
+}
+
+void AppendVarint(std::string& out, uint32_t value) {
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+bool ReadVarint(std::string_view& in, uint32_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 35 && !in.empty(); shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(in[0]);
+    in.remove_prefix(1);
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Terms of the estimator by Ertl, "New cardinality estimation algorithms for
+// HyperLogLog sketches" (2017). It corrects the small and large range bias
+// of the raw estimate without the empirical tables of HyperLogLog++.
+double Sigma(double x) {
+  if (x == 1) {
+    return INFINITY;
+  }
+  double y = 1;
+  double z = x;
+  double previous;
+  do {
+    x *= x;
+    previous = z;
+    z += x * y;
+    y += y;
+  } while (z != previous);
+  return z;
+}
+
+double Tau(double x) {
+  if (x == 0 || x == 1) {
+    return 0;
+  }
+  double y = 1;
+  double z = 1 - x;
+  double previous;
+  do {
+    x = std::sqrt(x);
+    previous = z;
+    y *= 0.5;
+    z -= (1 - x) * (1 - x) * y;
+  } while (z != previous);
+  return z / 3;
+}
+}  // namespace
+
+HyperLogLog::HyperLogLog(int precision)
+    : precision_(std::clamp(precision, kMinPrecision, kMaxPrecision)) {}
+
+void HyperLogLog::Add(std::string_view item) {
+  AddHash(MixBits(HashWord(item)));
+}
+
+void HyperLogLog::AddHash(uint64_t hash) {
+  if (!is_sparse_) {
+    AddToDense(hash);
+    return;
+  }
+  const uint32_t index = static_cast<uint32_t>(hash >> (64 - kSparsePrecision));
+  sparse_buffer_.push_back(index << kValueBits |
+                           RegisterValue(hash, kSparsePrecision));
+  // Sparse pairs take 4 bytes, registers 1, so past a quarter of the
+  // register count the dense form is smaller
+  const size_t max_sparse_pairs = (size_t{1} << precision_) / 4;
+  if (sparse_buffer_.size() >= std::max<size_t>(max_sparse_pairs / 4, 16)) {
+    FlushSparseBuffer();
+    if (sparse_pairs_.size() > max_sparse_pairs) {
+      ConvertToDense();
+    }
+  }
+}
+
+bool HyperLogLog::AddLinesFromFile(const std::string& file_name) {
+  std::ifstream input_file(file_name, std::ios::binary);
+  if (!input_file.is_open() || input_file.fail()) {
+    return false;
+  }
+  return AddLinesFromStream(input_file);
+}
+
+bool HyperLogLog::AddLinesFromStream(std::istream& input_stream) {
+  // Lines are hashed straight from large reads; the bytes after the last
+  // line break carry over to the next read
+  std::string buffer(kReadChunkSize, '\0');
+  size_t carried = 0;
+  while (true) {
+    input_stream.read(&buffer[carried], buffer.size() - carried);
+    const size_t end = carried + static_cast<size_t>(input_stream.gcount());
+    const char* const data = buffer.data();
+    if (end == carried) {
+      // The last line may lack a line break
+      const std::string_view line =
+          mini_utils::trimView(std::string_view(data, carried));
+      if (!line.empty()) Add(line);
+      return true;
+    }
+
+    size_t line_start = 0;
+    while (const void* found =
+               std::memchr(data + line_start, '\n', end - line_start)) {
+      const size_t line_end = static_cast<const char*>(found) - data;
+      const std::string_view line = mini_utils::trimView(
+          std::string_view(data + line_start, line_end - line_start));
+      if (!line.empty()) Add(line);
+      line_start = line_end + 1;
+    }
+
+    carried = end - line_start;
+    std::memmove(&buffer[0], data + line_start, carried);
+    // A line longer than the buffer needs more room
+    if (carried == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+  }
+}
+
+bool HyperLogLog::Merge(const HyperLogLog& other) {
+  if (other.precision_ != precision_) {
+    return false;
+  }
+  if (!other.is_sparse_) {
+    if (is_sparse_) {
+      ConvertToDense();
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+    return true;
+  }
+
+  other.FlushSparseBuffer();
+  if (!is_sparse_) {
+    for (const uint32_t pair : other.sparse_pairs_) {
+      uint32_t index;
+      uint8_t value;
+      DecodeSparse(pair, index, value);
+      registers_[index] = std::max(registers_[index], value);
+    }
+    return true;
+  }
+  // A copy first, as the other sketch may be this one
+  const std::vector<uint32_t> pairs = other.sparse_pairs_;
+  sparse_buffer_.insert(sparse_buffer_.end(), pairs.begin(), pairs.end());
+  FlushSparseBuffer();
+  if (sparse_pairs_.size() > (size_t{1} << precision_) / 4) {
+    ConvertToDense();
+  }
+  return true;
+}
+
+uint64_t HyperLogLog::Estimate() const {
+  if (is_sparse_) {
+    // Linear counting over the sparse registers, exact in practice for as
+    // many items as a sparse sketch holds
+    FlushSparseBuffer();
+    const double registers = static_cast<double>(1 << kSparsePrecision);
+    const double empty = registers - static_cast<double>(sparse_pairs_.size());
+    return static_cast<uint64_t>(
+        std::llround(registers * std::log(registers / empty)));
+  }
+
+  const int max_value = 64 - precision_ + 1;
+  std::vector<int> histogram(max_value + 1);
+  for (const uint8_t value : registers_) {
+    ++histogram[value];
+  }
+  const double registers = static_cast<double>(registers_.size());
+  double z = registers * Tau(1 - histogram[max_value] / registers);
+  for (int value = max_value - 1; value >= 1; --value) {
+    z = 0.5 * (z + histogram[value]);
+  }
+  z += registers * Sigma(histogram[0] / registers);
+  const double kAlphaInfinity = 0.5 / std::log(2.0);
+  return static_cast<uint64_t>(
+      std::llround(kAlphaInfinity * registers * registers / z));
+}
+
+int HyperLogLog::GetPrecision() const { return precision_; }
+
+bool HyperLogLog::IsSparse() const { return is_sparse_; }
+
+std::string HyperLogLog::Serialize() const {
+  std::string out(kMagic, sizeof(kMagic));
+  out += static_cast<char>(precision_);
+  if (!is_sparse_) {
+    out += static_cast<char>(kDenseMode);
+    out.append(reinterpret_cast<const char*>(registers_.data()),
+               registers_.size());
+    return out;
+  }
+
+  FlushSparseBuffer();
+  out += static_cast<char>(kSparseMode);
+  AppendVarint(out, static_cast<uint32_t>(sparse_pairs_.size()));
+  uint32_t previous = 0;
+  for (const uint32_t pair : sparse_pairs_) {
+    AppendVarint(out, pair - previous);
+    previous = pair;
+  }
+  return out;
+}
+
+bool HyperLogLog::Deserialize(std::string_view data) {
+  if (data.size() < kHeaderSize ||
+      std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+  HyperLogLog sketch(static_cast<uint8_t>(data[sizeof(kMagic)]));
+  if (sketch.precision_ != static_cast<uint8_t>(data[sizeof(kMagic)])) {
+    return false;
+  }
+  const uint8_t mode = static_cast<uint8_t>(data[sizeof(kMagic) + 1]);
+  data.remove_prefix(kHeaderSize);
+  const uint8_t max_value = static_cast<uint8_t>(64 - sketch.precision_ + 1);
+
+  if (mode == kDenseMode) {
+    if (data.size() != size_t{1} << sketch.precision_) {
+      return false;
+    }
+    sketch.ConvertToDense();
+    std::memcpy(sketch.registers_.data(), data.data(), data.size());
+    if (*std::max_element(sketch.registers_.begin(),
+                          sketch.registers_.end()) > max_value) {
+      return false;
+    }
+  } else if (mode == kSparseMode) {
+    uint32_t count = 0;
+    if (!ReadVarint(data, count) ||
+        count > (size_t{1} << sketch.precision_) / 4) {
+      return false;
+    }
+    sketch.sparse_pairs_.reserve(count);
+    uint32_t pair = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t delta = 0;
+      if (!ReadVarint(data, delta) || delta > UINT32_MAX - pair) {
+        return false;
+      }
+      const uint32_t previous = pair;
+      pair += delta;
+      // Pairs are strictly increasing by register, with values in range
+      const uint32_t value = pair & kValueMask;
+      if ((i > 0 && pair >> kValueBits <= previous >> kValueBits) ||
+          pair >> kValueBits >= uint32_t{1} << kSparsePrecision ||
+          value == 0 || value > 64 - kSparsePrecision + 1) {
+        return false;
+      }
+      sketch.sparse_pairs_.push_back(pair);
+    }
+    if (!data.empty()) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+  *this = std::move(sketch);
+  return true;
+}
+
+void HyperLogLog::FlushSparseBuffer() const {
+  if (sparse_buffer_.empty()) {
+    return;
+  }
+  std::sort(sparse_buffer_.begin(), sparse_buffer_.end());
+  const size_t old_size = sparse_pairs_.size();
+  sparse_pairs_.insert(sparse_pairs_.end(), sparse_buffer_.begin(),
+                       sparse_buffer_.end());
+  std::inplace_merge(sparse_pairs_.begin(), sparse_pairs_.begin() + old_size,
+                     sparse_pairs_.end());
+  sparse_buffer_.clear();
+
+  // Pairs of a register are adjacent, the largest value last; keep that one
+  size_t kept = 0;
+  for (size_t i = 0; i < sparse_pairs_.size(); ++i) {
+    if (i + 1 < sparse_pairs_.size() &&
+        sparse_pairs_[i] >> kValueBits == sparse_pairs_[i + 1] >> kValueBits) {
+      continue;
+    }
+    sparse_pairs_[kept++] = sparse_pairs_[i];
+  }
+  sparse_pairs_.resize(kept);
+}
+
+void HyperLogLog::ConvertToDense() {
+  FlushSparseBuffer();
+  registers_.assign(size_t{1} << precision_, 0);
+  for (const uint32_t pair : sparse_pairs_) {
+    uint32_t index;
+    uint8_t value;
+    DecodeSparse(pair, index, value);
+    registers_[index] = std::max(registers_[index], value);
+  }
+  sparse_pairs_ = {};
+  sparse_buffer_ = {};
+  is_sparse_ = false;
+}
+
+void HyperLogLog::AddToDense(uint64_t hash) {
+  uint8_t& value = registers_[hash >> (64 - precision_)];
+  value = std::max(value, RegisterValue(hash, precision_));
+}
+
+void HyperLogLog::DecodeSparse(uint32_t pair, uint32_t& index,
+                               uint8_t& value) const {
+  const uint32_t sparse_index = pair >> kValueBits;
+  const int extra_bits = kSparsePrecision - precision_;
+  index = sparse_index >> extra_bits;
+  // The sparse index holds the first extra_bits bits the dense value counts
+  // leading zeros in
+  const uint32_t extra = sparse_index & ((uint32_t{1} << extra_bits) - 1);
+  if (extra != 0) {
+    value = static_cast<uint8_t>(
+        CountLeadingZeros(static_cast<uint64_t>(extra) << (64 - extra_bits)) +
+        1);
+  } else {
+    value = static_cast<uint8_t>(extra_bits + (pair & kValueMask));
+  }
+}
+
+}  // namespace item_tracker
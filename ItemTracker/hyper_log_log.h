@@ -0,0 +1,87 @@
+#ifndef HYPER_LOG_LOG_H
+#define HYPER_LOG_LOG_H
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace item_tracker {
+
+// Estimate of the number of distinct items seen, in a few kilobytes however
+// many items there are. The relative error is about 1.04 / sqrt(2^precision),
+// e.g. 0.8% at the default precision of 14 (16KB).
+//
+// Small sketches are kept sparse, as a sorted list of (register, value)
+// pairs at a precision of 25 bits, and are exact enough to count a handful of
+// items. Once the list would outgrow the dense registers it is converted.
+// Sketches of the same precision merge into the sketch of the union, e.g.
+// per-day sketches into a weekly one, and can be serialized to a string.
+//
+// Example:
+//   HyperLogLog sketch;
+//   sketch.AddLinesFromFile("day1.txt");
+//   tracker.Reserve(sketch.Estimate());
+//   tracker.LoadItemsFromFile("day1.txt");
+class HyperLogLog {
+ public:
+  static constexpr int kMinPrecision = 4;
+  static constexpr int kMaxPrecision = 18;
+
+  // Precision is clamped to [kMinPrecision, kMaxPrecision]
+  explicit HyperLogLog(int precision = 14);
+
+  void Add(std::string_view item);
+
+  // Add an item by a 64-bit hash of it, which must be well mixed
+  void AddHash(uint64_t hash);
+
+  // Add every trimmed non-empty line, the items ItemTracker would count.
+  // Returns false if the file cannot be opened.
+  bool AddLinesFromFile(const std::string& file_name);
+  bool AddLinesFromStream(std::istream& input_stream);
+
+  // Fold the other sketch into this one. Returns false, leaving this sketch
+  // unchanged, if the precisions differ.
+  bool Merge(const HyperLogLog& other);
+
+  // Estimated number of distinct items added
+  uint64_t Estimate() const;
+
+  int GetPrecision() const;
+  bool IsSparse() const;
+
+  // Compact binary form: a header, then the sparse pairs delta and varint
+  // encoded, or the dense registers
+  std::string Serialize() const;
+
+  // Replace the sketch with a serialized one. Returns false, leaving the
+  // sketch unchanged, if the data is malformed.
+  bool Deserialize(std::string_view data);
+
+ private:
+  // Precision of the sparse representation
+  static constexpr int kSparsePrecision = 25;
+
+  // Sort the buffered sparse pairs into the list, going dense if it grew
+  // too big
+  void FlushSparseBuffer() const;
+  void ConvertToDense();
+
+  // Register index and value of a hash at the dense precision
+  void AddToDense(uint64_t hash);
+  // Dense register index and value of a sparse pair
+  void DecodeSparse(uint32_t pair, uint32_t& index, uint8_t& value) const;
+
+  int precision_;
+  bool is_sparse_ = true;
+  // Sorted pairs, one per sparse register, as index << 6 | value. New pairs
+  // are buffered unsorted and folded in in batches; both are logically
+  // part of the sketch, hence mutable.
+  mutable std::vector<uint32_t> sparse_pairs_;
+  mutable std::vector<uint32_t> sparse_buffer_;
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace item_tracker
+#endif  // HYPER_LOG_LOG_H
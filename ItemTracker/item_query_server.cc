@@ -0,0 +1,573 @@
+#include "item_query_server.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace item_tracker {
+namespace {
+#ifdef __linux__
+// Event loop tokens of the listening socket and the wake-up eventfd;
+// connections are numbered after them
+constexpr uint64_t kListenToken = 0;
+constexpr uint64_t kWakeToken = 1;
+constexpr int kMaxEvents = 64;
+constexpr size_t kReadChunkSize = 64 * 1024;
+// Input read from one connection per readiness event; the level-triggered
+// loop reports the rest again after serving the other connections
+constexpr size_t kMaxReadBytesPerEvent = 4 * kReadChunkSize;
+// A client that stops reading is dropped rather than buffered for forever
+constexpr size_t kMaxPendingOutputBytes = 64 << 20;
+
+bool MakeSocketAddress(const std::string& socket_path, sockaddr_un& address) {
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    errno = ENAMETOOLONG;
+    return false;
+  }
+  address = {};
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, socket_path.data(), socket_path.size());
+  return true;
+}
+
+void CloseFd(int& fd) {
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+}
+#endif
+
+void AppendFrequency(std::string& response, int frequency) {
+  AppendUint32(response, static_cast<uint32_t>(frequency));
+}
+}  // namespace
+
+ItemQueryServer::ItemQueryServer(const ItemTracker& tracker, int reader_count)
+    : tracker_(tracker),
+      reader_count_(reader_count > 0
+                        ? reader_count
+                        : std::max(1u, std::thread::hardware_concurrency())),
+      next_connection_id_(2) {
+  tracker.ForEachItem([this](std::string_view item, int frequency) {
+    ranked_items_.emplace_back(item, frequency);
+  });
+  std::sort(ranked_items_.begin(), ranked_items_.end(),
+            [](const auto& left, const auto& right) {
+              return left.second != right.second ? left.second > right.second
+                                                 : left.first < right.first;
+            });
+}
+
+void ItemQueryServer::HandleRequest(std::string_view frame,
+                                    std::string& response) const {
+  uint32_t length = 0;
+  uint32_t request_id = 0;
+  const bool has_header = ReadUint32(frame, length) &&
+                          ReadUint32(frame, request_id) && !frame.empty();
+  const char opcode = has_header ? frame[0] : 0;
+  frame.remove_prefix(has_header ? 1 : frame.size());
+
+  const size_t start = response.size();
+  AppendUint32(response, 0);
+  AppendUint32(response, request_id);
+  response += opcode;
+  response += static_cast<char>(QueryStatus::kOk);
+  const size_t payload_start = response.size();
+
+  bool is_valid = has_header;
+  switch (static_cast<QueryOpcode>(opcode)) {
+    case QueryOpcode::kFrequency: {
+      std::string_view item;
+      is_valid = ReadString(frame, item);
+      AppendFrequency(response, tracker_.GetWordFrequency(item));
+      break;
+    }
+    case QueryOpcode::kTopK: {
+      uint32_t k = 0;
+      is_valid = ReadUint32(frame, k);
+      AppendUint32(response, 0);
+      // As many items as fit in a frame
+      uint32_t count = 0;
+      for (; count < k && count < ranked_items_.size(); ++count) {
+        const std::string_view item = ranked_items_[count].first;
+        if (response.size() - start + 8 + item.size() > kMaxQueryFrameBytes) {
+          break;
+        }
+        AppendString(response, item);
+        AppendFrequency(response, ranked_items_[count].second);
+      }
+      std::string count_field;
+      AppendUint32(count_field, count);
+      response.replace(payload_start, count_field.size(), count_field);
+      break;
+    }
+    case QueryOpcode::kBatchFrequency: {
+      uint32_t count = 0;
+      is_valid = ReadUint32(frame, count) && count <= frame.size() / 4;
+      AppendUint32(response, count);
+      for (uint32_t i = 0; is_valid && i < count; ++i) {
+        std::string_view item;
+        is_valid = ReadString(frame, item);
+        AppendFrequency(response, tracker_.GetWordFrequency(item));
+      }
+      break;
+    }
+    default:
+      is_valid = false;
+  }
+
+  if (!is_valid || !frame.empty()) {
+    response.resize(payload_start);
+    response.back() = static_cast<char>(QueryStatus::kBadRequest);
+  }
+  FinishFrame(response, start);
+}
+
+#ifdef __linux__
+
+ItemQueryServer::~ItemQueryServer() {
+  CloseFd(wake_fd_);
+  CloseFd(epoll_fd_);
+  if (listen_fd_ >= 0) {
+    CloseFd(listen_fd_);
+    unlink(socket_path_.c_str());
+  }
+}
+
+bool ItemQueryServer::Listen(const std::string& socket_path) {
+  sockaddr_un address;
+  if (!MakeSocketAddress(socket_path, address)) {
+    return false;
+  }
+  // A socket file left behind by a server that did not shut down
+  struct stat file_status;
+  if (stat(socket_path.c_str(), &file_status) == 0 &&
+      S_ISSOCK(file_status.st_mode)) {
+    unlink(socket_path.c_str());
+  }
+
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event listen_event = {};
+  listen_event.events = EPOLLIN;
+  listen_event.data.u64 = kListenToken;
+  epoll_event wake_event = {};
+  wake_event.events = EPOLLIN;
+  wake_event.data.u64 = kWakeToken;
+  if (listen_fd_ < 0 || epoll_fd_ < 0 || wake_fd_ < 0 ||
+      bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address),
+           sizeof(address)) != 0) {
+    const int error = errno;
+    CloseFd(listen_fd_);
+    CloseFd(epoll_fd_);
+    CloseFd(wake_fd_);
+    errno = error;
+    return false;
+  }
+  socket_path_ = socket_path;
+  if (listen(listen_fd_, SOMAXCONN) != 0 ||
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &listen_event) != 0 ||
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event) != 0) {
+    const int error = errno;
+    CloseFd(listen_fd_);
+    CloseFd(epoll_fd_);
+    CloseFd(wake_fd_);
+    unlink(socket_path.c_str());
+    errno = error;
+    return false;
+  }
+  return true;
+}
+
+void ItemQueryServer::Run() {
+  if (epoll_fd_ < 0) {
+    return;
+  }
+  for (int i = 0; i < reader_count_; ++i) {
+    readers_.emplace_back(&ItemQueryServer::RunReader, this);
+  }
+
+  epoll_event events[kMaxEvents];
+  while (!is_stop_requested_) {
+    const int count = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+    if (count < 0 && errno != EINTR) {
+      break;
+    }
+    for (int i = 0; i < count; ++i) {
+      const uint64_t token = events[i].data.u64;
+      if (token == kListenToken) {
+        AcceptConnections();
+        continue;
+      }
+      if (token == kWakeToken) {
+        uint64_t wake_count = 0;
+        if (read(wake_fd_, &wake_count, sizeof(wake_count)) < 0) {
+          // Nothing to read; another event already took the wake-ups
+        }
+        DeliverResponses();
+        continue;
+      }
+      // Closed by an earlier event of this batch
+      auto connection = connections_.find(token);
+      if (connection == connections_.end()) continue;
+      bool is_open = true;
+      if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        is_open = ReadFrames(token, connection->second);
+      }
+      if (is_open && (events[i].events & EPOLLOUT)) {
+        is_open = WriteOutput(token, connection->second);
+      }
+      if (!is_open) {
+        CloseConnection(token);
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(jobs_mutex_);
+    is_stopping_readers_ = true;
+  }
+  jobs_ready_.notify_all();
+  for (std::thread& reader : readers_) {
+    reader.join();
+  }
+  readers_.clear();
+  jobs_.clear();
+  responses_.clear();
+  is_stopping_readers_ = false;
+  while (!connections_.empty()) {
+    CloseConnection(connections_.begin()->first);
+  }
+  is_stop_requested_ = false;
+}
+
+void ItemQueryServer::Stop() {
+  is_stop_requested_ = true;
+  if (wake_fd_ >= 0) {
+    const uint64_t wake_count = 1;
+    if (write(wake_fd_, &wake_count, sizeof(wake_count)) < 0) {
+      // The counter is saturated, so the loop is woken anyway
+    }
+  }
+}
+
+void ItemQueryServer::AcceptConnections() {
+  while (true) {
+    const int fd =
+        accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    const uint64_t connection_id = next_connection_id_++;
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = connection_id;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+      close(fd);
+      continue;
+    }
+    connections_[connection_id].fd = fd;
+  }
+}
+
+bool ItemQueryServer::ReadFrames(uint64_t connection_id,
+                                 Connection& connection) {
+  // Input is no longer watched, so this is a hang-up or an error: the
+  // client cannot take the answers anymore
+  if (connection.is_read_closed) {
+    return false;
+  }
+  char buffer[kReadChunkSize];
+  size_t read_bytes = 0;
+  while (read_bytes < kMaxReadBytesPerEvent) {
+    const ssize_t count = recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (count > 0) {
+      connection.input.append(buffer, static_cast<size_t>(count));
+      read_bytes += static_cast<size_t>(count);
+      // A short read drained the socket; more input wakes the loop again
+      if (static_cast<size_t>(count) < sizeof(buffer)) break;
+      continue;
+    }
+    if (count == 0) {
+      connection.is_read_closed = true;
+      break;
+    }
+    if (errno == EINTR) continue;
+    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+    return false;
+  }
+
+  size_t frames_size = 0;
+  bool is_malformed = false;
+  while (const size_t frame_size = GetQueryFrameSize(
+             std::string_view(connection.input).substr(frames_size),
+             is_malformed)) {
+    frames_size += frame_size;
+  }
+  if (is_malformed) {
+    return false;
+  }
+
+  if (frames_size > 0) {
+    Job job{connection_id, {}};
+    if (frames_size == connection.input.size()) {
+      job.frames.swap(connection.input);
+    } else {
+      job.frames.assign(connection.input, 0, frames_size);
+      connection.input.erase(0, frames_size);
+    }
+    ++connection.pending_jobs;
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    jobs_ready_.notify_one();
+  }
+
+  if (connection.is_read_closed) {
+    // A partial frame can never be completed. The answers to the complete
+    // ones are still written before the connection is closed.
+    connection.input.clear();
+    return WriteOutput(connection_id, connection);
+  }
+  return true;
+}
+
+bool ItemQueryServer::WriteOutput(uint64_t connection_id,
+                                  Connection& connection) {
+  std::string& output = connection.output;
+  while (connection.output_offset < output.size()) {
+    const ssize_t count =
+        send(connection.fd, output.data() + connection.output_offset,
+             output.size() - connection.output_offset, MSG_NOSIGNAL);
+    if (count >= 0) {
+      connection.output_offset += static_cast<size_t>(count);
+      continue;
+    }
+    if (errno == EINTR) continue;
+    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+    return false;
+  }
+
+  const bool has_pending_output = connection.output_offset < output.size();
+  if (!has_pending_output) {
+    output.clear();
+    connection.output_offset = 0;
+  }
+  if (!UpdateEvents(connection_id, connection, has_pending_output)) {
+    return false;
+  }
+  return !connection.is_read_closed || connection.pending_jobs > 0 ||
+         has_pending_output;
+}
+
+bool ItemQueryServer::UpdateEvents(uint64_t connection_id,
+                                   Connection& connection,
+                                   bool has_pending_output) {
+  const bool is_watching_input = !connection.is_read_closed;
+  if (has_pending_output == connection.is_waiting_to_write &&
+      is_watching_input == connection.is_watching_input) {
+    return true;
+  }
+  epoll_event event = {};
+  if (is_watching_input) {
+    event.events |= EPOLLIN;
+  }
+  if (has_pending_output) {
+    event.events |= EPOLLOUT;
+  }
+  event.data.u64 = connection_id;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event) != 0) {
+    return false;
+  }
+  connection.is_waiting_to_write = has_pending_output;
+  connection.is_watching_input = is_watching_input;
+  return true;
+}
+
+void ItemQueryServer::DeliverResponses() {
+  {
+    std::lock_guard<std::mutex> lock(responses_mutex_);
+    delivered_.swap(responses_);
+  }
+  for (Job& job : delivered_) {
+    auto found = connections_.find(job.connection_id);
+    // The client went away while its requests were answered
+    if (found == connections_.end()) continue;
+    Connection& connection = found->second;
+    --connection.pending_jobs;
+    if (connection.output.empty()) {
+      connection.output.swap(job.frames);
+    } else {
+      connection.output.erase(0, connection.output_offset);
+      connection.output_offset = 0;
+      connection.output += job.frames;
+    }
+    // Otherwise the loop writes once the socket takes more
+    const bool is_open =
+        connection.output.size() <= kMaxPendingOutputBytes &&
+        (connection.is_waiting_to_write ||
+         WriteOutput(job.connection_id, connection));
+    if (!is_open) {
+      CloseConnection(job.connection_id);
+    }
+  }
+  delivered_.clear();
+}
+
+void ItemQueryServer::CloseConnection(uint64_t connection_id) {
+  auto found = connections_.find(connection_id);
+  if (found == connections_.end()) {
+    return;
+  }
+  // Closing the socket also takes it out of the epoll set
+  close(found->second.fd);
+  connections_.erase(found);
+}
+
+void ItemQueryServer::RunReader() {
+  Job job;
+  std::string responses;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(jobs_mutex_);
+      jobs_ready_.wait(
+          lock, [this] { return is_stopping_readers_ || !jobs_.empty(); });
+      if (is_stopping_readers_) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+
+    responses.clear();
+    std::string_view frames = job.frames;
+    bool is_malformed = false;
+    while (const size_t frame_size = GetQueryFrameSize(frames, is_malformed)) {
+      HandleRequest(frames.substr(0, frame_size), responses);
+      frames.remove_prefix(frame_size);
+    }
+    // The request buffer is reused for the next job's responses
+    job.frames.swap(responses);
+
+    bool is_loop_idle = false;
+    {
+      std::lock_guard<std::mutex> lock(responses_mutex_);
+      is_loop_idle = responses_.empty();
+      responses_.push_back(std::move(job));
+    }
+    // Responses already waiting mean the loop has been woken
+    if (is_loop_idle) {
+      const uint64_t wake_count = 1;
+      if (write(wake_fd_, &wake_count, sizeof(wake_count)) < 0) {
+        // The counter is saturated, so the loop is woken anyway
+      }
+    }
+  }
+}
+
+ItemQueryClient::~ItemQueryClient() { CloseFd(fd_); }
+
+bool ItemQueryClient::Connect(const std::string& socket_path) {
+  sockaddr_un address;
+  if (!MakeSocketAddress(socket_path, address)) {
+    return false;
+  }
+  CloseFd(fd_);
+  fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0 || connect(fd_, reinterpret_cast<const sockaddr*>(&address),
+                         sizeof(address)) != 0) {
+    const int error = errno;
+    CloseFd(fd_);
+    errno = error;
+    return false;
+  }
+  input_.clear();
+  input_offset_ = 0;
+  return true;
+}
+
+bool ItemQueryClient::Send(std::string_view frames) {
+  while (!frames.empty()) {
+    const ssize_t count = send(fd_, frames.data(), frames.size(), MSG_NOSIGNAL);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    frames.remove_prefix(static_cast<size_t>(count));
+  }
+  return true;
+}
+
+bool ItemQueryClient::FinishSending() {
+  return fd_ >= 0 && shutdown(fd_, SHUT_WR) == 0;
+}
+
+bool ItemQueryClient::Receive(QueryResponse& response) {
+  while (true) {
+    const std::string_view buffered =
+        std::string_view(input_).substr(input_offset_);
+    bool is_malformed = false;
+    const size_t frame_size = GetQueryFrameSize(buffered, is_malformed);
+    if (is_malformed) {
+      return false;
+    }
+    if (frame_size > 0) {
+      input_offset_ += frame_size;
+      return DecodeQueryResponse(buffered.substr(0, frame_size), response);
+    }
+
+    input_.erase(0, input_offset_);
+    input_offset_ = 0;
+    char buffer[kReadChunkSize];
+    const ssize_t count = recv(fd_, buffer, sizeof(buffer), 0);
+    if (count <= 0) {
+      if (count < 0 && errno == EINTR) continue;
+      return false;
+    }
+    input_.append(buffer, static_cast<size_t>(count));
+  }
+}
+
+#else
+
+ItemQueryServer::~ItemQueryServer() = default;
+
+bool ItemQueryServer::Listen(const std::string& socket_path) {
+  errno = ENOSYS;
+  return false;
+}
+
+void ItemQueryServer::Run() {}
+
+void ItemQueryServer::Stop() { is_stop_requested_ = true; }
+
+ItemQueryClient::~ItemQueryClient() = default;
+
+bool ItemQueryClient::Connect(const std::string& socket_path) {
+  errno = ENOSYS;
+  return false;
+}
+
+bool ItemQueryClient::Send(std::string_view frames) { return false; }
+
+bool ItemQueryClient::FinishSending() { return false; }
+
+bool ItemQueryClient::Receive(QueryResponse& response) { return false; }
+
+#endif  // __linux__
+
+}  // namespace item_tracker
@@ -0,0 +1,156 @@
+#ifndef ITEM_QUERY_SERVER_H
+#define ITEM_QUERY_SERVER_H
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "item_tracker.h"
+#include "query_protocol.h"
+
+namespace item_tracker {
+
+// Long-lived server answering frequency, top-K and batch lookups about a
+// loaded ItemTracker over a Unix domain socket, in the protocol of
+// query_protocol.h.
+//
+// One thread runs an epoll loop that accepts connections, reads and writes
+// without blocking and cuts the input into frames. Each readiness event
+// reads a bounded amount, so one busy client cannot starve the others. Each
+// read's complete frames go to a pool of reader threads as one job, so a
+// pipelining client is answered in batches, and the responses are handed
+// back to the loop to be written. A client that shuts down its sending side
+// still gets every answer before the connection is closed.
+//
+// Serving over sockets needs epoll, i.e. Linux; elsewhere Listen() fails.
+// HandleRequest() works everywhere.
+//
+// Example:
+//   ItemQueryServer server(tracker);
+//   if (server.Listen("/tmp/items.sock")) server.Run();
+class ItemQueryServer {
+ public:
+  // The tracker must outlive the server and not change while it serves.
+  // reader_count of 0 uses one reader per hardware thread.
+  explicit ItemQueryServer(const ItemTracker& tracker, int reader_count = 0);
+  ~ItemQueryServer();
+
+  ItemQueryServer(const ItemQueryServer&) = delete;
+  ItemQueryServer& operator=(const ItemQueryServer&) = delete;
+
+  // Answer one whole request frame, appending the response frame. Safe to
+  // call from several threads at once.
+  void HandleRequest(std::string_view frame, std::string& response) const;
+
+  // Create the socket, replacing a stale socket file. Returns false if it
+  // cannot be created, with errno set.
+  bool Listen(const std::string& socket_path);
+
+  // Serve until Stop() is called, then close every connection. Run() can
+  // be called again afterwards to serve the same socket anew.
+  void Run();
+
+  // Make the current or next Run() return. Safe to call from any thread.
+  void Stop();
+
+ private:
+  struct Connection {
+    int fd = -1;
+    // Bytes read that do not make a whole frame yet
+    std::string input;
+    // Responses not written yet, from output_offset on
+    std::string output;
+    size_t output_offset = 0;
+    bool is_waiting_to_write = false;
+    bool is_watching_input = true;
+    // The client shut down its sending side. The connection is closed once
+    // every request read before that is answered and written.
+    bool is_read_closed = false;
+    // Jobs of the connection that the loop has not delivered yet
+    int pending_jobs = 0;
+  };
+
+  // Frames of one read, or the responses to them
+  struct Job {
+    uint64_t connection_id;
+    std::string frames;
+  };
+
+  void AcceptConnections();
+  // Read what is available and dispatch the complete frames. Returns false
+  // if the connection is to be closed.
+  bool ReadFrames(uint64_t connection_id, Connection& connection);
+  // Write as much output as the socket takes. Returns false if the
+  // connection is to be closed, also once a read-closed connection is done.
+  bool WriteOutput(uint64_t connection_id, Connection& connection);
+  // Watch for input until the client stops sending, and for writability
+  // while output is pending. Returns false if the events cannot be changed.
+  bool UpdateEvents(uint64_t connection_id, Connection& connection,
+                    bool has_pending_output);
+  void DeliverResponses();
+  void CloseConnection(uint64_t connection_id);
+  void RunReader();
+
+  const ItemTracker& tracker_;
+  // Items by descending frequency, then name, for top-K lookups
+  std::vector<std::pair<std::string_view, int>> ranked_items_;
+  int reader_count_;
+
+  std::string socket_path_;
+  int listen_fd_ = -1;
+  int epoll_fd_ = -1;
+  // Wakes the loop for responses and Stop()
+  int wake_fd_ = -1;
+  std::atomic<bool> is_stop_requested_{false};
+  std::unordered_map<uint64_t, Connection> connections_;
+  uint64_t next_connection_id_;
+
+  std::vector<std::thread> readers_;
+  std::mutex jobs_mutex_;
+  std::condition_variable jobs_ready_;
+  std::deque<Job> jobs_;
+  bool is_stopping_readers_ = false;
+  std::mutex responses_mutex_;
+  std::vector<Job> responses_;
+  // Responses taken over by the loop, kept to reuse the vector
+  std::vector<Job> delivered_;
+};
+
+// Blocking client of ItemQueryServer, for tools and tests. Linux only, like
+// serving.
+class ItemQueryClient {
+ public:
+  ItemQueryClient() = default;
+  ~ItemQueryClient();
+
+  ItemQueryClient(const ItemQueryClient&) = delete;
+  ItemQueryClient& operator=(const ItemQueryClient&) = delete;
+
+  bool Connect(const std::string& socket_path);
+
+  // Send request frames built with the Append*Request() functions
+  bool Send(std::string_view frames);
+
+  // Shut down the sending side. The server still answers every request
+  // sent before, then closes the connection.
+  bool FinishSending();
+
+  // Wait for the next response. Returns false if the connection broke or
+  // the response is malformed.
+  bool Receive(QueryResponse& response);
+
+ private:
+  int fd_ = -1;
+  std::string input_;
+  size_t input_offset_ = 0;
+};
+
+}  // namespace item_tracker
+#endif  // ITEM_QUERY_SERVER_H
@@ -0,0 +1,265 @@
+#include "item_search_index.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace item_tracker {
+namespace {
+constexpr uint32_t kNoNode = UINT32_MAX;
+constexpr size_t kTrigramLength = 3;
+
+uint32_t TrigramAt(std::string_view text, size_t position) {
+  return static_cast<uint32_t>(static_cast<unsigned char>(text[position]))
+             << 16 |
+         static_cast<uint32_t>(static_cast<unsigned char>(text[position + 1]))
+             << 8 |
+         static_cast<unsigned char>(text[position + 2]);
+}
+
+// Levenshtein distance with a single reused row of the dynamic programming
+// table
+int EditDistance(std::string_view from, std::string_view to,
+                 std::vector<int>& row) {
+  row.resize(to.size() + 1);
+  for (size_t j = 0; j <= to.size(); ++j) {
+    row[j] = static_cast<int>(j);
+  }
+  for (size_t i = 1; i <= from.size(); ++i) {
+    int diagonal = row[0];
+    row[0] = static_cast<int>(i);
+    for (size_t j = 1; j <= to.size(); ++j) {
+      const int above = row[j];
+      const int substitution = diagonal + (from[i - 1] != to[j - 1]);
+      row[j] = std::min({above + 1, row[j - 1] + 1, substitution});
+      diagonal = above;
+    }
+  }
+  return row[to.size()];
+}
+}  // namespace
+
+ItemSearchIndex::ItemSearchIndex(std::pmr::memory_resource* resource)
+    : keys_(resource),
+      frequencies_(resource),
+      owned_keys_(resource),
+      trigrams_(resource),
+      posting_offsets_(resource),
+      postings_(resource),
+      bk_nodes_(resource) {}
+
+void ItemSearchIndex::Build(const std::unordered_map<std::string, int>& items) {
+  owned_keys_.clear();
+  owned_keys_.reserve(items.size());
+  std::vector<std::pair<std::string_view, int>> pairs;
+  pairs.reserve(items.size());
+  for (const auto& item : items) {
+    pairs.emplace_back(owned_keys_.view(owned_keys_.intern(item.first)),
+                       item.second);
+  }
+  BuildFromPairs(pairs);
+}
+
+void ItemSearchIndex::Build(const mini_utils::StringPool& names,
+                            const std::pmr::vector<int>& frequencies) {
+  owned_keys_.clear();
+  std::vector<std::pair<std::string_view, int>> pairs;
+  pairs.reserve(names.size());
+  for (uint32_t id = 0; id < names.size(); ++id) {
+    pairs.emplace_back(names.view(id), frequencies[id]);
+  }
+  BuildFromPairs(pairs);
+}
+
+std::vector<ItemMatch> ItemSearchIndex::FindByPrefix(std::string_view prefix,
+                                                     size_t limit) const {
+  // Keys with the prefix form one run starting at the first key not below it
+  auto key = std::lower_bound(
+      keys_.begin(), keys_.end(), prefix,
+      [](std::string_view candidate, std::string_view value) {
+        return candidate < value;
+      });
+  std::vector<Candidate> candidates;
+  for (; key != keys_.end() && key->compare(0, prefix.size(), prefix) == 0;
+       ++key) {
+    candidates.push_back({static_cast<uint32_t>(key - keys_.begin()), 0});
+  }
+  return Rank(candidates, limit);
+}
+
+std::vector<ItemMatch> ItemSearchIndex::FindBySubstring(std::string_view text,
+                                                        size_t limit) const {
+  std::vector<Candidate> candidates;
+  if (text.size() < kTrigramLength) {
+    for (size_t key = 0; key < keys_.size(); ++key) {
+      if (keys_[key].find(text) != std::string_view::npos) {
+        candidates.push_back({static_cast<uint32_t>(key), 0});
+      }
+    }
+    return Rank(candidates, limit);
+  }
+
+  // Every trigram of the text must occur in a match, so only the keys of the
+  // rarest trigram need to be checked
+  std::pair<const uint32_t*, const uint32_t*> rarest =
+      FindPostings(TrigramAt(text, 0));
+  for (size_t position = 1; position + kTrigramLength <= text.size();
+       ++position) {
+    const auto postings = FindPostings(TrigramAt(text, position));
+    if (postings.second - postings.first < rarest.second - rarest.first) {
+      rarest = postings;
+    }
+  }
+  for (const uint32_t* key = rarest.first; key != rarest.second; ++key) {
+    if (keys_[*key].find(text) != std::string_view::npos) {
+      candidates.push_back({*key, 0});
+    }
+  }
+  return Rank(candidates, limit);
+}
+
+std::vector<ItemMatch> ItemSearchIndex::FindSimilar(std::string_view text,
+                                                    int max_distance,
+                                                    size_t limit) const {
+  std::vector<Candidate> candidates;
+  if (bk_nodes_.empty()) {
+    return {};
+  }
+
+  // By the triangle inequality only children whose distance to their parent
+  // is within max_distance of the text's distance can hold matches
+  std::vector<int> row;
+  std::vector<uint32_t> pending = {0};
+  while (!pending.empty()) {
+    const BkNode& node = bk_nodes_[pending.back()];
+    pending.pop_back();
+    const int distance = EditDistance(text, keys_[node.key], row);
+    if (distance <= max_distance) {
+      candidates.push_back({node.key, distance});
+    }
+    for (uint32_t child = node.first_child; child != kNoNode;
+         child = bk_nodes_[child].next_sibling) {
+      if (std::abs(bk_nodes_[child].distance_to_parent - distance) <=
+          max_distance) {
+        pending.push_back(child);
+      }
+    }
+  }
+  return Rank(candidates, limit);
+}
+
+size_t ItemSearchIndex::Size() const { return keys_.size(); }
+
+void ItemSearchIndex::BuildFromPairs(
+    std::vector<std::pair<std::string_view, int>>& pairs) {
+  std::sort(pairs.begin(), pairs.end());
+  keys_.clear();
+  frequencies_.clear();
+  keys_.reserve(pairs.size());
+  frequencies_.reserve(pairs.size());
+  for (const auto& pair : pairs) {
+    keys_.push_back(pair.first);
+    frequencies_.push_back(pair.second);
+  }
+
+  BuildTrigramIndex();
+  BuildBkTree();
+}
+
+void ItemSearchIndex::BuildTrigramIndex() {
+  // (trigram, key) pairs sorted and deduplicated, then split into postings
+  std::vector<uint64_t> pairs;
+  for (size_t key = 0; key < keys_.size(); ++key) {
+    const std::string_view text = keys_[key];
+    for (size_t position = 0; position + kTrigramLength <= text.size();
+         ++position) {
+      pairs.push_back(static_cast<uint64_t>(TrigramAt(text, position)) << 32 |
+                      key);
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+  trigrams_.clear();
+  posting_offsets_.clear();
+  postings_.clear();
+  postings_.reserve(pairs.size());
+  for (const uint64_t pair : pairs) {
+    const uint32_t trigram = static_cast<uint32_t>(pair >> 32);
+    if (trigrams_.empty() || trigrams_.back() != trigram) {
+      trigrams_.push_back(trigram);
+      posting_offsets_.push_back(static_cast<uint32_t>(postings_.size()));
+    }
+    postings_.push_back(static_cast<uint32_t>(pair));
+  }
+  posting_offsets_.push_back(static_cast<uint32_t>(postings_.size()));
+}
+
+void ItemSearchIndex::BuildBkTree() {
+  bk_nodes_.clear();
+  if (keys_.empty()) {
+    return;
+  }
+  bk_nodes_.reserve(keys_.size());
+  bk_nodes_.push_back({0, 0, kNoNode, kNoNode});
+
+  std::vector<int> row;
+  for (uint32_t key = 1; key < keys_.size(); ++key) {
+    uint32_t parent = 0;
+    while (true) {
+      const int distance =
+          EditDistance(keys_[key], keys_[bk_nodes_[parent].key], row);
+      uint32_t child = bk_nodes_[parent].first_child;
+      while (child != kNoNode &&
+             bk_nodes_[child].distance_to_parent != distance) {
+        child = bk_nodes_[child].next_sibling;
+      }
+      if (child == kNoNode) {
+        const uint32_t node = static_cast<uint32_t>(bk_nodes_.size());
+        bk_nodes_.push_back(
+            {key, distance, kNoNode, bk_nodes_[parent].first_child});
+        bk_nodes_[parent].first_child = node;
+        break;
+      }
+      parent = child;
+    }
+  }
+}
+
+std::pair<const uint32_t*, const uint32_t*> ItemSearchIndex::FindPostings(
+    uint32_t trigram) const {
+  const auto found =
+      std::lower_bound(trigrams_.begin(), trigrams_.end(), trigram);
+  if (found == trigrams_.end() || *found != trigram) {
+    return {nullptr, nullptr};
+  }
+  const size_t index = found - trigrams_.begin();
+  return {postings_.data() + posting_offsets_[index],
+          postings_.data() + posting_offsets_[index + 1]};
+}
+
+std::vector<ItemMatch> ItemSearchIndex::Rank(std::vector<Candidate>& candidates,
+                                             size_t limit) const {
+  const auto ranks_before = [this](const Candidate& left,
+                                   const Candidate& right) {
+    if (frequencies_[left.key] != frequencies_[right.key]) {
+      return frequencies_[left.key] > frequencies_[right.key];
+    }
+    if (left.tie_break != right.tie_break) {
+      return left.tie_break < right.tie_break;
+    }
+    return left.key < right.key;
+  };
+  const size_t count = std::min(limit, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + count,
+                    candidates.end(), ranks_before);
+
+  std::vector<ItemMatch> matches;
+  matches.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t key = candidates[i].key;
+    matches.push_back({keys_[key], frequencies_[key]});
+  }
+  return matches;
+}
+
+}  // namespace item_tracker
@@ -0,0 +1,110 @@
+#ifndef ITEM_SEARCH_INDEX_H
+#define ITEM_SEARCH_INDEX_H
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "string_pool.h"
+
+namespace item_tracker {
+
+// An item found by a search. The view points into the index and stays valid
+// until the index is rebuilt.
+struct ItemMatch {
+  std::string_view item;
+  int frequency;
+};
+
+// Read-only search structures over a snapshot of item frequencies, built
+// once so that queries never scan every item:
+// - keys sorted for prefix lookup by binary search,
+// - a trigram index for substring lookup,
+// - a BK-tree for lookup by edit distance.
+// Every query returns at most `limit` matches, most frequent first.
+class ItemSearchIndex {
+ public:
+  ItemSearchIndex() = default;
+
+  // Keep the index structures in the resource, which must outlive the index.
+  // Scratch space used while building comes from the default resource, so a
+  // monotonic resource only grows by what the index keeps.
+  explicit ItemSearchIndex(std::pmr::memory_resource* resource);
+
+  // Replace the indexed items with the given ones
+  void Build(const std::unordered_map<std::string, int>& items);
+
+  // Replace the indexed items with the pooled strings, frequencies given by
+  // id. The index refers to the strings in the pool instead of copying them.
+  void Build(const mini_utils::StringPool& names,
+             const std::pmr::vector<int>& frequencies);
+
+  // Items starting with the prefix
+  std::vector<ItemMatch> FindByPrefix(std::string_view prefix,
+                                      size_t limit) const;
+
+  // Items containing the text. Texts shorter than a trigram fall back to
+  // checking every item.
+  std::vector<ItemMatch> FindBySubstring(std::string_view text,
+                                         size_t limit) const;
+
+  // Items at most max_distance single character insertions, deletions or
+  // substitutions away from the text. Ties in frequency go to the closer
+  // item.
+  std::vector<ItemMatch> FindSimilar(std::string_view text, int max_distance,
+                                     size_t limit) const;
+
+  size_t Size() const;
+
+ private:
+  // Node of the BK-tree. Children are kept as a linked list of siblings so
+  // the whole tree lives in one vector.
+  struct BkNode {
+    uint32_t key;
+    int distance_to_parent;
+    uint32_t first_child;
+    uint32_t next_sibling;
+  };
+
+  // Key ids and their rank tie-breaks, e.g. edit distances
+  struct Candidate {
+    uint32_t key;
+    int tie_break;
+  };
+
+  void BuildTrigramIndex();
+  void BuildBkTree();
+
+  // Postings of a trigram, empty if no key contains it
+  std::pair<const uint32_t*, const uint32_t*> FindPostings(
+      uint32_t trigram) const;
+
+  // Sort candidates by frequency, tie-break and key, then drop all but the
+  // first `limit`
+  std::vector<ItemMatch> Rank(std::vector<Candidate>& candidates,
+                              size_t limit) const;
+
+  // Index the (key, frequency) pairs, sorting them by key first
+  void BuildFromPairs(std::vector<std::pair<std::string_view, int>>& pairs);
+
+  // Keys in lexicographic order; a key's id is its position here
+  std::pmr::vector<std::string_view> keys_;
+  std::pmr::vector<int> frequencies_;
+  // Copies of the keys when the index was built from a map
+  mini_utils::StringPool owned_keys_;
+
+  // Distinct trigrams in ascending order. The ids of the keys containing
+  // trigrams_[i] are postings_[posting_offsets_[i]..posting_offsets_[i + 1]).
+  std::pmr::vector<uint32_t> trigrams_;
+  std::pmr::vector<uint32_t> posting_offsets_;
+  std::pmr::vector<uint32_t> postings_;
+
+  // Root is bk_nodes_[0]
+  std::pmr::vector<BkNode> bk_nodes_;
+};
+
+}  // namespace item_tracker
+#endif  // ITEM_SEARCH_INDEX_H
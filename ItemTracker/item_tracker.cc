@@ -1,10 +1,103 @@
 #include "item_tracker.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 namespace item_tracker {
+namespace {
+constexpr char kMenuFormatCharacter = '*';
+constexpr const char* kMenuItems[] = {
+    "1. Find item frequency", "2. List items with frequencies",
+    "3. List item histogram with frequencies", "4. Exit"};
+// Title, options heading and items between two borders
+constexpr int kMenuLines = sizeof(kMenuItems) / sizeof(kMenuItems[0]) + 4;
+// Width of the standard console the menu is precomputed for
+constexpr int kMenuFrameWidth = 80;
+
+// The menu never changes, so it is laid out once at compile time
+constexpr mini_utils::StaticFrame<kMenuFrameWidth, kMenuLines>
+MakeMenuFrame() {
+  mini_utils::StaticFrame<kMenuFrameWidth, kMenuLines> frame;
+  frame.horizontalSeparator(kMenuFormatCharacter)
+      .formatFullBorder("Item Tracker Menu", kMenuFormatCharacter)
+      .formatSideBorder("Options:");
+  for (const char* item : kMenuItems) {
+    frame.formatSideBorder(item);
+  }
+  frame.horizontalSeparator(kMenuFormatCharacter);
+  return frame;
+}
+
+constexpr auto kMenuFrame = MakeMenuFrame();
+
+// Bytes of text read at once when counting words
+constexpr size_t kReadChunkSize = 1 << 20;
+// Base of the polynomial hash over the word hashes of a run
+constexpr uint64_t kNGramHashBase = 0x100000001B3ULL;
+constexpr size_t kMinNGramSlots = 1024;
+constexpr uint32_t kNoItem = UINT32_MAX;
+
+// Spread the bits of a run's hash, whose low bits pick its slot
+uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  return hash ^ (hash >> 33);
+}
+
+// True if the item is the words joined by single spaces
+bool IsJoinedWords(std::string_view item, const Word* words, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) {
+      if (item.empty() || item[0] != ' ') return false;
+      item.remove_prefix(1);
+    }
+    if (item.substr(0, words[i].text.size()) != words[i].text) return false;
+    item.remove_prefix(words[i].text.size());
+  }
+  return item.empty();
+}
+
+// Items offered when the searched item is not present
+constexpr size_t kMaxSuggestions = 5;
+// Typos tolerated in suggestions
+constexpr int kMaxSuggestionDistance = 2;
+
+// Items starting with, containing or close to the text, in that order
+std::vector<ItemMatch> FindSuggestions(const ItemSearchIndex& index,
+                                       const std::string& text) {
+  std::vector<ItemMatch> suggestions;
+  const auto add_new = [&suggestions](const std::vector<ItemMatch>& matches) {
+    for (const ItemMatch& match : matches) {
+      const bool is_known =
+          std::any_of(suggestions.begin(), suggestions.end(),
+                      [&match](const ItemMatch& known) {
+                        return known.item == match.item;
+                      });
+      if (!is_known && suggestions.size() < kMaxSuggestions) {
+        suggestions.push_back(match);
+      }
+    }
+  };
+  add_new(index.FindByPrefix(text, kMaxSuggestions));
+  add_new(index.FindBySubstring(text, kMaxSuggestions));
+  add_new(index.FindSimilar(text, kMaxSuggestionDistance, kMaxSuggestions));
+  return suggestions;
+}
+}  // namespace
 
 // ItemTracker:Public
+ItemTracker::ItemTracker(std::pmr::memory_resource* resource)
+    : item_names_(resource),
+      frequencies_(resource),
+      search_index_(resource),
+      ngram_slots_(resource),
+      ngram_key_(resource),
+      prefix_hashes_(resource),
+      base_powers_(resource) {}
+
 bool ItemTracker::LoadItemsFromFile(const std::string& file_name) {
   std::ifstream input_file(file_name);
   if (!input_file.is_open() || input_file.fail()) {
@@ -14,46 +107,287 @@ bool ItemTracker::LoadItemsFromFile(const std::string& file_name) {
 }
 
 bool ItemTracker::ImportFromStream(std::istream& input_stream) {
-  std::string line;
+  // The line buffer comes from the tracker's resource too, so counting
+  // lines never touches the global heap when the tracker has an arena
+  std::pmr::string line(frequencies_.get_allocator().resource());
   while (getline(input_stream, line)) {
-    std::string trimmed_line = mini_utils::trim(line);
-    if (!trimmed_line.empty()) ++items_[trimmed_line];
+    const std::string_view trimmed_line = mini_utils::trimView(line);
+    if (trimmed_line.empty()) continue;
+    const uint32_t id = item_names_.intern(trimmed_line);
+    if (id == frequencies_.size()) frequencies_.push_back(0);
+    ++frequencies_[id];
   }
+  is_search_index_stale_ = true;
   return true;
 }
 
-int ItemTracker::GetWordFrequency(const std::string& word) const {
-  auto found_item = items_.find(word);
-  return found_item == items_.end() ? 0 : found_item->second;
+bool ItemTracker::LoadWordsFromFile(const std::string& file_name,
+                                    int max_ngram_words) {
+  std::ifstream input_file(file_name, std::ios::binary);
+  if (!input_file.is_open() || input_file.fail()) {
+    return false;
+  }
+  return ImportWordsFromStream(input_file, max_ngram_words);
+}
+
+bool ItemTracker::ImportWordsFromStream(std::istream& input_stream,
+                                        int max_ngram_words) {
+  max_ngram_words = std::max(max_ngram_words, 1);
+  base_powers_.assign(max_ngram_words + 1, 1);
+  for (int length = 1; length <= max_ngram_words; ++length) {
+    base_powers_[length] = base_powers_[length - 1] * kNGramHashBase;
+  }
+
+  // Text is read in large chunks and split into lines in place; the bytes
+  // after the last line break carry over to the next read
+  std::pmr::memory_resource* const resource =
+      frequencies_.get_allocator().resource();
+  std::pmr::string buffer(resource);
+  buffer.resize(kReadChunkSize);
+  std::pmr::vector<Word> words(resource);
+  size_t carried = 0;
+  while (true) {
+    input_stream.read(&buffer[carried], buffer.size() - carried);
+    const size_t end = carried + static_cast<size_t>(input_stream.gcount());
+    const char* const data = buffer.data();
+    if (end == carried) {
+      // The last line may lack a line break
+      words.clear();
+      SplitWords(std::string_view(data, carried), words);
+      CountWords(words, max_ngram_words);
+      break;
+    }
+
+    size_t line_start = 0;
+    while (const void* found =
+               std::memchr(data + line_start, '\n', end - line_start)) {
+      const size_t line_end = static_cast<const char*>(found) - data;
+      words.clear();
+      SplitWords(std::string_view(data + line_start, line_end - line_start),
+                 words);
+      CountWords(words, max_ngram_words);
+      line_start = line_end + 1;
+    }
+
+    carried = end - line_start;
+    std::memmove(&buffer[0], data + line_start, carried);
+    // A line longer than the buffer needs more room
+    if (carried == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+  }
+  is_search_index_stale_ = true;
+  return true;
+}
+
+bool ItemTracker::LoadSnapshotFromFile(const std::string& file_name) {
+  std::ifstream input_file(file_name);
+  if (!input_file.is_open() || input_file.fail()) {
+    return false;
+  }
+  return ImportSnapshotFromStream(input_file);
+}
+
+bool ItemTracker::ImportSnapshotFromStream(std::istream& input_stream) {
+  std::pmr::string line(frequencies_.get_allocator().resource());
+  std::string_view item;
+  int frequency = 0;
+  is_search_index_stale_ = true;
+  while (getline(input_stream, line)) {
+    if (line.empty()) continue;
+    if (!ParseSnapshotLine(line, item, frequency)) {
+      return false;
+    }
+    const uint32_t id = item_names_.intern(item);
+    if (id == frequencies_.size()) frequencies_.push_back(0);
+    frequencies_[id] += frequency;
+  }
+  return true;
+}
+
+bool ItemTracker::ParseSnapshotLine(std::string_view line,
+                                    std::string_view& item, int& frequency) {
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  // Items may contain spaces, the frequency cannot
+  const size_t separator = line.rfind(' ');
+  if (separator == std::string_view::npos || separator == 0) {
+    return false;
+  }
+  const char* const end = line.data() + line.size();
+  const auto result =
+      std::from_chars(line.data() + separator + 1, end, frequency);
+  if (result.ec != std::errc() || result.ptr != end || frequency < 0) {
+    return false;
+  }
+  item = line.substr(0, separator);
+  return true;
 }
 
-bool ItemTracker::ExportItemsToFile(const std::string& file_name) const {
+void ItemTracker::Reserve(size_t item_count) {
+  item_names_.reserve(item_count);
+  frequencies_.reserve(item_count);
+}
+
+int ItemTracker::GetWordFrequency(std::string_view word) const {
+  uint32_t id = 0;
+  return item_names_.find(word, id) ? frequencies_[id] : 0;
+}
+
+bool ItemTracker::FindItem(std::string_view item, uint32_t& id) const {
+  return item_names_.find(item, id);
+}
+
+std::string_view ItemTracker::GetItemName(uint32_t id) const {
+  return item_names_.view(id);
+}
+
+int ItemTracker::GetItemFrequency(uint32_t id) const {
+  return frequencies_[id];
+}
+
+size_t ItemTracker::GetItemCount() const { return frequencies_.size(); }
+
+bool ItemTracker::ExportItemsToFile(const std::string& file_name,
+                                    bool is_sorted_by_item) const {
   std::ofstream output_file(file_name);
   if (!output_file.is_open() || output_file.fail()) {
     return false;
   }
-  return ExportToStream(output_file);
+  return ExportToStream(output_file, is_sorted_by_item);
 }
 
-bool ItemTracker::ExportToStream(std::ostream& output_stream) const {
-  for (const auto& item : items_) {
-    output_stream << item.first << " " << item.second << "\n";
+bool ItemTracker::ExportToStream(std::ostream& output_stream,
+                                 bool is_sorted_by_item) const {
+  if (!is_sorted_by_item) {
+    ForEachItem([&output_stream](std::string_view item, int frequency) {
+      output_stream << item << " " << frequency << "\n";
+    });
+    return true;
+  }
+
+  std::vector<uint32_t> ids(frequencies_.size());
+  for (uint32_t id = 0; id < ids.size(); ++id) {
+    ids[id] = id;
+  }
+  std::sort(ids.begin(), ids.end(), [this](uint32_t left, uint32_t right) {
+    return item_names_.view(left) < item_names_.view(right);
+  });
+  for (const uint32_t id : ids) {
+    output_stream << item_names_.view(id) << " " << frequencies_[id] << "\n";
   }
   return true;
 }
 
 std::unordered_map<std::string, int> ItemTracker::GetItems() const {
-  return items_;
+  std::unordered_map<std::string, int> items;
+  items.reserve(frequencies_.size());
+  ForEachItem([&items](std::string_view item, int frequency) {
+    items.emplace(item, frequency);
+  });
+  return items;
+}
+
+void ItemTracker::Merge(const ItemTracker& other) {
+  // Ids differ between trackers, so each of the other's items is mapped once
+  for (uint32_t other_id = 0; other_id < other.frequencies_.size();
+       ++other_id) {
+    const uint32_t id = item_names_.intern(other.item_names_.view(other_id));
+    if (id == frequencies_.size()) frequencies_.push_back(0);
+    frequencies_[id] += other.frequencies_[other_id];
+  }
+  is_search_index_stale_ = true;
+}
+
+const ItemSearchIndex& ItemTracker::GetSearchIndex() const {
+  if (is_search_index_stale_) {
+    search_index_.Build(item_names_, frequencies_);
+    is_search_index_stale_ = false;
+  }
+  return search_index_;
+}
+
+// ItemTracker:Private
+
+void ItemTracker::CountWords(const std::pmr::vector<Word>& words,
+                             int max_ngram_words) {
+  // prefix_hashes_[i] is the polynomial hash of the first i word hashes, so
+  // the hash of any run follows from two prefixes as the window moves
+  prefix_hashes_.resize(words.size() + 1);
+  prefix_hashes_[0] = 0;
+  for (size_t i = 0; i < words.size(); ++i) {
+    prefix_hashes_[i + 1] = prefix_hashes_[i] * kNGramHashBase + words[i].hash;
+  }
+  for (size_t first = 0; first < words.size(); ++first) {
+    const size_t max_count =
+        std::min(words.size() - first, static_cast<size_t>(max_ngram_words));
+    for (size_t count = 1; count <= max_count; ++count) {
+      const uint64_t hash = prefix_hashes_[first + count] -
+                            prefix_hashes_[first] * base_powers_[count];
+      CountNGram(&words[first], count, MixHash(hash));
+    }
+  }
+}
+
+void ItemTracker::CountNGram(const Word* words, size_t count, uint64_t hash) {
+  if ((ngram_count_ + 1) * 2 > ngram_slots_.size()) {
+    GrowNGramTable();
+  }
+  const size_t mask = ngram_slots_.size() - 1;
+  size_t slot = hash & mask;
+  for (; ngram_slots_[slot].id != kNoItem; slot = (slot + 1) & mask) {
+    const NGramSlot& candidate = ngram_slots_[slot];
+    if (candidate.hash == hash &&
+        IsJoinedWords(item_names_.view(candidate.id), words, count)) {
+      ++frequencies_[candidate.id];
+      return;
+    }
+  }
+
+  // First sight of the run: only now is its string built
+  ngram_key_.clear();
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) ngram_key_ += ' ';
+    ngram_key_ += words[i].text;
+  }
+  const uint32_t id = item_names_.intern(ngram_key_);
+  if (id == frequencies_.size()) frequencies_.push_back(0);
+  ++frequencies_[id];
+  ngram_slots_[slot] = {hash, id};
+  ++ngram_count_;
+}
+
+void ItemTracker::GrowNGramTable() {
+  std::pmr::vector<NGramSlot> slots(
+      std::max(kMinNGramSlots, ngram_slots_.size() * 2), {0, kNoItem},
+      ngram_slots_.get_allocator());
+  const size_t mask = slots.size() - 1;
+  for (const NGramSlot& entry : ngram_slots_) {
+    if (entry.id == kNoItem) continue;
+    size_t slot = entry.hash & mask;
+    while (slots[slot].id != kNoItem) slot = (slot + 1) & mask;
+    slots[slot] = entry;
+  }
+  ngram_slots_.swap(slots);
 }
 // /ItemTracker
 
 // ItemTrackerCli:Public
 ItemTrackerCli::ItemTrackerCli(const std::string& input_file_name,
                                const std::string& output_file_name,
-                               int max_console_width)
+                               int max_console_width,
+                               std::pmr::memory_resource* resource)
     : input_file_name_(input_file_name),
       output_file_name_(output_file_name),
-      formatter_(max_console_width) {}
+      item_tracker_(resource),
+      formatter_(max_console_width),
+      menu_screen_(max_console_width, kMenuLines) {}
+
+void ItemTrackerCli::SetStreams(std::istream& input, std::ostream& output) {
+  input_ = &input;
+  output_ = &output;
+}
 
 void ItemTrackerCli::Start() {
   if (!item_tracker_.LoadItemsFromFile(input_file_name_)) {
@@ -69,36 +403,45 @@ void ItemTrackerCli::Start() {
   }
 
   int user_choice = 0;
-  while (user_choice != 4) {
-    DisplayMenu();
-    user_choice = mini_utils::getValidatedInput<int>(
-        "State your choice: ",
-        [](int input) { return input >= 1 && input <= 4; },
-        "integer 1 through 4");
-    mini_utils::clearInput();
-    HandleMenuChoice(user_choice);
-    std::cout << std::endl;
+  try {
+    while (user_choice != 4) {
+      DisplayMenu();
+      user_choice = mini_utils::getValidatedInput<int>(
+          *input_, *output_, "State your choice: ",
+          [](int input) { return input >= 1 && input <= 4; },
+          "integer 1 through 4");
+      mini_utils::clearInput(*input_);
+      HandleMenuChoice(user_choice);
+      *output_ << std::endl;
+    }
+  } catch (const mini_utils::InputEndedError&) {
+    // The input ended without choosing to exit, e.g. at the end of a script
+    *output_ << std::endl;
   }
 }
 
 // ItemTrackerCli:Private
 
-void ItemTrackerCli::DisplayMenu() const {
-  const char FORMAT_CHARACTER = '*';
-  std::cout << formatter_.horizontalSeparator(FORMAT_CHARACTER) << "\n"
-            << formatter_.formatFullBorder("Item Tracker Menu",
-                                           FORMAT_CHARACTER)
-            << "\n"
-            << formatter_.formatSideBorder("Options:") << "\n";
-
-  const std::vector<std::string> kMenuItems = {
-      "1. Find item frequency", "2. List items with frequencies",
-      "3. List item histogram with frequencies", "4. Exit"};
-
-  for (const auto& item : kMenuItems) {
-    std::cout << formatter_.formatSideBorder(item) << "\n";
+void ItemTrackerCli::DisplayMenu() {
+  if (formatter_.getWidth() == kMenuFrameWidth) {
+    menu_screen_.writeLines(0, {kMenuFrame.data(), kMenuFrame.size()});
+  } else {
+    // Other console widths are laid out at runtime
+    int row = 0;
+    formatter_.appendHorizontalSeparator(menu_screen_.beginLine(row++),
+                                         kMenuFormatCharacter);
+    formatter_.appendFullBorder(menu_screen_.beginLine(row++),
+                                "Item Tracker Menu", kMenuFormatCharacter);
+    formatter_.appendSideBorder(menu_screen_.beginLine(row++), "Options:");
+    for (const char* item : kMenuItems) {
+      formatter_.appendSideBorder(menu_screen_.beginLine(row++), item);
+    }
+    formatter_.appendHorizontalSeparator(menu_screen_.beginLine(row),
+                                         kMenuFormatCharacter);
   }
-  std::cout << formatter_.horizontalSeparator(FORMAT_CHARACTER) << std::endl;
+  // The answers to the last menu scrolled it away, so it is written in full
+  menu_screen_.invalidate();
+  menu_screen_.present(*output_);
 }
 
 void ItemTrackerCli::HandleMenuChoice(int user_choice) const {
@@ -113,7 +456,7 @@ void ItemTrackerCli::HandleMenuChoice(int user_choice) const {
       ListItemHistogram();
       break;
     case 4:
-      std::cout << "Goodbye!" << std::endl;
+      *output_ << "Goodbye!" << std::endl;
       break;
     default:
       std::cerr << "Invalid choice. Please, select a valid menu item."
@@ -124,37 +467,47 @@ void ItemTrackerCli::HandleMenuChoice(int user_choice) const {
 // Prompts the user for an item and displays its frequency
 void ItemTrackerCli::FindItemFrequency() const {
   std::string user_input = "";
-  std::cout << "Please, enter item to search for: ";
-  while (user_input.empty()) getline(std::cin, user_input);
+  *output_ << "Please, enter item to search for: ";
+  while (user_input.empty()) {
+    if (!getline(*input_, user_input)) {
+      throw mini_utils::InputEndedError();
+    }
+  }
 
   int frequency = item_tracker_.GetWordFrequency(user_input);
   const std::string s_suffix = frequency != 1 ? "s" : "";
 
   if (frequency == 0) {
-    std::cout << "Item \"" << user_input << "\" is not present in the list."
-              << std::endl;
+    *output_ << "Item \"" << user_input << "\" is not present in the list."
+             << std::endl;
+    const std::vector<ItemMatch> suggestions =
+        FindSuggestions(item_tracker_.GetSearchIndex(), user_input);
+    for (size_t i = 0; i < suggestions.size(); ++i) {
+      *output_ << (i == 0 ? "Did you mean: " : ", ") << suggestions[i].item
+               << " (" << suggestions[i].frequency << ")";
+    }
+    if (!suggestions.empty()) {
+      *output_ << "?" << std::endl;
+    }
   } else {
-    std::cout << "Item \"" << user_input << "\" encountered " << frequency
-              << " time" << s_suffix << "." << std::endl;
+    *output_ << "Item \"" << user_input << "\" encountered " << frequency
+             << " time" << s_suffix << "." << std::endl;
   }
 }
 
 // Displays all items with their corresponding frequencies
 void ItemTrackerCli::ListItemsWithFrequencies() const {
-  const auto& items = item_tracker_.GetItems();
-  for (const auto& item : items) {
-    std::cout << item.first << " " << item.second << std::endl;
-  }
+  item_tracker_.ForEachItem([this](std::string_view item, int frequency) {
+    *output_ << item << " " << frequency << std::endl;
+  });
 }
 
 // Displays all items as a histogram (bars made of '#' characters) based on
 // their frequencies
 void ItemTrackerCli::ListItemHistogram() const {
-  const auto& items = item_tracker_.GetItems();
-  for (const auto& item : items) {
-    std::cout << item.first << " " << std::string(item.second, '#')
-              << std::endl;
-  }
+  item_tracker_.ForEachItem([this](std::string_view item, int frequency) {
+    *output_ << item << " " << std::string(frequency, '#') << std::endl;
+  });
 }
 // /ItemTrackerCli
 
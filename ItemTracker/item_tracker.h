@@ -1,46 +1,148 @@
 #ifndef ITEM_TRACKER_H
 #define ITEM_TRACKER_H
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "item_search_index.h"
 #include "mini_utils.h"
+#include "screen.h"
+#include "string_pool.h"
+#include "word_splitter.h"
 
 namespace item_tracker {
 
 class ItemTracker {
  public:
+  ItemTracker() = default;
+
+  // Keep the items, their frequencies and the search index in the resource,
+  // which must outlive the tracker. A batch run can pass a
+  // std::pmr::monotonic_buffer_resource and free everything at once.
+  explicit ItemTracker(std::pmr::memory_resource* resource);
+
   // Import item data from a file, counting occurrences of each line
   bool LoadItemsFromFile(const std::string& file_name);
 
   // Import item data from a stream, counting occurrences of each line
   bool ImportFromStream(std::istream& input_stream);
 
+  // Import free text, counting every word and every run of 2 up to
+  // max_ngram_words consecutive words of a line. A run is stored as its words
+  // joined by single spaces, so "red  apple." counts as "red apple".
+  bool LoadWordsFromFile(const std::string& file_name, int max_ngram_words = 1);
+  bool ImportWordsFromStream(std::istream& input_stream,
+                             int max_ngram_words = 1);
+
+  // Import item data written by ExportToStream, adding each line's
+  // frequency to its item. Returns false at the first malformed line.
+  bool LoadSnapshotFromFile(const std::string& file_name);
+  bool ImportSnapshotFromStream(std::istream& input_stream);
+
+  // Split an exported "item frequency" line. Returns false if it is not one.
+  static bool ParseSnapshotLine(std::string_view line, std::string_view& item,
+                                int& frequency);
+
+  // Make room for the given number of distinct items, e.g. a HyperLogLog
+  // estimate, so importing them does not grow the tables step by step
+  void Reserve(size_t item_count);
+
   // Get frequency of the word in the internal items list
-  int GetWordFrequency(const std::string& word) const;
+  int GetWordFrequency(std::string_view word) const;
+
+  // Id of a stored item, the position ForEachItem() visits it at
+  bool FindItem(std::string_view item, uint32_t& id) const;
+
+  // Stored item and frequency by id, 0..GetItemCount() - 1
+  std::string_view GetItemName(uint32_t id) const;
+  int GetItemFrequency(uint32_t id) const;
 
-  // Export item data to a file
-  bool ExportItemsToFile(const std::string& file_name) const;
+  // Number of distinct items stored
+  size_t GetItemCount() const;
+
+  // Export item data to a file, in first-seen order or sorted by item. A
+  // sorted snapshot can be compared in one pass, see FrequencyDiff.
+  bool ExportItemsToFile(const std::string& file_name,
+                         bool is_sorted_by_item = false) const;
 
   // Export item data to a stream
-  bool ExportToStream(std::ostream& output_stream) const;
+  bool ExportToStream(std::ostream& output_stream,
+                      bool is_sorted_by_item = false) const;
 
   // Get list of stored items
   std::unordered_map<std::string, int> GetItems() const;
 
+  // Call visit(item, frequency) for every stored item, in the order the
+  // items were first imported
+  template <typename Visitor>
+  void ForEachItem(Visitor visit) const {
+    for (uint32_t id = 0; id < frequencies_.size(); ++id) {
+      visit(item_names_.view(id), frequencies_[id]);
+    }
+  }
+
+  // Add the frequencies of the other tracker's items to this one
+  void Merge(const ItemTracker& other);
+
+  // Prefix, substring and typo-tolerant search over the stored items. It is
+  // rebuilt on the first call after items change, so bulk imports do not pay
+  // for it.
+  const ItemSearchIndex& GetSearchIndex() const;
+
  private:
-  std::unordered_map<std::string, int> items_;
+  // Items are counted by their id in the pool, so every distinct item is
+  // stored once and counting never hashes into a map of strings
+  mini_utils::StringPool item_names_;
+  std::pmr::vector<int> frequencies_;
+  // Built lazily by GetSearchIndex()
+  mutable ItemSearchIndex search_index_;
+  mutable bool is_search_index_stale_ = false;
+
+  // Slot of the word and n-gram table: the rolling hash of a run of words
+  // and the id of the run's item
+  struct NGramSlot {
+    uint64_t hash;
+    uint32_t id;
+  };
+
+  // Count the runs of words of a line, each located by the rolling hash of
+  // its word hashes, so a run's string is built only on first sight
+  void CountWords(const std::pmr::vector<Word>& words, int max_ngram_words);
+  void CountNGram(const Word* words, size_t count, uint64_t hash);
+  void GrowNGramTable();
+
+  // Open addressing with linear probing, at most half full, a power of two
+  std::pmr::vector<NGramSlot> ngram_slots_;
+  size_t ngram_count_ = 0;
+  std::pmr::string ngram_key_;
+  // Rolling hash prefixes of the current line and powers of the hash base
+  std::pmr::vector<uint64_t> prefix_hashes_;
+  std::pmr::vector<uint64_t> base_powers_;
 };
 
 class ItemTrackerCli {
  public:
-  ItemTrackerCli(const std::string& input_file_name,
-                 const std::string& output_file_name, int max_console_width);
+  // The tracker allocates from the resource, see ItemTracker
+  ItemTrackerCli(
+      const std::string& input_file_name, const std::string& output_file_name,
+      int max_console_width,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   // Start the CLI, loading items from the file and displaying the menu.
+  // Returns once the user exits or the input ends.
   void Start();
 
+  // Talk through the given streams instead of the console, e.g. to replay a
+  // scripted session. Errors still go to std::cerr. The streams must outlive
+  // the CLI.
+  void SetStreams(std::istream& input, std::ostream& output);
+
  private:
-  void DisplayMenu() const;
+  void DisplayMenu();
   void HandleMenuChoice(int user_choice) const;
   void FindItemFrequency() const;
   void ListItemsWithFrequencies() const;
@@ -50,6 +152,10 @@ class ItemTrackerCli {
   std::string output_file_name_;
   ItemTracker item_tracker_;
   mini_utils::StringFormatter formatter_;
+  // Menu lines, kept between menus so redrawing one does not allocate
+  mini_utils::Screen menu_screen_;
+  std::istream* input_ = &std::cin;
+  std::ostream* output_ = &std::cout;
 };
 
 }  // namespace item_tracker
@@ -1,14 +1,236 @@
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "co_occurrence_counter.h"
+#include "frequency_diff.h"
+#include "item_query_server.h"
 #include "item_tracker.h"
+#include "mini_utils.h"
 
-int main() {
+namespace {
+item_tracker::ItemQueryServer* running_server = nullptr;
+
+void StopServer(int) { running_server->Stop(); }
+
+// Load the items once and answer queries about them until interrupted
+int Serve(const std::string& input_file_name, const std::string& socket_path,
+          int reader_count) {
+  item_tracker::ItemTracker tracker;
+  if (!tracker.LoadItemsFromFile(input_file_name)) {
+    std::cerr << "Error: Unable to import items from file: " << input_file_name
+              << std::endl;
+    return 1;
+  }
+  item_tracker::ItemQueryServer server(tracker, reader_count);
+  if (!server.Listen(socket_path)) {
+    std::cerr << "Error: Unable to listen on socket: " << socket_path << " ("
+              << std::strerror(errno) << ")" << std::endl;
+    return 1;
+  }
+  running_server = &server;
+  std::signal(SIGINT, StopServer);
+  std::signal(SIGTERM, StopServer);
+  std::cout << "Serving items of " << input_file_name << " on "
+            << socket_path << std::endl;
+  server.Run();
+  return 0;
+}
+
+// Print the changed items as a table, largest change first
+void PrintDeltas(const item_tracker::FrequencyDiff& diff, int console_width) {
+  const std::vector<item_tracker::ItemDelta>& deltas = diff.GetDeltas();
+  std::cout << deltas.size() << " items changed: " << diff.GetNewCount()
+            << " new, " << diff.GetVanishedCount() << " vanished"
+            << std::endl;
+
+  mini_utils::TableFormatter table(console_width);
+  table.setHeaders({"Item", "Before", "After", "Change", "Ratio"});
+  if (!table.setColumnWidths({console_width - 48, 12, 12, 12, 12})) {
+    return;
+  }
+  const mini_utils::StringFormatter formatter(console_width);
+  size_t next = 0;
+  table.renderPage(std::cout, [&](std::vector<std::string>& row) {
+    if (next == deltas.size()) {
+      return false;
+    }
+    const item_tracker::ItemDelta& delta = deltas[next++];
+    row.resize(5);
+    row[0] = delta.item;
+    row[1] = std::to_string(delta.before);
+    row[2] = std::to_string(delta.after);
+    row[3] = (delta.GetChange() > 0 ? "+" : "") +
+             std::to_string(delta.GetChange());
+    if (delta.before == 0) {
+      row[4] = "new";
+    } else if (delta.after == 0) {
+      row[4] = "vanished";
+    } else {
+      row[4] = "x";
+      formatter.appendWithPrecision(row[4], delta.GetRatio());
+    }
+    return true;
+  });
+}
+
+// Compare a snapshot written by an earlier run with the input file, or with
+// another snapshot, and print what changed
+int Compare(const std::string& input_file_name,
+            const std::string& before_file_name,
+            const std::string& after_file_name, int console_width) {
+  std::ifstream before(before_file_name);
+  if (!before.is_open()) {
+    std::cerr << "Error: Unable to open snapshot: " << before_file_name
+              << std::endl;
+    return 1;
+  }
+
+  item_tracker::ItemTracker after_tracker;
+  item_tracker::FrequencyDiff diff;
+  bool is_compared = false;
+  if (after_file_name.empty()) {
+    if (!after_tracker.LoadItemsFromFile(input_file_name)) {
+      std::cerr << "Error: Unable to import items from file: "
+                << input_file_name << std::endl;
+      return 1;
+    }
+    is_compared = diff.Compare(before, after_tracker);
+  } else {
+    std::ifstream after(after_file_name);
+    if (!after.is_open()) {
+      std::cerr << "Error: Unable to open snapshot: " << after_file_name
+                << std::endl;
+      return 1;
+    }
+    is_compared = diff.CompareSorted(before, after);
+    // Snapshots not sorted by item are joined through an index of one
+    if (!is_compared) {
+      before.clear();
+      before.seekg(0);
+      is_compared = after_tracker.LoadSnapshotFromFile(after_file_name) &&
+                    diff.Compare(before, after_tracker);
+    }
+  }
+  if (!is_compared) {
+    std::cerr << "Error: Malformed snapshot, expected \"item frequency\" lines"
+              << std::endl;
+    return 1;
+  }
+  PrintDeltas(diff, console_width);
+  return 0;
+}
+
+// Print the items most often found in the same session as each item of the
+// file, most frequent item first
+int PrintPartners(const std::string& sessions_file_name, int console_width) {
+  constexpr size_t kTopPartners = 3;
+  item_tracker::CoOccurrenceCounter counter;
+  if (!counter.LoadSessionsFromFile(sessions_file_name)) {
+    std::cerr << "Error: Unable to import sessions from file: "
+              << sessions_file_name << std::endl;
+    return 1;
+  }
+  std::cout << counter.GetItemCount() << " items, " << counter.GetPairCount()
+            << " pairs seen together" << std::endl;
+
+  std::vector<uint32_t> ids(counter.GetItemCount());
+  for (uint32_t id = 0; id < ids.size(); ++id) {
+    ids[id] = id;
+  }
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&counter](uint32_t left, uint32_t right) {
+                     return counter.GetItemFrequency(left) >
+                            counter.GetItemFrequency(right);
+                   });
+
+  mini_utils::TableFormatter table(console_width);
+  table.setHeaders({"Item", "Sessions", "Seen with", "Together"});
+  const int kNameWidth = (console_width - 24) / 2;
+  if (!table.setColumnWidths({kNameWidth, 12, kNameWidth, 12})) {
+    return 1;
+  }
+  // One row per partner, the item's name and count only on the first
+  size_t next = 0;
+  size_t next_partner = 0;
+  std::vector<item_tracker::Partner> partners;
+  table.renderPage(std::cout, [&](std::vector<std::string>& row) {
+    if (next_partner == 0) {
+      if (next == ids.size()) {
+        return false;
+      }
+      partners = counter.GetTopPartners(ids[next], kTopPartners);
+    }
+    row.assign(4, "");
+    if (next_partner == 0) {
+      row[0] = counter.GetItemName(ids[next]);
+      row[1] = std::to_string(counter.GetItemFrequency(ids[next]));
+    }
+    if (next_partner < partners.size()) {
+      row[2] = counter.GetItemName(partners[next_partner].id);
+      row[3] = std::to_string(partners[next_partner].frequency);
+    }
+    if (++next_partner >= partners.size()) {
+      next_partner = 0;
+      ++next;
+    }
+    return true;
+  });
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
   // These are set in stone by assignment requirements
   // Normally we can fetch those from arguments/ask user for input
   const std::string kInputFileName = "CS210_Project_Three_Input_File.txt";
   const std::string kOutputFileName = "frequency.dat";
 
   const int kStandardConsoleWidth = 80;
+
+  std::string socket_path;
+  int reader_count = 0;
+  std::string before_file_name;
+  std::string after_file_name;
+  std::string sessions_file_name;
+  for (int i = 1; i + 1 < argc; ++i) {
+    // "--serve <socket>" answers queries over a Unix domain socket instead
+    // of showing the menu, with "--readers <count>" threads answering them
+    if (std::strcmp(argv[i], "--serve") == 0) {
+      socket_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--readers") == 0) {
+      reader_count = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--compare") == 0) {
+      // "--compare <snapshot> [<snapshot>]" prints how the items changed
+      // since the frequency.dat of an earlier run, or between two of them
+      before_file_name = argv[++i];
+      if (i + 1 < argc && std::strncmp(argv[i + 1], "--", 2) != 0) {
+        after_file_name = argv[++i];
+      }
+    } else if (std::strcmp(argv[i], "--pairs") == 0) {
+      // "--pairs <sessions>" prints the items found together most often in
+      // blocks of lines separated by blank lines
+      sessions_file_name = argv[++i];
+    }
+  }
+  if (!socket_path.empty()) {
+    return Serve(kInputFileName, socket_path, reader_count);
+  }
+  if (!before_file_name.empty()) {
+    return Compare(kInputFileName, before_file_name, after_file_name,
+                   kStandardConsoleWidth);
+  }
+
+  if (!sessions_file_name.empty()) {
+    return PrintPartners(sessions_file_name, kStandardConsoleWidth);
+  }
+
   item_tracker::ItemTrackerCli cli(kInputFileName, kOutputFileName,
                                    kStandardConsoleWidth);
   cli.Start();
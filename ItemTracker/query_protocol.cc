@@ -0,0 +1,139 @@
+#include "query_protocol.h"
+
+namespace item_tracker {
+namespace {
+constexpr size_t kLengthBytes = 4;
+
+// Start a frame with a length to be set by FinishFrame()
+size_t BeginRequest(std::string& frames, uint32_t request_id,
+                    QueryOpcode opcode) {
+  const size_t start = frames.size();
+  AppendUint32(frames, 0);
+  AppendUint32(frames, request_id);
+  frames += static_cast<char>(opcode);
+  return start;
+}
+}  // namespace
+
+void AppendUint32(std::string& out, uint32_t value) {
+  const char bytes[] = {
+      static_cast<char>(value), static_cast<char>(value >> 8),
+      static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+  out.append(bytes, sizeof(bytes));
+}
+
+void AppendString(std::string& out, std::string_view value) {
+  AppendUint32(out, static_cast<uint32_t>(value.size()));
+  out += value;
+}
+
+void FinishFrame(std::string& frames, size_t frame_start) {
+  const uint32_t length =
+      static_cast<uint32_t>(frames.size() - frame_start - kLengthBytes);
+  for (size_t i = 0; i < kLengthBytes; ++i) {
+    frames[frame_start + i] = static_cast<char>(length >> (8 * i));
+  }
+}
+
+bool ReadUint32(std::string_view& data, uint32_t& value) {
+  if (data.size() < 4) {
+    return false;
+  }
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 |
+          static_cast<uint32_t>(bytes[3]) << 24;
+  data.remove_prefix(4);
+  return true;
+}
+
+bool ReadString(std::string_view& data, std::string_view& value) {
+  uint32_t size = 0;
+  if (!ReadUint32(data, size) || size > data.size()) {
+    return false;
+  }
+  value = data.substr(0, size);
+  data.remove_prefix(size);
+  return true;
+}
+
+void AppendFrequencyRequest(std::string& frames, uint32_t request_id,
+                            std::string_view item) {
+  const size_t start =
+      BeginRequest(frames, request_id, QueryOpcode::kFrequency);
+  AppendString(frames, item);
+  FinishFrame(frames, start);
+}
+
+void AppendTopKRequest(std::string& frames, uint32_t request_id, uint32_t k) {
+  const size_t start = BeginRequest(frames, request_id, QueryOpcode::kTopK);
+  AppendUint32(frames, k);
+  FinishFrame(frames, start);
+}
+
+void AppendBatchFrequencyRequest(std::string& frames, uint32_t request_id,
+                                 const std::vector<std::string_view>& items) {
+  const size_t start =
+      BeginRequest(frames, request_id, QueryOpcode::kBatchFrequency);
+  AppendUint32(frames, static_cast<uint32_t>(items.size()));
+  for (std::string_view item : items) {
+    AppendString(frames, item);
+  }
+  FinishFrame(frames, start);
+}
+
+size_t GetQueryFrameSize(std::string_view buffer, bool& is_malformed) {
+  uint32_t length = 0;
+  if (!ReadUint32(buffer, length)) {
+    return 0;
+  }
+  if (length < kQueryRequestHeaderBytes - kLengthBytes ||
+      length > kMaxQueryFrameBytes - kLengthBytes) {
+    is_malformed = true;
+    return 0;
+  }
+  return buffer.size() < length ? 0 : length + kLengthBytes;
+}
+
+bool DecodeQueryResponse(std::string_view frame, QueryResponse& response) {
+  uint32_t length = 0;
+  if (!ReadUint32(frame, length) || length != frame.size() ||
+      !ReadUint32(frame, response.request_id) || frame.size() < 2) {
+    return false;
+  }
+  response.opcode = static_cast<QueryOpcode>(frame[0]);
+  response.status = static_cast<QueryStatus>(frame[1]);
+  frame.remove_prefix(2);
+  response.items.clear();
+  response.frequencies.clear();
+  // An error echoes whatever opcode the request had
+  if (response.status != QueryStatus::kOk) {
+    return frame.empty();
+  }
+  if (response.opcode < QueryOpcode::kFrequency ||
+      response.opcode > QueryOpcode::kBatchFrequency) {
+    return false;
+  }
+
+  uint32_t count = 1;
+  if (response.opcode != QueryOpcode::kFrequency &&
+      (!ReadUint32(frame, count) || count > frame.size() / 4)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    std::string_view item;
+    if (response.opcode == QueryOpcode::kTopK) {
+      if (!ReadString(frame, item)) {
+        return false;
+      }
+      response.items.emplace_back(item);
+    }
+    uint32_t frequency = 0;
+    if (!ReadUint32(frame, frequency)) {
+      return false;
+    }
+    response.frequencies.push_back(static_cast<int>(frequency));
+  }
+  return frame.empty();
+}
+
+}  // namespace item_tracker
@@ -0,0 +1,84 @@
+#ifndef QUERY_PROTOCOL_H
+#define QUERY_PROTOCOL_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace item_tracker {
+
+// Binary protocol of ItemQueryServer. Every message is a frame:
+//   uint32  length of the rest of the frame
+//   uint32  request id, chosen by the client and echoed in the response
+//   uint8   opcode
+//   uint8   status, responses only
+//   payload
+// Integers are little-endian, strings are a uint32 length and the bytes.
+//
+//   opcode            request payload          response payload
+//   kFrequency        string item              int32 frequency
+//   kTopK             uint32 k                 uint32 n, n x (string, int32)
+//   kBatchFrequency   uint32 n, n x string     uint32 n, n x int32
+//
+// A client may send any number of requests without waiting for responses.
+// Responses can arrive out of order and are matched up by request id.
+enum class QueryOpcode : uint8_t {
+  kFrequency = 1,
+  kTopK = 2,
+  kBatchFrequency = 3,
+};
+
+enum class QueryStatus : uint8_t {
+  kOk = 0,
+  // Unknown opcode or a payload that does not match it; no payload
+  kBadRequest = 1,
+};
+
+// Largest frame, length field included, either side accepts
+constexpr size_t kMaxQueryFrameBytes = 1 << 20;
+constexpr size_t kQueryRequestHeaderBytes = 9;
+constexpr size_t kQueryResponseHeaderBytes = 10;
+
+// Append a request frame to the frames to send
+void AppendFrequencyRequest(std::string& frames, uint32_t request_id,
+                            std::string_view item);
+void AppendTopKRequest(std::string& frames, uint32_t request_id, uint32_t k);
+void AppendBatchFrequencyRequest(std::string& frames, uint32_t request_id,
+                                 const std::vector<std::string_view>& items);
+
+// Size of the frame at the start of the buffer, or 0 if the buffer does not
+// hold all of it yet. Sets is_malformed if the frame cannot be valid, after
+// which the connection cannot be resynchronized.
+size_t GetQueryFrameSize(std::string_view buffer, bool& is_malformed);
+
+// Append a field in the wire format
+void AppendUint32(std::string& out, uint32_t value);
+void AppendString(std::string& out, std::string_view value);
+
+// Set the length field of the frame starting at frame_start, once the rest
+// of it is appended
+void FinishFrame(std::string& frames, size_t frame_start);
+
+// Read a field in the wire format off the front of the data. Return false
+// if the data is too short.
+bool ReadUint32(std::string_view& data, uint32_t& value);
+bool ReadString(std::string_view& data, std::string_view& value);
+
+// Decoded response frame. Decoding into the same object again reuses its
+// vectors.
+struct QueryResponse {
+  uint32_t request_id = 0;
+  QueryOpcode opcode = QueryOpcode::kFrequency;
+  QueryStatus status = QueryStatus::kOk;
+  // Items of a kTopK response
+  std::vector<std::string> items;
+  // One frequency per requested item, or per kTopK item
+  std::vector<int> frequencies;
+};
+
+// Decode a whole response frame. Returns false if it is malformed.
+bool DecodeQueryResponse(std::string_view frame, QueryResponse& response);
+
+}  // namespace item_tracker
+#endif  // QUERY_PROTOCOL_H
@@ -0,0 +1,351 @@
+#include "windowed_item_counter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+#include "mini_utils.h"
+
+namespace item_tracker {
+namespace {
+// Bytes read from a followed file at once
+constexpr size_t kReadChunkSize = 1 << 20;
+constexpr uint32_t kNotInBucket = UINT32_MAX;
+// Expired items are evicted once they outnumber the live ones and there are
+// at least this many items in all, or none are live
+constexpr size_t kMinItemsToEvict = 1024;
+
+// Division rounding towards negative infinity, so timestamps before the
+// epoch land in the right bucket
+long long FloorDivide(long long value, long long divisor) {
+  const long long quotient = value / divisor;
+  return quotient - (value % divisor != 0 && (value < 0) != (divisor < 0));
+}
+}  // namespace
+
+WindowedItemCounter::WindowedItemCounter(int bucket_seconds, int bucket_count)
+    : bucket_seconds_(std::max(bucket_seconds, 1)),
+      buckets_(std::max(bucket_count, 1)) {}
+
+bool WindowedItemCounter::Add(std::string_view item, long long timestamp,
+                              int count) {
+  const long long bucket_number = FloorDivide(timestamp, bucket_seconds_);
+  if (is_empty_) {
+    latest_bucket_ = bucket_number;
+    is_empty_ = false;
+  } else if (bucket_number > latest_bucket_) {
+    AdvanceTo(bucket_number);
+  } else if (bucket_number <=
+             latest_bucket_ - static_cast<long long>(buckets_.size())) {
+    return false;
+  }
+
+  const uint32_t id = Intern(item);
+  Bucket& bucket = BucketAt(bucket_number);
+  if (bucket_number != latest_bucket_) {
+    bucket.counts.emplace_back(id, count);
+  } else if (latest_position_buckets_[id] == latest_bucket_) {
+    bucket.counts[latest_positions_[id]].second += count;
+  } else {
+    latest_positions_[id] = static_cast<uint32_t>(bucket.counts.size());
+    latest_position_buckets_[id] = latest_bucket_;
+    bucket.counts.emplace_back(id, count);
+  }
+  AddToTotal(id, count);
+  return true;
+}
+
+bool WindowedItemCounter::ImportFromStream(std::istream& input_stream) {
+  std::string line;
+  while (getline(input_stream, line)) {
+    AddLine(line);
+  }
+  return true;
+}
+
+bool WindowedItemCounter::LoadNewLinesFromFile(const std::string& file_name) {
+  std::ifstream input_file(file_name, std::ios::binary | std::ios::ate);
+  if (!input_file.is_open() || input_file.fail()) {
+    return false;
+  }
+  // A file shorter than what was consumed was truncated or replaced
+  if (input_file.tellg() < file_offset_) {
+    file_offset_ = 0;
+  }
+  input_file.seekg(file_offset_);
+
+  // Complete lines are counted straight from the buffer; the bytes after the
+  // last line break carry over to the next read
+  if (read_buffer_.size() < kReadChunkSize) {
+    read_buffer_.resize(kReadChunkSize);
+  }
+  size_t carried = 0;
+  while (true) {
+    input_file.read(&read_buffer_[carried], read_buffer_.size() - carried);
+    const size_t end = carried + static_cast<size_t>(input_file.gcount());
+    if (end == carried) {
+      break;
+    }
+
+    size_t line_start = 0;
+    const char* const data = read_buffer_.data();
+    while (const void* found =
+               std::memchr(data + line_start, '\n', end - line_start)) {
+      const size_t line_end = static_cast<const char*>(found) - data;
+      AddLine(std::string_view(data + line_start, line_end - line_start));
+      line_start = line_end + 1;
+    }
+    file_offset_ += line_start;
+
+    carried = end - line_start;
+    std::memmove(&read_buffer_[0], data + line_start, carried);
+    // A line longer than the buffer needs more room
+    if (carried == read_buffer_.size()) {
+      read_buffer_.resize(read_buffer_.size() * 2);
+    }
+  }
+  return true;
+}
+
+int WindowedItemCounter::GetCount(std::string_view item) const {
+  uint32_t id = 0;
+  return item_names_.find(item, id) ? totals_[id] : 0;
+}
+
+int WindowedItemCounter::GetCount(std::string_view item,
+                                  long long window_seconds) const {
+  uint32_t id = 0;
+  if (!item_names_.find(item, id)) {
+    return 0;
+  }
+  const long long buckets = BucketsInWindow(window_seconds);
+  if (buckets == static_cast<long long>(buckets_.size())) {
+    return totals_[id];
+  }
+
+  int count = 0;
+  for (long long number = latest_bucket_ - buckets + 1;
+       number <= latest_bucket_; ++number) {
+    for (const auto& entry : BucketAt(number).counts) {
+      if (entry.first == id) {
+        count += entry.second;
+      }
+    }
+  }
+  return count;
+}
+
+std::vector<std::pair<std::string, int>> WindowedItemCounter::GetTopItems(
+    long long window_seconds, size_t limit) const {
+  std::vector<int> sums(item_names_.size());
+  const long long buckets = BucketsInWindow(window_seconds);
+  if (buckets == static_cast<long long>(buckets_.size())) {
+    sums = totals_;
+  } else {
+    SumBuckets(latest_bucket_ - buckets + 1, latest_bucket_, sums);
+  }
+
+  std::vector<uint32_t> ids;
+  ids.reserve(live_items_);
+  for (uint32_t id = 0; id < sums.size(); ++id) {
+    if (sums[id] > 0) {
+      ids.push_back(id);
+    }
+  }
+  const size_t count = std::min(limit, ids.size());
+  std::partial_sort(ids.begin(), ids.begin() + count, ids.end(),
+                    [&](uint32_t left, uint32_t right) {
+                      if (sums[left] != sums[right]) {
+                        return sums[left] > sums[right];
+                      }
+                      return item_names_.view(left) <
+                             item_names_.view(right);
+                    });
+
+  std::vector<std::pair<std::string, int>> top_items;
+  top_items.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    top_items.emplace_back(item_names_.view(ids[i]), sums[ids[i]]);
+  }
+  return top_items;
+}
+
+std::vector<ItemTrend> WindowedItemCounter::GetTrendingItems(
+    long long window_seconds, size_t limit) const {
+  // Both windows must fit in the retained range
+  const long long buckets =
+      std::min(BucketsInWindow(window_seconds),
+               static_cast<long long>(buckets_.size()) / 2);
+  std::vector<int> current(item_names_.size());
+  std::vector<int> previous(item_names_.size());
+  SumBuckets(latest_bucket_ - buckets + 1, latest_bucket_, current);
+  SumBuckets(latest_bucket_ - 2 * buckets + 1, latest_bucket_ - buckets,
+             previous);
+
+  std::vector<uint32_t> ids;
+  for (uint32_t id = 0; id < current.size(); ++id) {
+    if (current[id] > previous[id]) {
+      ids.push_back(id);
+    }
+  }
+  const auto delta = [&](uint32_t id) { return current[id] - previous[id]; };
+  const size_t count = std::min(limit, ids.size());
+  std::partial_sort(ids.begin(), ids.begin() + count, ids.end(),
+                    [&](uint32_t left, uint32_t right) {
+                      if (delta(left) != delta(right)) {
+                        return delta(left) > delta(right);
+                      }
+                      return item_names_.view(left) <
+                             item_names_.view(right);
+                    });
+
+  std::vector<ItemTrend> trends;
+  trends.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t id = ids[i];
+    trends.push_back({std::string(item_names_.view(id)), current[id],
+                      previous[id], delta(id)});
+  }
+  return trends;
+}
+
+long long WindowedItemCounter::GetLatestBucketStart() const {
+  return latest_bucket_ * bucket_seconds_;
+}
+
+long long WindowedItemCounter::GetRejectedLines() const {
+  return rejected_lines_;
+}
+
+size_t WindowedItemCounter::GetLiveItems() const { return live_items_; }
+
+size_t WindowedItemCounter::GetTrackedItems() const {
+  return item_names_.size();
+}
+
+uint32_t WindowedItemCounter::Intern(std::string_view item) {
+  const uint32_t id = item_names_.intern(item);
+  if (id < totals_.size()) {
+    return id;
+  }
+  totals_.push_back(0);
+  latest_positions_.push_back(kNotInBucket);
+  latest_position_buckets_.push_back(latest_bucket_ - 1);
+  return id;
+}
+
+void WindowedItemCounter::AddToTotal(uint32_t id, int count) {
+  const bool was_live = totals_[id] != 0;
+  totals_[id] += count;
+  if (was_live && totals_[id] == 0) {
+    --live_items_;
+  } else if (!was_live && totals_[id] != 0) {
+    ++live_items_;
+  }
+}
+
+void WindowedItemCounter::AdvanceTo(long long bucket_number) {
+  // Past a full turn of the ring every bucket is expired exactly once
+  const long long first = std::max(
+      latest_bucket_ + 1,
+      bucket_number - static_cast<long long>(buckets_.size()) + 1);
+  for (long long number = first; number <= bucket_number; ++number) {
+    Bucket& bucket = BucketAt(number);
+    for (const auto& entry : bucket.counts) {
+      AddToTotal(entry.first, -entry.second);
+    }
+    bucket.counts.clear();
+  }
+  latest_bucket_ = bucket_number;
+
+  // Each eviction at least halves the items, so its cost is spread over the
+  // items added since the previous one. A range that emptied out is always
+  // cleared.
+  if (live_items_ * 2 < item_names_.size() &&
+      (item_names_.size() >= kMinItemsToEvict || live_items_ == 0)) {
+    EvictExpiredItems();
+  }
+}
+
+void WindowedItemCounter::EvictExpiredItems() {
+  std::vector<uint32_t> new_ids(item_names_.size(), kNotInBucket);
+  for (const Bucket& bucket : buckets_) {
+    for (const auto& entry : bucket.counts) {
+      new_ids[entry.first] = 0;
+    }
+  }
+
+  // New ids never exceed old ones, so the per-item state moves down in place
+  mini_utils::StringPool kept_names;
+  for (uint32_t id = 0; id < new_ids.size(); ++id) {
+    if (new_ids[id] == kNotInBucket) {
+      continue;
+    }
+    const uint32_t new_id = kept_names.intern(item_names_.view(id));
+    new_ids[id] = new_id;
+    totals_[new_id] = totals_[id];
+    latest_positions_[new_id] = latest_positions_[id];
+    latest_position_buckets_[new_id] = latest_position_buckets_[id];
+  }
+  totals_.resize(kept_names.size());
+  latest_positions_.resize(kept_names.size());
+  latest_position_buckets_.resize(kept_names.size());
+
+  for (Bucket& bucket : buckets_) {
+    for (auto& entry : bucket.counts) {
+      entry.first = new_ids[entry.first];
+    }
+  }
+  item_names_ = std::move(kept_names);
+}
+
+void WindowedItemCounter::SumBuckets(long long first, long long last,
+                                     std::vector<int>& sums) const {
+  const long long oldest =
+      latest_bucket_ - static_cast<long long>(buckets_.size()) + 1;
+  first = std::max(first, oldest);
+  for (long long number = first; number <= last; ++number) {
+    for (const auto& entry : BucketAt(number).counts) {
+      sums[entry.first] += entry.second;
+    }
+  }
+}
+
+long long WindowedItemCounter::BucketsInWindow(long long window_seconds) const {
+  const long long buckets =
+      (std::max(window_seconds, 1LL) + bucket_seconds_ - 1) / bucket_seconds_;
+  return std::min(buckets, static_cast<long long>(buckets_.size()));
+}
+
+void WindowedItemCounter::AddLine(std::string_view line) {
+  line = mini_utils::trimView(line);
+  if (line.empty()) {
+    return;
+  }
+  long long timestamp = 0;
+  const auto [end, error] =
+      std::from_chars(line.data(), line.data() + line.size(), timestamp);
+  const size_t parsed = end - line.data();
+  const std::string_view item = mini_utils::trimView(line.substr(parsed));
+  // The timestamp must be separated from a non-empty item
+  if (error != std::errc() || parsed == line.size() ||
+      (line[parsed] != ' ' && line[parsed] != '\t') || item.empty() ||
+      !Add(item, timestamp)) {
+    ++rejected_lines_;
+  }
+}
+
+WindowedItemCounter::Bucket& WindowedItemCounter::BucketAt(
+    long long bucket_number) {
+  const long long size = static_cast<long long>(buckets_.size());
+  return buckets_[((bucket_number % size) + size) % size];
+}
+
+const WindowedItemCounter::Bucket& WindowedItemCounter::BucketAt(
+    long long bucket_number) const {
+  const long long size = static_cast<long long>(buckets_.size());
+  return buckets_[((bucket_number % size) + size) % size];
+}
+
+}  // namespace item_tracker
@@ -0,0 +1,131 @@
+#ifndef WINDOWED_ITEM_COUNTER_H
+#define WINDOWED_ITEM_COUNTER_H
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "string_pool.h"
+
+namespace item_tracker {
+
+// Change of an item's count between two consecutive windows
+struct ItemTrend {
+  std::string item;
+  int current_count;
+  int previous_count;
+  int delta;
+};
+
+// Counts timestamped items over a sliding time range. Time is split into
+// fixed-size buckets kept in a ring; a bucket is recycled, and its counts
+// subtracted from the running totals, once it falls out of the range, so
+// every expired count costs O(1) and nothing is reallocated once the ring
+// has warmed up. Items that leave every bucket are evicted in batches, so
+// memory follows the items in range rather than every item ever seen.
+//
+// Input lines are "<unix seconds> <item>", e.g. "1700000000 apple".
+class WindowedItemCounter {
+ public:
+  // Keep bucket_count buckets of bucket_seconds each, e.g. 60 and 1440 for
+  // the last day by minute
+  WindowedItemCounter(int bucket_seconds, int bucket_count);
+
+  // Count the item at the timestamp. Returns false, counting nothing, if the
+  // timestamp is older than the retained range.
+  bool Add(std::string_view item, long long timestamp, int count = 1);
+
+  // Count every line of the stream
+  bool ImportFromStream(std::istream& input_stream);
+
+  // Count the lines appended to the file since the previous call. A partial
+  // last line is left for the next call. Returns false if the file cannot be
+  // read.
+  bool LoadNewLinesFromFile(const std::string& file_name);
+
+  // Count of the item over the whole retained range
+  int GetCount(std::string_view item) const;
+
+  // Count of the item over the last window_seconds, rounded up to buckets
+  int GetCount(std::string_view item, long long window_seconds) const;
+
+  // Most frequent items over the last window_seconds
+  std::vector<std::pair<std::string, int>> GetTopItems(
+      long long window_seconds, size_t limit) const;
+
+  // Items whose count grew the most from the window before the last
+  // window_seconds to the last window_seconds
+  std::vector<ItemTrend> GetTrendingItems(long long window_seconds,
+                                          size_t limit) const;
+
+  // Start of the newest bucket, in unix seconds
+  long long GetLatestBucketStart() const;
+
+  // Lines that were malformed or too old to count
+  long long GetRejectedLines() const;
+
+  // Items with a count in the retained range
+  size_t GetLiveItems() const;
+
+  // Items whose names are kept, including expired ones not yet evicted
+  size_t GetTrackedItems() const;
+
+ private:
+  // Counts of one bucket as an append-only list of (item id, count). The
+  // newest bucket merges repeated items; late events may add duplicates,
+  // which sums treat the same.
+  struct Bucket {
+    std::vector<std::pair<uint32_t, int>> counts;
+  };
+
+  // Id of the item, assigned on first sight
+  uint32_t Intern(std::string_view item);
+
+  // Add to the item's total, keeping the live item count
+  void AddToTotal(uint32_t id, int count);
+
+  // Move the newest bucket forward, expiring every bucket left behind
+  void AdvanceTo(long long bucket_number);
+
+  // Drop the name and counts of every item in no bucket, renumbering the
+  // rest in first-seen order
+  void EvictExpiredItems();
+
+  // Add the counts of buckets first..last, inclusive, into sums by item id
+  void SumBuckets(long long first, long long last,
+                  std::vector<int>& sums) const;
+
+  // Number of buckets covering window_seconds, within the retained range
+  long long BucketsInWindow(long long window_seconds) const;
+
+  // Parse and count one line, updating the rejected line count
+  void AddLine(std::string_view line);
+
+  Bucket& BucketAt(long long bucket_number);
+  const Bucket& BucketAt(long long bucket_number) const;
+
+  const int bucket_seconds_;
+  std::vector<Bucket> buckets_;
+  // Bucket number (timestamp / bucket_seconds_) of the newest bucket
+  long long latest_bucket_ = 0;
+  bool is_empty_ = true;
+
+  mini_utils::StringPool item_names_;
+  // Per item: count over the retained range, and where the item sits in the
+  // newest bucket so repeats update in place
+  std::vector<int> totals_;
+  std::vector<uint32_t> latest_positions_;
+  std::vector<long long> latest_position_buckets_;
+  // Items with a non-zero total
+  size_t live_items_ = 0;
+
+  // Bytes of the followed file consumed so far
+  std::streamoff file_offset_ = 0;
+  std::string read_buffer_;
+  long long rejected_lines_ = 0;
+};
+
+}  // namespace item_tracker
+#endif  // WINDOWED_ITEM_COUNTER_H
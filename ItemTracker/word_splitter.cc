@@ -0,0 +1,142 @@
+#include "word_splitter.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ITEM_TRACKER_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace item_tracker {
+namespace {
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ULL;
+
+bool IsWordByte(char byte) {
+  const unsigned char value = static_cast<unsigned char>(byte);
+  return value >= 0x80 || (value >= '0' && value <= '9') ||
+         ((value | 0x20) >= 'a' && (value | 0x20) <= 'z') || value == '\'';
+}
+
+void AddWord(const char* begin, const char* end,
+             std::pmr::vector<Word>& words) {
+  const std::string_view text(begin, end - begin);
+  words.push_back({text, HashWord(text)});
+}
+
+#ifdef ITEM_TRACKER_HAS_SSE2
+constexpr size_t kBlockSize = 16;
+
+int CountTrailingZeros(uint32_t value) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+  _BitScanForward(&index, value);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(value);
+#endif
+}
+
+// Lanes of `bytes` in [first, first + count), as an unsigned comparison:
+// x - first <= count - 1 exactly when the minimum of the two is x - first
+__m128i InRange(__m128i bytes, char first, char count) {
+  const __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8(first));
+  return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(count - 1)),
+                        offset);
+}
+
+// Bit i is set when data[i] is a word byte, see IsWordByte
+uint32_t WordMask(const char* data) {
+  const __m128i bytes =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const __m128i letters =
+      InRange(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), 'a', 26);
+  const __m128i digits = InRange(bytes, '0', 10);
+  const __m128i apostrophes = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\''));
+  const __m128i ascii_word =
+      _mm_or_si128(_mm_or_si128(letters, digits), apostrophes);
+  // The sign bit of every byte marks non-ASCII bytes directly
+  return static_cast<uint32_t>(_mm_movemask_epi8(ascii_word) |
+                               _mm_movemask_epi8(bytes));
+}
+#endif
+}  // namespace
+
+void SplitWords(std::string_view text, std::pmr::vector<Word>& words) {
+  const char* const data = text.data();
+  size_t position = 0;
+  bool in_word = false;
+  const char* word_start = data;
+
+#ifdef ITEM_TRACKER_HAS_SSE2
+  // Only the bytes where a word starts or ends are visited one by one
+  for (; position + kBlockSize <= text.size(); position += kBlockSize) {
+    const uint32_t mask = WordMask(data + position);
+    uint32_t changes = (mask ^ (mask << 1 | (in_word ? 1 : 0))) & 0xFFFF;
+    while (changes != 0) {
+      const char* const boundary =
+          data + position + CountTrailingZeros(changes);
+      changes &= changes - 1;
+      if (in_word) {
+        AddWord(word_start, boundary, words);
+      } else {
+        word_start = boundary;
+      }
+      in_word = !in_word;
+    }
+  }
+#endif
+
+  for (; position < text.size(); ++position) {
+    if (IsWordByte(data[position]) == in_word) {
+      continue;
+    }
+    if (in_word) {
+      AddWord(word_start, data + position, words);
+    } else {
+      word_start = data + position;
+    }
+    in_word = !in_word;
+  }
+  if (in_word) {
+    AddWord(word_start, data + text.size(), words);
+  }
+}
+
+uint64_t HashWord(std::string_view word) {
+  uint64_t hash = word.size() * kHashMultiplier;
+  size_t position = 0;
+  for (; position + 8 <= word.size(); position += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, word.data() + position, 8);
+    hash = (hash ^ chunk) * kHashMultiplier;
+    hash ^= hash >> 32;
+  }
+  // The last 1 to 7 bytes are read as two overlapping fixed-size loads, or
+  // as three single bytes, which avoids a variable-length copy. The length
+  // is already part of the hash, so overlaps cannot make words collide.
+  const size_t rest = word.size() - position;
+  const char* const tail = word.data() + position;
+  uint64_t chunk = 0;
+  if (rest >= 4) {
+    uint32_t head_bytes;
+    uint32_t tail_bytes;
+    std::memcpy(&head_bytes, tail, 4);
+    std::memcpy(&tail_bytes, tail + rest - 4, 4);
+    chunk = static_cast<uint64_t>(head_bytes) << 32 | tail_bytes;
+  } else if (rest > 0) {
+    chunk = static_cast<uint64_t>(static_cast<unsigned char>(tail[0])) << 16 |
+            static_cast<uint64_t>(static_cast<unsigned char>(tail[rest / 2]))
+                << 8 |
+            static_cast<unsigned char>(tail[rest - 1]);
+  } else {
+    return hash;
+  }
+  hash = (hash ^ chunk) * kHashMultiplier;
+  return hash ^ (hash >> 32);
+}
+
+}  // namespace item_tracker
@@ -0,0 +1,26 @@
+#ifndef WORD_SPLITTER_H
+#define WORD_SPLITTER_H
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace item_tracker {
+
+// A word of a text and its hash
+struct Word {
+  std::string_view text;
+  uint64_t hash;
+};
+
+// Append the words of the text to `words`. A word is a maximal run of ASCII
+// letters, digits, apostrophes and non-ASCII bytes, so UTF-8 letters stay
+// inside words; everything else separates them. Where SSE2 is available the
+// text is classified 16 bytes at a time.
+void SplitWords(std::string_view text, std::pmr::vector<Word>& words);
+
+// Hash of a word, reading it 8 bytes at a time
+uint64_t HashWord(std::string_view word);
+
+}  // namespace item_tracker
+#endif  // WORD_SPLITTER_H
@@ -0,0 +1,132 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "co_occurrence_counter.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+// Id of an item that must have been counted
+uint32_t GetId(const item_tracker::CoOccurrenceCounter& counter,
+               const std::string& item) {
+  uint32_t id = 0;
+  EXPECT_TRUE(counter.FindItem(item, id)) << item;
+  return id;
+}
+}  // namespace
+
+// Tests that pairs are counted once per session, in either order
+TEST(CoOccurrenceCounterTest, ImportSessions_CountsPairsPerSession) {
+  std::istringstream test_stream(
+      "bread\nmilk\neggs\nmilk\n"
+      "\n"
+      "  milk  \nbread\n"
+      "   \n"
+      "\n"
+      "eggs\n");
+  item_tracker::CoOccurrenceCounter counter(1);
+  ASSERT_TRUE(counter.ImportSessionsFromStream(test_stream));
+
+  const uint32_t bread = GetId(counter, "bread");
+  const uint32_t milk = GetId(counter, "milk");
+  const uint32_t eggs = GetId(counter, "eggs");
+  EXPECT_EQ(counter.GetItemCount(), 3u);
+  EXPECT_EQ(counter.GetPairCount(), 3u);
+  EXPECT_EQ(counter.GetItemFrequency(milk), 2);
+  EXPECT_EQ(counter.GetItemFrequency(eggs), 2);
+  EXPECT_EQ(counter.GetPairFrequency(bread, milk), 2);
+  EXPECT_EQ(counter.GetPairFrequency(milk, bread), 2);
+  EXPECT_EQ(counter.GetPairFrequency(milk, eggs), 1);
+  EXPECT_EQ(counter.GetPairFrequency(milk, milk), 0);
+}
+
+// Tests that partners come most frequent first, ties by id, up to the limit
+TEST(CoOccurrenceCounterTest, GetTopPartners_SortsByFrequency) {
+  std::istringstream test_stream(
+      "a\nb\nc\n\na\nc\n\na\nd\n\na\nc\nd\n\ne\n");
+  item_tracker::CoOccurrenceCounter counter;
+  counter.ImportSessionsFromStream(test_stream);
+
+  const std::vector<item_tracker::Partner> partners =
+      counter.GetTopPartners(GetId(counter, "a"), 2);
+  ASSERT_EQ(partners.size(), 2u);
+  EXPECT_EQ(counter.GetItemName(partners[0].id), "c");
+  EXPECT_EQ(partners[0].frequency, 3);
+  EXPECT_EQ(counter.GetItemName(partners[1].id), "d");
+  EXPECT_EQ(partners[1].frequency, 2);
+  EXPECT_EQ(counter.GetTopPartners(GetId(counter, "a"), 10).size(), 3u);
+  EXPECT_TRUE(counter.GetTopPartners(GetId(counter, "e"), 10).empty());
+}
+
+// Tests that composite keys keep the order of their fields
+TEST(CoOccurrenceCounterTest, ImportFieldPairs_CountsOrderedKeys) {
+  std::istringstream test_stream(
+      "ann, mon, tea\n"
+      "ann, tue, tea\n"
+      "ann, wed, coffee\n"
+      "tea, thu, ann\n"
+      "bob, fri\n"
+      ", sat, tea\n");
+  item_tracker::CoOccurrenceCounter counter(2);
+  ASSERT_TRUE(counter.ImportFieldPairsFromStream(test_stream, ',', 0, 2));
+
+  const uint32_t ann = GetId(counter, "ann");
+  const uint32_t tea = GetId(counter, "tea");
+  uint32_t id = 0;
+  EXPECT_FALSE(counter.FindItem("bob", id));
+  EXPECT_EQ(counter.GetPairCount(), 3u);
+  EXPECT_EQ(counter.GetPairFrequency(ann, tea), 2);
+  EXPECT_EQ(counter.GetPairFrequency(tea, ann), 1);
+
+  const std::vector<item_tracker::Partner> partners =
+      counter.GetTopPartners(ann, 5);
+  ASSERT_EQ(partners.size(), 2u);
+  EXPECT_EQ(partners[0].id, tea);
+  EXPECT_EQ(counter.GetItemName(partners[1].id), "coffee");
+}
+
+// Tests that counting on several threads matches a plain map of pairs
+TEST(CoOccurrenceCounterTest, ImportSessions_ThreadsMatchReference) {
+  std::mt19937 random(11);
+  std::uniform_int_distribution<int> item(0, 199);
+  std::uniform_int_distribution<int> session_size(1, 8);
+  std::vector<std::vector<int>> sessions(5000);
+  std::string text;
+  for (std::vector<int>& session : sessions) {
+    for (int i = session_size(random); i > 0; --i) {
+      session.push_back(item(random));
+      text += "item" + std::to_string(session.back()) + "\n";
+    }
+    text += "\n";
+  }
+
+  item_tracker::CoOccurrenceCounter counter(4);
+  std::istringstream test_stream(text);
+  counter.ImportSessionsFromStream(test_stream);
+
+  std::map<std::pair<int, int>, int> expected;
+  for (std::vector<int>& session : sessions) {
+    std::sort(session.begin(), session.end());
+    session.erase(std::unique(session.begin(), session.end()), session.end());
+    for (size_t first = 0; first < session.size(); ++first) {
+      for (size_t second = first + 1; second < session.size(); ++second) {
+        ++expected[{session[first], session[second]}];
+      }
+    }
+  }
+  ASSERT_EQ(counter.GetPairCount(), expected.size());
+  for (const auto& [pair, frequency] : expected) {
+    EXPECT_EQ(counter.GetPairFrequency(
+                  GetId(counter, "item" + std::to_string(pair.first)),
+                  GetId(counter, "item" + std::to_string(pair.second))),
+              frequency);
+  }
+}
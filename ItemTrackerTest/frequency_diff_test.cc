@@ -0,0 +1,106 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "frequency_diff.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "item_tracker.h"
+
+namespace {
+class FrequencyDiffTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::istringstream yesterday(
+        "apples\npears\napples\nplums\nplums\nplums\nkiwis\n");
+    std::istringstream today(
+        "apples\nplums\napples\nlimes\nlimes\napples\nkiwis\n");
+    before_.ImportFromStream(yesterday);
+    after_.ImportFromStream(today);
+  }
+
+  // The deltas as "item before after" strings, in order
+  static std::vector<std::string> Describe(
+      const item_tracker::FrequencyDiff& diff) {
+    std::vector<std::string> described;
+    for (const item_tracker::ItemDelta& delta : diff.GetDeltas()) {
+      described.push_back(std::string(delta.item) + " " +
+                          std::to_string(delta.before) + " " +
+                          std::to_string(delta.after));
+    }
+    return described;
+  }
+
+  const std::vector<std::string> kExpected = {"limes 0 2", "plums 3 1",
+                                              "apples 2 3", "pears 1 0"};
+  item_tracker::ItemTracker before_;
+  item_tracker::ItemTracker after_;
+};
+}  // namespace
+
+// Tests the hash join of two trackers
+TEST_F(FrequencyDiffTest, Compare_Trackers) {
+  item_tracker::FrequencyDiff diff;
+  diff.Compare(before_, after_);
+
+  EXPECT_EQ(Describe(diff), kExpected);
+  EXPECT_EQ(diff.GetNewCount(), 1u);
+  EXPECT_EQ(diff.GetVanishedCount(), 1u);
+  EXPECT_DOUBLE_EQ(diff.GetDeltas()[2].GetRatio(), 1.5);
+  EXPECT_TRUE(std::isinf(diff.GetDeltas()[0].GetRatio()));
+}
+
+// Tests the hash join of an exported snapshot against a tracker
+TEST_F(FrequencyDiffTest, Compare_SnapshotWithTracker) {
+  std::stringstream snapshot;
+  before_.ExportToStream(snapshot);
+  item_tracker::FrequencyDiff diff;
+  ASSERT_TRUE(diff.Compare(snapshot, after_));
+  EXPECT_EQ(Describe(diff), kExpected);
+
+  std::istringstream repeated("pears 1\npears 2\n");
+  EXPECT_FALSE(diff.Compare(repeated, after_));
+  std::istringstream malformed("pears\n");
+  EXPECT_FALSE(diff.Compare(malformed, after_));
+}
+
+// Tests the merge join of sorted snapshots and its order check
+TEST_F(FrequencyDiffTest, CompareSorted_Snapshots) {
+  std::stringstream before_snapshot;
+  std::stringstream after_snapshot;
+  before_.ExportToStream(before_snapshot, true);
+  after_.ExportToStream(after_snapshot, true);
+  item_tracker::FrequencyDiff diff;
+  ASSERT_TRUE(diff.CompareSorted(before_snapshot, after_snapshot));
+  EXPECT_EQ(Describe(diff), kExpected);
+  EXPECT_EQ(diff.GetNewCount(), 1u);
+
+  std::stringstream unsorted;
+  before_.ExportToStream(unsorted);
+  after_snapshot.clear();
+  after_snapshot.seekg(0);
+  EXPECT_FALSE(diff.CompareSorted(unsorted, after_snapshot));
+}
+
+// Tests that an exported snapshot imports back into the same table
+TEST_F(FrequencyDiffTest, ImportSnapshotFromStream_RoundTrip) {
+  std::stringstream snapshot;
+  after_.ExportToStream(snapshot);
+  item_tracker::ItemTracker restored;
+  ASSERT_TRUE(restored.ImportSnapshotFromStream(snapshot));
+
+  item_tracker::FrequencyDiff diff;
+  diff.Compare(after_, restored);
+  EXPECT_TRUE(diff.GetDeltas().empty());
+
+  std::istringstream with_spaces("red apple 2\r\n");
+  ASSERT_TRUE(restored.ImportSnapshotFromStream(with_spaces));
+  EXPECT_EQ(restored.GetWordFrequency("red apple"), 2);
+  std::istringstream negative("apples -1\n");
+  EXPECT_FALSE(restored.ImportSnapshotFromStream(negative));
+}
@@ -0,0 +1,86 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "frozen_item_table.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "item_tracker.h"
+
+namespace {
+// Items sharing long prefixes, with frequencies up to 5000
+std::string MakeItems() {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> suffix(0, 999);
+  std::uniform_int_distribution<int> copies(1, 3);
+  std::string lines;
+  for (int i = 0; i < 2000; ++i) {
+    const std::string item = "red apple " + std::to_string(suffix(random));
+    for (int j = copies(random); j > 0; --j) {
+      lines += item + "\n";
+    }
+  }
+  // Longer than a one-byte length
+  lines += std::string(300, 'x') + "\n";
+  for (int i = 0; i < 5000; ++i) {
+    lines += "pear\n";
+  }
+  return lines;
+}
+}  // namespace
+
+// Tests that every item is found with its frequency
+TEST(FrozenItemTableTest, GetFrequency_FindsEveryItem) {
+  std::istringstream test_stream(MakeItems());
+  item_tracker::ItemTracker tracker;
+  tracker.ImportFromStream(test_stream);
+  const item_tracker::FrozenItemTable table(tracker);
+
+  ASSERT_EQ(table.GetItemCount(), tracker.GetItemCount());
+  tracker.ForEachItem([&table](std::string_view item, int frequency) {
+    EXPECT_EQ(table.GetFrequency(item), frequency) << item;
+  });
+  EXPECT_EQ(table.GetFrequency("pear"), 5000);
+}
+
+// Tests that items around and between the stored ones are not found
+TEST(FrozenItemTableTest, GetFrequency_MissingItems) {
+  std::istringstream test_stream("banana\nbandana\nband\nbananas\nbanana\n");
+  item_tracker::ItemTracker tracker;
+  tracker.ImportFromStream(test_stream);
+  const item_tracker::FrozenItemTable table(tracker);
+
+  EXPECT_EQ(table.GetFrequency("banana"), 2);
+  EXPECT_EQ(table.GetFrequency("band"), 1);
+  for (const char* missing :
+       {"", "a", "ban", "banan", "bananaz", "bananas!", "bandanas", "zebra"}) {
+    EXPECT_EQ(table.GetFrequency(missing), 0) << missing;
+  }
+
+  const item_tracker::FrozenItemTable empty_table(item_tracker::ItemTracker{});
+  EXPECT_EQ(empty_table.GetItemCount(), 0u);
+  EXPECT_EQ(empty_table.GetFrequency("banana"), 0);
+}
+
+// Tests that items are visited in order with their frequencies
+TEST(FrozenItemTableTest, ForEachItem_SortedOrder) {
+  std::istringstream test_stream(
+      "pear\napple\napples\npear\n\xC3\xA9"
+      "clair\n");
+  item_tracker::ItemTracker tracker;
+  tracker.ImportFromStream(test_stream);
+  const item_tracker::FrozenItemTable table(tracker);
+
+  std::vector<std::string> visited;
+  table.ForEachItem([&visited](std::string_view item, int frequency) {
+    visited.push_back(std::string(item) + " " + std::to_string(frequency));
+  });
+  EXPECT_EQ(visited, (std::vector<std::string>{"apple 1", "apples 1", "pear 2",
+                                               "\xC3\xA9" "clair 1"}));
+  EXPECT_EQ(table.GetFrequency("\xC3\xA9" "clair"), 1);
+}
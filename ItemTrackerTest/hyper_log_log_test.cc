@@ -0,0 +1,108 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "hyper_log_log.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+namespace {
+const int kSmallCount = 1000;
+const int kLargeCount = 1000000;
+
+void AddItems(item_tracker::HyperLogLog& sketch, int first, int last) {
+  for (int i = first; i < last; ++i) {
+    sketch.Add("item" + std::to_string(i));
+  }
+}
+}  // namespace
+
+// Tests that small counts are exact while the sketch is sparse
+TEST(HyperLogLogTest, Estimate_SmallCountsSparse) {
+  item_tracker::HyperLogLog sketch;
+  EXPECT_EQ(sketch.Estimate(), 0u);
+
+  AddItems(sketch, 0, kSmallCount);
+  AddItems(sketch, 0, kSmallCount);
+  EXPECT_TRUE(sketch.IsSparse());
+  EXPECT_NEAR(static_cast<double>(sketch.Estimate()), kSmallCount, 1);
+}
+
+// Tests the error of a large count, well past the sparse range
+TEST(HyperLogLogTest, Estimate_LargeCountsDense) {
+  item_tracker::HyperLogLog sketch;
+  AddItems(sketch, 0, kLargeCount);
+
+  EXPECT_FALSE(sketch.IsSparse());
+  // About four standard errors of 0.8%
+  EXPECT_NEAR(static_cast<double>(sketch.Estimate()), kLargeCount,
+              kLargeCount * 0.03);
+}
+
+// Tests that merged shards estimate like one sketch of their union
+TEST(HyperLogLogTest, Merge_EqualsUnion) {
+  for (const int count : {kSmallCount, kLargeCount / 10}) {
+    item_tracker::HyperLogLog first;
+    item_tracker::HyperLogLog second;
+    item_tracker::HyperLogLog sparse;
+    item_tracker::HyperLogLog whole;
+    AddItems(first, 0, count);
+    AddItems(second, count / 2, count * 3 / 2);
+    AddItems(sparse, 0, 10);
+    AddItems(whole, 0, count * 3 / 2);
+
+    ASSERT_TRUE(first.Merge(second));
+    ASSERT_TRUE(first.Merge(sparse));
+    ASSERT_TRUE(first.Merge(first));
+    EXPECT_EQ(first.Estimate(), whole.Estimate());
+    EXPECT_EQ(first.IsSparse(), whole.IsSparse());
+  }
+
+  item_tracker::HyperLogLog coarse(10);
+  item_tracker::HyperLogLog fine;
+  EXPECT_FALSE(fine.Merge(coarse));
+}
+
+// Tests that sparse and dense sketches survive serialization
+TEST(HyperLogLogTest, Serialize_RoundTrip) {
+  for (const int count : {0, kSmallCount, kLargeCount / 10}) {
+    item_tracker::HyperLogLog sketch(12);
+    AddItems(sketch, 0, count);
+    const std::string data = sketch.Serialize();
+
+    item_tracker::HyperLogLog restored;
+    ASSERT_TRUE(restored.Deserialize(data));
+    EXPECT_EQ(restored.GetPrecision(), 12);
+    EXPECT_EQ(restored.IsSparse(), sketch.IsSparse());
+    EXPECT_EQ(restored.Estimate(), sketch.Estimate());
+    EXPECT_EQ(restored.Serialize(), data);
+  }
+}
+
+// Tests that malformed data is rejected without touching the sketch
+TEST(HyperLogLogTest, Deserialize_RejectsMalformed) {
+  item_tracker::HyperLogLog sketch;
+  AddItems(sketch, 0, kSmallCount);
+  const std::string data = sketch.Serialize();
+
+  EXPECT_FALSE(sketch.Deserialize(""));
+  EXPECT_FALSE(sketch.Deserialize("not a sketch"));
+  EXPECT_FALSE(sketch.Deserialize(data.substr(0, data.size() - 1)));
+  EXPECT_FALSE(sketch.Deserialize(data + "x"));
+  std::string bad_precision = data;
+  bad_precision[4] = 30;
+  EXPECT_FALSE(sketch.Deserialize(bad_precision));
+  EXPECT_NEAR(static_cast<double>(sketch.Estimate()), kSmallCount, 1);
+}
+
+// Tests that lines are counted the way ItemTracker counts them
+TEST(HyperLogLogTest, AddLinesFromStream_TrimsLines) {
+  item_tracker::HyperLogLog sketch;
+  std::istringstream test_stream("apple\n apple \r\n\n  \nbanana");
+  EXPECT_TRUE(sketch.AddLinesFromStream(test_stream));
+  EXPECT_EQ(sketch.Estimate(), 2u);
+
+  EXPECT_FALSE(sketch.AddLinesFromFile("no_such_file.txt"));
+}
@@ -0,0 +1,168 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "item_query_server.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "item_tracker.h"
+#include "query_protocol.h"
+
+namespace {
+class ItemQueryServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::istringstream test_stream(
+        "potatoes\nonions\npotatoes\ntomatoes\npotatoes\nonions\n");
+    tracker_.ImportFromStream(test_stream);
+    server_ = std::make_unique<item_tracker::ItemQueryServer>(tracker_, 2);
+  }
+
+  // Answer the request frames through HandleRequest()
+  item_tracker::QueryResponse Answer(const std::string& request) {
+    std::string response;
+    server_->HandleRequest(request, response);
+    item_tracker::QueryResponse decoded;
+    EXPECT_TRUE(item_tracker::DecodeQueryResponse(response, decoded));
+    return decoded;
+  }
+
+  item_tracker::ItemTracker tracker_;
+  std::unique_ptr<item_tracker::ItemQueryServer> server_;
+};
+}  // namespace
+
+// Tests that frequency, top-K and batch requests are answered
+TEST_F(ItemQueryServerTest, HandleRequest_AnswersQueries) {
+  std::string request;
+  item_tracker::AppendFrequencyRequest(request, 7, "potatoes");
+  item_tracker::QueryResponse response = Answer(request);
+  EXPECT_EQ(response.request_id, 7u);
+  EXPECT_EQ(response.status, item_tracker::QueryStatus::kOk);
+  EXPECT_EQ(response.frequencies, std::vector<int>{3});
+
+  request.clear();
+  item_tracker::AppendTopKRequest(request, 8, 2);
+  response = Answer(request);
+  EXPECT_EQ(response.opcode, item_tracker::QueryOpcode::kTopK);
+  EXPECT_EQ(response.items, (std::vector<std::string>{"potatoes", "onions"}));
+  EXPECT_EQ(response.frequencies, (std::vector<int>{3, 2}));
+
+  request.clear();
+  item_tracker::AppendBatchFrequencyRequest(request, 9,
+                                            {"tomatoes", "apples", "onions"});
+  response = Answer(request);
+  EXPECT_EQ(response.request_id, 9u);
+  EXPECT_EQ(response.frequencies, (std::vector<int>{1, 0, 2}));
+}
+
+// Tests that malformed requests get an error instead of an answer
+TEST_F(ItemQueryServerTest, HandleRequest_RejectsMalformed) {
+  std::string request;
+  item_tracker::AppendFrequencyRequest(request, 1, "potatoes");
+  request[8] = 42;
+  EXPECT_EQ(Answer(request).status, item_tracker::QueryStatus::kBadRequest);
+
+  request.clear();
+  item_tracker::AppendBatchFrequencyRequest(request, 2, {"potatoes"});
+  request += "extra";
+  EXPECT_EQ(Answer(request).status, item_tracker::QueryStatus::kBadRequest);
+  EXPECT_EQ(Answer(request).request_id, 2u);
+
+  bool is_malformed = false;
+  EXPECT_EQ(item_tracker::GetQueryFrameSize(std::string(4, '\xFF'),
+                                            is_malformed),
+            0u);
+  EXPECT_TRUE(is_malformed);
+}
+
+#ifdef __linux__
+// Tests pipelined requests of several clients over the socket
+TEST_F(ItemQueryServerTest, Run_ServesPipelinedClients) {
+  const std::string socket_path =
+      ::testing::TempDir() + "item_query_server_test.sock";
+  ASSERT_TRUE(server_->Listen(socket_path));
+  std::thread loop([this] { server_->Run(); });
+
+  const int kRequests = 1000;
+  std::vector<std::thread> clients;
+  std::vector<int> answered(4, 0);
+  for (int& client_answered : answered) {
+    clients.emplace_back([&socket_path, &client_answered] {
+      item_tracker::ItemQueryClient client;
+      if (!client.Connect(socket_path)) return;
+      std::string requests;
+      for (int i = 0; i < kRequests; ++i) {
+        item_tracker::AppendFrequencyRequest(
+            requests, i, i % 2 == 0 ? "potatoes" : "tomatoes");
+      }
+      if (!client.Send(requests)) return;
+      item_tracker::QueryResponse response;
+      for (int i = 0; i < kRequests && client.Receive(response); ++i) {
+        const int expected = response.request_id % 2 == 0 ? 3 : 1;
+        if (response.frequencies == std::vector<int>{expected}) {
+          ++client_answered;
+        }
+      }
+    });
+  }
+  for (std::thread& client : clients) {
+    client.join();
+  }
+  server_->Stop();
+  loop.join();
+
+  EXPECT_EQ(answered, std::vector<int>(4, kRequests));
+}
+
+// Tests that a client that stops sending still gets every pipelined answer
+// before the server closes, and that the server can run again after Stop()
+TEST_F(ItemQueryServerTest, Run_AnswersHalfClosedClient) {
+  const std::string socket_path =
+      ::testing::TempDir() + "item_query_server_half_close_test.sock";
+  ASSERT_TRUE(server_->Listen(socket_path));
+  // Stopping before running makes only that run return at once
+  server_->Stop();
+  server_->Run();
+
+  std::thread loop([this] { server_->Run(); });
+  // More than one read's worth of requests, then a partial frame
+  const int kRequests = 50000;
+  std::string requests;
+  for (int i = 0; i < kRequests; ++i) {
+    item_tracker::AppendFrequencyRequest(requests, i, "onions");
+  }
+  std::string partial;
+  item_tracker::AppendFrequencyRequest(partial, kRequests, "onions");
+  requests.append(partial, 0, partial.size() - 1);
+
+  item_tracker::ItemQueryClient client;
+  ASSERT_TRUE(client.Connect(socket_path));
+  std::thread sender([&client, &requests] {
+    if (client.Send(requests)) client.FinishSending();
+  });
+  // Jobs run on several readers, so answers may come out of order
+  std::vector<bool> is_answered(kRequests + 1, false);
+  int answered = 0;
+  item_tracker::QueryResponse response;
+  while (client.Receive(response)) {
+    if (response.request_id < is_answered.size() &&
+        !is_answered[response.request_id] &&
+        response.frequencies == std::vector<int>{2}) {
+      is_answered[response.request_id] = true;
+      ++answered;
+    }
+  }
+  sender.join();
+  server_->Stop();
+  loop.join();
+
+  EXPECT_EQ(answered, kRequests);
+}
+#endif
@@ -0,0 +1,144 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "item_search_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+const size_t kNoLimit = 1000000;
+
+// Plain Levenshtein distance over the full table
+int ReferenceDistance(const std::string& from, const std::string& to) {
+  std::vector<std::vector<int>> table(from.size() + 1,
+                                      std::vector<int>(to.size() + 1));
+  for (size_t i = 0; i <= from.size(); ++i) table[i][0] = i;
+  for (size_t j = 0; j <= to.size(); ++j) table[0][j] = j;
+  for (size_t i = 1; i <= from.size(); ++i) {
+    for (size_t j = 1; j <= to.size(); ++j) {
+      const int substitution = from[i - 1] != to[j - 1];
+      table[i][j] = std::min({table[i - 1][j] + 1, table[i][j - 1] + 1,
+                              table[i - 1][j - 1] + substitution});
+    }
+  }
+  return table[from.size()][to.size()];
+}
+
+std::vector<std::string> Items(
+    const std::vector<item_tracker::ItemMatch>& matches) {
+  std::vector<std::string> items;
+  for (const auto& match : matches) items.emplace_back(match.item);
+  return items;
+}
+
+std::vector<std::string> SortedItems(
+    const std::vector<item_tracker::ItemMatch>& matches) {
+  std::vector<std::string> items = Items(matches);
+  std::sort(items.begin(), items.end());
+  return items;
+}
+}  // namespace
+
+// Test suite for ItemSearchIndex class
+class ItemSearchIndexTest : public testing::Test {
+ protected:
+  item_tracker::ItemSearchIndex index_;
+
+  void SetUp() override {
+    index_.Build({{"tomatoes", 5},
+                  {"tomato", 2},
+                  {"tom yum", 7},
+                  {"potatoes", 3},
+                  {"onions", 1},
+                  {"green tomatoes", 4}});
+  }
+};
+
+// Tests prefix matches ranked by frequency
+TEST_F(ItemSearchIndexTest, FindByPrefix_RankedByFrequency) {
+  EXPECT_EQ(Items(index_.FindByPrefix("tom", kNoLimit)),
+            (std::vector<std::string>{"tom yum", "tomatoes", "tomato"}));
+  EXPECT_EQ(Items(index_.FindByPrefix("tom", 2)),
+            (std::vector<std::string>{"tom yum", "tomatoes"}));
+  EXPECT_TRUE(index_.FindByPrefix("tomatoes!", kNoLimit).empty());
+  EXPECT_EQ(index_.FindByPrefix("", kNoLimit).size(), 6u);
+}
+
+// Tests substring matches through the trigram index and the short fallback
+TEST_F(ItemSearchIndexTest, FindBySubstring_MatchesInsideItems) {
+  EXPECT_EQ(Items(index_.FindBySubstring("atoes", kNoLimit)),
+            (std::vector<std::string>{"tomatoes", "green tomatoes",
+                                      "potatoes"}));
+  EXPECT_EQ(Items(index_.FindBySubstring("on", kNoLimit)),
+            (std::vector<std::string>{"onions"}));
+  EXPECT_TRUE(index_.FindBySubstring("xyz", kNoLimit).empty());
+}
+
+// Tests typo-tolerant matches and frequencies of results
+TEST_F(ItemSearchIndexTest, FindSimilar_ToleratesTypos) {
+  const auto matches = index_.FindSimilar("tomatos", 1, kNoLimit);
+  EXPECT_EQ(Items(matches),
+            (std::vector<std::string>{"tomatoes", "tomato"}));
+  EXPECT_EQ(matches[0].frequency, 5);
+  EXPECT_TRUE(index_.FindSimilar("cucumber", 2, kNoLimit).empty());
+}
+
+// Tests queries against an empty index
+TEST(ItemSearchIndexEmptyTest, Queries_ReturnNothing) {
+  item_tracker::ItemSearchIndex index;
+  index.Build({});
+  EXPECT_TRUE(index.FindByPrefix("a", kNoLimit).empty());
+  EXPECT_TRUE(index.FindBySubstring("abc", kNoLimit).empty());
+  EXPECT_TRUE(index.FindSimilar("abc", 2, kNoLimit).empty());
+}
+
+// Tests every query kind against a scan over random items
+TEST(ItemSearchIndexRandomTest, Queries_MatchFullScan) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> length(0, 8);
+  std::uniform_int_distribution<int> letter('a', 'd');
+  const auto random_text = [&] {
+    std::string text(length(random), ' ');
+    for (char& c : text) c = static_cast<char>(letter(random));
+    return text;
+  };
+
+  std::unordered_map<std::string, int> items;
+  for (int i = 0; i < 2000; ++i) ++items[random_text()];
+  item_tracker::ItemSearchIndex index;
+  index.Build(items);
+
+  for (int query = 0; query < 200; ++query) {
+    const std::string text = random_text();
+    std::vector<std::string> prefixed;
+    std::vector<std::string> containing;
+    std::vector<std::string> similar;
+    for (const auto& item : items) {
+      if (item.first.compare(0, text.size(), text) == 0) {
+        prefixed.push_back(item.first);
+      }
+      if (item.first.find(text) != std::string::npos) {
+        containing.push_back(item.first);
+      }
+      if (ReferenceDistance(text, item.first) <= 2) {
+        similar.push_back(item.first);
+      }
+    }
+    std::sort(prefixed.begin(), prefixed.end());
+    std::sort(containing.begin(), containing.end());
+    std::sort(similar.begin(), similar.end());
+
+    ASSERT_EQ(SortedItems(index.FindByPrefix(text, kNoLimit)), prefixed)
+        << text;
+    ASSERT_EQ(SortedItems(index.FindBySubstring(text, kNoLimit)), containing)
+        << text;
+    ASSERT_EQ(SortedItems(index.FindSimilar(text, 2, kNoLimit)), similar)
+        << text;
+  }
+}
@@ -0,0 +1,112 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "item_tracker.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "mini_utils.h"
+
+namespace {
+const char* const kMenu =
+    "************************************************************************"
+    "********\n"
+    "****************************** Item Tracker Menu ***********************"
+    "********\n"
+    "* Options:                                                              "
+    "       *\n"
+    "* 1. Find item frequency                                                "
+    "       *\n"
+    "* 2. List items with frequencies                                        "
+    "       *\n"
+    "* 3. List item histogram with frequencies                               "
+    "       *\n"
+    "* 4. Exit                                                               "
+    "       *\n"
+    "************************************************************************"
+    "********\n";
+
+// Runs the CLI on a small item file with the scripted answers
+std::string RunSession(const std::string& answers, int width = 80) {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path();
+  const std::string input_file = (directory / "cli_items.txt").string();
+  const std::string output_file = (directory / "cli_frequency.dat").string();
+  std::ofstream(input_file) << "apple\npear\napple\n  apple \npear\nfig\n";
+
+  item_tracker::ItemTrackerCli cli(input_file, output_file, width);
+  std::istringstream input(answers);
+  std::ostringstream output;
+  cli.SetStreams(input, output);
+  cli.Start();
+
+  std::filesystem::remove(input_file);
+  std::filesystem::remove(output_file);
+  return output.str();
+}
+}  // namespace
+
+// Tests that the histogram session prints what the original CLI printed.
+// The original listed items in hash order, this one in first-seen order.
+TEST(ItemTrackerCliTest, Start_HistogramMatchesOriginalOutput) {
+  EXPECT_EQ(RunSession("3\n\n4\n\n"),
+            std::string(kMenu) + "State your choice: " +
+                "apple ###\n"
+                "pear ##\n"
+                "fig #\n"
+                "\n" +
+                kMenu + "State your choice: Goodbye!\n\n");
+}
+
+// Tests a lookup session, with the answer of the menu on its own line
+TEST(ItemTrackerCliTest, Start_FindsItemFrequency) {
+  EXPECT_EQ(RunSession("1\n\npear\n4\n\n"),
+            std::string(kMenu) +
+                "State your choice: Please, enter item to search for: "
+                "Item \"pear\" encountered 2 times.\n"
+                "\n" +
+                kMenu + "State your choice: Goodbye!\n\n");
+}
+
+// Tests that the session ends when the input does, instead of prompting on
+// forever
+TEST(ItemTrackerCliTest, Start_EndsAtEndOfInput) {
+  EXPECT_EQ(RunSession(""), std::string(kMenu) + "State your choice: \n");
+  EXPECT_EQ(RunSession("5\n"),
+            std::string(kMenu) +
+                "State your choice: Input is out of the accepted range or "
+                "format. Please enter a valid integer 1 through 4.\n"
+                "State your choice: \n");
+  // While asking for the item to look up
+  EXPECT_EQ(RunSession("1\n\n"),
+            std::string(kMenu) +
+                "State your choice: Please, enter item to search for: \n");
+}
+
+// Tests that a menu laid out at runtime for another width is drawn in full
+// each time, like the precomputed one
+TEST(ItemTrackerCliTest, Start_DrawsMenuForOtherWidths) {
+  const mini_utils::StringFormatter formatter(40);
+  std::string menu = formatter.horizontalSeparator('*') + "\n" +
+                     formatter.formatFullBorder("Item Tracker Menu", '*') +
+                     "\n" + formatter.formatSideBorder("Options:") + "\n";
+  for (const char* item :
+       {"1. Find item frequency", "2. List items with frequencies",
+        "3. List item histogram with frequencies", "4. Exit"}) {
+    menu += formatter.formatSideBorder(item) + "\n";
+  }
+  menu += formatter.horizontalSeparator('*') + "\n";
+
+  EXPECT_EQ(RunSession("2\n\n4\n\n", 40),
+            menu + "State your choice: " +
+                "apple 3\n"
+                "pear 2\n"
+                "fig 1\n"
+                "\n" +
+                menu + "State your choice: Goodbye!\n\n");
+}
@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory_resource>
 #include <sstream>
 
 
@@ -135,3 +136,89 @@ TEST_F(ItemTrackerTest, ExportToStream_SingleItem) {
   std::string expected_output = "apple 1\n";
   EXPECT_EQ(output_stream.str(), expected_output);
 }
+
+// Merge tests
+// Tests that merged frequencies add up and new items keep their order
+TEST_F(ItemTrackerTest, Merge_AddsFrequencies) {
+  std::istringstream test_stream("apple\nbanana\n");
+  PopulateTracker(test_stream);
+  item_tracker::ItemTracker other;
+  std::istringstream other_stream("cherry\napple\napple\n");
+  other.ImportFromStream(other_stream);
+
+  tracker_.Merge(other);
+
+  std::ostringstream output_stream;
+  EXPECT_TRUE(tracker_.ExportToStream(output_stream));
+  EXPECT_EQ(output_stream.str(), "apple 3\nbanana 1\ncherry 1\n");
+  EXPECT_EQ(tracker_.GetSearchIndex().Size(), 3u);
+}
+
+// Memory resource tests
+// Tests that a tracker on a fixed arena keeps everything in the arena
+TEST(ItemTrackerResourceTest, ImportFromStream_StaysInArena) {
+  // Running out of the buffer throws instead of falling back to the heap
+  static char buffer[1 << 20];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  item_tracker::ItemTracker tracker(&arena);
+
+  std::istringstream test_stream("apple\nbanana\n apple \ncherry\n");
+  ASSERT_NO_THROW(tracker.ImportFromStream(test_stream));
+  EXPECT_EQ(tracker.GetWordFrequency("apple"), 2);
+  EXPECT_EQ(tracker.GetSearchIndex().FindByPrefix("ch", 5).size(), 1u);
+}
+
+// Tests that counting words, with the read buffer and the words of each
+// line, also stays in the arena
+TEST(ItemTrackerResourceTest, ImportWordsFromStream_StaysInArena) {
+  static char buffer[4 << 20];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  item_tracker::ItemTracker tracker(&arena);
+
+  std::istringstream test_stream("red apple, green apple\nApple pie!");
+  ASSERT_NO_THROW(tracker.ImportWordsFromStream(test_stream, 2));
+  EXPECT_EQ(tracker.GetWordFrequency("apple"), 2);
+  EXPECT_EQ(tracker.GetWordFrequency("green apple"), 1);
+}
+
+// Word counting tests
+// Tests that words are counted across lines and separators
+TEST_F(ItemTrackerTest, ImportWordsFromStream_CountsWords) {
+  std::istringstream test_stream("red apple, green apple\nApple pie!");
+  EXPECT_TRUE(tracker_.ImportWordsFromStream(test_stream));
+
+  EXPECT_EQ(tracker_.GetWordFrequency("apple"), 2);
+  EXPECT_EQ(tracker_.GetWordFrequency("Apple"), 1);
+  EXPECT_EQ(tracker_.GetWordFrequency("pie"), 1);
+  EXPECT_EQ(tracker_.GetWordFrequency("red apple"), 0);
+  EXPECT_EQ(tracker_.GetItems().size(), 5u);
+}
+
+// Tests runs of words, which never span lines
+TEST_F(ItemTrackerTest, ImportWordsFromStream_CountsNGrams) {
+  std::istringstream test_stream(
+      "red  apple pie\nred apple.\napple pie\r\nred\napple pie");
+  EXPECT_TRUE(tracker_.ImportWordsFromStream(test_stream, 3));
+
+  EXPECT_EQ(tracker_.GetWordFrequency("red"), 3);
+  EXPECT_EQ(tracker_.GetWordFrequency("red apple"), 2);
+  EXPECT_EQ(tracker_.GetWordFrequency("apple pie"), 3);
+  EXPECT_EQ(tracker_.GetWordFrequency("red apple pie"), 1);
+  // "red" and "apple" are on different lines
+  EXPECT_EQ(tracker_.GetWordFrequency("pie red"), 0);
+  EXPECT_EQ(tracker_.GetSearchIndex().FindByPrefix("red apple", 5).size(),
+            2u);
+}
+
+// Tests that words and lines share their counts
+TEST_F(ItemTrackerTest, ImportWordsFromStream_SharesItemsWithLines) {
+  std::istringstream line_stream("red apple\n");
+  PopulateTracker(line_stream);
+  std::istringstream word_stream("red apple\nred apple\n");
+  EXPECT_TRUE(tracker_.ImportWordsFromStream(word_stream, 2));
+
+  EXPECT_EQ(tracker_.GetWordFrequency("red apple"), 3);
+  EXPECT_EQ(tracker_.GetWordFrequency("red"), 2);
+}
@@ -0,0 +1,172 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "windowed_item_counter.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+const int kBucketSeconds = 60;
+const int kBucketCount = 10;
+const long long kStart = 1700000000 / kBucketSeconds * kBucketSeconds;
+}  // namespace
+
+// Test suite for WindowedItemCounter class
+class WindowedItemCounterTest : public testing::Test {
+ protected:
+  item_tracker::WindowedItemCounter counter_{kBucketSeconds, kBucketCount};
+};
+
+// Tests counts over the whole range and over shorter windows
+TEST_F(WindowedItemCounterTest, GetCount_CountsPerWindow) {
+  counter_.Add("apple", kStart);
+  counter_.Add("apple", kStart + 1);
+  counter_.Add("apple", kStart + 5 * kBucketSeconds);
+  counter_.Add("pear", kStart + 5 * kBucketSeconds + 30);
+
+  EXPECT_EQ(counter_.GetCount("apple"), 3);
+  EXPECT_EQ(counter_.GetCount("apple", kBucketSeconds), 1);
+  EXPECT_EQ(counter_.GetCount("apple", 6 * kBucketSeconds), 3);
+  EXPECT_EQ(counter_.GetCount("pear", kBucketSeconds), 1);
+  EXPECT_EQ(counter_.GetCount("plum"), 0);
+}
+
+// Tests that buckets leaving the range stop counting
+TEST_F(WindowedItemCounterTest, Add_ExpiresOldBuckets) {
+  counter_.Add("apple", kStart);
+  counter_.Add("apple", kStart + kBucketSeconds);
+  counter_.Add("pear", kStart + kBucketCount * kBucketSeconds);
+
+  EXPECT_EQ(counter_.GetCount("apple"), 1);
+  EXPECT_EQ(counter_.GetCount("pear"), 1);
+
+  // A jump past the whole range expires everything
+  counter_.Add("plum", kStart + 100 * kBucketCount * kBucketSeconds);
+  EXPECT_EQ(counter_.GetCount("apple"), 0);
+  EXPECT_EQ(counter_.GetCount("pear"), 0);
+  EXPECT_EQ(counter_.GetCount("plum"), 1);
+}
+
+// Tests late events inside and outside of the range
+TEST_F(WindowedItemCounterTest, Add_LateEvents) {
+  counter_.Add("apple", kStart + 5 * kBucketSeconds);
+  EXPECT_TRUE(counter_.Add("apple", kStart));
+  EXPECT_FALSE(counter_.Add("apple", kStart - 5 * kBucketSeconds));
+
+  EXPECT_EQ(counter_.GetCount("apple"), 2);
+  EXPECT_EQ(counter_.GetCount("apple", kBucketSeconds), 1);
+}
+
+// Tests ranking over a window
+TEST_F(WindowedItemCounterTest, GetTopItems_RankedByCount) {
+  counter_.Add("apple", kStart, 5);
+  counter_.Add("pear", kStart + 9 * kBucketSeconds, 2);
+  counter_.Add("plum", kStart + 9 * kBucketSeconds, 3);
+
+  const auto all_time = counter_.GetTopItems(kBucketCount * kBucketSeconds, 2);
+  ASSERT_EQ(all_time.size(), 2u);
+  EXPECT_EQ(all_time[0].first, "apple");
+  EXPECT_EQ(all_time[1].first, "plum");
+
+  const auto last_minute = counter_.GetTopItems(kBucketSeconds, 10);
+  ASSERT_EQ(last_minute.size(), 2u);
+  EXPECT_EQ(last_minute[0], std::make_pair(std::string("plum"), 3));
+  EXPECT_EQ(last_minute[1], std::make_pair(std::string("pear"), 2));
+}
+
+// Tests trending items between the last two windows
+TEST_F(WindowedItemCounterTest, GetTrendingItems_BiggestGrowthFirst) {
+  counter_.Add("apple", kStart + 7 * kBucketSeconds, 10);
+  counter_.Add("apple", kStart + 9 * kBucketSeconds, 11);
+  counter_.Add("pear", kStart + 8 * kBucketSeconds, 1);
+  counter_.Add("pear", kStart + 9 * kBucketSeconds, 5);
+  counter_.Add("plum", kStart + 9 * kBucketSeconds, 2);
+
+  const auto trends = counter_.GetTrendingItems(kBucketSeconds, 10);
+  ASSERT_EQ(trends.size(), 3u);
+  EXPECT_EQ(trends[0].item, "apple");
+  EXPECT_EQ(trends[0].delta, 11);
+  EXPECT_EQ(trends[1].item, "pear");
+  EXPECT_EQ(trends[1].previous_count, 1);
+  EXPECT_EQ(trends[1].current_count, 5);
+  EXPECT_EQ(trends[2].item, "plum");
+
+  // Over two-minute windows apple barely grew
+  const auto slower = counter_.GetTrendingItems(2 * kBucketSeconds, 10);
+  ASSERT_EQ(slower.size(), 3u);
+  EXPECT_EQ(slower[0].item, "pear");
+  EXPECT_EQ(slower[2].item, "apple");
+  EXPECT_EQ(slower[2].delta, 1);
+}
+
+// Tests line parsing and rejection of malformed lines
+TEST_F(WindowedItemCounterTest, ImportFromStream_ParsesLines) {
+  std::istringstream test_stream(
+      std::to_string(kStart) + " red apple\n" + std::to_string(kStart) +
+      "\tred apple \r\n\n" + std::to_string(kStart) + "apple\nnow apple\n" +
+      std::to_string(kStart) + "\n");
+  EXPECT_TRUE(counter_.ImportFromStream(test_stream));
+
+  EXPECT_EQ(counter_.GetCount("red apple"), 2);
+  EXPECT_EQ(counter_.GetRejectedLines(), 3);
+}
+
+// Tests following a file as lines are appended to it
+TEST_F(WindowedItemCounterTest, LoadNewLinesFromFile_FollowsAppends) {
+  const std::string file_name = "windowed_item_counter_test.txt";
+  const std::string timestamp = std::to_string(kStart);
+  std::ofstream(file_name) << timestamp << " apple\n" << timestamp << " pe";
+  ASSERT_TRUE(counter_.LoadNewLinesFromFile(file_name));
+  EXPECT_EQ(counter_.GetCount("apple"), 1);
+  EXPECT_EQ(counter_.GetCount("pe"), 0);
+
+  std::ofstream(file_name, std::ios::app) << "ar\n" << timestamp << " apple\n";
+  ASSERT_TRUE(counter_.LoadNewLinesFromFile(file_name));
+  EXPECT_EQ(counter_.GetCount("apple"), 2);
+  EXPECT_EQ(counter_.GetCount("pear"), 1);
+
+  std::remove(file_name.c_str());
+  EXPECT_FALSE(counter_.LoadNewLinesFromFile(file_name));
+}
+
+// Tests that items leaving every bucket are evicted, and the rest keep their
+// counts
+TEST_F(WindowedItemCounterTest, Add_EvictsExpiredItems) {
+  counter_.Add("apple", kStart, 2);
+  // A new set of items every bucket, so most of them expire
+  for (int bucket = 0; bucket < 50; ++bucket) {
+    const long long timestamp = kStart + bucket * kBucketSeconds;
+    for (int item = 0; item < 100; ++item) {
+      counter_.Add(std::to_string(bucket) + "-" + std::to_string(item),
+                   timestamp);
+    }
+    counter_.Add("pear", timestamp);
+    EXPECT_LE(counter_.GetTrackedItems(), 2 * 1024u);
+  }
+
+  EXPECT_EQ(counter_.GetLiveItems(), kBucketCount * 100u + 1);
+  EXPECT_LT(counter_.GetTrackedItems(), 50 * 100u);
+  EXPECT_EQ(counter_.GetCount("apple"), 0);
+  EXPECT_EQ(counter_.GetCount("0-0"), 0);
+  EXPECT_EQ(counter_.GetCount("pear"), kBucketCount);
+  EXPECT_EQ(counter_.GetCount("pear", kBucketSeconds), 1);
+  EXPECT_EQ(counter_.GetCount("49-99"), 1);
+
+  // Repeats in the newest bucket still merge after the renumbering
+  counter_.Add("pear", kStart + 49 * kBucketSeconds, 4);
+  EXPECT_EQ(counter_.GetCount("pear", kBucketSeconds), 5);
+  const auto top = counter_.GetTopItems(kBucketCount * kBucketSeconds, 1);
+  ASSERT_EQ(top.size(), 1u);
+  EXPECT_EQ(top[0], std::make_pair(std::string("pear"), kBucketCount + 4));
+
+  // Once everything expires only the newest item is left
+  counter_.Add("plum", kStart + 1000 * kBucketSeconds);
+  EXPECT_EQ(counter_.GetLiveItems(), 1u);
+  EXPECT_EQ(counter_.GetTrackedItems(), 1u);
+  EXPECT_EQ(counter_.GetCount("plum"), 1);
+}
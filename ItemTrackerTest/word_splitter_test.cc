@@ -0,0 +1,81 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "word_splitter.h"
+
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+const int kFuzzIterations = 20000;
+const size_t kMaxFuzzLength = 80;
+
+std::vector<std::string> SplitText(std::string_view text) {
+  std::pmr::vector<item_tracker::Word> words;
+  item_tracker::SplitWords(text, words);
+  std::vector<std::string> texts;
+  for (const item_tracker::Word& word : words) {
+    texts.emplace_back(word.text);
+    EXPECT_EQ(word.hash, item_tracker::HashWord(word.text));
+  }
+  return texts;
+}
+
+// Byte at a time splitting by the documented rule
+std::vector<std::string> SplitByteByByte(std::string_view text) {
+  std::vector<std::string> words;
+  std::string word;
+  for (const char byte : text) {
+    const unsigned char value = static_cast<unsigned char>(byte);
+    if (value >= 0x80 || std::isalnum(value) || byte == '\'') {
+      word += byte;
+    } else if (!word.empty()) {
+      words.push_back(word);
+      word.clear();
+    }
+  }
+  if (!word.empty()) {
+    words.push_back(word);
+  }
+  return words;
+}
+}  // namespace
+
+// Tests separators, apostrophes and non-ASCII letters
+TEST(WordSplitterTest, SplitWords_Separators) {
+  const std::vector<std::string> expected = {"Don't", "stop", "caf\xC3\xA9",
+                                             "2", "go"};
+  EXPECT_EQ(SplitText("  Don't stop, caf\xC3\xA9\t2-go!\r"), expected);
+  EXPECT_TRUE(SplitText("").empty());
+  EXPECT_TRUE(SplitText(" .,;:!? [](){}@`~ ").empty());
+}
+
+// Tests words running across the 16 byte blocks and the tail
+TEST(WordSplitterTest, SplitWords_LongText) {
+  const std::string long_word(37, 'x');
+  const std::string text = "ab " + long_word + " cd efghijklmnopq z";
+  const std::vector<std::string> expected = {"ab", long_word, "cd",
+                                             "efghijklmnopq", "z"};
+  EXPECT_EQ(SplitText(text), expected);
+}
+
+// Fuzzes the splitter against byte at a time splitting
+TEST(WordSplitterTest, SplitWords_MatchesByteByByte) {
+  static const char kAlphabet[] = " \t\n.,'-azAZ09@[`{\x7F\x80\xC3\xFF";
+  std::mt19937 random(7);
+  std::uniform_int_distribution<size_t> length(0, kMaxFuzzLength);
+  std::uniform_int_distribution<size_t> character(0, sizeof(kAlphabet) - 2);
+  for (int i = 0; i < kFuzzIterations; ++i) {
+    std::string text(length(random), ' ');
+    for (char& c : text) {
+      c = kAlphabet[character(random)];
+    }
+    ASSERT_EQ(SplitText(text), SplitByteByByte(text)) << text;
+  }
+}
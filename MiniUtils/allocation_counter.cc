@@ -0,0 +1,65 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Replacements of the global allocation functions of the binary, counting
+// every heap allocation
+namespace {
+std::atomic<long long> g_allocationCount(0);
+}  // namespace
+
+void* operator new(std::size_t size) {
+  g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+// std::pmr::new_delete_resource allocates through the aligned forms
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t ALIGNMENT = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a non-zero multiple of the alignment
+  const std::size_t ROUNDED =
+      size == 0 ? ALIGNMENT : (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+#ifdef _WIN32
+  void* memory = _aligned_malloc(ROUNDED, ALIGNMENT);
+#else
+  void* memory = std::aligned_alloc(ALIGNMENT, ROUNDED);
+#endif
+  if (memory) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+#ifdef _WIN32
+  _aligned_free(memory);
+#else
+  std::free(memory);
+#endif
+}
+
+void operator delete(void* memory, std::size_t,
+                     std::align_val_t alignment) noexcept {
+  operator delete(memory, alignment);
+}
+
+namespace mini_utils {
+
+long long getAllocationCount() {
+  return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+}  // namespace mini_utils
@@ -0,0 +1,15 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+namespace mini_utils {
+
+// Number of global operator new calls made by the binary so far. Compare it
+// before and after a call to check how often the call allocated.
+//
+// allocation_counter.cc replaces the global allocation functions, so it is
+// not part of the MiniUtils library: the test and benchmark binaries that
+// count allocations compile it themselves.
+long long getAllocationCount();
+
+}  // namespace mini_utils
+#endif  // ALLOCATION_COUNTER_H
@@ -0,0 +1,37 @@
+#include "counting_resource.h"
+
+#include <algorithm>
+
+namespace mini_utils {
+
+CountingResource::CountingResource(std::pmr::memory_resource* upstream)
+    : m_upstream(upstream) {}
+
+void CountingResource::resetCounters() {
+  m_allocations = 0;
+  m_deallocations = 0;
+  m_peakBytes = m_bytesInUse;
+}
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+  // Counted only once the upstream succeeded, so a throw leaves no trace
+  void* pointer = m_upstream->allocate(bytes, alignment);
+  ++m_allocations;
+  m_bytesInUse += bytes;
+  m_peakBytes = std::max(m_peakBytes, m_bytesInUse);
+  return pointer;
+}
+
+void CountingResource::do_deallocate(void* pointer, size_t bytes,
+                                     size_t alignment) {
+  m_upstream->deallocate(pointer, bytes, alignment);
+  ++m_deallocations;
+  m_bytesInUse -= bytes;
+}
+
+bool CountingResource::do_is_equal(
+    const std::pmr::memory_resource& OTHER) const noexcept {
+  return this == &OTHER;
+}
+
+}  // namespace mini_utils
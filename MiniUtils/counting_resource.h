@@ -0,0 +1,51 @@
+#ifndef COUNTING_RESOURCE_H
+#define COUNTING_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace mini_utils {
+
+// Memory resource that forwards to an upstream resource and counts what goes
+// through it. Wrap the upstream of an arena to see how often the arena
+// grows, or hand it to a container directly to check that a hot path does
+// not allocate. Not thread-safe, like std::pmr::monotonic_buffer_resource.
+//
+// Example:
+//   CountingResource counter;
+//   std::pmr::monotonic_buffer_resource arena(&counter);
+//   ItemTracker tracker(&arena);
+//   ...
+//   std::cout << counter.getAllocationCount() << " arena blocks";
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  explicit CountingResource(
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+  long long getAllocationCount() const { return m_allocations; }
+  long long getDeallocationCount() const { return m_deallocations; }
+
+  // Bytes allocated and not yet deallocated
+  size_t getBytesInUse() const { return m_bytesInUse; }
+
+  // Highest getBytesInUse() since construction or the last reset
+  size_t getPeakBytes() const { return m_peakBytes; }
+
+  // Start counting from zero; bytes in use are kept
+  void resetCounters();
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& OTHER) const
+      noexcept override;
+
+  std::pmr::memory_resource* m_upstream;
+  long long m_allocations = 0;
+  long long m_deallocations = 0;
+  size_t m_bytesInUse = 0;
+  size_t m_peakBytes = 0;
+};
+
+}  // namespace mini_utils
+#endif  // COUNTING_RESOURCE_H
@@ -2,9 +2,12 @@
 #include "mini_utils.h"
 
 #include <algorithm>
-#include <iomanip>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
-#include <sstream>
+
+#include "screen.h"
 
 namespace mini_utils {
 using std::cin;
@@ -13,6 +16,101 @@ using std::endl;
 using std::max;
 using std::string;
 
+namespace {
+// Output targets shared by the string and stream table renderers
+class StringSink {
+ public:
+  explicit StringSink(string& buffer) : m_buffer(buffer) {}
+  void write(const char* data, size_t size) { m_buffer.append(data, size); }
+  void fill(char fillChar, size_t count) { m_buffer.append(count, fillChar); }
+
+ private:
+  string& m_buffer;
+};
+
+// Writes into the lines of a screen, starting a new line at every line break
+class ScreenSink {
+ public:
+  ScreenSink(Screen& screen, int row) : m_screen(screen), m_row(row) {
+    beginLine();
+  }
+
+  void write(const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      if (data[i] == '\n') {
+        ++m_row;
+        beginLine();
+      } else if (m_line != nullptr) {
+        *m_line += data[i];
+      }
+    }
+  }
+
+  void fill(char fillChar, size_t count) {
+    if (m_line != nullptr) {
+      m_line->append(count, fillChar);
+    }
+  }
+
+  // Row after the last complete line
+  int getRow() const { return m_row; }
+
+ private:
+  void beginLine() {
+    m_line = m_row < m_screen.getHeight() ? &m_screen.beginLine(m_row)
+                                          : nullptr;
+  }
+
+  Screen& m_screen;
+  int m_row;
+  // Line being written, nullptr below the screen
+  string* m_line = nullptr;
+};
+
+// Collects output in a stack buffer and hands it to the stream in large
+// blocks, instead of one stream call per cell and padding
+class StreamSink {
+ public:
+  explicit StreamSink(std::ostream& out) : m_out(out) {}
+  ~StreamSink() { flush(); }
+
+  void write(const char* data, size_t size) {
+    if (size > BUFFER_SIZE - m_used) {
+      flush();
+      if (size > BUFFER_SIZE) {
+        m_out.write(data, static_cast<std::streamsize>(size));
+        return;
+      }
+    }
+    std::memcpy(m_buffer + m_used, data, size);
+    m_used += size;
+  }
+
+  void fill(char fillChar, size_t count) {
+    while (count > 0) {
+      if (m_used == BUFFER_SIZE) {
+        flush();
+      }
+      const size_t SIZE = std::min(count, BUFFER_SIZE - m_used);
+      std::memset(m_buffer + m_used, fillChar, SIZE);
+      m_used += SIZE;
+      count -= SIZE;
+    }
+  }
+
+  void flush() {
+    m_out.write(m_buffer, static_cast<std::streamsize>(m_used));
+    m_used = 0;
+  }
+
+ private:
+  static const size_t BUFFER_SIZE = 4096;
+  std::ostream& m_out;
+  char m_buffer[BUFFER_SIZE];
+  size_t m_used = 0;
+};
+}  // namespace
+
 // Formatter
 // Public
 Formatter::Formatter(int width) : m_width(width) {}
@@ -25,107 +123,170 @@ string Formatter::truncateString(const string& STR, int width) const {
   return STR;
 }
 
+void Formatter::appendTruncated(string& out, std::string_view STR,
+                                int width) const {
+  if (static_cast<int>(STR.length()) > width) {
+    out.append(STR.substr(0, width - 3));
+    out += "...";
+    return;
+  }
+  out += STR;
+}
+
 void Formatter::setWidth(int newWidth) { m_width = newWidth; }
 
+int Formatter::getWidth() const { return m_width; }
+
 // StringFormatter
 // Private
 StringFormatter::StringMetrics StringFormatter::calculateStringMetrics(
-    const string& LABEL) const {
+    std::string_view LABEL) const {
   const int MIN_PADDING = 2;                       // Borders (e.g., "*TEXT*")
   const int USABLE_WIDTH = m_width - MIN_PADDING;  // Max text size
   const int LABEL_LENGTH = static_cast<int>(LABEL.length());
   return {USABLE_WIDTH, LABEL_LENGTH};
 }
 
-// Builds a formatted string with space padding between the borders and the
-// label.
-// NOTE: here and after 'LABEL' uses uppercase as per assignment-specific style
-// guidelines.
-string StringFormatter::buildFormattedString(const string& LABEL,
-                                             int leftPadding, int rightPadding,
-                                             char borderChar) const {
-  return string(1, borderChar) + string(leftPadding, ' ') + LABEL +
-         string(rightPadding, ' ') + string(1, borderChar);
-}
-
-// Builds a formatted string with border characters around the label,
-// and spaces between the label and the borders.
-string StringFormatter::buildFullBorderFormattedString(const string& LABEL,
-                                                       int leftPadding,
-                                                       int rightPadding,
-                                                       char borderChar) const {
-  return string(leftPadding, borderChar) + " " + LABEL + " " +
-         string(rightPadding, borderChar);
-}
-
-void clearInput() {
-  cin.clear();  // Reset the error flags on std::cin
-  cin.ignore(std::numeric_limits<std::streamsize>::max(),
-             '\n');  // Discard invalid input in the buffer
+void clearInput(std::istream& in) {
+  in.clear();  // Reset the error flags on the stream
+  in.ignore(std::numeric_limits<std::streamsize>::max(),
+            '\n');  // Discard invalid input in the buffer
 }
 
 // Public
 
 StringFormatter::StringFormatter(int width) : Formatter(width) {}
 
+// The string-returning methods reserve the final size once and delegate to
+// the append* methods, so each call costs at most a single allocation.
 string StringFormatter::horizontalSeparator(const char BORDER_CHAR) const {
   return string(m_width, BORDER_CHAR);
 }
 
 string StringFormatter::horizontalSeparatorWithSides(
     const char SEPARATOR_CHAR, const char SIDE_CHAR) const {
-  return SIDE_CHAR + string(m_width - 2, SEPARATOR_CHAR) + SIDE_CHAR;
-}
-
-string StringFormatter::buildCentered(
-    const string& LABEL, const char BORDER_CHAR,
-    string (StringFormatter::*formatBuilder)(const string&, int, int, char)
-        const) const {
-  auto [usableWidth, labelLength] = calculateStringMetrics(LABEL);
-  string truncatedLabel = truncateString(LABEL, usableWidth);
-
-  const int TOTAL_PADDING = std::max(0, usableWidth - labelLength);
-  const int LEFT_PADDING = TOTAL_PADDING / 2;
-  const int RIGHT_PADDING = TOTAL_PADDING - LEFT_PADDING;
-
-  return (this->*formatBuilder)(truncatedLabel, LEFT_PADDING, RIGHT_PADDING,
-                                BORDER_CHAR);
+  string result;
+  result.reserve(m_width);
+  appendHorizontalSeparatorWithSides(result, SEPARATOR_CHAR, SIDE_CHAR);
+  return result;
 }
 
 string StringFormatter::formatCentered(const string& LABEL,
                                        const char BORDER_CHAR) const {
-  return buildCentered(LABEL, BORDER_CHAR,
-                       &StringFormatter::buildFormattedString);
+  string result;
+  result.reserve(m_width);
+  appendCentered(result, LABEL, BORDER_CHAR);
+  return result;
 }
 
 string StringFormatter::formatFullBorder(const string& LABEL,
                                          const char BORDER_CHAR) const {
-  return buildCentered(LABEL, BORDER_CHAR,
-                       &StringFormatter::buildFullBorderFormattedString);
+  string result;
+  result.reserve(m_width);
+  appendFullBorder(result, LABEL, BORDER_CHAR);
+  return result;
 }
 
 string StringFormatter::formatSideBorder(const string& LABEL,
                                          const char BORDER_CHAR) const {
+  string result;
+  result.reserve(m_width);
+  appendSideBorder(result, LABEL, BORDER_CHAR);
+  return result;
+}
+
+string StringFormatter::toStringWithPrecision(double value,
+                                              int precision) const {
+  string result;
+  appendWithPrecision(result, value, precision);
+  return result;
+}
+
+void StringFormatter::appendHorizontalSeparator(string& out,
+                                                const char BORDER_CHAR) const {
+  out.append(max(0, m_width), BORDER_CHAR);
+}
+
+void StringFormatter::appendHorizontalSeparatorWithSides(
+    string& out, const char SEPARATOR_CHAR, const char SIDE_CHAR) const {
+  out += SIDE_CHAR;
+  out.append(max(0, m_width - 2), SEPARATOR_CHAR);
+  out += SIDE_CHAR;
+}
+
+// Appends the label with space padding between the borders and the label.
+// NOTE: here and after 'LABEL' uses uppercase as per assignment-specific style
+// guidelines.
+void StringFormatter::appendCentered(string& out, std::string_view LABEL,
+                                     const char BORDER_CHAR) const {
+  const auto [USABLE_WIDTH, LABEL_LENGTH] = calculateStringMetrics(LABEL);
+  const int TOTAL_PADDING = max(0, USABLE_WIDTH - LABEL_LENGTH);
+  const int LEFT_PADDING = TOTAL_PADDING / 2;
+  const int RIGHT_PADDING = TOTAL_PADDING - LEFT_PADDING;
+
+  out += BORDER_CHAR;
+  out.append(LEFT_PADDING, ' ');
+  appendTruncated(out, LABEL, USABLE_WIDTH);
+  out.append(RIGHT_PADDING, ' ');
+  out += BORDER_CHAR;
+}
+
+// Appends the label with border characters around it and spaces between the
+// label and the borders.
+void StringFormatter::appendFullBorder(string& out, std::string_view LABEL,
+                                       const char BORDER_CHAR) const {
+  const auto [USABLE_WIDTH, LABEL_LENGTH] = calculateStringMetrics(LABEL);
+  const int TOTAL_PADDING = max(0, USABLE_WIDTH - LABEL_LENGTH);
+  const int LEFT_PADDING = TOTAL_PADDING / 2;
+  const int RIGHT_PADDING = TOTAL_PADDING - LEFT_PADDING;
+
+  out.append(LEFT_PADDING, BORDER_CHAR);
+  out += ' ';
+  appendTruncated(out, LABEL, USABLE_WIDTH);
+  out += ' ';
+  out.append(RIGHT_PADDING, BORDER_CHAR);
+}
+
+void StringFormatter::appendSideBorder(string& out, std::string_view LABEL,
+                                       const char BORDER_CHAR) const {
   const auto [USABLE_WIDTH, LABEL_LENGTH] = calculateStringMetrics(LABEL);
-  string truncatedLabel = truncateString(LABEL, USABLE_WIDTH);
   const int SPACES =
-      std::max(0, USABLE_WIDTH - LABEL_LENGTH - 1);  // subtract left padding
+      max(0, USABLE_WIDTH - LABEL_LENGTH - 1);  // subtract left padding
 
-  return buildFormattedString(truncatedLabel, SPACES > 0 ? 1 : 0, SPACES,
-                              BORDER_CHAR);
+  out += BORDER_CHAR;
+  out.append(SPACES > 0 ? 1 : 0, ' ');
+  appendTruncated(out, LABEL, USABLE_WIDTH);
+  out.append(SPACES, ' ');
+  out += BORDER_CHAR;
 }
 
-string StringFormatter::toStringWithPrecision(double value,
-                                              int precision) const {
-  std::ostringstream oss;
-  oss << std::fixed << std::setprecision(precision) << value;
-  return oss.str();
+void StringFormatter::appendWithPrecision(string& out, double value,
+                                          int precision) const {
+  // Same digits as std::fixed with std::setprecision in the "C" locale
+  const int BUFFER_SIZE = 64;
+  char buffer[BUFFER_SIZE];
+  const int LENGTH =
+      std::snprintf(buffer, BUFFER_SIZE, "%.*f", precision, value);
+  if (LENGTH < 0) {
+    return;
+  }
+  if (LENGTH < BUFFER_SIZE) {
+    out.append(buffer, LENGTH);
+    return;
+  }
+
+  // Huge values do not fit the stack buffer, print them in place
+  const size_t OLD_SIZE = out.size();
+  out.resize(OLD_SIZE + LENGTH + 1);
+  std::snprintf(&out[OLD_SIZE], LENGTH + 1, "%.*f", precision, value);
+  out.resize(OLD_SIZE + LENGTH);
 }
 
 // Table Formatter
 // Public
 
-TableFormatter::TableFormatter(int width) : Formatter(width) {}
+TableFormatter::TableFormatter(int width, std::pmr::memory_resource* resource)
+    : Formatter(width), m_rows(resource) {}
 
 bool TableFormatter::setColumnWidths(const vector<int>& WIDTHS) {
   int sum = 0;
@@ -144,53 +305,187 @@ void TableFormatter::setHeaders(const vector<string>& HEADERS) {
 }
 
 void TableFormatter::addRow(const vector<string>& ROW) {
-  m_rows.push_back(ROW);
+  // emplace_back hands the table's resource down to the row and its cells
+  auto& row = m_rows.emplace_back();
+  row.reserve(ROW.size());
+  for (const string& CELL : ROW) {
+    row.emplace_back(CELL.data(), CELL.size());
+  }
+}
+
+void TableFormatter::addRow(std::initializer_list<std::string_view> ROW) {
+  auto& row = m_rows.emplace_back();
+  row.reserve(ROW.size());
+  for (std::string_view cell : ROW) {
+    row.emplace_back(cell.data(), cell.size());
+  }
 }
 
 void TableFormatter::clearRows() { m_rows.clear(); }
 
 string TableFormatter::render() const {
   string result;
-  string border = "+";
-  bool isFirstWidth = true;
-  for (int width : m_col_widths) {
-    int adjustedWidth = isFirstWidth ? width : width - 2;
-    isFirstWidth = false;
+  result.reserve(getRenderedSize());
+  StringSink sink(result);
 
-    border += string(adjustedWidth, '-') + "+";
+  writeBorder(sink);
+  if (!m_headers.empty()) {
+    writeRow(sink, m_headers);
+    writeBorder(sink);
+  }
+  for (const auto& ROW : m_rows) {
+    writeRow(sink, ROW);
   }
-  border += "\n";
+  writeBorder(sink);
 
-  // Add headers
-  result += border;
+  return result;
+}
+
+void TableFormatter::render(std::ostream& out) const {
+  StreamSink sink(out);
+
+  writeBorder(sink);
   if (!m_headers.empty()) {
-    result += formatRow(m_headers) + "\n";
-    result += border;
+    writeRow(sink, m_headers);
+    writeBorder(sink);
+  }
+  for (const auto& ROW : m_rows) {
+    writeRow(sink, ROW);
   }
+  writeBorder(sink);
+}
+
+int TableFormatter::render(Screen& screen, int row) const {
+  ScreenSink sink(screen, row);
 
-  // Add rows
+  writeBorder(sink);
+  if (!m_headers.empty()) {
+    writeRow(sink, m_headers);
+    writeBorder(sink);
+  }
   for (const auto& ROW : m_rows) {
-    result += formatRow(ROW) + "\n";
+    writeRow(sink, ROW);
   }
-  result += border;
+  writeBorder(sink);
+  return std::min(sink.getRow(), screen.getHeight());
+}
 
-  return result;
+size_t TableFormatter::getRenderedSize() const {
+  const size_t BORDER_LENGTH = getRowLength(m_col_widths.size());
+  size_t size = BORDER_LENGTH * 2;
+  if (!m_headers.empty()) {
+    size += getRowLength(m_headers.size()) + BORDER_LENGTH;
+  }
+  for (const auto& ROW : m_rows) {
+    size += getRowLength(ROW.size());
+  }
+  return size;
+}
+
+size_t TableFormatter::renderPage(std::ostream& out, const RowSource& SOURCE,
+                                  size_t maxRows) const {
+  StreamSink sink(out);
+  return writePage(sink, SOURCE, maxRows);
+}
+
+size_t TableFormatter::renderPage(string& buffer, const RowSource& SOURCE,
+                                  size_t maxRows) const {
+  if (maxRows != ALL_ROWS) {
+    const size_t BORDERS_LENGTH = getRowLength(m_col_widths.size()) *
+                                  (m_headers.empty() ? 2 : 3);
+    const size_t HEADERS_LENGTH =
+        m_headers.empty() ? 0 : getRowLength(m_headers.size());
+    const size_t REQUIRED = buffer.size() + BORDERS_LENGTH + HEADERS_LENGTH +
+                            getRowLength(m_col_widths.size()) * maxRows;
+    // Grow geometrically, so appending many pages stays linear
+    if (REQUIRED > buffer.capacity()) {
+      buffer.reserve(std::max(REQUIRED, buffer.capacity() * 2));
+    }
+  }
+  StringSink sink(buffer);
+  return writePage(sink, SOURCE, maxRows);
 }
 
 // Private
 
-string TableFormatter::formatRow(const vector<string>& ROW) const {
-  string result = "|";
+size_t TableFormatter::getRowLength(size_t cellCount) const {
+  // "|" + " CELL |" per cell + "\n"; borders come out the same length
+  size_t length = 2;
+  for (size_t i = 0; i < cellCount && i < m_col_widths.size(); ++i) {
+    const int ADJUSTED_WIDTH =
+        i == 0 ? m_col_widths[i] - 2 : m_col_widths[i] - 4;
+    length += std::max(0, ADJUSTED_WIDTH) + 3;
+  }
+  return length;
+}
+
+template <typename Sink>
+void TableFormatter::writeBorder(Sink& sink) const {
+  sink.write("+", 1);
   bool isFirstWidth = true;
-  for (size_t i = 0; i < ROW.size(); ++i) {
-    int width = m_col_widths[i];
-    int adjustedWidth = isFirstWidth ? width - 2 : width - 4;
+  for (int width : m_col_widths) {
+    int adjustedWidth = isFirstWidth ? width : width - 2;
     isFirstWidth = false;
 
-    string cell = truncateString(ROW[i], adjustedWidth);
-    result += " " + cell + string(adjustedWidth - cell.length(), ' ') + " |";
+    sink.fill('-', std::max(0, adjustedWidth));
+    sink.write("+", 1);
   }
-  return result;
+  sink.write("\n", 1);
+}
+
+template <typename Sink, typename Row>
+void TableFormatter::writeRow(Sink& sink, const Row& ROW) const {
+  const size_t CELL_COUNT = std::min(ROW.size(), m_col_widths.size());
+  sink.write("|", 1);
+  for (size_t i = 0; i < CELL_COUNT; ++i) {
+    const int WIDTH = m_col_widths[i];
+    const size_t ADJUSTED_WIDTH = std::max(0, i == 0 ? WIDTH - 2 : WIDTH - 4);
+    const std::string_view CELL = ROW[i];
+
+    sink.write(" ", 1);
+    // Same as truncateString(), without building a temporary string
+    if (CELL.length() > ADJUSTED_WIDTH) {
+      const size_t KEPT = ADJUSTED_WIDTH >= 3 ? ADJUSTED_WIDTH - 3 : 0;
+      sink.write(CELL.data(), KEPT);
+      sink.write("...", 3);
+      sink.fill(' ', ADJUSTED_WIDTH - std::min(ADJUSTED_WIDTH, KEPT + 3));
+    } else {
+      sink.write(CELL.data(), CELL.length());
+      sink.fill(' ', ADJUSTED_WIDTH - CELL.length());
+    }
+    sink.write(" |", 2);
+  }
+  sink.write("\n", 1);
+}
+
+template <typename Sink>
+size_t TableFormatter::writePage(Sink& sink, const RowSource& SOURCE,
+                                 size_t maxRows) const {
+  if (maxRows == 0) {
+    return 0;
+  }
+
+  // Pull the first row before drawing anything, so an exhausted source
+  // does not leave an empty table behind
+  vector<string> row;
+  if (!SOURCE(row)) {
+    return 0;
+  }
+
+  writeBorder(sink);
+  if (!m_headers.empty()) {
+    writeRow(sink, m_headers);
+    writeBorder(sink);
+  }
+
+  size_t rowCount = 0;
+  do {
+    writeRow(sink, row);
+    ++rowCount;
+  } while (rowCount < maxRows && SOURCE(row));
+  writeBorder(sink);
+
+  return rowCount;
 }
 
 // Checks whether provided value is a positive real number
@@ -223,4 +518,142 @@ string trim(const string& STR) {
   return STR.substr(first, last - first);
 }
 
+std::string_view trimView(std::string_view STR) {
+  auto isSpace = [](char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+  };
+  while (!STR.empty() && isSpace(STR.front())) {
+    STR.remove_prefix(1);
+  }
+  while (!STR.empty() && isSpace(STR.back())) {
+    STR.remove_suffix(1);
+  }
+  return STR;
+}
+
+// Input parsing
+size_t skipWhitespace(std::string_view INPUT, size_t start) {
+  // The classic locale whitespace skipped by std::skipws
+  while (start < INPUT.size() &&
+         std::strchr(" \t\n\v\f\r", INPUT[start]) != nullptr &&
+         INPUT[start] != '\0') {
+    ++start;
+  }
+  return start;
+}
+
+size_t findNumberEnd(std::string_view INPUT, size_t start,
+                     bool isFloatingPoint) {
+  auto isDigitAt = [&INPUT](size_t i) {
+    return i < INPUT.size() && INPUT[i] >= '0' && INPUT[i] <= '9';
+  };
+  auto isAnyOfAt = [&INPUT](size_t i, const char* CHARACTERS) {
+    return i < INPUT.size() && INPUT[i] != '\0' &&
+           std::strchr(CHARACTERS, INPUT[i]) != nullptr;
+  };
+
+  size_t end = start;
+  if (isAnyOfAt(end, "+-")) {
+    ++end;
+  }
+  if (!isFloatingPoint) {
+    while (isDigitAt(end)) {
+      ++end;
+    }
+    return end;
+  }
+
+  const bool IS_HEXADECIMAL = isAnyOfAt(end, "0") &&
+                              isAnyOfAt(end + 1, "xX") &&
+                              end + 2 < INPUT.size() &&
+                              std::isxdigit(static_cast<unsigned char>(
+                                  INPUT[end + 2]));
+  if (IS_HEXADECIMAL) {
+    end += 2;
+  }
+  auto isMantissaDigitAt = [&](size_t i) {
+    return IS_HEXADECIMAL ? i < INPUT.size() &&
+                                std::isxdigit(static_cast<unsigned char>(
+                                    INPUT[i]))
+                          : isDigitAt(i);
+  };
+
+  // Digits with at most one decimal point
+  bool hasDigits = false;
+  bool hasPoint = false;
+  while (isMantissaDigitAt(end) || (!hasPoint && isAnyOfAt(end, "."))) {
+    hasDigits = hasDigits || INPUT[end] != '.';
+    hasPoint = hasPoint || INPUT[end] == '.';
+    ++end;
+  }
+
+  // An exponent only follows digits; its sign and digits are optional to
+  // the scan, the conversion then rejects a dangling exponent
+  if (hasDigits && isAnyOfAt(end, IS_HEXADECIMAL ? "pP" : "eE")) {
+    ++end;
+    if (isAnyOfAt(end, "+-")) {
+      ++end;
+    }
+    while (isDigitAt(end)) {
+      ++end;
+    }
+  }
+  return end;
+}
+
+namespace {
+template <typename T>
+bool convertFloatingPoint(std::string_view TEXT, T& value) {
+  // from_chars takes neither a plus sign nor a hexadecimal prefix
+  const bool IS_NEGATIVE = !TEXT.empty() && TEXT.front() == '-';
+  if (!TEXT.empty() && (TEXT.front() == '+' || IS_NEGATIVE)) {
+    TEXT.remove_prefix(1);
+  }
+  std::chars_format format = std::chars_format::general;
+  if (TEXT.size() > 2 && TEXT[0] == '0' && (TEXT[1] == 'x' || TEXT[1] == 'X')) {
+    TEXT.remove_prefix(2);
+    format = std::chars_format::hex;
+  }
+  // Streams read neither a second sign nor infinity and NaN
+  if (TEXT.empty() ||
+      !(std::isxdigit(static_cast<unsigned char>(TEXT.front())) ||
+        TEXT.front() == '.')) {
+    return false;
+  }
+
+  const char* END = TEXT.data() + TEXT.size();
+  const auto [PARSED_END, ERROR] =
+      std::from_chars(TEXT.data(), END, value, format);
+  if (PARSED_END != END) {
+    return false;
+  }
+  if (ERROR == std::errc::result_out_of_range) {
+    // Streams fail on overflow, but read an underflow as zero
+    const size_t EXPONENT =
+        TEXT.find_first_of(format == std::chars_format::hex ? "pP" : "eE");
+    if (EXPONENT == std::string_view::npos || EXPONENT + 1 >= TEXT.size() ||
+        TEXT[EXPONENT + 1] != '-') {
+      return false;
+    }
+    value = 0;
+  } else if (ERROR != std::errc()) {
+    return false;
+  }
+  value = IS_NEGATIVE ? -value : value;
+  return true;
+}
+}  // namespace
+
+bool convertNumber(std::string_view TEXT, double& value) {
+  return convertFloatingPoint(TEXT, value);
+}
+
+bool convertNumber(std::string_view TEXT, float& value) {
+  return convertFloatingPoint(TEXT, value);
+}
+
+bool convertNumber(std::string_view TEXT, long double& value) {
+  return convertFloatingPoint(TEXT, value);
+}
+
 }  // namespace mini_utils
@@ -1,35 +1,51 @@
 #ifndef MINI_UTILS_H
 #define MINI_UTILS_H
 
+#include <charconv>
 #include <functional>
 #include <iostream>
-#include <sstream>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace mini_utils {
 using std::string;
 using std::vector;
 
+class Screen;
+
 // Checks whether provided value is a positive real number
 bool isPositiveRealNum(double number);
 
 // Trims leading and trailing whitespace from a string
 string trim(const string& STR);
 
+// Same as trim, but returns a view into STR instead of a copy
+std::string_view trimView(std::string_view STR);
+
 class Formatter {
  public:
   Formatter(int width);
   void setWidth(int newWidth);
+  int getWidth() const;
 
  protected:
   // Helper: truncate a string if it exceeds the width
   string truncateString(const string& STR, int width) const;
 
+  // Helper: append a string truncated to the width, without temporaries
+  void appendTruncated(string& out, std::string_view STR, int width) const;
+
   // Width within which the text is rendered
   int m_width = 0;
 };
 
+// Every format* method has an append* counterpart that writes the same text
+// into a caller-provided buffer. Reusing one buffer per frame (e.g. a menu
+// redraw) avoids the intermediate strings entirely.
 class StringFormatter : public Formatter {
  public:
   StringFormatter(int width);
@@ -53,89 +69,275 @@ class StringFormatter : public Formatter {
   // Format double to string with precision
   string toStringWithPrecision(double value, int precision = 2) const;
 
- private:
-  // Helper to construct a formatted string with padding and border.
-  string buildFormattedString(const string& LABEL, int leftPadding,
-                              int rightPadding, char borderChar) const;
-
-  string buildFullBorderFormattedString(const string& LABEL, int leftPadding,
-                                        int rightPadding,
-                                        char borderChar) const;
-
-  string buildCentered(const string& LABEL, const char BORDER_CHAR,
-                       string (StringFormatter::*formatBuilder)(const string&,
-                                                                int, int, char)
-                           const) const;
+  void appendHorizontalSeparator(string& out,
+                                 const char BORDER_CHAR = '*') const;
+  void appendHorizontalSeparatorWithSides(string& out,
+                                          const char SEPARATOR_CHAR = '*',
+                                          const char SIDE_CHAR = '|') const;
+  void appendCentered(string& out, std::string_view LABEL,
+                      const char BORDER_CHAR = '*') const;
+  void appendFullBorder(string& out, std::string_view LABEL,
+                        const char BORDER_CHAR = '*') const;
+  void appendSideBorder(string& out, std::string_view LABEL,
+                        const char BORDER_CHAR = '*') const;
+  void appendWithPrecision(string& out, double value, int precision = 2) const;
 
+ private:
   struct StringMetrics {
     int usableWidth;
     int labelLength;
   };
 
-  StringMetrics calculateStringMetrics(const string& LABEL) const;
+  StringMetrics calculateStringMetrics(std::string_view LABEL) const;
+};
+
+// Compile-time counterpart of StringFormatter for layouts known in advance,
+// such as menus. Each call appends one line, followed by a line break, laid
+// out exactly like the StringFormatter method of the same name. Built as a
+// constexpr value, the whole frame is a string literal in the binary.
+//
+// Example:
+//   constexpr StaticFrame<26, 2> MakeFrame() {
+//     StaticFrame<26, 2> frame;
+//     frame.horizontalSeparator().formatSideBorder("1 - Add One Hour");
+//     return frame;
+//   }
+template <int WIDTH, int LINES>
+class StaticFrame {
+ public:
+  constexpr StaticFrame& horizontalSeparator(char borderChar = '*') {
+    fill(borderChar, WIDTH);
+    return endLine();
+  }
+
+  constexpr StaticFrame& horizontalSeparatorWithSides(char separatorChar = '*',
+                                                      char sideChar = '|') {
+    fill(sideChar, 1);
+    fill(separatorChar, WIDTH - 2);
+    fill(sideChar, 1);
+    return endLine();
+  }
+
+  constexpr StaticFrame& formatCentered(const char* LABEL,
+                                        char borderChar = '*') {
+    const int TOTAL_PADDING = padding(USABLE_WIDTH - length(LABEL));
+    fill(borderChar, 1);
+    fill(' ', TOTAL_PADDING / 2);
+    appendTruncated(LABEL);
+    fill(' ', TOTAL_PADDING - TOTAL_PADDING / 2);
+    fill(borderChar, 1);
+    return endLine();
+  }
+
+  constexpr StaticFrame& formatFullBorder(const char* LABEL,
+                                          char borderChar = '*') {
+    const int TOTAL_PADDING = padding(USABLE_WIDTH - length(LABEL));
+    fill(borderChar, TOTAL_PADDING / 2);
+    fill(' ', 1);
+    appendTruncated(LABEL);
+    fill(' ', 1);
+    fill(borderChar, TOTAL_PADDING - TOTAL_PADDING / 2);
+    return endLine();
+  }
+
+  constexpr StaticFrame& formatSideBorder(const char* LABEL,
+                                          char borderChar = '*') {
+    const int SPACES = padding(USABLE_WIDTH - length(LABEL) - 1);
+    fill(borderChar, 1);
+    fill(' ', SPACES > 0 ? 1 : 0);
+    appendTruncated(LABEL);
+    fill(' ', SPACES);
+    fill(borderChar, 1);
+    return endLine();
+  }
+
+  constexpr const char* data() const { return m_text; }
+  constexpr size_t size() const { return m_size; }
+
+ private:
+  static constexpr int USABLE_WIDTH = WIDTH - 2;  // Borders (e.g., "*TEXT*")
+
+  // Every line fits into the width plus its line break
+  char m_text[(WIDTH + 1) * LINES + 1] = {};
+  size_t m_size = 0;
+
+  static constexpr int length(const char* TEXT) {
+    int textLength = 0;
+    while (TEXT[textLength] != '\0') {
+      ++textLength;
+    }
+    return textLength;
+  }
+
+  static constexpr int padding(int space) { return space > 0 ? space : 0; }
+
+  constexpr void fill(char fillChar, int count) {
+    for (int i = 0; i < count; ++i) {
+      m_text[m_size++] = fillChar;
+    }
+  }
+
+  constexpr void appendTruncated(const char* LABEL) {
+    const int LABEL_LENGTH = length(LABEL);
+    const bool IS_TRUNCATED = LABEL_LENGTH > USABLE_WIDTH;
+    const int KEPT = IS_TRUNCATED ? padding(USABLE_WIDTH - 3) : LABEL_LENGTH;
+    for (int i = 0; i < KEPT; ++i) {
+      m_text[m_size++] = LABEL[i];
+    }
+    if (IS_TRUNCATED) {
+      fill('.', 3);
+    }
+  }
+
+  constexpr StaticFrame& endLine() {
+    m_text[m_size++] = '\n';
+    return *this;
+  }
 };
 
 // Clear the input buffer in case of invalid input,
 // ensuring that subsequent input operations are not affected.
-void clearInput();
+void clearInput(std::istream& in = std::cin);
+
+// Index of the first character at or after START that is not whitespace, as
+// skipped by an input stream
+size_t skipWhitespace(std::string_view INPUT, size_t start);
+
+// End of the longest prefix of INPUT from START that an input stream would
+// read as a number: optional sign, digits, and for floating point a decimal
+// point and exponent. Floating point also takes hexadecimal ("0x1.8p3"),
+// which the MSVC streams accept.
+size_t findNumberEnd(std::string_view INPUT, size_t start,
+                     bool isFloatingPoint);
+
+// Converts the whole TEXT found by findNumberEnd. Fails like a stream does:
+// on a sign without digits, a dangling exponent or a value out of range,
+// except that floating point underflow reads as zero.
+bool convertNumber(std::string_view TEXT, double& value);
+bool convertNumber(std::string_view TEXT, float& value);
+bool convertNumber(std::string_view TEXT, long double& value);
+
+template <typename T>
+bool convertNumber(std::string_view TEXT, T& value) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>,
+                "Unsigned input is not supported, streams wrap negatives");
+  // from_chars takes no plus sign, streams do
+  if (!TEXT.empty() && TEXT.front() == '+') {
+    TEXT.remove_prefix(1);
+  }
+  const char* END = TEXT.data() + TEXT.size();
+  const auto [PARSED_END, ERROR] = std::from_chars(TEXT.data(), END, value);
+  return ERROR == std::errc() && PARSED_END == END;
+}
+
+// Parses a value from the start of INPUT the way `std::istream >> value`
+// does: leading whitespace is skipped and parsing stops at the first
+// character that cannot continue the value. hasExtraCharacters tells whether
+// anything but whitespace follows the value. Numbers are converted with
+// std::from_chars, without copies, locales or streams.
+template <typename T>
+bool parseInput(std::string_view INPUT, T& value, bool& hasExtraCharacters) {
+  const size_t START = skipWhitespace(INPUT, 0);
+  size_t end = START;
+  if constexpr (std::is_same_v<T, char>) {
+    if (START == INPUT.size()) {
+      return false;
+    }
+    value = INPUT[START];
+    end = START + 1;
+  } else if constexpr (std::is_same_v<T, string>) {
+    while (end < INPUT.size() && skipWhitespace(INPUT, end) == end) {
+      ++end;
+    }
+    if (end == START) {
+      return false;
+    }
+    value.assign(INPUT.data() + START, end - START);
+  } else {
+    end = findNumberEnd(INPUT, START, std::is_floating_point_v<T>);
+    if (!convertNumber(INPUT.substr(START, end - START), value)) {
+      return false;
+    }
+  }
+  hasExtraCharacters = skipWhitespace(INPUT, end) < INPUT.size();
+  return true;
+}
+
+// Thrown by getValidatedInput when the input stream ends or fails before a
+// valid value was entered, e.g. on Ctrl+D or at the end of a replayed
+// session. The CLIs catch it at their top level and end the session.
+class InputEndedError : public std::runtime_error {
+ public:
+  InputEndedError() : std::runtime_error("Input ended") {}
+};
 
 // Prompts the user to input a value, validates it, and ensures it meets
 // specified criteria.
 //
+// in, out:
+//   Streams the prompt talks through. The overload without them uses the
+//   console.
 // T:
-//   The expected input type (e.g., int, double, string).
+//   The expected input type (e.g., int, double, char, string).
 // PROMPT:
 //   Message to display when asking for input.
 // validator:
-//   A function that checks if the input meets specific conditions.
+//   A callable that checks if the input meets specific conditions.
 // criteriaDescription:
 //   A short explanation of the validation criteria for error messages.
 // strictMode:
 //   If true, disallows extra characters after the expected input. Defaults to
 //   false.
 // preprocess:
-//   A function that preprocesses the input string before parsing. Defaults to
-//   trim.
-template <typename T>
-T getValidatedInput(
-    const string& PROMPT, std::function<bool(T)> validator,
-    const string& CRITERIA_DESCRIPTION = "value", bool strictMode = false,
-    std::function<std::string(const std::string&)> preprocess = trim) {
-  T input;
+//   A callable that preprocesses the input string before parsing. It may
+//   return a string or a view into its argument. Defaults to trimView.
+//
+// Throws InputEndedError if the input ends before a valid value is read.
+//
+// The callables are template parameters rather than std::function, so they
+// are inlined into the input loop.
+template <typename T, typename Validator,
+          typename Preprocess = std::string_view (*)(std::string_view)>
+T getValidatedInput(std::istream& in, std::ostream& out, const string& PROMPT,
+                    Validator validator,
+                    const string& CRITERIA_DESCRIPTION = "value",
+                    bool strictMode = false,
+                    Preprocess preprocess = trimView) {
+  T input{};
+  string rawInput;
   bool isInputValid = false;
 
   do {
-    std::cout << PROMPT;
-    string rawInput = "";
-    getline(std::cin, rawInput);
-
-    // Preprocess input, e.g. trim spaces
-    rawInput = preprocess(rawInput);
+    out << PROMPT;
+    if (!getline(in, rawInput)) {
+      throw InputEndedError();
+    }
 
-    // Attempt to convert input to the desired type
-    std::stringstream inputStream(rawInput);
+    // Preprocess input, e.g. trim spaces. Binding to a const reference keeps
+    // a returned string alive and a returned view cheap.
+    const auto& PREPROCESSED = preprocess(rawInput);
 
     // Attempt to extract the input
-    if (!(inputStream >> input)) {
-      std::cout << "Invalid input. Please enter a valid "
-                << CRITERIA_DESCRIPTION
-                << "." << std::endl;
+    bool hasExtraCharacters = false;
+    if (!parseInput(std::string_view(PREPROCESSED), input,
+                    hasExtraCharacters)) {
+      out << "Invalid input. Please enter a valid " << CRITERIA_DESCRIPTION
+          << "." << std::endl;
       continue;
     }
 
     // Check if input meets custom criteria
     if (!validator(input)) {
-      std::cout << "Input is out of the accepted range or format. Please enter "
-                   "a valid "
-                << CRITERIA_DESCRIPTION << "." << std::endl;
+      out << "Input is out of the accepted range or format. Please enter "
+             "a valid "
+          << CRITERIA_DESCRIPTION << "." << std::endl;
       continue;
     }
 
     // In strict mode, ensure there are no unexpected characters after the input
-    char extraChar;
-    if (strictMode && inputStream >> extraChar) {
-      std::cout << "Unexpected characters found. Please enter a valid "
-                << CRITERIA_DESCRIPTION << "." << std::endl;
+    if (strictMode && hasExtraCharacters) {
+      out << "Unexpected characters found. Please enter a valid "
+          << CRITERIA_DESCRIPTION << "." << std::endl;
       continue;
     }
 
@@ -145,15 +347,39 @@ T getValidatedInput(
   return input;
 }
 
+template <typename T, typename Validator,
+          typename Preprocess = std::string_view (*)(std::string_view)>
+T getValidatedInput(const string& PROMPT, Validator validator,
+                    const string& CRITERIA_DESCRIPTION = "value",
+                    bool strictMode = false,
+                    Preprocess preprocess = trimView) {
+  return getValidatedInput<T>(std::cin, std::cout, PROMPT, validator,
+                              CRITERIA_DESCRIPTION, strictMode, preprocess);
+}
+
 class TableFormatter : public Formatter {
  public:
-  TableFormatter(int width);
+  // Fills ROW with the cells of the next row and returns true, or returns
+  // false once there are no more rows. The same vector is handed over on
+  // every call, so its strings can reuse their capacity between rows.
+  using RowSource = std::function<bool(vector<string>& row)>;
+
+  // Page size meaning "until the row source is exhausted"
+  static const size_t ALL_ROWS = static_cast<size_t>(-1);
+
+  // Added rows are kept in the resource, which must outlive the formatter.
+  // With a std::pmr::monotonic_buffer_resource, a big table costs no calls
+  // to the global heap and is freed in one go.
+  TableFormatter(
+      int width,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
   // Mind that minimal terminal size in columns: 80
   bool setColumnWidths(const vector<int>& WIDTHS);
   void setHeaders(const vector<string>& HEADERS);
 
-  // Add a row to the table
+  // Add a row to the table. The cells are copied into the table's resource.
   void addRow(const vector<string>& ROW);
+  void addRow(std::initializer_list<std::string_view> ROW);
 
   // Clear all rows
   void clearRows();
@@ -161,13 +387,45 @@ class TableFormatter : public Formatter {
   // Render the entire table as a formatted string
   string render() const;
 
+  // Render the entire table straight into a stream
+  void render(std::ostream& out) const;
+
+  // Render the entire table into the lines of the screen from the row on.
+  // Returns the row after the table; lines below the screen are dropped.
+  int render(Screen& screen, int row) const;
+
+  // Exact length of the render() output, used to allocate it once
+  size_t getRenderedSize() const;
+
+  // Render up to maxRows rows pulled from SOURCE as a table of its own,
+  // without storing them. Call again with the same source for the next page.
+  // Returns the number of rendered rows; nothing is written once SOURCE is
+  // exhausted.
+  size_t renderPage(std::ostream& out, const RowSource& SOURCE,
+                    size_t maxRows = ALL_ROWS) const;
+
+  // Same as above, appending to a caller-provided buffer. Space for a full
+  // page is reserved up front.
+  size_t renderPage(string& buffer, const RowSource& SOURCE,
+                    size_t maxRows = ALL_ROWS) const;
+
  private:
   vector<int> m_col_widths;       // Column widths
   vector<string> m_headers;       // Optional headers
-  vector<vector<string>> m_rows;  // Rows of data
-
-  // Helper: format a single row as a string
-  string formatRow(const vector<string>& ROW) const;
+  // Rows of data; the inner containers share the outer one's resource
+  std::pmr::vector<std::pmr::vector<std::pmr::string>> m_rows;
+
+  // Helper: length of a rendered row with the given number of cells,
+  // including the line break
+  size_t getRowLength(size_t cellCount) const;
+
+  // Helpers shared by the string and stream renderers
+  template <typename Sink>
+  void writeBorder(Sink& sink) const;
+  template <typename Sink, typename Row>
+  void writeRow(Sink& sink, const Row& ROW) const;
+  template <typename Sink>
+  size_t writePage(Sink& sink, const RowSource& SOURCE, size_t maxRows) const;
 };
 
 }  // namespace mini_utils
@@ -0,0 +1,159 @@
+#include "screen.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace mini_utils {
+namespace {
+// Rewriting a few equal characters is cheaper than another cursor move
+const size_t MAX_EQUAL_GAP = 4;
+
+// Escape sequence followed by a number, e.g. "\x1b[12G", without temporaries
+void appendEscape(string& out, int number, char command) {
+  char buffer[16];
+  const int LENGTH =
+      std::snprintf(buffer, sizeof(buffer), "\x1b[%d%c", number, command);
+  out.append(buffer, LENGTH);
+}
+
+// Characters past the end of the shorter line count as blanks
+char charAt(std::string_view LINE, size_t i) {
+  return i < LINE.size() ? LINE[i] : ' ';
+}
+}  // namespace
+
+Screen::Screen(int width, int height)
+    : m_width(std::max(0, width)),
+      m_height(std::max(0, height)),
+      m_lines(m_height),
+      m_presentedLines(m_height) {}
+
+int Screen::getWidth() const { return m_width; }
+
+int Screen::getHeight() const { return m_height; }
+
+string& Screen::beginLine(int row) {
+  string& line = m_lines[row];
+  line.clear();
+  return line;
+}
+
+int Screen::writeLines(int row, std::string_view TEXT) {
+  size_t start = 0;
+  while (start < TEXT.size() && row < m_height) {
+    const size_t END = std::min(TEXT.find('\n', start), TEXT.size());
+    beginLine(row++).assign(TEXT.data() + start, END - start);
+    start = END + 1;
+  }
+  return row;
+}
+
+void Screen::clear() {
+  for (string& line : m_lines) {
+    line.clear();
+  }
+}
+
+void Screen::appendFrame(string& out) { appendFrameEndingOn(out, m_height); }
+
+void Screen::present(std::ostream& out) { write(out, m_height); }
+
+void Screen::invalidate() { m_isPresented = false; }
+
+void Screen::appendRelease(string& out, int row) {
+  appendFrameEndingOn(out, std::clamp(row, 0, m_height));
+  m_isPresented = false;
+}
+
+void Screen::release(std::ostream& out, int row) {
+  write(out, std::clamp(row, 0, m_height));
+  m_isPresented = false;
+}
+
+void Screen::addLinesBelow(int count) {
+  m_linesBelow += std::max(0, count);
+}
+
+// Private
+
+void Screen::appendFrameEndingOn(string& out, int endRow) {
+  // The cursor starts where the last frame left it, or further down by the
+  // lines reported since
+  int cursorRow = m_height + m_linesBelow;
+  if (!m_isPresented) {
+    for (int row = 0; row < m_height; ++row) {
+      const std::string_view LINE = getVisibleLine(row);
+      out.append(LINE.data(), LINE.size());
+      out += '\n';
+      m_presentedLines[row].assign(LINE.data(), LINE.size());
+    }
+    m_isPresented = true;
+    m_linesBelow = 0;
+    cursorRow = m_height;
+  } else {
+    for (int row = 0; row < m_height; ++row) {
+      const std::string_view CURRENT = getVisibleLine(row);
+      const std::string_view PREVIOUS = m_presentedLines[row];
+      const size_t LENGTH = std::max(PREVIOUS.size(), CURRENT.size());
+
+      size_t i = 0;
+      while (i < LENGTH) {
+        if (charAt(PREVIOUS, i) == charAt(CURRENT, i)) {
+          ++i;
+          continue;
+        }
+
+        // Extend the changed run over short stretches of equal characters
+        size_t runEnd = i + 1;
+        size_t lastChanged = i;
+        while (runEnd < LENGTH && runEnd - lastChanged <= MAX_EQUAL_GAP) {
+          if (charAt(PREVIOUS, runEnd) != charAt(CURRENT, runEnd)) {
+            lastChanged = runEnd;
+          }
+          ++runEnd;
+        }
+
+        if (cursorRow > row) {
+          appendEscape(out, cursorRow - row, 'A');  // Cursor up
+        } else if (cursorRow < row) {
+          appendEscape(out, row - cursorRow, 'B');  // Cursor down
+        }
+        cursorRow = row;
+        appendEscape(out, static_cast<int>(i) + 1, 'G');  // Column, 1-based
+        for (size_t j = i; j <= lastChanged; ++j) {
+          out += charAt(CURRENT, j);
+        }
+        i = lastChanged + 1;
+      }
+      m_presentedLines[row].assign(CURRENT.data(), CURRENT.size());
+    }
+  }
+
+  // A cursor left below an unchanged screen stays there
+  if (cursorRow < m_height || endRow < m_height) {
+    if (cursorRow > endRow) {
+      appendEscape(out, cursorRow - endRow, 'A');  // Cursor up
+    } else if (cursorRow < endRow) {
+      appendEscape(out, endRow - cursorRow, 'B');  // Cursor back down
+    }
+    out += '\r';
+    m_linesBelow = 0;
+  }
+}
+
+void Screen::write(std::ostream& out, int endRow) {
+  m_output.clear();
+  appendFrameEndingOn(m_output, endRow);
+  if (!m_output.empty()) {
+    out.write(m_output.data(), static_cast<std::streamsize>(m_output.size()));
+  }
+  out.flush();
+}
+
+std::string_view Screen::getVisibleLine(int row) const {
+  const std::string_view LINE = m_lines[row];
+  return LINE.substr(0, std::min({LINE.find('\n'), LINE.size(),
+                                  static_cast<size_t>(m_width)}));
+}
+
+}  // namespace mini_utils
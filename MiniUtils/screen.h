@@ -0,0 +1,99 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mini_utils {
+using std::string;
+using std::vector;
+
+// Double-buffered block of terminal lines that is redrawn in place.
+//
+// Frames are drawn into the lines of the screen, then presented: the first
+// frame is written as plain lines, and every later one only as the cursor
+// moves and characters that turn the frame on the terminal into the new
+// one, all in a single write. The block ends above the line the cursor is
+// on, so it works inline in a scrolling CLI without taking over the whole
+// terminal, as long as nothing else is written between frames, or what is
+// written is reported with addLinesBelow().
+//
+// A cell is a byte, so lines should be ASCII. Text past the width, or past
+// a line break within a line, is not shown.
+//
+// Example:
+//   Screen screen(80, 2);
+//   formatter.appendCentered(screen.beginLine(0), "Title");
+//   table.render(screen, 1);
+//   screen.present(std::cout);
+class Screen {
+ public:
+  Screen(int width, int height);
+
+  int getWidth() const;
+  int getHeight() const;
+
+  // Empty the line and return it to be drawn into, e.g. by the append*
+  // methods of StringFormatter
+  string& beginLine(int row);
+
+  // Replace lines from the row on with the lines of TEXT. Lines below the
+  // screen are dropped. Returns the row after the last replaced one.
+  int writeLines(int row, std::string_view TEXT);
+
+  // Empty every line
+  void clear();
+
+  // Append the output turning the presented frame into the drawn one, and
+  // make the drawn one the presented one. The cursor ends at the start of
+  // the line below the screen.
+  void appendFrame(string& out);
+
+  // Write the same output to the stream with one write, and flush
+  void present(std::ostream& out);
+
+  // Write the next frame in full, e.g. after other output scrolled it away
+  void invalidate();
+
+  // Append the drawn frame like appendFrame(), but end at the start of the
+  // row instead of below the screen, handing the lines from there on back to
+  // other output. The next frame is written in full.
+  void appendRelease(string& out, int row);
+
+  // Write the same output to the stream with one write, and flush
+  void release(std::ostream& out, int row);
+
+  // Report that the cursor moved count lines further down since the last
+  // frame, e.g. as the terminal echoed the answer to a prompt on the screen.
+  // The next frame moves up past those lines, ends right below the screen
+  // again, and leaves them as they are.
+  void addLinesBelow(int count);
+
+ private:
+  // Append the frame and end at the start of endRow, or leave the cursor
+  // below the screen if endRow is the height and nothing was redrawn
+  void appendFrameEndingOn(string& out, int endRow);
+
+  // Write the output of appendFrameEndingOn with one write, and flush
+  void write(std::ostream& out, int endRow);
+
+  // Line as it is shown: clipped to the width and at a line break
+  std::string_view getVisibleLine(int row) const;
+
+  int m_width;
+  int m_height;
+  // Frame being drawn
+  vector<string> m_lines;
+  // Frame on the terminal, as getVisibleLine showed it
+  vector<string> m_presentedLines;
+  bool m_isPresented = false;
+  // Lines between the bottom of the screen and the cursor
+  int m_linesBelow = 0;
+  // Output buffer reused by every present()
+  string m_output;
+};
+
+}  // namespace mini_utils
+#endif  // SCREEN_H
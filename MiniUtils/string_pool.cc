@@ -0,0 +1,184 @@
+#include "string_pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+namespace mini_utils {
+namespace {
+const size_t MIN_SLOTS = 16;
+
+size_t hashString(std::string_view STR) {
+  return std::hash<std::string_view>()(STR);
+}
+}  // namespace
+
+StringPool::StringPool(std::pmr::memory_resource* resource)
+    : m_resource(resource),
+      m_chunks(resource),
+      m_views(resource),
+      m_hashes(resource),
+      m_slots(resource) {}
+
+uint32_t StringPool::intern(std::string_view STR) {
+  const size_t HASH = hashString(STR);
+  if (m_slots.empty()) {
+    rehash(MIN_SLOTS);
+  }
+  size_t slot = findSlot(STR, HASH);
+  if (m_slots[slot] != EMPTY_SLOT) {
+    return m_slots[slot];
+  }
+  // Only a new string can take the table past half full
+  if ((m_views.size() + 1) * 2 > m_slots.size()) {
+    rehash(m_slots.size() * 2);
+    slot = findSlot(STR, HASH);
+  }
+
+  const uint32_t ID = static_cast<uint32_t>(m_views.size());
+  m_views.push_back(store(STR));
+  m_hashes.push_back(HASH);
+  m_slots[slot] = ID;
+  return ID;
+}
+
+bool StringPool::find(std::string_view STR, uint32_t& id) const {
+  if (m_slots.empty()) {
+    return false;
+  }
+  const uint32_t FOUND = m_slots[findSlot(STR, hashString(STR))];
+  if (FOUND == EMPTY_SLOT) {
+    return false;
+  }
+  id = FOUND;
+  return true;
+}
+
+void StringPool::reserve(size_t count) {
+  m_views.reserve(count);
+  m_hashes.reserve(count);
+  size_t slotCount = std::max(MIN_SLOTS, m_slots.size());
+  while (slotCount < count * 2) {
+    slotCount *= 2;
+  }
+  if (slotCount > m_slots.size()) {
+    rehash(slotCount);
+  }
+}
+
+size_t StringPool::getArenaBytes() const { return m_arenaBytes; }
+
+void StringPool::clear() {
+  m_chunks.clear();
+  m_chunkUsed = CHUNK_SIZE;
+  m_arenaBytes = 0;
+  m_views.clear();
+  m_hashes.clear();
+  m_slots.clear();
+}
+
+std::string_view StringPool::store(std::string_view STR) {
+  if (STR.empty()) {
+    return {};
+  }
+  if (STR.size() > CHUNK_SIZE) {
+    Chunk chunk = allocateChunk(STR.size());
+    std::memcpy(chunk.get(), STR.data(), STR.size());
+    const char* COPY = chunk.get();
+    // Inserted before the current chunk, which stays current
+    m_chunks.insert(m_chunks.empty() ? m_chunks.end() : m_chunks.end() - 1,
+                    std::move(chunk));
+    m_arenaBytes += STR.size();
+    return {COPY, STR.size()};
+  }
+  if (CHUNK_SIZE - m_chunkUsed < STR.size()) {
+    m_chunks.push_back(allocateChunk(CHUNK_SIZE));
+    m_arenaBytes += CHUNK_SIZE;
+    m_chunkUsed = 0;
+  }
+  char* copy = m_chunks.back().get() + m_chunkUsed;
+  std::memcpy(copy, STR.data(), STR.size());
+  m_chunkUsed += STR.size();
+  return {copy, STR.size()};
+}
+
+StringPool::Chunk StringPool::allocateChunk(size_t size) {
+  return Chunk(static_cast<char*>(m_resource->allocate(size, 1)),
+               ChunkDeleter{m_resource, size});
+}
+
+size_t StringPool::findSlot(std::string_view STR, size_t hash) const {
+  const size_t MASK = m_slots.size() - 1;
+  size_t slot = hash & MASK;
+  while (m_slots[slot] != EMPTY_SLOT &&
+         (m_hashes[m_slots[slot]] != hash || m_views[m_slots[slot]] != STR)) {
+    slot = (slot + 1) & MASK;
+  }
+  return slot;
+}
+
+void StringPool::rehash(size_t slotCount) {
+  m_slots.assign(slotCount, EMPTY_SLOT);
+  const size_t MASK = slotCount - 1;
+  for (uint32_t id = 0; id < m_views.size(); ++id) {
+    size_t slot = m_hashes[id] & MASK;
+    while (m_slots[slot] != EMPTY_SLOT) {
+      slot = (slot + 1) & MASK;
+    }
+    m_slots[slot] = id;
+  }
+}
+
+uint32_t ConcurrentStringPool::intern(std::string_view STR) {
+  const uint32_t SHARD_INDEX = getShardIndex(STR);
+  Shard& shard = m_shards[SHARD_INDEX];
+  uint32_t localId = 0;
+  {
+    // Most strings repeat, so the shared lock usually suffices
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.pool.find(STR, localId)) {
+      return localId << SHARD_BITS | SHARD_INDEX;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  localId = shard.pool.intern(STR);
+  return localId << SHARD_BITS | SHARD_INDEX;
+}
+
+bool ConcurrentStringPool::find(std::string_view STR, uint32_t& id) const {
+  const uint32_t SHARD_INDEX = getShardIndex(STR);
+  const Shard& shard = m_shards[SHARD_INDEX];
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  uint32_t localId = 0;
+  if (!shard.pool.find(STR, localId)) {
+    return false;
+  }
+  id = localId << SHARD_BITS | SHARD_INDEX;
+  return true;
+}
+
+std::string_view ConcurrentStringPool::view(uint32_t id) const {
+  const Shard& shard = m_shards[id & (SHARD_COUNT - 1)];
+  // The shard's view table may be reallocated by a concurrent intern
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.pool.view(id >> SHARD_BITS);
+}
+
+size_t ConcurrentStringPool::size() const {
+  size_t total = 0;
+  for (const Shard& shard : m_shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    total += shard.pool.size();
+  }
+  return total;
+}
+
+uint32_t ConcurrentStringPool::getShardIndex(std::string_view STR) {
+  // Top bits, as the shard pools probe by the low bits of the same hash
+  return static_cast<uint32_t>(
+      hashString(STR) >> (std::numeric_limits<size_t>::digits - SHARD_BITS));
+}
+
+}  // namespace mini_utils
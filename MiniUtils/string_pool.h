@@ -0,0 +1,118 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+// Dictionary encoding of strings: every distinct string is stored once and
+// known by a 32-bit id, so tables keyed by strings can be keyed by integers.
+namespace mini_utils {
+
+// Interned strings, copied back to back into large arena chunks. Ids are
+// dense, 0..size() - 1, in first-seen order. Views stay valid, and ids
+// stable, for the life of the pool, however much it grows.
+//
+// Example:
+//   StringPool pool;
+//   const uint32_t ID = pool.intern(line);  // same id for equal lines
+//   std::cout << pool.view(ID);
+class StringPool {
+ public:
+  // Strings and lookup tables are allocated from the resource, which must
+  // outlive the pool
+  explicit StringPool(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // Id of the string, storing a copy of it first if it is new
+  uint32_t intern(std::string_view STR);
+
+  // Id of the string without storing it. Returns false if it is not pooled.
+  bool find(std::string_view STR, uint32_t& id) const;
+
+  // The string with the id, which must come from this pool
+  std::string_view view(uint32_t id) const { return m_views[id]; }
+
+  size_t size() const { return m_views.size(); }
+
+  // Make room for the given number of strings in the lookup table
+  void reserve(size_t count);
+
+  // Bytes allocated for string contents, including unused chunk tails
+  size_t getArenaBytes() const;
+
+  // Drop every string; ids and views handed out before become invalid
+  void clear();
+
+ private:
+  // Strings longer than this get a chunk of their own
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+  static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+  // Hands a chunk back to the resource it came from
+  struct ChunkDeleter {
+    std::pmr::memory_resource* resource;
+    size_t size;
+    void operator()(char* chunk) const {
+      resource->deallocate(chunk, size, 1);
+    }
+  };
+  using Chunk = std::unique_ptr<char[], ChunkDeleter>;
+
+  // New chunk of the given size from the resource
+  Chunk allocateChunk(size_t size);
+
+  // Copy of the string in the arena
+  std::string_view store(std::string_view STR);
+
+  // Slot holding the string's id, or the empty slot where it would go
+  size_t findSlot(std::string_view STR, size_t hash) const;
+
+  // Resize the lookup table to slotCount slots and reinsert every id
+  void rehash(size_t slotCount);
+
+  std::pmr::memory_resource* m_resource;
+  std::pmr::vector<Chunk> m_chunks;
+  size_t m_chunkUsed = CHUNK_SIZE;
+  size_t m_arenaBytes = 0;
+
+  std::pmr::vector<std::string_view> m_views;
+  // Hash of every string, kept so rehashing never reads the strings
+  std::pmr::vector<size_t> m_hashes;
+  // Open addressing with linear probing, at most half full, a power of two
+  std::pmr::vector<uint32_t> m_slots;
+};
+
+// StringPool safe for concurrent intern, find and view calls. Strings are
+// spread over independently locked shards by hash, so threads rarely wait
+// on each other. Ids are unique and stable but not dense: the low bits name
+// the shard.
+class ConcurrentStringPool {
+ public:
+  uint32_t intern(std::string_view STR);
+  bool find(std::string_view STR, uint32_t& id) const;
+  std::string_view view(uint32_t id) const;
+
+  // Number of strings over all shards
+  size_t size() const;
+
+ private:
+  static constexpr int SHARD_BITS = 4;
+  static constexpr uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    StringPool pool;
+  };
+
+  static uint32_t getShardIndex(std::string_view STR);
+
+  std::array<Shard, SHARD_COUNT> m_shards;
+};
+
+}  // namespace mini_utils
+#endif  // STRING_POOL_H
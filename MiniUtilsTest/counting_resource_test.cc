@@ -0,0 +1,72 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "counting_resource.h"
+#include "mini_utils.h"
+#include "string_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+mini_utils::TableFormatter MakeTable(std::pmr::memory_resource* resource) {
+  mini_utils::TableFormatter table(40, resource);
+  table.setColumnWidths({10, 15, 15});
+  table.setHeaders({"Year", "Balance", "Interest"});
+  table.addRow({"1", "$1000.00", "$50.00"});
+  table.addRow(std::vector<std::string>{"2", "a cell too long to fit", "$"});
+  return table;
+}
+}  // namespace
+
+// Tests that allocations and bytes are counted and forwarded
+TEST(CountingResourceTest, Allocate_CountsAndForwards) {
+  mini_utils::CountingResource counter;
+  {
+    std::pmr::vector<int> numbers(&counter);
+    numbers.reserve(100);
+    EXPECT_EQ(counter.getAllocationCount(), 1);
+    EXPECT_EQ(counter.getBytesInUse(), 100 * sizeof(int));
+    numbers.reserve(1000);
+  }
+  EXPECT_EQ(counter.getAllocationCount(), 2);
+  EXPECT_EQ(counter.getDeallocationCount(), 2);
+  EXPECT_EQ(counter.getBytesInUse(), 0u);
+  EXPECT_EQ(counter.getPeakBytes(), 1100 * sizeof(int));
+
+  counter.resetCounters();
+  EXPECT_EQ(counter.getAllocationCount(), 0);
+  EXPECT_EQ(counter.getPeakBytes(), 0u);
+}
+
+// Tests that an arena asks its upstream for a few large blocks only
+TEST(CountingResourceTest, MonotonicArena_FewUpstreamAllocations) {
+  mini_utils::CountingResource counter;
+  {
+    std::pmr::monotonic_buffer_resource arena(&counter);
+    mini_utils::StringPool pool(&arena);
+    for (int i = 0; i < 10000; ++i) {
+      pool.intern("item" + std::to_string(i));
+    }
+    EXPECT_EQ(pool.size(), 10000u);
+    EXPECT_LT(counter.getAllocationCount(), 30);
+  }
+  // Everything goes back when the arena does
+  EXPECT_EQ(counter.getBytesInUse(), 0u);
+}
+
+// Tests that a table kept in a resource renders like one on the heap
+TEST(CountingResourceTest, TableFormatter_RendersFromResource) {
+  mini_utils::CountingResource counter;
+  const mini_utils::TableFormatter heap_table =
+      MakeTable(std::pmr::get_default_resource());
+  {
+    const mini_utils::TableFormatter counted_table = MakeTable(&counter);
+    EXPECT_EQ(counted_table.render(), heap_table.render());
+    EXPECT_GT(counter.getAllocationCount(), 0);
+  }
+  EXPECT_EQ(counter.getBytesInUse(), 0u);
+}
@@ -0,0 +1,179 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "mini_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+const int kFuzzIterations = 200000;
+const size_t kMaxFuzzLength = 12;
+
+// The stringstream extraction getValidatedInput used before parseInput
+template <typename T>
+bool ParseWithStream(const std::string& input, T& value,
+                     bool& has_extra_characters) {
+  std::stringstream input_stream(input);
+  if (!(input_stream >> value)) {
+    return false;
+  }
+  char extra_char;
+  has_extra_characters = static_cast<bool>(input_stream >> extra_char);
+  return true;
+}
+
+// Random short strings over characters that matter to number parsing.
+// 'x' and 'p' are left out on purpose: standard libraries disagree on
+// hexadecimal floating point input, see the dedicated test below.
+std::string RandomInput(std::mt19937& random) {
+  static const char kAlphabet[] = " \t0123456789+-.eEaZ";
+  std::uniform_int_distribution<size_t> length(0, kMaxFuzzLength);
+  std::uniform_int_distribution<size_t> character(0, sizeof(kAlphabet) - 2);
+  std::string input(length(random), ' ');
+  for (char& c : input) {
+    c = kAlphabet[character(random)];
+  }
+  return input;
+}
+
+// Compares parseInput with the stream path over random inputs
+template <typename T>
+void ExpectSameAsStream(unsigned seed) {
+  std::mt19937 random(seed);
+  for (int i = 0; i < kFuzzIterations; ++i) {
+    const std::string input = RandomInput(random);
+    T expected{};
+    T actual{};
+    bool expected_extra = false;
+    bool actual_extra = false;
+    const bool expected_ok = ParseWithStream(input, expected, expected_extra);
+    const bool actual_ok =
+        mini_utils::parseInput(input, actual, actual_extra);
+
+    ASSERT_EQ(actual_ok, expected_ok) << "input \"" << input << "\"";
+    if (expected_ok) {
+      // Bitwise, so that -0.0 and 0.0 count as different
+      ASSERT_EQ(std::memcmp(&actual, &expected, sizeof(T)), 0)
+          << "input \"" << input << "\"";
+      ASSERT_EQ(actual_extra, expected_extra) << "input \"" << input << "\"";
+    }
+  }
+}
+}  // namespace
+
+// Fuzzes integer parsing against the stream path
+TEST(InputParsingTest, ParseInput_IntMatchesStream) {
+  ExpectSameAsStream<int>(1);
+}
+
+// Fuzzes wide integer parsing against the stream path
+TEST(InputParsingTest, ParseInput_LongLongMatchesStream) {
+  ExpectSameAsStream<long long>(2);
+}
+
+// Fuzzes floating point parsing against the stream path
+TEST(InputParsingTest, ParseInput_DoubleMatchesStream) {
+  ExpectSameAsStream<double>(3);
+}
+
+// Fuzzes single character parsing against the stream path
+TEST(InputParsingTest, ParseInput_CharMatchesStream) {
+  ExpectSameAsStream<char>(4);
+}
+
+// Tests the edge cases fuzzing hits rarely
+TEST(InputParsingTest, ParseInput_EdgeCasesMatchStream) {
+  const std::string inputs[] = {
+      "2147483647",  "2147483648", "-2147483648", "-2147483649",
+      "1e308",       "1e309",      "-1e309",      "1e-400",
+      "-1e-400",     "4.9e-324",   "1e",          "1e+",
+      "+.5",         "-.5e-3x",    "00012 34",    "+-1",
+      "  \v\f\r\n7 ", "",          "inf",         "nan"};
+  for (const std::string& input : inputs) {
+    int expected_int = 0;
+    int actual_int = 0;
+    double expected_double = 0;
+    double actual_double = 0;
+    bool expected_extra = false;
+    bool actual_extra = false;
+    EXPECT_EQ(mini_utils::parseInput(input, actual_int, actual_extra),
+              ParseWithStream(input, expected_int, expected_extra))
+        << "int input \"" << input << "\"";
+    EXPECT_EQ(mini_utils::parseInput(input, actual_double, actual_extra),
+              ParseWithStream(input, expected_double, expected_extra))
+        << "double input \"" << input << "\"";
+  }
+}
+
+// Tests hexadecimal floating point input, which the MSVC streams accept
+TEST(InputParsingTest, ParseInput_HexadecimalDouble) {
+  double value = 0;
+  bool has_extra_characters = true;
+  ASSERT_TRUE(mini_utils::parseInput("0x1A", value, has_extra_characters));
+  EXPECT_DOUBLE_EQ(value, 26.0);
+  EXPECT_FALSE(has_extra_characters);
+
+  ASSERT_TRUE(mini_utils::parseInput("-0x1.8p1", value, has_extra_characters));
+  EXPECT_DOUBLE_EQ(value, -3.0);
+}
+
+// Tests the prompt loop end to end with scripted input
+TEST(InputParsingTest, GetValidatedInput_RepromptsUntilValid) {
+  std::istringstream input("abc\n42\n 7 x\n 7 \n");
+  std::ostringstream output;
+  std::streambuf* const original_input = std::cin.rdbuf(input.rdbuf());
+  std::streambuf* const original_output = std::cout.rdbuf(output.rdbuf());
+
+  const int value = mini_utils::getValidatedInput<int>(
+      "> ", [](int number) { return number < 10; }, "digit", true);
+
+  std::cin.rdbuf(original_input);
+  std::cout.rdbuf(original_output);
+  EXPECT_EQ(value, 7);
+  EXPECT_EQ(output.str(),
+            "> Invalid input. Please enter a valid digit.\n"
+            "> Input is out of the accepted range or format. Please enter a "
+            "valid digit.\n"
+            "> Unexpected characters found. Please enter a valid digit.\n"
+            "> ");
+}
+
+// Tests a preprocessor returning a new string, like trimUserFormatting
+TEST(InputParsingTest, GetValidatedInput_StringPreprocessor) {
+  std::istringstream input("$12.5\n");
+  std::ostringstream output;
+  std::streambuf* const original_input = std::cin.rdbuf(input.rdbuf());
+  std::streambuf* const original_output = std::cout.rdbuf(output.rdbuf());
+
+  const double value = mini_utils::getValidatedInput<double>(
+      "", mini_utils::isPositiveRealNum, "amount", false,
+      [](const std::string& raw) { return raw.substr(1); });
+
+  std::cin.rdbuf(original_input);
+  std::cout.rdbuf(original_output);
+  EXPECT_DOUBLE_EQ(value, 12.5);
+}
+
+// Tests that the prompt loop stops at the end of the input, even when no
+// valid value was read
+TEST(InputParsingTest, GetValidatedInput_ThrowsAtEndOfInput) {
+  std::istringstream input("abc\n");
+  std::ostringstream output;
+  EXPECT_THROW(mini_utils::getValidatedInput<int>(
+                   input, output, "> ", [](int) { return true; }, "number"),
+               mini_utils::InputEndedError);
+  EXPECT_EQ(output.str(),
+            "> Invalid input. Please enter a valid number.\n> ");
+
+  std::istringstream empty_input("");
+  EXPECT_THROW(mini_utils::getValidatedInput<int>(
+                   empty_input, output, "> ", [](int) { return true; },
+                   "number"),
+               mini_utils::InputEndedError);
+}
@@ -0,0 +1,5 @@
+#ifndef PCH_H
+#define PCH_H
+
+#include "gtest/gtest.h"
+#endif // PCH_H
\ No newline at end of file
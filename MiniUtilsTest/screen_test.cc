@@ -0,0 +1,216 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "screen.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "mini_utils.h"
+
+// Tests that the first frame is written as plain lines
+TEST(ScreenTest, AppendFrame_FirstFrameInFull) {
+  mini_utils::Screen screen(8, 3);
+  screen.beginLine(0) = "title";
+  screen.writeLines(1, "a line past the width\n");
+
+  std::string out;
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "title\na line p\n\n");
+
+  // Nothing changed, nothing to write
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "");
+}
+
+// Tests that later frames only move to and rewrite the changed characters
+TEST(ScreenTest, AppendFrame_WritesOnlyChanges) {
+  mini_utils::Screen screen(40, 3);
+  screen.writeLines(0, "12:00:00\nstatic\n00 ms");
+  std::string out;
+  screen.appendFrame(out);
+
+  screen.beginLine(0) = "12:00:01";
+  screen.beginLine(2) = "10 ms";
+  out.clear();
+  screen.appendFrame(out);
+  // Up three lines to column 8, down two lines to column 1, back below
+  EXPECT_EQ(out, "\x1b[3A\x1b[8G1\x1b[2B\x1b[1G1\x1b[1B\r");
+
+  // A shorter line blanks the rest of the longer one
+  screen.beginLine(1) = "st";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[2A\x1b[3G    \x1b[2B\r");
+}
+
+// Tests that an invalidated screen is written in full again
+TEST(ScreenTest, Invalidate_WritesFullFrame) {
+  mini_utils::Screen screen(10, 2);
+  screen.writeLines(0, "one\ntwo");
+  std::ostringstream first;
+  screen.present(first);
+
+  screen.invalidate();
+  std::ostringstream second;
+  screen.present(second);
+  EXPECT_EQ(second.str(), first.str());
+  EXPECT_EQ(second.str(), "one\ntwo\n");
+}
+
+// Tests that formatters draw into the screen like they render to strings
+TEST(ScreenTest, Formatters_RenderIntoScreen) {
+  mini_utils::TableFormatter table(30);
+  table.setColumnWidths({10, 20});
+  table.setHeaders({"Year", "Balance"});
+  table.addRow({"1", "$100.00"});
+  const std::string rendered = table.render();
+
+  mini_utils::Screen screen(40, 6);
+  mini_utils::StringFormatter formatter(30);
+  formatter.appendCentered(screen.beginLine(0), "Balances", '|');
+  EXPECT_EQ(table.render(screen, 1), 6);
+
+  std::string out;
+  screen.appendFrame(out);
+  EXPECT_EQ(out, formatter.formatCentered("Balances", '|') + "\n" + rendered);
+
+  // Rows below the screen are dropped
+  mini_utils::Screen short_screen(40, 2);
+  EXPECT_EQ(table.render(short_screen, 1), 2);
+}
+
+// Tests that redrawing the same lines writes nothing at all
+TEST(ScreenTest, AppendFrame_EqualLinesWriteNothing) {
+  mini_utils::Screen screen(8, 2);
+  screen.writeLines(0, "12:00:00\nstatic");
+  std::string out;
+  screen.appendFrame(out);
+
+  // Same visible text, drawn again; the part past the width is not shown
+  screen.writeLines(0, "12:00:00 and more\nstatic\nbelow the screen");
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "");
+}
+
+// Tests that a single changed digit costs one column move
+TEST(ScreenTest, AppendFrame_OneChangedDigit) {
+  mini_utils::Screen screen(20, 1);
+  screen.beginLine(0) = "12:34:56";
+  std::string out;
+  screen.appendFrame(out);
+
+  screen.beginLine(0) = "12:34:57";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[1A\x1b[8G7\x1b[1B\r");
+}
+
+// Tests that changes a few equal characters apart are written as one run
+TEST(ScreenTest, AppendFrame_MergesShortGaps) {
+  mini_utils::Screen screen(20, 1);
+  screen.beginLine(0) = "abcdefghij";
+  std::string out;
+  screen.appendFrame(out);
+
+  // Three equal characters in between are rewritten instead of skipped
+  screen.beginLine(0) = "XbcdXfghij";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[1A\x1b[1GXbcdX\x1b[1B\r");
+
+  // Four are skipped with a second column move
+  screen.beginLine(0) = "YbcdXYghij";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[1A\x1b[1GY\x1b[6GY\x1b[1B\r");
+}
+
+// Tests that a longer line writes its tail and a shorter one blanks it
+TEST(ScreenTest, AppendFrame_ChangedLengthRewritesTail) {
+  mini_utils::Screen screen(20, 1);
+  screen.beginLine(0) = "9 ms";
+  std::string out;
+  screen.appendFrame(out);
+
+  screen.beginLine(0) = "9 ms total";
+  out.clear();
+  screen.appendFrame(out);
+  // A space past the end already looks blank on the terminal
+  EXPECT_EQ(out, "\x1b[1A\x1b[6Gtotal\x1b[1B\r");
+
+  screen.beginLine(0) = "9";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[1A\x1b[3G        \x1b[1B\r");
+}
+
+// Tests that lines reported below the screen are moved past, and stay
+// reported until a frame moves the cursor
+TEST(ScreenTest, AddLinesBelow_MovesPastEchoedLines) {
+  mini_utils::Screen screen(40, 1);
+  screen.beginLine(0) = "Press enter";
+  std::string out;
+  screen.appendFrame(out);
+
+  screen.addLinesBelow(1);
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "");
+
+  screen.beginLine(0) = "Pressed";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[2A\x1b[6Ged    \x1b[1B\r");
+
+  // Back right below the screen
+  screen.beginLine(0) = "Pressed!";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[1A\x1b[8G!\x1b[1B\r");
+
+  // A full frame starts wherever the cursor is
+  screen.addLinesBelow(3);
+  screen.invalidate();
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "Pressed!\n");
+  screen.beginLine(0) = "";
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "\x1b[1A\x1b[1G        \x1b[1B\r");
+}
+
+// Tests that a released screen ends on the row, and is written in full next
+TEST(ScreenTest, Release_EndsOnRow) {
+  mini_utils::Screen screen(20, 3);
+  screen.writeLines(0, "one\ntwo\nthree");
+  std::string out;
+  screen.appendRelease(out, 1);
+  EXPECT_EQ(out, "one\ntwo\nthree\n\x1b[2A\r");
+
+  // The next frame starts wherever the other output left the cursor
+  screen.writeLines(0, "one\nTWO\nthree");
+  out.clear();
+  screen.appendFrame(out);
+  EXPECT_EQ(out, "one\nTWO\nthree\n");
+
+  // A prompt blanked in place, with the cursor left at its start
+  mini_utils::Screen prompt(20, 1);
+  prompt.beginLine(0) = "Continue?";
+  out.clear();
+  prompt.appendFrame(out);
+  prompt.addLinesBelow(1);
+  prompt.clear();
+  out.clear();
+  prompt.appendRelease(out, 0);
+  EXPECT_EQ(out, "\x1b[2A\x1b[1G         \r");
+  // Rows past the height end below the screen
+  out.clear();
+  prompt.appendRelease(out, 5);
+  EXPECT_EQ(out, "\n");
+}
@@ -0,0 +1,122 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "mini_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "allocation_counter.h"
+
+namespace {
+// Short, exactly fitting, too long and empty labels for a width of 26
+constexpr const char* LABELS[] = {
+    "Options:", "123456789012345678901234",
+    "a label far too long to fit in the width", ""};
+
+// Menu laid out at compile time, as the Clock and ItemTracker do it
+constexpr mini_utils::StaticFrame<26, 6> makeFrame() {
+  mini_utils::StaticFrame<26, 6> frame;
+  frame.horizontalSeparator()
+      .horizontalSeparatorWithSides('-', '+')
+      .formatCentered("Clock", '|')
+      .formatFullBorder("Menu")
+      .formatSideBorder("1 - Add One Hour")
+      .formatSideBorder(LABELS[2]);
+  return frame;
+}
+
+constexpr auto FRAME = makeFrame();
+static_assert(FRAME.size() == 6 * 27, "every line is 26 characters wide");
+}  // namespace
+
+// Tests that each append* method writes what its format* method returns
+TEST(StringFormatterTest, Append_MatchesFormat) {
+  for (int width : {5, 26, 80}) {
+    const mini_utils::StringFormatter FORMATTER(width);
+    // Appending keeps what is already in the buffer
+    const std::string PREFIX = "prefix|";
+
+    std::string out = PREFIX;
+    FORMATTER.appendHorizontalSeparator(out, '#');
+    EXPECT_EQ(out, PREFIX + FORMATTER.horizontalSeparator('#'));
+    out = PREFIX;
+    FORMATTER.appendHorizontalSeparatorWithSides(out, '-', '+');
+    EXPECT_EQ(out, PREFIX + FORMATTER.horizontalSeparatorWithSides('-', '+'));
+
+    for (const char* LABEL : LABELS) {
+      out = PREFIX;
+      FORMATTER.appendCentered(out, LABEL, '|');
+      EXPECT_EQ(out, PREFIX + FORMATTER.formatCentered(LABEL, '|'))
+          << width << ": " << LABEL;
+      out = PREFIX;
+      FORMATTER.appendFullBorder(out, LABEL);
+      EXPECT_EQ(out, PREFIX + FORMATTER.formatFullBorder(LABEL))
+          << width << ": " << LABEL;
+      out = PREFIX;
+      FORMATTER.appendSideBorder(out, LABEL);
+      EXPECT_EQ(out, PREFIX + FORMATTER.formatSideBorder(LABEL))
+          << width << ": " << LABEL;
+    }
+  }
+
+  const mini_utils::StringFormatter FORMATTER(80);
+  for (double value : {0.0, -0.005, 1.125, 12345.678, 1e20}) {
+    for (int precision : {0, 2, 6}) {
+      std::string out = "$";
+      FORMATTER.appendWithPrecision(out, value, precision);
+      EXPECT_EQ(out, "$" + FORMATTER.toStringWithPrecision(value, precision))
+          << value << " to " << precision;
+    }
+  }
+}
+
+// Tests that a compile-time frame is laid out like the runtime formatter
+TEST(StringFormatterTest, StaticFrame_MatchesFormat) {
+  const mini_utils::StringFormatter FORMATTER(26);
+  const std::string EXPECTED =
+      FORMATTER.horizontalSeparator() + "\n" +
+      FORMATTER.horizontalSeparatorWithSides('-', '+') + "\n" +
+      FORMATTER.formatCentered("Clock", '|') + "\n" +
+      FORMATTER.formatFullBorder("Menu") + "\n" +
+      FORMATTER.formatSideBorder("1 - Add One Hour") + "\n" +
+      FORMATTER.formatSideBorder(LABELS[2]) + "\n";
+  EXPECT_EQ(std::string(FRAME.data(), FRAME.size()), EXPECTED);
+}
+
+// Tests that redrawing a menu into a warmed-up buffer does not allocate
+TEST(StringFormatterTest, Append_WarmBufferDoesNotAllocate) {
+  const mini_utils::StringFormatter FORMATTER(80);
+  std::string menu;
+  const auto DRAW_MENU = [&FORMATTER, &menu] {
+    menu.clear();
+    FORMATTER.appendHorizontalSeparator(menu);
+    menu += '\n';
+    FORMATTER.appendFullBorder(menu, "Item Tracker Menu");
+    menu += '\n';
+    for (const char* LABEL : LABELS) {
+      FORMATTER.appendSideBorder(menu, LABEL);
+      menu += '\n';
+    }
+    FORMATTER.appendCentered(menu, "Total", '|');
+    FORMATTER.appendWithPrecision(menu, 1234.5678);
+    menu += '\n';
+  };
+  // The first draw grows the buffer
+  const long long COLD_ALLOCATIONS_BEFORE = mini_utils::getAllocationCount();
+  DRAW_MENU();
+  EXPECT_GT(mini_utils::getAllocationCount() - COLD_ALLOCATIONS_BEFORE, 0);
+  const std::string FIRST = menu;
+
+  const long long ALLOCATIONS_BEFORE = mini_utils::getAllocationCount();
+  DRAW_MENU();
+  DRAW_MENU();
+  EXPECT_EQ(mini_utils::getAllocationCount() - ALLOCATIONS_BEFORE, 0);
+  EXPECT_EQ(menu, FIRST);
+
+  // Writing a compile-time frame into the buffer does not allocate either
+  const long long FRAME_ALLOCATIONS_BEFORE = mini_utils::getAllocationCount();
+  menu.assign(FRAME.data(), FRAME.size());
+  EXPECT_EQ(mini_utils::getAllocationCount() - FRAME_ALLOCATIONS_BEFORE, 0);
+}
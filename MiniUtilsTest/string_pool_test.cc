@@ -0,0 +1,132 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "string_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.h"
+
+namespace {
+const int kThreads = 4;
+const int kStringsPerThread = 20000;
+}  // namespace
+
+// Tests that equal strings get the same dense id
+TEST(StringPoolTest, Intern_EqualStringsShareId) {
+  mini_utils::StringPool pool;
+  EXPECT_EQ(pool.intern("apple"), 0u);
+  EXPECT_EQ(pool.intern("pear"), 1u);
+  EXPECT_EQ(pool.intern(std::string("apple")), 0u);
+  EXPECT_EQ(pool.intern(""), 2u);
+  EXPECT_EQ(pool.intern(""), 2u);
+  EXPECT_EQ(pool.size(), 3u);
+  EXPECT_EQ(pool.view(1), "pear");
+}
+
+// Tests that interning a pooled string never grows the lookup table, even
+// when the table is as full as it gets
+TEST(StringPoolTest, Intern_PooledStringDoesNotRehash) {
+  mini_utils::StringPool pool;
+  // Half of the 16 slots the table starts with
+  for (int i = 0; i < 8; ++i) {
+    pool.intern("item " + std::to_string(i));
+  }
+  const std::string POOLED = "item 3";
+  const long long ALLOCATIONS_BEFORE = mini_utils::getAllocationCount();
+  EXPECT_EQ(pool.intern(POOLED), 3u);
+  EXPECT_EQ(mini_utils::getAllocationCount() - ALLOCATIONS_BEFORE, 0);
+
+  // A new string still grows it, and every string stays found
+  EXPECT_EQ(pool.intern("item 8"), 8u);
+  for (int i = 0; i <= 8; ++i) {
+    EXPECT_EQ(pool.intern("item " + std::to_string(i)),
+              static_cast<uint32_t>(i));
+  }
+}
+
+// Tests lookups of pooled and unknown strings
+TEST(StringPoolTest, Find_DoesNotStore) {
+  mini_utils::StringPool pool;
+  uint32_t id = 7;
+  EXPECT_FALSE(pool.find("apple", id));
+  EXPECT_EQ(id, 7u);
+
+  pool.intern("apple");
+  EXPECT_TRUE(pool.find("apple", id));
+  EXPECT_EQ(id, 0u);
+  EXPECT_FALSE(pool.find("appl", id));
+  EXPECT_EQ(pool.size(), 1u);
+}
+
+// Tests that views and ids survive growth of the pool
+TEST(StringPoolTest, View_StableAcrossGrowth) {
+  mini_utils::StringPool pool;
+  const std::string_view first = pool.view(pool.intern("item0"));
+  const std::string large(200000, 'x');
+  pool.intern(large);
+  for (int i = 1; i < 100000; ++i) {
+    pool.intern("item" + std::to_string(i));
+  }
+
+  EXPECT_EQ(first, "item0");
+  EXPECT_EQ(first.data(), pool.view(0).data());
+  EXPECT_EQ(pool.view(1), large);
+  uint32_t id = 0;
+  ASSERT_TRUE(pool.find("item54321", id));
+  EXPECT_EQ(pool.view(id), "item54321");
+  EXPECT_GE(pool.getArenaBytes(), large.size());
+}
+
+// Tests that a cleared pool starts over
+TEST(StringPoolTest, Clear_DropsStrings) {
+  mini_utils::StringPool pool;
+  pool.reserve(100);
+  pool.intern("apple");
+  pool.clear();
+
+  uint32_t id = 0;
+  EXPECT_FALSE(pool.find("apple", id));
+  EXPECT_EQ(pool.getArenaBytes(), 0u);
+  EXPECT_EQ(pool.intern("pear"), 0u);
+}
+
+// Tests that threads interning overlapping strings agree on every id
+TEST(StringPoolTest, ConcurrentIntern_ThreadsAgree) {
+  mini_utils::ConcurrentStringPool pool;
+  std::vector<std::vector<uint32_t>> ids(kThreads);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreads; ++thread) {
+    threads.emplace_back([&pool, &ids, thread] {
+      for (int i = 0; i < kStringsPerThread; ++i) {
+        // Every thread walks the same strings from a different start
+        const int item = (i + thread * kStringsPerThread / kThreads) %
+                         kStringsPerThread;
+        ids[thread].push_back(pool.intern("item" + std::to_string(item)));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(pool.size(), static_cast<size_t>(kStringsPerThread));
+  std::set<uint32_t> distinct(ids[0].begin(), ids[0].end());
+  EXPECT_EQ(distinct.size(), static_cast<size_t>(kStringsPerThread));
+  for (int thread = 0; thread < kThreads; ++thread) {
+    for (int i = 0; i < kStringsPerThread; ++i) {
+      const uint32_t id = ids[thread][i];
+      const int item = (i + thread * kStringsPerThread / kThreads) %
+                       kStringsPerThread;
+      ASSERT_EQ(pool.view(id), "item" + std::to_string(item));
+      uint32_t found = 0;
+      ASSERT_TRUE(pool.find(pool.view(id), found));
+      ASSERT_EQ(found, id);
+    }
+  }
+}
@@ -0,0 +1,172 @@
+// Important: pch.h import MUST always be on top
+#include "pch.h"
+
+#include "mini_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Expected output below was captured from the formatters as they were before
+// the streaming renderers were added, so every render path has to stay
+// byte-identical to it.
+namespace {
+// Airgead yearly report: the title block and the balance table
+const char* const REPORT_TITLE =
+    "+------------------------------------------------------------------------"
+    "------+\n"
+    "|           Balance and Interest Without Additional Monthly Deposits    "
+    "       |\n";
+const char* const REPORT_TABLE =
+    "+----------+---------------------------------+--------------------------"
+    "-------+\n"
+    "| Year     | End of the Year Balance         | End of the Year Earned In"
+    "terest |\n"
+    "+----------+---------------------------------+--------------------------"
+    "-------+\n"
+    "| 1        | $1050.00                        | $50.00                   "
+    "       |\n"
+    "| 2        | $1102.50                        | $52.50                   "
+    "       |\n"
+    "| 30       | $4321.94                        | $205.81 and a note long e"
+    "nou... |\n"
+    "+----------+---------------------------------+--------------------------"
+    "-------+\n";
+
+// Clock menu at the default clock width of 26
+const char* const CLOCK_MENU =
+    "**************************\n"
+    "* 1 - Add One Hour       *\n"
+    "* 2 - Add One Minute     *\n"
+    "* 3 - Add One Second     *\n"
+    "* 4 - Exit Program       *\n"
+    "**************************\n";
+
+// ItemTracker menu at the standard console width of 80
+const char* const ITEM_TRACKER_MENU =
+    "************************************************************************"
+    "********\n"
+    "****************************** Item Tracker Menu ***********************"
+    "********\n"
+    "* Options:                                                              "
+    "       *\n"
+    "* 1. Find item frequency                                                "
+    "       *\n"
+    "* 2. List items with frequencies                                        "
+    "       *\n"
+    "* 3. List item histogram with frequencies                               "
+    "       *\n"
+    "* 4. Exit                                                               "
+    "       *\n"
+    "************************************************************************"
+    "********\n";
+
+const std::vector<std::vector<std::string>> REPORT_ROWS = {
+    {"1", "$1050.00", "$50.00"},
+    {"2", "$1102.50", "$52.50"},
+    {"30", "$4321.94", "$205.81 and a note long enough to be cut short"}};
+
+// Formatter set up the way InvestmentPlannerCli::getTable() does it
+mini_utils::TableFormatter makeReportTable() {
+  mini_utils::TableFormatter table(80);
+  table.setHeaders({"Year", "End of the Year Balance",
+                    "End of the Year Earned Interest"});
+  table.setColumnWidths({10, 35, 35});
+  return table;
+}
+
+// Row source handing out REPORT_ROWS from index next on
+mini_utils::TableFormatter::RowSource makeReportSource(size_t& next) {
+  return [&next](std::vector<std::string>& row) {
+    if (next == REPORT_ROWS.size()) {
+      return false;
+    }
+    row = REPORT_ROWS[next++];
+    return true;
+  };
+}
+}  // namespace
+
+// Tests that the stored rows render exactly like the original report
+TEST(TableFormatterTest, Render_MatchesOriginalReport) {
+  mini_utils::TableFormatter table = makeReportTable();
+  for (const std::vector<std::string>& ROW : REPORT_ROWS) {
+    table.addRow(ROW);
+  }
+  const mini_utils::StringFormatter FORMATTER(80);
+  const std::string TITLE =
+      FORMATTER.horizontalSeparatorWithSides('-', '+') + "\n" +
+      FORMATTER.formatCentered(
+          "Balance and Interest Without Additional Monthly Deposits", '|') +
+      "\n";
+  EXPECT_EQ(TITLE + table.render(),
+            std::string(REPORT_TITLE) + REPORT_TABLE);
+  EXPECT_EQ(table.getRenderedSize(), std::string(REPORT_TABLE).size());
+
+  std::ostringstream out;
+  table.render(out);
+  EXPECT_EQ(out.str(), REPORT_TABLE);
+}
+
+// Tests that rows streamed from a source render the same table
+TEST(TableFormatterTest, RenderPage_MatchesOriginalReport) {
+  const mini_utils::TableFormatter TABLE = makeReportTable();
+  size_t next = 0;
+  std::string buffer;
+  EXPECT_EQ(TABLE.renderPage(buffer, makeReportSource(next)), 3u);
+  EXPECT_EQ(buffer, REPORT_TABLE);
+
+  next = 0;
+  std::ostringstream out;
+  EXPECT_EQ(TABLE.renderPage(out, makeReportSource(next)), 3u);
+  EXPECT_EQ(out.str(), REPORT_TABLE);
+
+  // An exhausted source writes nothing
+  EXPECT_EQ(TABLE.renderPage(out, makeReportSource(next)), 0u);
+  EXPECT_EQ(out.str(), REPORT_TABLE);
+}
+
+// Tests that each page is a complete table of its own rows
+TEST(TableFormatterTest, RenderPage_SplitsIntoTables) {
+  const mini_utils::TableFormatter TABLE = makeReportTable();
+  size_t next = 0;
+  const mini_utils::TableFormatter::RowSource SOURCE =
+      makeReportSource(next);
+  std::string pages;
+  EXPECT_EQ(TABLE.renderPage(pages, SOURCE, 2), 2u);
+  EXPECT_EQ(TABLE.renderPage(pages, SOURCE, 2), 1u);
+
+  mini_utils::TableFormatter first = makeReportTable();
+  first.addRow(REPORT_ROWS[0]);
+  first.addRow(REPORT_ROWS[1]);
+  mini_utils::TableFormatter second = makeReportTable();
+  second.addRow(REPORT_ROWS[2]);
+  EXPECT_EQ(pages, first.render() + second.render());
+}
+
+// Tests that the menus of the Clock and ItemTracker are laid out as before
+TEST(TableFormatterTest, Menus_MatchOriginalLayout) {
+  const mini_utils::StringFormatter CLOCK_FORMATTER(26);
+  const std::string CLOCK_BORDER(26, '*');
+  std::string clockMenu = CLOCK_BORDER + "\n";
+  for (const char* ITEM : {"1 - Add One Hour", "2 - Add One Minute",
+                           "3 - Add One Second", "4 - Exit Program"}) {
+    clockMenu += CLOCK_FORMATTER.formatSideBorder(ITEM) + "\n";
+  }
+  clockMenu += CLOCK_BORDER + "\n";
+  EXPECT_EQ(clockMenu, CLOCK_MENU);
+
+  const mini_utils::StringFormatter FORMATTER(80);
+  std::string menu = FORMATTER.horizontalSeparator('*') + "\n" +
+                     FORMATTER.formatFullBorder("Item Tracker Menu", '*') +
+                     "\n" + FORMATTER.formatSideBorder("Options:") + "\n";
+  for (const char* ITEM :
+       {"1. Find item frequency", "2. List items with frequencies",
+        "3. List item histogram with frequencies", "4. Exit"}) {
+    menu += FORMATTER.formatSideBorder(ITEM) + "\n";
+  }
+  menu += FORMATTER.horizontalSeparator('*') + "\n";
+  EXPECT_EQ(menu, ITEM_TRACKER_MENU);
+}